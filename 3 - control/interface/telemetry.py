@@ -0,0 +1,119 @@
+"""Décodeur de référence des trames de télémétrie du bateau (platformIO/include/telemetryFrame.h)
+
+Trame : COBS(version, type, séquence, charge utile, CRC-16) puis 0x00.
+"""
+import struct
+
+TELEMETRY_VERSION = 1
+TELEMETRY_STATE = 1
+TELEMETRY_TEXT = 2
+
+# Même table que TELEMETRY_FIELDS, dans le même ordre : (clé, octets, angle, échelle)
+FIELDS = [
+    ("latitude",         4, False, 1e7),
+    ("longitude",        4, False, 1e7),
+    ("compass",          2, True,  100),
+    ("wind_vane",        2, True,  100),
+    ("horizontal_tilt",  2, False, 100),
+    ("vertical_tilt",    2, False, 100),
+    ("target_angle",     2, False, 1),
+    ("target_tension",   2, False, 1),
+    ("angle_from_north", 2, False, 1),
+]
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE (polynôme 0x1021, valeur initiale 0xFFFF)"""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Décodage COBS d'une trame sans son délimiteur, None si elle n'est pas valide"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        block = data[i:i + code - 1]
+        if 0 in block:
+            return None
+        out += block
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def _format(value, scale):
+    decimals = len(str(int(scale))) - 1
+    return f"{value / scale:.{decimals}f}"
+
+
+class TelemetryDecoder():
+    def __init__(self):
+        self.buffer = bytearray()
+        self.sequence = None
+        self.frames = 0
+        self.lost_frames = 0
+        self.crc_errors = 0
+
+    def feed(self, data):
+        """Ajoute les octets reçus, renvoie la liste des (clé, valeur) des trames complètes"""
+        values = []
+        self.buffer += data
+        while True:
+            end = self.buffer.find(b"\x00")
+            if end < 0:
+                return values
+            frame = bytes(self.buffer[:end])
+            del self.buffer[:end + 1]
+            if frame:
+                values += self.decode_frame(frame)
+
+    def decode_frame(self, encoded):
+        """(clé, valeur) d'une trame encodée en COBS, sans son délimiteur"""
+        raw = cobs_decode(encoded)
+        if raw is None or len(raw) < 5 or crc16(raw[:-2]) != struct.unpack("<H", raw[-2:])[0]:
+            self.crc_errors += 1
+            return []
+        version, frame_type, sequence = raw[0], raw[1], raw[2]
+        payload = raw[3:-2]
+        if version != TELEMETRY_VERSION:
+            return []
+
+        # Numéros de séquence manquants = trames perdues
+        if self.sequence is not None:
+            self.lost_frames += (sequence - self.sequence - 1) & 0xFF
+        self.sequence = sequence
+        self.frames += 1
+
+        if frame_type == TELEMETRY_TEXT:
+            parts = payload.decode("utf-8", "replace").split(":", 1)
+            if len(parts) == 2:
+                return [(parts[0].strip(), parts[1].strip())]
+            return []
+        if frame_type != TELEMETRY_STATE or len(payload) < 2:
+            return []
+
+        mask = struct.unpack("<H", payload[:2])[0]
+        offset = 2
+        values = []
+        for index, (key, size, angle, scale) in enumerate(FIELDS):
+            if not mask & (1 << index):
+                continue
+            if offset + size > len(payload):
+                self.crc_errors += 1
+                return []
+            fmt = ("<H" if angle else "<h") if size == 2 else "<i"
+            value = struct.unpack(fmt, payload[offset:offset + size])[0]
+            offset += size
+            values.append((key, _format(value, scale)))
+        return values
@@ -1,6 +1,8 @@
 import serial
 import time
 
+from telemetry import TelemetryDecoder
+
 class Xbee():
     def __init__(self, port, baud_rate):
         try:
@@ -9,6 +11,7 @@ class Xbee():
         except serial.SerialException as e:
             print(f"[{time.strftime('%H:%M:%S')}] Erreur série : {e}")
             exit(1)
+        self.telemetry = TelemetryDecoder()
 
 
     def send_key_value(self, key, value):
@@ -21,6 +24,13 @@ class Xbee():
         #print(f"[{time.strftime('%H:%M:%S')}] Message envoyé : {message}")
 
 
+    def send_key_values(self, pairs):
+        """Plusieurs paires (clé, valeur) dans une trame : le bateau les applique toutes ou aucune"""
+        message = ";".join(key.lower() + ":" + str(value) for key, value in pairs) + "|"
+        print(f"{message}")
+        self.serial_xbee.write(message.encode() + b"\n")
+
+
     def send_message(self, message):
         if message.lower() == "exit":
             self.disconnect()
@@ -37,14 +47,10 @@ class Xbee():
         return None
 
 
-    def receive_key_value(self):
-        message = self.receive_message()
-        if message:
-            parts = message.split(":", 1)
-            if len(parts) == 2:
-                key, value = parts[0].strip(), parts[1].strip()
-                return key, value
-        return None, None
+    def receive_key_values(self):
+        """Liste des (clé, valeur) des trames de télémétrie binaires reçues (voir telemetry.py)"""
+        data = self.serial_xbee.read(max(1, self.serial_xbee.in_waiting))
+        return self.telemetry.feed(data)
 
 
     def disconnect(self):
@@ -57,7 +63,7 @@ if __name__ == "__main__":
     xbee = Xbee("COM7", 115200)
     try:
         while True:
-            received_key, received_value = xbee.receive_key_value()
+            received_values = xbee.receive_key_values()
             # if received_key:
             #     print(f"Reçu -> Clé: {received_key}, Valeur: {received_value}")
             
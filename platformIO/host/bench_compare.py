@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""
+Compare two JSON outputs of bench_suite and flag regressions.
+
+Usage:
+    bench_compare.py baseline.json current.json [--threshold 10]
+
+A benchmark regresses when its ns/call grows by more than --threshold
+percent, or when it allocates more per call than in the baseline. The exit
+status is 1 if anything regressed, so the comparison can gate a script.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        return {(r["name"], r["scalar"]): r for r in json.load(f)["results"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown (percent)")
+    options = parser.parse_args()
+
+    baseline, current = load(options.baseline), load(options.current)
+    regressions = 0
+    print("%-42s %-7s %10s %10s %8s" % ("benchmark", "scalar", "base ns", "ns", "change"))
+    for key in sorted(current):
+        now = current[key]
+        if key not in baseline:
+            print("%-42s %-7s %10s %10.2f %8s" % (key[0], key[1], "-", now["ns_per_call"], "new"))
+            continue
+        before = baseline[key]
+        change = 100.0 * (now["ns_per_call"] / before["ns_per_call"] - 1.0)
+        flag = ""
+        if change > options.threshold:
+            flag = "  SLOWER"
+        if now["allocs_per_call"] > before["allocs_per_call"]:
+            flag += "  ALLOCATES (%.3f/call)" % now["allocs_per_call"]
+        regressions += bool(flag)
+        print("%-42s %-7s %10.2f %10.2f %+7.1f%%%s" % (key[0], key[1], before["ns_per_call"],
+                                                      now["ns_per_call"], change, flag))
+    for key in sorted(set(baseline) - set(current)):
+        print("%-42s %-7s %10.2f %10s %8s" % (key[0], key[1], baseline[key]["ns_per_call"], "-", "removed"))
+
+    if regressions:
+        print("%d regression(s) above %.0f %%" % (regressions, options.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,459 @@
+/**
+ * @brief Host benchmark suite: planner, geo helpers and rudder control law
+ *
+ * Usage:
+ *   bench_suite [--format table|json|csv] [--filter text] [--min-time s] [--runs N] [--ghz f]
+ *
+ * Times BasicLaylinePathPlanner::calculate_direction over scripted scenarios,
+ * the static geo helpers and the rudder control law, for every scalar type
+ * the planner is instantiated with, and the SharedData snapshots against a
+ * plain struct copy. Each benchmark is repeated for --min-time
+ * seconds per run and the fastest of --runs runs is kept. Reported per call:
+ *   ns        wall-clock time
+ *   cycles    time-stamp counter ticks on x86, or ns * --ghz elsewhere
+ *   allocs    operator new calls (the planner is meant to never allocate)
+ *
+ * JSON output can be compared between two builds with host/bench_compare.py.
+ */
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "pathPlanification.h"
+#include "controlLaw.h"
+#include "shared_data.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#else
+#define BENCH_HAS_TSC 0
+#endif
+
+// ------------------------------------------------------------------
+// Allocation counter: every operator new of the process
+// ------------------------------------------------------------------
+
+static long allocation_count = 0;
+
+void* operator new(size_t size) {
+    allocation_count++;
+    void* p = malloc(size ? size : 1);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+// ------------------------------------------------------------------
+// Measurement
+// ------------------------------------------------------------------
+
+struct BenchOptions {
+    const char* format = "table";
+    const char* filter = "";
+    double min_time_s = 0.2;
+    int runs = 5;
+    double ghz = 0.0;
+};
+
+struct BenchResult {
+    std::string name;
+    std::string scalar;
+    long calls;
+    double ns_per_call;
+    double cycles_per_call;             // Negative when unknown
+    double allocs_per_call;
+};
+
+/**
+ * @brief Keep a result alive without storing it
+ */
+template <typename V>
+static inline void keep(const V& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+static inline uint64_t cycle_counter() {
+#if BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static const char* scalar_name(double) { return "double"; }
+static const char* scalar_name(float) { return "float"; }
+static const char* scalar_name(q16_16) { return "q16_16"; }
+
+/**
+ * @brief Time a pass function that makes calls_per_pass calls
+ */
+template <typename Pass>
+static void measure(std::vector<BenchResult>& results, const BenchOptions& options,
+                    const std::string& name, const char* scalar, long calls_per_pass, Pass pass) {
+    if (strstr((name + "/" + scalar).c_str(), options.filter) == NULL) {
+        return;
+    }
+    pass();                             // Warm-up: caches, lazy tables
+
+    BenchResult result;
+    result.name = name;
+    result.scalar = scalar;
+    result.calls = 0;
+    result.ns_per_call = DBL_MAX;
+    result.cycles_per_call = DBL_MAX;
+    long allocations_before = allocation_count;
+    for (int run = 0; run < options.runs; run++) {
+        long passes = 0;
+        double elapsed = 0.0;
+        uint64_t cycles_start = cycle_counter();
+        auto start = std::chrono::steady_clock::now();
+        do {
+            pass();
+            passes++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < options.min_time_s);
+        uint64_t cycles = cycle_counter() - cycles_start;
+
+        double calls = (double)passes * calls_per_pass;
+        result.calls += passes * calls_per_pass;
+        result.ns_per_call = fmin(result.ns_per_call, elapsed * 1e9 / calls);
+        result.cycles_per_call = fmin(result.cycles_per_call, cycles / calls);
+    }
+    result.allocs_per_call = (double)(allocation_count - allocations_before) / result.calls;
+    if (!BENCH_HAS_TSC) {
+        result.cycles_per_call = options.ghz > 0.0 ? result.ns_per_call * options.ghz : -1.0;
+    }
+    results.push_back(result);
+}
+
+// ------------------------------------------------------------------
+// Planner scenarios
+// ------------------------------------------------------------------
+
+/**
+ * @brief Scripted leg: waypoint due north of the start, steady or oscillating wind
+ */
+struct PlannerScenario {
+    const char* name;
+    double wind_off_course;             // Wind direction relative to the course (degrees, from)
+    double wind_speed;                  // m/s
+    double shift_amplitude;             // Oscillating shift, 120 s period (degrees)
+    double distance;                    // Start to waypoint (meters)
+};
+
+static const PlannerScenario SCENARIOS[] = {
+    {"beat",        10.0,  6.0,  0.0, 800.0},   // Upwind, tacks on the laylines
+    {"beat_shifty",  5.0,  8.0, 15.0, 800.0},   // Upwind in an oscillating breeze
+    {"reach",       90.0,  5.0,  0.0, 800.0},   // Direct sailing
+    {"run",        170.0, 10.0,  0.0, 800.0},   // Downwind, strong wind
+    {"arrival",     30.0,  5.0,  0.0,  40.0},   // Close to the mark, switch to direct
+};
+
+static const int SCENARIO_STEPS = 600;          // One decision per second for 10 minutes
+
+/**
+ * @brief Planner inputs of one scenario, recorded once and replayed for every scalar type
+ */
+struct PlannerTrace {
+    std::vector<double> boat_lat, boat_lon, compass, wind_vane, wind_speed;
+    std::vector<uint32_t> time_ms;
+    double wpt_lat, wpt_lon;
+};
+
+/**
+ * @brief Sail the scenario with the double planner: the boat turns to the planner
+ * heading and moves 1.5 m per step, like the autopilot holding the course
+ */
+static PlannerTrace record_scenario(const PlannerScenario& scenario) {
+    const double start_lat = 47.2537, start_lon = -1.3702;
+    const double m_per_deg_lat = 111320.0;
+    const double m_per_deg_lon = m_per_deg_lat * cos(start_lat * M_PI / 180.0);
+
+    PlannerTrace trace;
+    trace.wpt_lat = start_lat + scenario.distance / m_per_deg_lat;
+    trace.wpt_lon = start_lon;
+
+    BasicLaylinePathPlanner<double> planner;
+    double lat = start_lat, lon = start_lon, heading = 0.0;
+    for (int k = 0; k < SCENARIO_STEPS; k++) {
+        double wind = scenario.wind_off_course + scenario.shift_amplitude * sin(2.0 * M_PI * k / 120.0);
+        double vane = fmod(wind - heading + 540.0, 360.0) - 180.0;
+        trace.boat_lat.push_back(lat);
+        trace.boat_lon.push_back(lon);
+        trace.compass.push_back(heading);
+        trace.wind_vane.push_back(vane);
+        trace.wind_speed.push_back(scenario.wind_speed);
+        trace.time_ms.push_back(1000u * k);
+
+        heading = planner.calculate_direction(lat, lon, trace.wpt_lat, trace.wpt_lon,
+                                              heading, vane, scenario.wind_speed, 1000u * k);
+        lat += 1.5 * cos(heading * M_PI / 180.0) / m_per_deg_lat;
+        lon += 1.5 * sin(heading * M_PI / 180.0) / m_per_deg_lon;
+    }
+    return trace;
+}
+
+template <typename T>
+static std::vector<T> convert(const std::vector<double>& values) {
+    std::vector<T> out;
+    for (double v : values) {
+        out.push_back(T(v));
+    }
+    return out;
+}
+
+template <typename T>
+static void bench_planner(std::vector<BenchResult>& results, const BenchOptions& options,
+                          const PlannerScenario& scenario, const PlannerTrace& trace) {
+    // Inputs converted up front so the conversion is not timed
+    std::vector<T> boat_lat = convert<T>(trace.boat_lat), boat_lon = convert<T>(trace.boat_lon);
+    std::vector<T> compass = convert<T>(trace.compass), wind_vane = convert<T>(trace.wind_vane);
+    std::vector<T> wind_speed = convert<T>(trace.wind_speed);
+    T wpt_lat = T(trace.wpt_lat), wpt_lon = T(trace.wpt_lon);
+
+    BasicLaylinePathPlanner<T> planner;
+    measure(results, options, std::string("planner.calculate_direction/") + scenario.name, scalar_name(T()),
+            SCENARIO_STEPS, [&]() {
+        planner.reset_planner_state();
+        for (int k = 0; k < SCENARIO_STEPS; k++) {
+            T heading = planner.calculate_direction(boat_lat[k], boat_lon[k], wpt_lat, wpt_lon,
+                                                    compass[k], wind_vane[k], wind_speed[k], trace.time_ms[k]);
+            keep(heading);
+        }
+    });
+}
+
+// ------------------------------------------------------------------
+// Geo helpers and control law
+// ------------------------------------------------------------------
+
+static const int INPUT_COUNT = 1024;
+
+template <typename T>
+static void bench_geo(std::vector<BenchResult>& results, const BenchOptions& options) {
+    typedef BasicLaylinePathPlanner<T> Planner;
+
+    // Point pairs within 5 km of Nantes, winds of any direction and speed
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> offset(-0.045, 0.045);
+    std::uniform_real_distribution<double> angle(0.0, 360.0);
+    std::uniform_real_distribution<double> speed(0.0, 18.0);
+    std::vector<T> lat1, lon1, lat2, lon2, wind_direction, wind_speed;
+    for (int k = 0; k < INPUT_COUNT; k++) {
+        lat1.push_back(T(47.2537 + offset(rng)));
+        lon1.push_back(T(-1.3702 + offset(rng)));
+        lat2.push_back(T(47.2537 + offset(rng)));
+        lon2.push_back(T(-1.3702 + offset(rng)));
+        wind_direction.push_back(T(angle(rng)));
+        wind_speed.push_back(T(speed(rng)));
+    }
+    const char* scalar = scalar_name(T());
+
+    measure(results, options, "geo.calculate_azimuth", scalar, INPUT_COUNT, [&]() {
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            T azimuth = Planner::calculate_azimuth(lat1[k], lon1[k], lat2[k], lon2[k]);
+            keep(azimuth);
+        }
+    });
+    measure(results, options, "geo.calculate_distance", scalar, INPUT_COUNT, [&]() {
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            T distance = Planner::calculate_distance(lat1[k], lon1[k], lat2[k], lon2[k]);
+            keep(distance);
+        }
+    });
+    measure(results, options, "geo.define_no_go_zone", scalar, INPUT_COUNT, [&]() {
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            T min_angle, max_angle;
+            Planner::define_no_go_zone(wind_direction[k], wind_speed[k], &min_angle, &max_angle);
+            keep(min_angle);
+            keep(max_angle);
+        }
+    });
+}
+
+static void bench_control(std::vector<BenchResult>& results, const BenchOptions& options) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> heading(0, 359);
+    std::vector<int> current, target;
+    for (int k = 0; k < INPUT_COUNT; k++) {
+        current.push_back(heading(rng));
+        target.push_back(heading(rng));
+    }
+
+    measure(results, options, "control.calculateShortestPath", "int", INPUT_COUNT, [&]() {
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            int error = shortest_angle_difference(current[k], target[k]);
+            keep(error);
+        }
+    });
+    // servo_control without the servo writes: heading error then PI step
+    measure(results, options, "control.pi_update", "float", INPUT_COUNT, [&]() {
+        float servo_angle = 125.0f;
+        float cumulate_error = 0.0f, adjustment = 0.0f;
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            int error = shortest_angle_difference(current[k], target[k]);
+            servo_angle = pi_rudder_update(servo_angle, error, 0.5f, 0.01f, &cumulate_error, &adjustment);
+            keep(servo_angle);
+        }
+    });
+}
+
+// ------------------------------------------------------------------
+// Shared data snapshots
+// ------------------------------------------------------------------
+
+static void bench_shared(std::vector<BenchResult>& results, const BenchOptions& options) {
+    static SharedData shared;
+    static GnssData plain;
+    GnssData fix = {};
+    fix.latitude = 47.2537;
+    fix.longitude = -1.3702;
+    fix.altitude = 12.0;
+    AttitudeData attitude = {};
+    shared.attitude.write(attitude, 1);
+
+    // Reference: the unsynchronised global struct this replaces
+    measure(results, options, "shared.plain_copy/gnss", "-", INPUT_COUNT, [&]() {
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            fix.latitude += 1e-7;
+            plain = fix;
+            GnssData copy = plain;
+            keep(copy);
+        }
+    });
+    measure(results, options, "shared.write/gnss", "-", INPUT_COUNT, [&]() {
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            fix.latitude += 1e-7;
+            shared.gnss.write(fix, (uint32_t)k);
+        }
+    });
+    measure(results, options, "shared.read/gnss", "-", INPUT_COUNT, [&]() {
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            GnssData copy;
+            shared.gnss.read(&copy);
+            keep(copy);
+        }
+    });
+    measure(results, options, "shared.read/attitude", "-", INPUT_COUNT, [&]() {
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            AttitudeData copy;
+            shared.attitude.read(&copy);
+            keep(copy);
+        }
+    });
+    measure(results, options, "shared.telemetry", "-", INPUT_COUNT, [&]() {
+        for (int k = 0; k < INPUT_COUNT; k++) {
+            TelemetryData copy = shared.telemetry();
+            keep(copy);
+        }
+    });
+}
+
+// ------------------------------------------------------------------
+// Output
+// ------------------------------------------------------------------
+
+static const char* cycle_source(const BenchOptions& options) {
+    return BENCH_HAS_TSC ? "tsc" : (options.ghz > 0.0 ? "ghz" : "none");
+}
+
+static void print_results(const std::vector<BenchResult>& results, const BenchOptions& options) {
+    if (strcmp(options.format, "json") == 0) {
+        printf("{\n  \"cycle_source\": \"%s\",\n  \"planner_scalar\": \"%s\",\n  \"results\": [\n",
+               cycle_source(options), scalar_name(PlannerScalar()));
+        for (size_t k = 0; k < results.size(); k++) {
+            const BenchResult& r = results[k];
+            printf("    {\"name\": \"%s\", \"scalar\": \"%s\", \"calls\": %ld, \"ns_per_call\": %.3f, "
+                   "\"cycles_per_call\": %.1f, \"allocs_per_call\": %.3f}%s\n",
+                   r.name.c_str(), r.scalar.c_str(), r.calls, r.ns_per_call,
+                   r.cycles_per_call, r.allocs_per_call, k + 1 < results.size() ? "," : "");
+        }
+        printf("  ]\n}\n");
+    } else if (strcmp(options.format, "csv") == 0) {
+        printf("name,scalar,calls,ns_per_call,cycles_per_call,allocs_per_call\n");
+        for (const BenchResult& r : results) {
+            printf("%s,%s,%ld,%.3f,%.1f,%.3f\n", r.name.c_str(), r.scalar.c_str(), r.calls,
+                   r.ns_per_call, r.cycles_per_call, r.allocs_per_call);
+        }
+    } else {
+        printf("%-42s %-7s %10s %12s %12s\n", "benchmark", "scalar", "ns/call", "cycles/call", "allocs/call");
+        for (const BenchResult& r : results) {
+            char cycles[32];
+            if (r.cycles_per_call < 0.0) {
+                snprintf(cycles, sizeof(cycles), "-");
+            } else {
+                snprintf(cycles, sizeof(cycles), "%.1f", r.cycles_per_call);
+            }
+            printf("%-42s %-7s %10.2f %12s %12.3f\n", r.name.c_str(), r.scalar.c_str(),
+                   r.ns_per_call, cycles, r.allocs_per_call);
+        }
+        printf("cycles: %s\n", cycle_source(options));
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--format") == 0) {
+            options.format = argv[i + 1];
+        } else if (strcmp(argv[i], "--filter") == 0) {
+            options.filter = argv[i + 1];
+        } else if (strcmp(argv[i], "--min-time") == 0) {
+            options.min_time_s = atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--runs") == 0) {
+            options.runs = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--ghz") == 0) {
+            options.ghz = atof(argv[i + 1]);
+        } else {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (options.runs < 1) {
+        options.runs = 1;
+    }
+
+    std::vector<BenchResult> results;
+    for (const PlannerScenario& scenario : SCENARIOS) {
+        PlannerTrace trace = record_scenario(scenario);
+        bench_planner<double>(results, options, scenario, trace);
+        bench_planner<float>(results, options, scenario, trace);
+        bench_planner<q16_16>(results, options, scenario, trace);
+    }
+    bench_geo<double>(results, options);
+    bench_geo<float>(results, options);
+    bench_geo<q16_16>(results, options);
+    bench_control(results, options);
+    bench_shared(results, options);
+
+    print_results(results, options);
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @brief Host tool: isochrone route from a wind file, printed as an XBee mission upload
+ *
+ * Usage:
+ *   isochrone_route <wind.txt> <start_lat> <start_lon> <dest_lat> <dest_lon>
+ *                   [--polar polar.csv] [--threads N] [--step seconds] [--start-time seconds]
+ *
+ * stdout holds the messages to send over the XBee link (mission_clear, one
+ * wp per waypoint, mission_start), a summary goes to stderr.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include "isochroneRouter.h"
+#include "mission.h"
+
+int main(int argc, char** argv) {
+    if (argc < 6) {
+        fprintf(stderr, "usage: %s <wind.txt> <start_lat> <start_lon> <dest_lat> <dest_lon> "
+                        "[--polar polar.csv] [--threads N] [--step seconds] [--start-time seconds]\n", argv[0]);
+        return 2;
+    }
+
+    const char* polar_path = NULL;
+    int threads = (int)std::thread::hardware_concurrency();
+    double start_time_s = 0.0;
+    IsochroneSettings settings;
+    for (int i = 6; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--polar") == 0) {
+            polar_path = argv[i + 1];
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            threads = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--step") == 0) {
+            settings.time_step_s = (float)atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--start-time") == 0) {
+            start_time_s = atof(argv[i + 1]);
+        }
+    }
+
+    // Grid large enough for a day of hourly forecasts over a 100 x 100 area
+    std::vector<WindSample> storage(25 * 100 * 100);
+    WindField wind(storage.data(), (int)storage.size());
+    if (!wind.load_from_file(argv[1])) {
+        fprintf(stderr, "cannot load wind field %s\n", argv[1]);
+        return 1;
+    }
+
+    static BasicPolarTable<float> polar;
+    if (polar_path != NULL && !polar.load_from_file(polar_path)) {
+        fprintf(stderr, "cannot load polar %s, using the default polar\n", polar_path);
+    }
+
+    // ~3 MB of search state: keep it off the stack
+    static HostIsochroneRouter router(polar, wind);
+    router.set_settings(settings);
+    RouteResult result = router.route(atof(argv[2]), atof(argv[3]), atof(argv[4]), atof(argv[5]),
+                                      start_time_s, threads < 1 ? 1 : threads);
+
+    double lats[MISSION_MAX_WAYPOINTS], lons[MISSION_MAX_WAYPOINTS];
+    int count = router.waypoints(lats, lons, MISSION_MAX_WAYPOINTS);
+    fprintf(stderr, "%s in %.0f s (%d isochrones, %d nodes, %d waypoints, %d threads)\n",
+            result.reached ? "destination reached" : "destination NOT reached, closest point",
+            result.duration_s, result.steps, result.nodes, count, threads);
+
+    printf("mission_clear:1|\n");
+    for (int i = 0; i < count; i++) {
+        printf("wp:%.7f,%.7f|\n", lats[i], lons[i]);
+    }
+    printf("mission_start:1|\n");
+    return result.reached ? 0 : 3;
+}
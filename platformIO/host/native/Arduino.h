@@ -0,0 +1,46 @@
+/**
+ * @brief Host stand-in for the few Arduino calls of the unit tests and of the
+ * modules built by the native_test environment (pio test -e native_test)
+ *
+ * Timing comes from the host steady clock, Serial prints to stdout. Nothing
+ * else of the Arduino core is provided: a module that needs more belongs to
+ * the Pico build only.
+ */
+#ifndef HOST_NATIVE_ARDUINO_H
+#define HOST_NATIVE_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define DEC 10
+#define HEX 16
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+/**
+ * @brief Serial port of the tests, printed on stdout
+ */
+class HostSerial {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void print(const char* text) { fputs(text, stdout); }
+    void print(long value, int base = DEC) { printf(base == HEX ? "%lX" : "%ld", value); }
+    void print(double value) { printf("%.2f", value); }
+    void println() { fputc('\n', stdout); }
+    template <typename T>
+    void println(T value) { print(value); println(); }
+    void println(long value, int base) { print(value, base); println(); }
+    operator bool() const { return true; }
+};
+
+extern HostSerial Serial;
+
+#endif // HOST_NATIVE_ARDUINO_H
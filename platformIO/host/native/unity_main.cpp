@@ -0,0 +1,32 @@
+/**
+ * @brief Entry point of the host unit tests: runs the Arduino-style setup()
+ * of the test, then returns the Unity failure count
+ */
+#include <chrono>
+#include <unity.h>
+#include "Arduino.h"
+
+HostSerial Serial;
+
+static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void delay(unsigned long ms) {
+    (void)ms;   // The tests wait for a serial monitor, not needed on the host
+}
+
+void setup();
+
+int main() {
+    setup();
+    return Unity.TestFailures > 0 ? 1 : 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @brief Host benchmark: planner decision core, one state at a time vs PlannerBatch
+ *
+ * Usage:
+ *   planner_bench [states] [repeats]
+ *
+ * Random states within 2 km of the waypoint are evaluated once with libm
+ * scalar code (the formulas of calculate_raw_direction, one call per state)
+ * and once with PlannerBatch. Throughput of both and the number of differing
+ * decisions are printed.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "plannerBatch.h"
+
+struct ScalarDecision {
+    float azimuth, distance;
+    bool can_sail_direct, tack_proposed;
+};
+
+/**
+ * @brief Reference: same decision core with libm, kept out of line like a planner call
+ */
+static __attribute__((noinline)) ScalarDecision scalar_decision(const BasicPolarTable<float>& polar,
+                                                               float east, float north, float compass,
+                                                               float wind_vane, float wind_speed, bool port) {
+    ScalarDecision d;
+    d.azimuth = fmodf(atan2f(east, north) * (float)(180.0 / M_PI) + 360.0f, 360.0f);
+    d.distance = sqrtf(east * east + north * north);
+    float vmg_tack = fmaxf(polar.upwind_vmg_angle(wind_speed), 40.0f) + 5.0f;
+    if (wind_speed > 6.0f) {
+        vmg_tack += (wind_speed - 6.0f) * 0.8f;
+    }
+    float wind_abs = fmodf(compass + wind_vane + 360.0f, 360.0f);
+    float relative = fmodf(d.azimuth - wind_abs + 540.0f, 360.0f) - 180.0f;
+    float no_go = wind_speed > 15.0f ? 54.0f : (wind_speed < 5.0f ? 36.0f : 45.0f);
+    d.can_sail_direct = fabsf(relative) > no_go + 7.0f;
+    float wind_push = wind_speed > 5.0f ? fminf((wind_speed - 5.0f) * 2.5f, 20.0f) : 0.0f;
+    float layline = vmg_tack + 8.0f + fmaxf(wind_push, fminf(15.0f, fmaxf(7.0f, d.distance / 10.0f)));
+    d.tack_proposed = port ? relative > layline : relative < -layline;
+    return d;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    const int count = argc > 1 ? atoi(argv[1]) : 1 << 20;
+    const int repeats = argc > 2 ? atoi(argv[2]) : 20;
+
+    std::vector<float> boat_east(count), boat_north(count), wpt_east(count, 0.0f), wpt_north(count, 0.0f);
+    std::vector<float> compass(count), wind_vane(count), wind_speed(count);
+    std::vector<uint8_t> on_port_tack(count);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+    std::uniform_real_distribution<float> speed(0.0f, 18.0f);
+    for (int k = 0; k < count; k++) {
+        boat_east[k] = position(rng);
+        boat_north[k] = position(rng);
+        compass[k] = angle(rng);
+        wind_vane[k] = angle(rng);
+        wind_speed[k] = speed(rng);
+        on_port_tack[k] = rng() & 1;
+    }
+
+    std::vector<float> azimuth(count), distance(count), port_heading(count), starboard_heading(count);
+    std::vector<uint8_t> can_sail_direct(count), tack_proposed(count), required_confirmations(count);
+    PlannerBatchStates states = {boat_east.data(), boat_north.data(), wpt_east.data(), wpt_north.data(),
+                                 compass.data(), wind_vane.data(), wind_speed.data(), on_port_tack.data()};
+    PlannerBatchResults results = {azimuth.data(), distance.data(), port_heading.data(), starboard_heading.data(),
+                                   can_sail_direct.data(), tack_proposed.data(), required_confirmations.data()};
+
+    const BasicPolarTable<float>& polar = BasicPolarTable<float>::default_table();
+    PlannerBatch batch(polar);
+
+    // One state at a time
+    long direct_differences = 0, tack_differences = 0;
+    double checksum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) {
+        for (int k = 0; k < count; k++) {
+            ScalarDecision d = scalar_decision(polar, wpt_east[k] - boat_east[k], wpt_north[k] - boat_north[k],
+                                               compass[k], wind_vane[k], wind_speed[k], on_port_tack[k] != 0);
+            checksum += d.azimuth;
+        }
+    }
+    double scalar_time = seconds_since(start);
+
+    // Batch
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) {
+        batch.evaluate(states, results, count);
+        checksum += azimuth[r % count];
+    }
+    double batch_time = seconds_since(start);
+
+    for (int k = 0; k < count; k++) {
+        ScalarDecision d = scalar_decision(polar, wpt_east[k] - boat_east[k], wpt_north[k] - boat_north[k],
+                                           compass[k], wind_vane[k], wind_speed[k], on_port_tack[k] != 0);
+        direct_differences += d.can_sail_direct != (can_sail_direct[k] != 0);
+        tack_differences += d.tack_proposed != (tack_proposed[k] != 0);
+    }
+
+    double states_total = (double)count * repeats;
+    printf("scalar: %8.1f Mstates/s\n", states_total / scalar_time / 1e6);
+    printf("batch:  %8.1f Mstates/s (x%.1f)\n", states_total / batch_time / 1e6, scalar_time / batch_time);
+    printf("differences: %ld direct, %ld tack out of %d states (checksum %.0f)\n",
+           direct_differences, tack_differences, count, checksum);
+    return 0;
+}
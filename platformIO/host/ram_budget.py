@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+RAM budget of the firmware per subsystem, from the symbols of the ELF.
+
+Usage:
+    ram_budget.py firmware.elf [--nm arm-none-eabi-nm] [--budget tasks=40000 ...] [--details]
+
+Every object in .data and .bss (nm types d/D/b/B) is charged to the first
+subsystem whose pattern matches its demangled name; the stacks and control
+blocks of the STATIC_ALLOCATION build are in taskStackPool / taskTcbPool
+(see create_task in staticAlloc.h). The exit status is 1 when a subsystem
+is over its --budget (bytes), so the report can gate a build.
+"""
+import argparse
+import re
+import subprocess
+import sys
+
+# (subsystem, pattern on the demangled symbol), first match wins
+SUBSYSTEMS = [
+    ("tasks", r"taskStackPool|taskTcbPool|xIdleTaskTCB|uxIdleTaskStack|xTimerTaskTCB|uxTimerTaskStack"),
+    ("heap", r"ucHeap|__heap|_sbrk"),
+    ("trace", r"traceBuffer|trace"),
+    ("queues", r"Queue$"),
+    ("monitor", r"taskMonitor|monitorTask"),
+    ("shared", r"sharedData|pathFindingHandle"),
+    ("planner", r"[Pp]lanner|[Pp]olar|[Mm]ission|pathFinding"),
+    ("i2c", r"i2c[01]Bus|interruptBus"),
+    ("gps", r"m_GNSS|myGNSS|GNSS"),
+    ("sensors", r"cmps12|qmc5883l|sensorTask"),
+    ("control", r"\bboat\b|[Ss]ervo|controlTask"),
+    ("xbee", r"xbee|Xbee|Serial[12]"),
+    ("freertos", r"^(px|ux|x|pv|ul)[A-Z]|FreeRTOS"),
+]
+
+
+def symbols(elf, nm):
+    output = subprocess.run([nm, "-S", "-C", "--size-sort", elf], check=True,
+                            capture_output=True, text=True).stdout
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) == 4 and fields[2] in "dDbB":
+            yield fields[3], int(fields[1], 16)
+
+
+def classify(name):
+    for subsystem, pattern in SUBSYSTEMS:
+        if re.search(pattern, name):
+            return subsystem
+    return "other"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm of the toolchain")
+    parser.add_argument("--budget", action="append", default=[], metavar="SUBSYSTEM=BYTES")
+    parser.add_argument("--details", action="store_true", help="list the symbols of each subsystem")
+    options = parser.parse_args()
+
+    budgets = {}
+    for entry in options.budget:
+        subsystem, _, size = entry.partition("=")
+        budgets[subsystem] = int(size, 0)
+
+    usage = {}
+    for name, size in symbols(options.elf, options.nm):
+        usage.setdefault(classify(name), []).append((size, name))
+
+    total = sum(size for entries in usage.values() for size, _ in entries)
+    over = 0
+    print("%-10s %8s %6s %8s" % ("subsystem", "bytes", "share", "budget"))
+    for subsystem in sorted(usage, key=lambda s: -sum(size for size, _ in usage[s])):
+        size = sum(size for size, _ in usage[subsystem])
+        budget = budgets.get(subsystem)
+        flag = ""
+        if budget is not None and size > budget:
+            flag = "  OVER BUDGET"
+            over += 1
+        print("%-10s %8d %5.1f%% %8s%s" % (subsystem, size, 100.0 * size / max(total, 1),
+                                          "-" if budget is None else budget, flag))
+        if options.details:
+            for symbol_size, name in sorted(usage[subsystem], reverse=True):
+                print("    %8d  %s" % (symbol_size, name))
+    print("%-10s %8d" % ("total", total))
+
+    if over:
+        print("%d subsystem(s) over budget" % over)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
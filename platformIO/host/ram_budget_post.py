@@ -0,0 +1,16 @@
+"""
+PlatformIO post script of env:pico_static: prints the RAM budget per
+subsystem (host/ram_budget.py) after each link of the firmware.
+"""
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+import os
+
+
+def ram_budget(source, target, env):
+    script = os.path.join(env.subst("$PROJECT_DIR"), "host", "ram_budget.py")
+    nm = env.subst("$CC").replace("gcc", "nm")
+    env.Execute('"$PYTHONEXE" "%s" "%s" --nm "%s"' % (script, target[0].get_abspath(), nm))
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", ram_budget)  # noqa: F821
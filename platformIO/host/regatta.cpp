@@ -0,0 +1,68 @@
+/**
+ * @brief Host tool: Monte Carlo regatta of the layline planner on the simulated boat
+ *
+ * Usage:
+ *   regatta [--scenarios N] [--threads N] [--seed S] [--length meters]
+ *           [--wind-min m/s] [--wind-max m/s] [--angle-min deg] [--angle-max deg]
+ *
+ * Prints the arrival rate and the distribution of time to waypoint, tack
+ * count and distance sailed.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "regattaRunner.h"
+
+static void print_distribution(const char* name, const RegattaDistribution& d) {
+    printf("%-12s %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+           name, d.mean, d.stddev, d.min, d.p10, d.p50, d.p90, d.max);
+}
+
+int main(int argc, char** argv) {
+    RegattaSettings settings;
+    int scenarios = 1000;
+    int threads = (int)std::thread::hardware_concurrency();
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--scenarios") == 0) {
+            scenarios = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            threads = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            settings.seed = strtoull(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--length") == 0) {
+            settings.course_length_m = atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--wind-min") == 0) {
+            settings.wind_speed_min = atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--wind-max") == 0) {
+            settings.wind_speed_max = atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--angle-min") == 0) {
+            settings.wind_angle_min_deg = atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--angle-max") == 0) {
+            settings.wind_angle_max_deg = atof(argv[i + 1]);
+        } else {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (scenarios < 1) {
+        scenarios = 1;
+    }
+
+    RegattaRunner runner(settings);
+    std::vector<ScenarioResult> results(scenarios);
+    auto start = std::chrono::steady_clock::now();
+    runner.run(results.data(), scenarios, threads < 1 ? 1 : threads);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    RegattaSummary summary = RegattaRunner::summarize(results.data(), scenarios);
+    printf("%d scenarios, %d arrived (%.1f %%), %.2f s on %d threads\n", summary.scenarios, summary.arrived,
+           100.0 * summary.arrived / summary.scenarios, elapsed, threads);
+    printf("%-12s %9s %9s %9s %9s %9s %9s %9s\n", "", "mean", "stddev", "min", "p10", "p50", "p90", "max");
+    print_distribution("time (s)", summary.time_s);
+    print_distribution("tacks", summary.tacks);
+    print_distribution("distance (m)", summary.distance_m);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""
+Decode the binary trace of the Pico (include/trace.h) back into text.
+
+Usage:
+    trace_decode.py /dev/ttyACM0 [--baud 115200]     # live, needs pyserial
+    trace_decode.py capture.bin                      # raw capture of the port
+
+Event formats are read from include/traceEvents.h, so the decoder always
+matches the firmware it sits next to (pass --events to use another table).
+Bytes outside trace frames (boot messages printed with Serial) are passed
+through as text.
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+RECORD = struct.Struct("<IHBB3I")
+FRAME_SIZE = len(SYNC) + RECORD.size + 1
+LEVELS = {1: "E", 2: "W", 3: "I", 4: "D"}
+
+DEFAULT_EVENTS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "include", "traceEvents.h")
+
+# %{a|b}, %D, or a printf conversion on 32-bit integers or floats
+SPEC = re.compile(r"%\{([^}]*)\}|%D|%([-+ 0#]*\d*(?:\.\d+)?)([duxXf])|%%")
+
+
+def load_events(path):
+    """Event formats in table order: X(NAME, "format")."""
+    events = []
+    with open(path, encoding="utf-8") as header:
+        for line in header:
+            match = re.match(r'\s*X\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', line)
+            if match:
+                events.append((match.group(1), match.group(2)))
+    return events
+
+
+def format_event(fmt, args):
+    values = iter(args)
+
+    def substitute(match):
+        if match.group(0) == "%%":
+            return "%"
+        word = next(values, 0)
+        if match.group(1) is not None:
+            choices = match.group(1).split("|")
+            return choices[word] if word < len(choices) else str(word)
+        if match.group(0) == "%D":
+            return "%.7f" % (struct.unpack("<i", struct.pack("<I", word))[0] / 1e7)
+        flags, conversion = match.group(2), match.group(3)
+        if conversion == "f":
+            value = struct.unpack("<f", struct.pack("<I", word))[0]
+        elif conversion == "d":
+            value = struct.unpack("<i", struct.pack("<I", word))[0]
+        else:
+            value = word
+        return ("%" + flags + conversion) % value
+
+    return SPEC.sub(substitute, fmt)
+
+
+class Decoder:
+    """Splits a byte stream into trace frames and plain text."""
+
+    def __init__(self, events, out):
+        self.events = events
+        self.out = out
+        self.buffer = bytearray()
+        self.text = bytearray()
+        self.wraps = 0
+        self.last_timestamp = None
+
+    def feed(self, data):
+        self.buffer += data
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                # Keep a trailing 0xA5, it may be the start of the next frame
+                keep = 1 if self.buffer.endswith(SYNC[:1]) else 0
+                self.add_text(self.buffer[:len(self.buffer) - keep])
+                del self.buffer[:len(self.buffer) - keep]
+                return
+            self.add_text(self.buffer[:start])
+            del self.buffer[:start]
+            if len(self.buffer) < FRAME_SIZE:
+                return
+            body = bytes(self.buffer[len(SYNC):FRAME_SIZE])
+            if sum(body) & 0xFF != 0:
+                # Not a frame after all: the sync bytes are text
+                self.add_text(self.buffer[:1])
+                del self.buffer[:1]
+                continue
+            del self.buffer[:FRAME_SIZE]
+            self.flush_text()
+            self.record(RECORD.unpack(body[:RECORD.size]))
+
+    def record(self, fields):
+        timestamp, event, level, arg_count, *args = fields
+        # micros() wraps every 71 minutes
+        if self.last_timestamp is not None and timestamp < self.last_timestamp:
+            self.wraps += 1
+        self.last_timestamp = timestamp
+        seconds = (timestamp + (self.wraps << 32)) / 1e6
+        if event < len(self.events):
+            text = format_event(self.events[event][1], args[:arg_count])
+        else:
+            text = "unknown event %d %s" % (event, " ".join("0x%08x" % a for a in args[:arg_count]))
+        self.out.write("%12.6f %s %s\n" % (seconds, LEVELS.get(level, "?"), text))
+
+    def add_text(self, data):
+        self.text += data
+        while b"\n" in self.text:
+            line, _, rest = bytes(self.text).partition(b"\n")
+            self.text = bytearray(rest)
+            self.out.write(line.decode("utf-8", "replace").rstrip("\r") + "\n")
+
+    def flush_text(self):
+        if self.text:
+            self.out.write(self.text.decode("utf-8", "replace") + "\n")
+            self.text = bytearray()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="serial port or capture file")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--events", default=DEFAULT_EVENTS, help="traceEvents.h of the firmware")
+    options = parser.parse_args()
+
+    decoder = Decoder(load_events(options.events), sys.stdout)
+    if os.path.isfile(options.source):
+        with open(options.source, "rb") as capture:
+            decoder.feed(capture.read())
+        decoder.flush_text()
+        return
+
+    import serial
+    with serial.Serial(options.source, options.baud, timeout=0.1) as port:
+        try:
+            while True:
+                decoder.feed(port.read(256))
+                sys.stdout.flush()
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == "__main__":
+    main()
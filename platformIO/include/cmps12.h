@@ -2,13 +2,50 @@
 #define CMPS12_H
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "i2cBus.h"
+
+// Registres lus en rafale par readOrientation(), à partir du cap 16 bits
+#define CMPS12_REG_BEARING      0x02    // Cap 0..3599 (dixièmes de degré), poids fort d'abord
+#define CMPS12_REG_PITCH        0x04    // Tangage en degrés, signé
+#define CMPS12_REG_ROLL         0x05    // Roulis en degrés, signé
+#define CMPS12_REG_MAGNETOMETER 0x06    // X, Y, Z bruts, 16 bits signés
+#define CMPS12_REG_ACCELEROMETER 0x0C
+#define CMPS12_REG_GYROSCOPE    0x12
+#define CMPS12_REG_TEMPERATURE  0x18
+#define CMPS12_REG_CALIBRATION  0x1E
+// Plus longue rafale : 0x02..0x1E
+#define CMPS12_BURST_MAX        (CMPS12_REG_CALIBRATION - CMPS12_REG_BEARING + 1)
+
+// Blocs optionnels de readOrientation() ; la rafale va jusqu'au dernier demandé
+enum CMPS12Block : uint8_t {
+  CMPS12_MAGNETOMETER  = 0x01,
+  CMPS12_ACCELEROMETER = 0x02,
+  CMPS12_GYROSCOPE     = 0x04,
+  CMPS12_TEMPERATURE   = 0x08,
+  CMPS12_CALIBRATION   = 0x10
+};
+
+// Un échantillon, lu en une seule transaction
+struct CMPS12Orientation {
+  uint16_t bearing;         // Dixièmes de degré
+  int8_t pitch;             // Degrés
+  int8_t roll;
+  int16_t magnetometer[3];
+  int16_t accelerometer[3];
+  int16_t gyroscope[3];
+  int16_t temperature;
+  uint8_t calibration;
+  uint8_t blocks;           // Blocs remplis (CMPS12Block), ceux couverts par la rafale
+  uint32_t sample_us;       // Fin de la lecture (micros())
+};
 
 class CMPS12 {
 public:
-  // Constructeur : on passe l'instance TwoWire et l'adresse I2C (par défaut 0x60)
-  CMPS12(TwoWire &wire, uint8_t addr = 0x60);
+  // Constructeur : on passe le bus I2C (i2cBus.h), l'adresse I2C (par défaut 0x60)
+  // et la priorité du capteur sur ce bus (0 : servi en premier)
+  CMPS12(I2cBus &bus, uint8_t addr = 0x60, uint8_t priority = 0);
 
+  // Rattache le capteur au bus ; les lectures endorment la tâche appelante pendant le transfert
   void begin();
   void startCalibration();
   void endCalibration();
@@ -20,9 +57,20 @@ public:
   int8_t   readRoll();
   uint8_t  readCalibrationState();
 
+  // Cap, tangage, roulis et les blocs demandés en une seule transaction
+  // Retourne false si le capteur n'a pas répondu (out n'est pas modifié)
+  bool readOrientation(CMPS12Orientation *out, uint8_t blocks = 0);
+
+  // Nombre de registres lus à partir de CMPS12_REG_BEARING pour ces blocs
+  static uint8_t burstLength(uint8_t blocks);
+  // Décodage des registres lus à partir de CMPS12_REG_BEARING
+  static void decode(const uint8_t *registers, uint8_t length, CMPS12Orientation *out);
+
 private:
-  TwoWire &_wire;
+  I2cBus &_bus;
+  I2cChannel _channel;
   uint8_t _addr;
+  bool sendCommand(uint8_t command);
   uint8_t read8BitRegister(uint8_t reg);
   int16_t read16BitRegister(uint8_t reg);
 };
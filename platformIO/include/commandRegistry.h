@@ -0,0 +1,90 @@
+#ifndef COMMAND_REGISTRY_H
+#define COMMAND_REGISTRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Uplink commands: keys, value types and the parser of a command frame
+ *
+ * A frame holds one or more "key:value" pairs separated by ';', e.g.
+ * "kp:0.8;ki:0.05;cap:270". Keys are found through a perfect hash built at
+ * compile time (one hash and one string comparison per key). Values are
+ * parsed in place, in the frame buffer, without allocation. The whole frame
+ * is checked before anything is returned, so its commands can be applied
+ * together or not at all.
+ *
+ * "rtk:" frames never get here: RadioFrameParser streams them to the GNSS.
+ */
+
+enum CommandValue : uint8_t {
+    CMD_VALUE_NUMBER,   // One decimal number
+    CMD_VALUE_PAIR,     // Two decimal numbers, "a,b"
+    CMD_VALUE_TEXT,     // Checked by the handler
+    CMD_VALUE_NONE      // Value ignored, ':' optional
+};
+
+// X(id, key, value type): append only
+#define UPLINK_COMMANDS(X) \
+    X(CMD_KP,            "kp",            CMD_VALUE_NUMBER) \
+    X(CMD_KI,            "ki",            CMD_VALUE_NUMBER) \
+    X(CMD_TENSION,       "tension",       CMD_VALUE_NUMBER) \
+    X(CMD_CAP,           "cap",           CMD_VALUE_NUMBER) \
+    X(CMD_POINT_LAT,     "point_lat",     CMD_VALUE_NUMBER) \
+    X(CMD_POINT_LON,     "point_lon",     CMD_VALUE_NUMBER) \
+    X(CMD_POINT,         "point",         CMD_VALUE_PAIR) \
+    X(CMD_WAYPOINT,      "wp",            CMD_VALUE_PAIR) \
+    X(CMD_MISSION_CLEAR, "mission_clear", CMD_VALUE_NONE) \
+    X(CMD_MISSION_START, "mission_start", CMD_VALUE_NONE) \
+    X(CMD_TELEMETRY,     "tlm",           CMD_VALUE_TEXT) \
+    X(CMD_GPS_RATE,      "gps_rate",      CMD_VALUE_NUMBER) \
+    X(CMD_GPS_TXREADY,   "gps_txready",   CMD_VALUE_NUMBER)
+
+#define UPLINK_COMMAND_ID(id, key, value) id,
+enum CommandId : uint8_t {
+    UPLINK_COMMANDS(UPLINK_COMMAND_ID)
+    CMD_COUNT
+};
+#undef UPLINK_COMMAND_ID
+
+#define COMMAND_SEPARATOR ';'
+// Most commands in one frame
+#define COMMAND_MAX_PER_FRAME 8
+
+extern const char* const command_keys[CMD_COUNT];
+
+/**
+ * @brief One parsed command
+ */
+struct Command {
+    CommandId id;
+    double value[2];        // NUMBER: value[0], PAIR: both
+    const char* text;       // TEXT: the value, NUL-terminated inside the frame buffer
+};
+
+enum CommandError : uint8_t {
+    CMD_ERROR_NONE,
+    CMD_ERROR_FORMAT,       // No ':'
+    CMD_ERROR_UNKNOWN_KEY,
+    CMD_ERROR_BAD_VALUE,    // Not a number, or not "a,b"
+    CMD_ERROR_TOO_MANY,     // More than COMMAND_MAX_PER_FRAME pairs
+    CMD_ERROR_REFUSED       // Set by the handler: well formed but not applicable
+};
+
+/**
+ * @brief Command of a key, CMD_COUNT if unknown
+ */
+CommandId find_command(const char* key, size_t length);
+
+/**
+ * @brief Parse a frame into commands
+ *
+ * The separators of frame are replaced by NULs, so TEXT values end there.
+ *
+ * @param commands At least COMMAND_MAX_PER_FRAME entries
+ * @param error Why the frame was rejected, and failed_pair its index
+ * @return Number of commands, -1 if the frame is rejected (no command is returned then)
+ */
+int parse_commands(char* frame, Command* commands, CommandError* error, int* failed_pair);
+
+#endif // COMMAND_REGISTRY_H
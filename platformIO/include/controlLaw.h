@@ -0,0 +1,65 @@
+#ifndef CONTROL_LAW_H
+#define CONTROL_LAW_H
+
+/**
+ * @brief Rudder control law of servoControl, without the Arduino and Servo
+ * dependencies so that host tests and benchmarks can run it
+ */
+
+// Safran servo angle limits (degrees)
+const int min_angle_safran = 70;
+const int max_angle_safran = 170;
+
+/**
+ * @brief Signed difference from current to target heading, in [-180, 180]
+ */
+inline int shortest_angle_difference(int current, int target) {
+    int angleDifference = target - current;
+    if (angleDifference > 180)
+    {
+        angleDifference -= 360;
+    }
+    else if (angleDifference < -180)
+    {
+        angleDifference += 360;
+    }
+    return angleDifference;
+}
+
+/**
+ * @brief One step of the PI rudder controller
+ * @param servo_angle Current safran servo angle (degrees, kept fractional between steps)
+ * @param error Heading error (degrees, see shortest_angle_difference)
+ * @param cumulate_error Integral term, accumulated in place
+ * @param adjustment Output: PI correction applied this step
+ * @return New safran servo angle, within [min_angle_safran, max_angle_safran]
+ *
+ * The angle is not rounded here: a move smaller than one degree per step
+ * would be lost (and truncation would only lose it towards 0, so the rudder
+ * would drift one way). Round only when writing the servo (safran_pulse_us).
+ */
+inline float pi_rudder_update(float servo_angle, int error, float kp, float ki,
+                              float* cumulate_error, float* adjustment) {
+    *cumulate_error += error;                               // accumulate the error over time
+    *adjustment = kp * error + ki * *cumulate_error;        // PI control
+    float position = servo_angle - *adjustment;
+    if (position < min_angle_safran) {
+        position = min_angle_safran;
+    } else if (position > max_angle_safran) {
+        position = max_angle_safran;
+    }
+    return position;
+}
+
+/**
+ * @brief Safran servo pulse for a servo angle, rounded to the microsecond
+ * @param servo_angle Safran servo angle (degrees, see pi_rudder_update)
+ * @param min_us, max_us Pulses of min_angle_safran and max_angle_safran
+ */
+inline int safran_pulse_us(float servo_angle, int min_us, int max_us) {
+    float pulse = min_us + (servo_angle - min_angle_safran) * (max_us - min_us) /
+                           (float)(max_angle_safran - min_angle_safran);
+    return (int)(pulse + (pulse >= 0.0f ? 0.5f : -0.5f));
+}
+
+#endif // CONTROL_LAW_H
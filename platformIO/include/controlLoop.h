@@ -0,0 +1,136 @@
+#ifndef CONTROL_LOOP_H
+#define CONTROL_LOOP_H
+
+#include <stdint.h>
+#include "pipeline.h"
+
+/**
+ * @brief Core partition and timing of the rudder/sail control loop
+ *
+ * controlTask runs alone on CONTROL_CORE at CONTROL_RATE_HZ, released by
+ * xTaskDelayUntil so the period does not drift with the loop duration.
+ * Sensors, planner, radio, telemetry and traces run on IO_CORE. Headings
+ * reach the loop and reports leave it through SpscQueue, sensor values are
+ * read from the SharedData snapshots: nothing on either side takes a lock.
+ */
+
+#define IO_CORE 0
+#define CONTROL_CORE 1
+
+// Control loop rate, -DCONTROL_RATE_HZ=... to change it
+#ifndef CONTROL_RATE_HZ
+#define CONTROL_RATE_HZ 50
+#endif
+#define CONTROL_PERIOD_US (1000000UL / CONTROL_RATE_HZ)
+
+// Rate the kp and ki values sent over the radio were tuned at
+#define CONTROL_TUNING_RATE_HZ 10
+
+// Period of the jitter and latency reports sent to IO_CORE
+#ifndef CONTROL_REPORT_PERIOD_MS
+#define CONTROL_REPORT_PERIOD_MS 1000
+#endif
+
+/**
+ * @brief Convert PI gains tuned at CONTROL_TUNING_RATE_HZ to the loop rate
+ * @param rate_hz Actual loop rate (the task table may override CONTROL_RATE_HZ)
+ *
+ * pi_rudder_update moves the rudder by kp * error + ki * sum(error) at each
+ * call. Running it n times faster multiplies the proportional move by n and
+ * the integral one by n * n for the same heading error over time.
+ */
+inline void scale_pi_gains(float* kp, float* ki, float rate_hz = CONTROL_RATE_HZ) {
+    float scale = (float)CONTROL_TUNING_RATE_HZ / rate_hz;
+    *kp *= scale;
+    *ki *= scale * scale;
+}
+
+/**
+ * @brief Timing of the control loop over one report window
+ */
+struct JitterData {
+    uint32_t count;                 // Periods measured
+    uint32_t min_period_us;
+    uint32_t max_period_us;
+    uint32_t max_jitter_us;         // Largest |period - nominal period|
+    uint32_t mean_jitter_us;        // Mean |period - nominal period|
+    uint32_t overruns;              // Steps that ended after the next release
+    uint32_t max_exec_us;           // Longest step
+};
+
+/**
+ * @brief Accumulates the control loop release times (single task, no locking)
+ */
+class JitterStats {
+    JitterData stats;
+    uint32_t nominal_us;
+    uint32_t last_release_us;
+    bool started;
+    uint64_t total_jitter_us;
+
+public:
+    explicit JitterStats(uint32_t nominal_period_us)
+        : nominal_us(nominal_period_us), last_release_us(0), started(false) {
+        start_window();
+    }
+
+    /**
+     * @brief Clear the statistics, the next period is still measured
+     */
+    void start_window() {
+        stats = JitterData();
+        total_jitter_us = 0;
+    }
+
+    /**
+     * @brief Add one control step
+     * @param release_us Time the step started (micros())
+     * @param exec_us Duration of the step
+     */
+    void record(uint32_t release_us, uint32_t exec_us) {
+        if (exec_us > stats.max_exec_us) {
+            stats.max_exec_us = exec_us;
+        }
+        if (!started) {
+            // First step: no period yet
+            started = true;
+            last_release_us = release_us;
+            return;
+        }
+        uint32_t period_us = release_us - last_release_us;
+        last_release_us = release_us;
+        uint32_t jitter_us = period_us > nominal_us ? period_us - nominal_us : nominal_us - period_us;
+
+        if (stats.count == 0 || period_us < stats.min_period_us) {
+            stats.min_period_us = period_us;
+        }
+        if (period_us > stats.max_period_us) {
+            stats.max_period_us = period_us;
+        }
+        if (jitter_us > stats.max_jitter_us) {
+            stats.max_jitter_us = jitter_us;
+        }
+        stats.count++;
+        total_jitter_us += jitter_us;
+        stats.mean_jitter_us = (uint32_t)(total_jitter_us / stats.count);
+    }
+
+    /**
+     * @brief Count a step that ended after the next release time
+     */
+    void add_overrun() {
+        stats.overruns++;
+    }
+
+    const JitterData& data() const { return stats; }
+};
+
+/**
+ * @brief Report pushed by controlTask to IO_CORE every CONTROL_REPORT_PERIOD_MS
+ */
+struct ControlReport {
+    JitterData jitter;              // This window only
+    LatencyData latency;            // Since boot
+};
+
+#endif // CONTROL_LOOP_H
@@ -0,0 +1,92 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+
+/**
+ * @brief Signed 32-bit fixed-point number with FracBits fractional bits
+ *
+ * The RP2040 (Cortex-M0+) has no FPU, so every float/double operation goes
+ * through the soft-float library. FixedPoint keeps the planner arithmetic on
+ * the integer ALU: additions are plain int32 adds, multiplications and
+ * divisions use a 64-bit intermediate and saturate instead of wrapping.
+ *
+ * Construction from double is constexpr so literals such as T(360.0) are
+ * folded at compile time; conversion back to floating point is explicit.
+ */
+template <int FracBits>
+class FixedPoint {
+public:
+    static constexpr int FRAC_BITS = FracBits;
+    static constexpr int32_t ONE = int32_t(1) << FracBits;
+    static constexpr int32_t RAW_MAX = INT32_MAX;
+    static constexpr int32_t RAW_MIN = INT32_MIN;
+
+    constexpr FixedPoint() : raw_value(0) {}
+    constexpr FixedPoint(double value) : raw_value(saturate(value * ONE + (value >= 0 ? 0.5 : -0.5))) {}
+    constexpr FixedPoint(float value) : FixedPoint(static_cast<double>(value)) {}
+    constexpr FixedPoint(int value) : raw_value(saturate(static_cast<int64_t>(value) * ONE)) {}
+
+    /**
+     * @brief Build a value directly from its raw integer representation
+     */
+    static constexpr FixedPoint from_raw(int32_t raw) {
+        FixedPoint result;
+        result.raw_value = raw;
+        return result;
+    }
+
+    /**
+     * @brief Clamp a 64-bit raw intermediate into the representable range
+     */
+    static constexpr int32_t saturate(int64_t raw) {
+        return raw > RAW_MAX ? RAW_MAX : (raw < RAW_MIN ? RAW_MIN : static_cast<int32_t>(raw));
+    }
+
+    constexpr int32_t raw() const { return raw_value; }
+
+    explicit constexpr operator double() const { return static_cast<double>(raw_value) / ONE; }
+    explicit constexpr operator float() const { return static_cast<float>(raw_value) / ONE; }
+    explicit constexpr operator int() const { return raw_value / ONE; }
+
+    constexpr FixedPoint operator-() const { return from_raw(saturate(-static_cast<int64_t>(raw_value))); }
+
+    FixedPoint& operator+=(FixedPoint other) { *this = *this + other; return *this; }
+    FixedPoint& operator-=(FixedPoint other) { *this = *this - other; return *this; }
+    FixedPoint& operator*=(FixedPoint other) { *this = *this * other; return *this; }
+    FixedPoint& operator/=(FixedPoint other) { *this = *this / other; return *this; }
+
+    friend constexpr FixedPoint operator+(FixedPoint a, FixedPoint b) {
+        return from_raw(saturate(static_cast<int64_t>(a.raw_value) + b.raw_value));
+    }
+    friend constexpr FixedPoint operator-(FixedPoint a, FixedPoint b) {
+        return from_raw(saturate(static_cast<int64_t>(a.raw_value) - b.raw_value));
+    }
+    friend constexpr FixedPoint operator*(FixedPoint a, FixedPoint b) {
+        // Round to nearest before dropping the extra fractional bits
+        return from_raw(saturate((static_cast<int64_t>(a.raw_value) * b.raw_value + (int64_t(1) << (FracBits - 1))) >> FracBits));
+    }
+    friend constexpr FixedPoint operator/(FixedPoint a, FixedPoint b) {
+        if (b.raw_value == 0) {
+            return from_raw(a.raw_value >= 0 ? RAW_MAX : RAW_MIN);
+        }
+        return from_raw(saturate((static_cast<int64_t>(a.raw_value) * ONE) / b.raw_value));
+    }
+
+    friend constexpr bool operator==(FixedPoint a, FixedPoint b) { return a.raw_value == b.raw_value; }
+    friend constexpr bool operator!=(FixedPoint a, FixedPoint b) { return a.raw_value != b.raw_value; }
+    friend constexpr bool operator<(FixedPoint a, FixedPoint b) { return a.raw_value < b.raw_value; }
+    friend constexpr bool operator<=(FixedPoint a, FixedPoint b) { return a.raw_value <= b.raw_value; }
+    friend constexpr bool operator>(FixedPoint a, FixedPoint b) { return a.raw_value > b.raw_value; }
+    friend constexpr bool operator>=(FixedPoint a, FixedPoint b) { return a.raw_value >= b.raw_value; }
+
+private:
+    int32_t raw_value;
+};
+
+// Q16.16: planner scalar (angles in degrees, distances in metres up to ~32 km)
+typedef FixedPoint<16> q16_16;
+// Q2.30: unit-range values (sin/cos, atan ratios) used inside the trig kernels
+typedef FixedPoint<30> q2_30;
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,84 @@
+#ifndef GNSS_INGEST_H
+#define GNSS_INGEST_H
+
+#include <stdint.h>
+#include "pipeline.h"
+
+/**
+ * @brief Cost and latency of the GNSS ingestion, per reporting window
+ *
+ * The GPS task drains the ZED-F9P either every GPS_POLL_PERIOD_MS (polled)
+ * or when the TX-ready pin of the receiver rises (see gps.hpp). Both modes
+ * are measured the same way so they can be compared on the boat:
+ * - polls: reads of the pending byte count (registers 0xFD-0xFE), and how
+ *   many found nothing;
+ * - bytes: stream bytes read, divided by the fixes published;
+ * - latency: from the TX-ready edge (timestamped by the pin interrupt in
+ *   both modes, when the pin is wired) to the publication of the fix.
+ *
+ * Single task (the GPS task), no locking.
+ */
+
+// Reporting window of the GPS task
+#ifndef GNSS_INGEST_REPORT_MS
+#define GNSS_INGEST_REPORT_MS 5000
+#endif
+
+struct GnssIngestReport {
+    uint32_t polls;
+    uint32_t empty_polls;
+    uint32_t reads;             // Stream bursts
+    uint32_t bytes;
+    uint32_t fixes;
+    uint32_t bytes_per_fix;     // 0 without fix
+    LatencyData latency;        // Edge to publication, count 0 if the pin never rose
+};
+
+class GnssIngestStats {
+    GnssIngestReport current;
+    LatencyStats latency;
+
+public:
+    GnssIngestStats() : current() {}
+
+    /**
+     * @brief One read of the pending byte count
+     */
+    void record_poll(uint16_t available) {
+        current.polls++;
+        if (available == 0) {
+            current.empty_polls++;
+        }
+    }
+
+    /**
+     * @brief One burst read of the stream
+     */
+    void record_read(uint16_t bytes) {
+        current.reads++;
+        current.bytes += bytes;
+    }
+
+    /**
+     * @brief One fix published
+     * @param edge_us TX-ready edge before the data (0: none seen)
+     */
+    void record_fix(uint32_t edge_us, uint32_t publish_us) {
+        current.fixes++;
+        latency.record(edge_us, publish_us);
+    }
+
+    /**
+     * @brief Report of the window, then start a new one
+     */
+    GnssIngestReport take() {
+        GnssIngestReport report = current;
+        report.bytes_per_fix = report.fixes != 0 ? report.bytes / report.fixes : 0;
+        report.latency = latency.data();
+        current = GnssIngestReport();
+        latency.reset();
+        return report;
+    }
+};
+
+#endif // GNSS_INGEST_H
@@ -1,22 +1,126 @@
-#include <Wire.h>
 //#include <SparkFun_u-blox_GNSS_Arduino_Library.h>
 #include <SparkFun_u-blox_GNSS_v3.h>
+#include "gnssIngest.h"
+#include "i2cBus.h"
+#include "pipeline.h"
 
 #define ZED_F9P_I2C_ADDRESS 0x42 // Adresse I2C par défaut
 //#define ZED_F9P_I2C_ADDRESS 0x21 // Adresse I2C trouvée par scan I2C
 
+// Broche TX-ready du ZED-F9P : le module la lève dès qu'il a des données en attente sur l'I2C.
+// ZED_F9P_TXREADY_GPIO : entrée du Pico reliée à la broche (-1 : non câblée, interrogation seule)
+// ZED_F9P_TXREADY_PIO : PIO du module qui porte le signal (CFG-TXREADY-PIN, voir le manuel d'intégration)
+#ifndef ZED_F9P_TXREADY_GPIO
+#define ZED_F9P_TXREADY_GPIO 6
+#endif
+#ifndef ZED_F9P_TXREADY_PIO
+#define ZED_F9P_TXREADY_PIO 6
+#endif
+// Seuil de déclenchement (CFG-TXREADY-THRESHOLD) : au plus bas, le front suit le premier message
+#define ZED_F9P_TXREADY_THRESHOLD 1
+// Attente maximale d'un front ; une solution trouvée à l'échéance compte comme front manqué
+#define GNSS_TXREADY_TIMEOUT_MS 250
+// Fronts manqués consécutifs avant le retour à l'interrogation (broche absente ou mal configurée)
+#define GNSS_TXREADY_MISSED_MAX 3
+
+// Bus I2C du ZED-F9P (i2c1, SDA = GP2, SCL = GP3), tâche propriétaire dans main.cpp
+extern I2cBus i2c1Bus;
+
+// Accès de la bibliothèque SparkFun au ZED-F9P par le moteur I2C (i2cBus.h) au lieu de Wire :
+// chaque lecture ou écriture est une transaction DMA, la tâche GPS dort pendant le transfert
+class GnssI2cBus : public SparkFun_UBLOX_GNSS::GNSSDeviceBus
+{
+    private:
+        I2cChannel canal;
+        uint8_t adresse;
+        GnssIngestStats &mesures;   // Interrogations et octets lus, pour le rapport d'ingestion
+        uint32_t octets = 0;        // Octets du flux lus depuis le démarrage
+
+    public:
+        GnssI2cBus(uint8_t adresse, GnssIngestStats &mesures) : canal(0), adresse(adresse), mesures(mesures) {}
+
+        // Rattache le canal au bus (une fois)
+        void begin(I2cBus &bus);
+        // Écriture brute (messages UBX de configuration)
+        bool envoyer(const uint8_t *data, uint16_t length);
+
+        bool ping() override;
+        uint16_t available() override;                                  // Registres 0xFD-0xFE
+        uint8_t writeBytes(uint8_t *data, uint8_t length) override;
+        uint8_t readBytes(uint8_t *data, uint8_t length) override;       // Flux, registre 0xFF
+
+        // SPI uniquement
+        void writeReadBytes(const uint8_t *data, uint8_t *readData, uint8_t length) { (void)data; (void)readData; (void)length; }
+        void startWriteReadByte() {}
+        void writeReadByte(const uint8_t *data, uint8_t *readData) { (void)data; (void)readData; }
+        void writeReadByte(const uint8_t data, uint8_t *readData) { (void)data; (void)readData; }
+        void endWriteReadByte() {}
+
+        uint32_t octetsLus() const { return octets; }
+};
+
+// Récepteur u-blox sur un GnssI2cBus
+class ZedF9P : public DevUBLOXGNSS
+{
+    public:
+        ZedF9P() { _commType = COMM_TYPE_I2C; }
+
+        bool begin(GnssI2cBus &bus, uint16_t maxWait = kUBLOXGNSSDefaultMaxWait)
+        {
+            setCommunicationBus(bus);
+            return init(maxWait, false);
+        }
+};
+
 class GNSS
 {
+    private:
+        uint32_t dernierTimeOfWeek = 0; // iTOW de la dernière solution publiée
+        uint32_t derniereSolution_ms = 0;
+        bool sansDonnees = false;
+        bool nouvelleSolution = false;  // Publiée pendant le dernier lireFluxGPS()
+        uint8_t dernierFixType = 0;     // Type de fix de la dernière solution publiée
+        uint8_t dernierRtk = 0xFF;      // Dernier état RTK tracé (0xFF : aucun)
+        uint8_t cadence_hz = 0;         // Cadence de navigation configurée
+        bool txReady = false;           // Réveil par la broche TX-ready, sinon interrogation
+        bool reveilParBroche = false;   // Dernière attente terminée par un front
+        uint8_t frontsManques = 0;      // Solutions trouvées à l'échéance, consécutives
+        uint32_t frontVidange_us = 0;   // Front TX-ready de la vidange en cours (0 : aucun)
+        GnssIngestStats mesures;        // Avant bus, qui le référence
+        GnssI2cBus bus;
+
     public:
-        SFE_UBLOX_GNSS myGNSS; // Objet GNSS pour communiquer avec le ZED-F9P
+        ZedF9P myGNSS; // Objet GNSS pour communiquer avec le ZED-F9P
 
         GNSS();
         ~GNSS();
 
-        void scanI2C();
+        // Vérifie que le ZED-F9P répond à son adresse (au lieu de sonder les 127 adresses)
+        bool detecterModule();
         void activeUBX_RTK();
         void configurerUART_RX2();
         void configurerTrameNAV_PVT_I2C();
-        void lireFluxGPS();
+        // Cadence des solutions (UBX-CFG-RATE), bornée à 1..GNSS_NAV_RATE_MAX_HZ
+        bool configurerCadence(uint8_t hz);
+        uint8_t cadence() const { return cadence_hz; }
+        // Configure la sortie TX-ready du module et l'interruption de la broche ;
+        // sans broche câblée (ZED_F9P_TXREADY_GPIO < 0), reste en interrogation
+        bool configurerTxReady();
+        // Choisit le mode d'ingestion : réveil par TX-ready ou interrogation toutes les GPS_POLL_PERIOD_MS
+        void utiliserTxReady(bool actif);
+        bool modeTxReady() const { return txReady; }
+        // Tâche réveillée par l'interruption TX-ready (la tâche GPS, au démarrage)
+        void demarrerIngestion(void *tache);
+        // Dort jusqu'au front TX-ready (au plus GNSS_TXREADY_TIMEOUT_MS), ou periode_ms en interrogation
+        void attendreDonnees(uint32_t periode_ms);
+        // Trace les mesures de la fenêtre écoulée (EVT_GPS_INGEST*), puis en ouvre une nouvelle
+        void rapporterMesures();
+        // Vide le tampon du module ; les callbacks auto-PVT/RELPOSNED publient chaque solution.
+        // Retourne true si au moins une nouvelle solution a été publiée
+        bool lireFluxGPS();
         void gpsInit();
+
+        // Appelés par les callbacks de la bibliothèque (dans lireFluxGPS, tâche GPS)
+        void publierPVT(const UBX_NAV_PVT_data_t &pvt);
+        void suivreRELPOSNED(const UBX_NAV_RELPOSNED_data_t &relposned);
 };
@@ -0,0 +1,157 @@
+#ifndef HEADING_SMOOTHER_H
+#define HEADING_SMOOTHER_H
+
+#include <stdint.h>
+#include "scalarMath.h"
+
+/**
+ * @brief Adaptive blending applied after the circular mean
+ *
+ * The smoothed heading moves towards the window mean by a factor chosen from
+ * the size of the change: small oscillations are damped hard, large changes
+ * (tacks) are followed quickly.
+ */
+template <typename T>
+struct HeadingBlend {
+    T small_change = T(5.0);       // Below this change (degrees)...
+    T small_factor = T(0.1);       // ...heavy smoothing
+    T medium_change = T(15.0);     // Below this change (degrees)...
+    T medium_factor = T(0.2);      // ...medium smoothing
+    T large_change = T(60.0);      // Above this change (degrees)...
+    T large_factor = T(0.5);       // ...fast response
+    T default_factor = T(0.3);     // Everything in between
+};
+
+/**
+ * @brief Circular-mean heading smoother on a fixed ring buffer
+ *
+ * Keeps the sin/cos of the last Window headings and their running sums, so a
+ * new heading costs one sin/cos pair, an add/subtract on the sums and one
+ * atan2 whatever the window size. No allocation after construction.
+ *
+ * Floating-point sums are rebuilt from the stored terms every RESYNC_PERIOD
+ * updates so rounding drift cannot build up over a long mission; fixed-point
+ * sums are exact and never need it.
+ *
+ * @tparam T Scalar type (double, float or FixedPoint)
+ * @tparam Window Number of headings in the circular mean
+ */
+template <typename T, int Window>
+class HeadingSmoother {
+private:
+    typedef ScalarMath<T> M;
+
+    static_assert(Window > 0, "HeadingSmoother window must hold at least one heading");
+
+    static constexpr uint16_t RESYNC_PERIOD = 1024;   // Updates between running-sum rebuilds
+
+    T sin_terms[Window];             // sin of each heading in the window
+    T cos_terms[Window];             // cos of each heading in the window
+    T sin_sum, cos_sum;              // Running sums over the window
+    int count;                       // Number of valid entries
+    int next;                        // Slot written by the next update
+    uint16_t updates_since_resync;   // Floating-point drift control
+
+    HeadingBlend<T> blend;
+    T smoothed_heading;              // Last blended output
+    bool smoothed_heading_set;       // Flag indicating smoothed_heading is valid
+
+    void resync_sums() {
+        sin_sum = T(0);
+        cos_sum = T(0);
+        for (int i = 0; i < count; i++) {
+            sin_sum += sin_terms[i];
+            cos_sum += cos_terms[i];
+        }
+        updates_since_resync = 0;
+    }
+
+public:
+    static constexpr int WINDOW = Window;
+
+    /**
+     * @brief Constructor
+     * @param blend_params Adaptive blending thresholds and factors
+     */
+    explicit HeadingSmoother(const HeadingBlend<T>& blend_params = HeadingBlend<T>())
+        : blend(blend_params) {
+        reset();
+    }
+
+    /**
+     * @brief Empty the window and forget the last output
+     */
+    void reset() {
+        sin_sum = T(0);
+        cos_sum = T(0);
+        count = 0;
+        next = 0;
+        updates_since_resync = 0;
+        smoothed_heading = T(0);
+        smoothed_heading_set = false;
+    }
+
+    void set_blend(const HeadingBlend<T>& blend_params) { blend = blend_params; }
+
+    /**
+     * @brief Push a heading into the window
+     * @return Circular mean of the window (degrees, [0, 360))
+     */
+    T push(T heading) {
+        T s = M::sin_deg(heading);
+        T c = M::cos_deg(heading);
+        if (count == Window) {
+            // Window full: the oldest term leaves the sums
+            sin_sum -= sin_terms[next];
+            cos_sum -= cos_terms[next];
+        } else {
+            count++;
+        }
+        sin_terms[next] = s;
+        cos_terms[next] = c;
+        sin_sum += s;
+        cos_sum += c;
+        next = (next + 1 == Window) ? 0 : next + 1;
+
+        if (!M::IS_FIXED && ++updates_since_resync >= RESYNC_PERIOD) {
+            resync_sums();
+        }
+        return M::fmod(M::atan2_deg(sin_sum, cos_sum) + T(360.0), T(360.0));
+    }
+
+    /**
+     * @brief Push a heading and blend the output towards the new window mean
+     * @param heading New raw heading (degrees)
+     * @return Smoothed heading (degrees, [0, 360))
+     */
+    T update(T heading) {
+        T mean = push(heading);
+        if (!smoothed_heading_set) {
+            smoothed_heading = mean;
+            smoothed_heading_set = true;
+            return smoothed_heading;
+        }
+
+        // Shortest angular difference
+        T angle_diff = M::fmod(mean - smoothed_heading + T(540.0), T(360.0)) - T(180.0);
+        T magnitude = M::fabs(angle_diff);
+
+        T factor = blend.default_factor;
+        if (magnitude < blend.small_change) {
+            factor = blend.small_factor;
+        } else if (magnitude < blend.medium_change) {
+            factor = blend.medium_factor;
+        } else if (magnitude > blend.large_change) {
+            factor = blend.large_factor;
+        }
+
+        smoothed_heading = M::fmod(smoothed_heading + angle_diff * factor + T(360.0), T(360.0));
+        return smoothed_heading;
+    }
+
+    int size() const { return count; }
+    bool has_output() const { return smoothed_heading_set; }
+    T output() const { return smoothed_heading; }
+};
+
+#endif // HEADING_SMOOTHER_H
@@ -0,0 +1,240 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "spscQueue.h"
+
+#ifdef ARDUINO
+#include "FreeRTOS.h"
+#include "semphr.h"
+#endif
+
+/**
+ * @brief Asynchronous I2C transactions, one owner task per bus
+ *
+ * Each RP2040 I2C controller is only touched by its owner task (main.cpp,
+ * service()), so the bus needs no mutex. Drivers attach an I2cChannel and
+ * submit transactions to it: a write, a read, or a write then a read after a
+ * repeated start (register read). The owner takes the next transaction from
+ * the non-empty channel of highest priority, hands the command words to the
+ * controller by DMA and sleeps until the I2C interrupt reports the stop
+ * condition or an abort (NACK). The received bytes are written to the
+ * caller's buffer by a second DMA channel, so no core waits on the bus.
+ *
+ * Completion is reported by a callback, run by the owner task, and/or by a
+ * task notification. I2cChannel::transfer() submits and sleeps until the
+ * completion, for drivers written as plain calls.
+ *
+ * The buffers of a request belong to the caller until its completion.
+ * Before the owner task runs (setup()), transfer() executes the transaction
+ * in the calling task: one task at a time may then use the bus.
+ */
+
+// Longest transaction, written plus read bytes (one DMA command word each)
+#ifndef I2C_TRANSFER_MAX
+#define I2C_TRANSFER_MAX 256
+#endif
+
+// Requests waiting in one channel, power of two
+#ifndef I2C_CHANNEL_DEPTH
+#define I2C_CHANNEL_DEPTH 4
+#endif
+
+// Channels attached to one bus
+#ifndef I2C_BUS_CHANNELS
+#define I2C_BUS_CHANNELS 4
+#endif
+
+// SCL frequency (CMPS12, QMC5883L and ZED-F9P all support fast mode)
+#ifndef I2C_BAUDRATE
+#define I2C_BAUDRATE 400000
+#endif
+
+// A transaction without stop after this long is aborted (256 bytes take ~6 ms at 400 kHz)
+#ifndef I2C_TIMEOUT_MS
+#define I2C_TIMEOUT_MS 20
+#endif
+
+// IC_DATA_CMD bits of the RP2040 controller, above the data byte
+#define I2C_CMD_READ    0x100
+#define I2C_CMD_STOP    0x200
+#define I2C_CMD_RESTART 0x400
+
+enum I2cStatus : uint8_t {
+    I2C_OK,
+    I2C_NACK,           // Address or data byte not acknowledged
+    I2C_TIMEOUT,        // No stop within I2C_TIMEOUT_MS, transfer aborted
+    I2C_QUEUE_FULL,     // Channel full, not submitted
+    I2C_NOT_READY       // Channel not attached, bus not started or request too long
+};
+
+/**
+ * @brief Called by the owner task when a request is done
+ */
+typedef void (*I2cCallback)(I2cStatus status, void* context);
+
+/**
+ * @brief One transaction: write_length bytes, then read_length bytes after a repeated start
+ */
+struct I2cRequest {
+    uint8_t address;            // 7-bit address
+    uint16_t write_length;
+    uint16_t read_length;
+    const uint8_t* write;
+    uint8_t* read;
+    I2cCallback callback;       // May be NULL
+    void* context;              // Passed to callback
+    void* notify;               // TaskHandle_t given a notification after the callback, may be NULL
+};
+
+/**
+ * @brief Command words of a request for IC_DATA_CMD
+ * @param commands At least I2C_TRANSFER_MAX words
+ * @return Number of words, 0 if the request is empty or longer than I2C_TRANSFER_MAX
+ */
+size_t i2c_build_commands(const I2cRequest& request, uint16_t* commands);
+
+class I2cBus;
+
+/**
+ * @brief Requests of one driver to one bus (one submitting task)
+ */
+class I2cChannel {
+    friend class I2cBus;
+
+    SpscQueue<I2cRequest, I2C_CHANNEL_DEPTH> queue;
+    I2cBus* bus;
+    uint8_t priority;
+    std::atomic<uint8_t> last_status;   // Of the transfer() in progress
+#ifdef ARDUINO
+    StaticSemaphore_t done_buffer;
+    SemaphoreHandle_t done;             // Given by the owner when transfer() completes
+#endif
+
+    static void on_transfer_done(I2cStatus status, void* context);
+
+public:
+    /**
+     * @param priority 0 is served first, equal priorities in attach order
+     */
+    explicit I2cChannel(uint8_t priority = 0);
+
+    bool attached() const { return bus != NULL; }
+
+    /**
+     * @brief Queue a request, the owner task is woken
+     * @return I2C_OK if queued, I2C_QUEUE_FULL or I2C_NOT_READY otherwise (no completion then)
+     */
+    I2cStatus submit(const I2cRequest& request);
+
+    /**
+     * @brief Submit and sleep until the completion
+     * @param read NULL when read_length is 0
+     */
+    I2cStatus transfer(uint8_t address, const uint8_t* write, uint16_t write_length,
+                       uint8_t* read, uint16_t read_length);
+
+    I2cStatus write(uint8_t address, const uint8_t* data, uint16_t length) {
+        return transfer(address, data, length, NULL, 0);
+    }
+
+    /**
+     * @brief Register read: writes reg, reads length bytes from it (auto-increment)
+     */
+    I2cStatus read_registers(uint8_t address, uint8_t reg, uint8_t* data, uint16_t length) {
+        return transfer(address, &reg, 1, data, length);
+    }
+
+    /**
+     * @brief true if a device acknowledges its address (one byte read, the RP2040 has no empty transfer)
+     */
+    bool probe(uint8_t address);
+};
+
+/**
+ * @brief Counters of one bus, written by the owner task only
+ */
+struct I2cBusStats {
+    uint32_t transactions;
+    uint32_t nacks;
+    uint32_t timeouts;
+    uint32_t bytes;
+    uint32_t busy_us;           // Time from start to stop, all transactions
+};
+
+class I2cBus {
+    uint8_t index;              // i2c0 or i2c1
+    uint8_t sda_pin;
+    uint8_t scl_pin;
+    I2cChannel* channels[I2C_BUS_CHANNELS];
+    std::atomic<uint8_t> channel_count;
+    std::atomic<void*> owner;   // TaskHandle_t, set by bind_owner()
+    std::atomic<bool> finished; // Stop or abort seen by the interrupt
+    volatile uint32_t abort_source;
+    void* waiting;              // TaskHandle_t woken by the interrupt
+    int tx_channel;             // DMA channels, -1 before begin()
+    int rx_channel;
+    I2cBusStats counters;
+    uint16_t commands[I2C_TRANSFER_MAX];
+
+public:
+    I2cBus(uint8_t index, uint8_t sda_pin, uint8_t scl_pin);
+
+    /**
+     * @brief Set up the controller, its pins, two DMA channels and the interrupt
+     * @return false if no DMA channel is free (every transfer then fails with I2C_NOT_READY)
+     */
+    bool begin(uint32_t baudrate = I2C_BAUDRATE);
+
+    /**
+     * @brief Add a channel (during initialization, one attaching task at a time)
+     * @return false if I2C_BUS_CHANNELS are already attached
+     */
+    bool attach(I2cChannel& channel);
+
+    /**
+     * @brief Called once by the owner task before its first service()
+     */
+    void bind_owner(void* task);
+
+    bool has_owner() const { return owner.load(std::memory_order_acquire) != NULL; }
+
+    /**
+     * @brief Wake the owner task (after a submission)
+     */
+    void wake();
+
+    /**
+     * @brief Take the oldest request of the non-empty channel of highest priority (owner only)
+     * @return false if every channel is empty
+     */
+    bool next(I2cRequest* request);
+
+    /**
+     * @brief Run one request on the bus, the calling task sleeps meanwhile
+     */
+    I2cStatus execute(const I2cRequest& request);
+
+    /**
+     * @brief Report a completion: callback, then notification
+     */
+    void complete(const I2cRequest& request, I2cStatus status);
+
+    /**
+     * @brief Execute and complete every pending request (owner only)
+     * @return Number of requests served
+     */
+    int service();
+
+    /**
+     * @brief Interrupt handler body (I2C interrupt of this controller)
+     */
+    void on_interrupt();
+
+    const I2cBusStats& stats() const { return counters; }
+    uint8_t bus_index() const { return index; }
+};
+
+#endif // I2C_BUS_H
@@ -0,0 +1,174 @@
+#ifndef ISOCHRONE_ROUTER_H
+#define ISOCHRONE_ROUTER_H
+
+#include <stdint.h>
+#include "polarTable.h"
+#include "windField.h"
+
+/**
+ * @brief Tuning of the isochrone search
+ */
+struct IsochroneSettings {
+    float time_step_s = 60.0f;          // Time between two isochrones (seconds)
+    int heading_step_deg = 5;           // Heading resolution of the expansion (degrees, divides 360)
+    float sector_span_deg = 180.0f;     // Width of the fan kept around the start-to-destination bearing (degrees)
+    float arrival_radius_m = 15.0f;     // Destination reached within this distance (meters)
+    float tack_penalty_s = 10.0f;       // Time lost when a step tacks or gybes (seconds)
+    float waypoint_tolerance_m = 25.0f; // Largest cross-track error when simplifying the route into waypoints (meters)
+};
+
+/**
+ * @brief Outcome of a routing run
+ */
+struct RouteResult {
+    bool reached;                       // Destination reached within the step budget
+    float duration_s;                   // Time to the destination (or to the closest point reached)
+    int steps;                          // Isochrones expanded
+    int nodes;                          // Route nodes from start to finish
+};
+
+/**
+ * @brief Time-optimal router over a gridded wind field (isochrone method)
+ *
+ * From the start point every node of the current isochrone is expanded over
+ * the heading grid for one time step, using the wind interpolated at the node
+ * and the boat polar; a step that puts the wind on the other side of the
+ * boat loses tack_penalty_s, which also keeps equal-time beats from turning
+ * into a zigzag. Candidates are binned by bearing from the start and only
+ * the one furthest from the start is kept per sector, which bounds each
+ * isochrone to MaxSectors nodes. The search stops when a candidate leg passes
+ * within the arrival radius of the destination.
+ *
+ * All memory is inside the object (MaxSectors x (MaxSteps + 1) nodes), so the
+ * Pico variant is a plain static object. On the host the expansion of each
+ * isochrone is split across threads.
+ *
+ * Positions are kept in meters in an equirectangular frame centred on the
+ * start, adequate for the tens of kilometres a route covers.
+ *
+ * @tparam MaxSectors Nodes kept per isochrone
+ * @tparam MaxSteps Largest number of time steps searched
+ */
+template <int MaxSectors, int MaxSteps>
+class IsochroneRouter {
+public:
+    static constexpr int MAX_HEADINGS = 360;
+
+    /**
+     * @brief Route node: position and link to the node it was reached from
+     */
+    struct Node {
+        float east, north;              // Position relative to the start (meters)
+        int16_t parent;                 // Index in the previous isochrone, -1 for the start
+        int16_t heading_index;          // Heading sailed from the parent (multiple of heading_step_deg)
+    };
+
+    /**
+     * @brief Constructor
+     * @param polar Boat polar, must outlive the router
+     * @param wind Wind field, must outlive the router
+     */
+    IsochroneRouter(const BasicPolarTable<float>& polar, const WindField& wind);
+
+    void set_settings(const IsochroneSettings& new_settings) { settings = new_settings; }
+    const IsochroneSettings& get_settings() const { return settings; }
+
+    /**
+     * @brief Compute the minimum-time route
+     * @param start_lat Start latitude (degrees)
+     * @param start_lon Start longitude (degrees)
+     * @param dest_lat Destination latitude (degrees)
+     * @param dest_lon Destination longitude (degrees)
+     * @param start_time_s Departure time on the wind field clock (seconds)
+     * @param threads Worker threads for the expansion (host only, ignored on the Pico)
+     * @return Route summary; when the destination is not reached the route ends
+     *         at the node closest to it
+     */
+    RouteResult route(double start_lat, double start_lon, double dest_lat, double dest_lon,
+                      double start_time_s, int threads = 1);
+
+    /**
+     * @brief Route as a waypoint list, ready for BasicMission::load
+     *
+     * The node chain is simplified (Douglas-Peucker) so that the straight
+     * legs between waypoints stay within waypoint_tolerance_m of the route;
+     * the tolerance is doubled until the list fits. Short tacks collapse into
+     * a single upwind leg, which the layline planner sails on its own.
+     *
+     * @param lats Output latitudes (degrees)
+     * @param lons Output longitudes (degrees)
+     * @param max_waypoints Capacity of the output arrays
+     * @return Number of waypoints written, the destination last
+     */
+    int waypoints(double* lats, double* lons, int max_waypoints) const;
+
+    /**
+     * @brief Route node by position along the route (0 = start)
+     */
+    const Node& route_node(int index) const { return path[index]; }
+    int route_length() const { return path_length; }
+
+private:
+    // Best candidate of one sector during an expansion
+    struct Candidate {
+        float distance2;                // Squared distance from the start, -1 when empty
+        Node node;
+    };
+
+    // Earliest candidate leg reaching the destination during an expansion
+    struct Arrival {
+        float fraction;                 // Position along the time step, 2 when none
+        Node node;
+    };
+
+    struct StepBest {
+        Candidate sectors[MaxSectors];
+        Arrival arrival;
+    };
+
+    const BasicPolarTable<float>& polar;
+    const WindField& wind;
+    IsochroneSettings settings;
+
+    // Search state
+    Node isochrones[MaxSteps + 1][MaxSectors];
+    int isochrone_size[MaxSteps + 1];
+    Node path[MaxSteps + 2];
+    int path_length;
+    bool reached_destination;
+    double route_dest_lat, route_dest_lon;
+
+    // Per-route constants shared by the expansion workers
+    double origin_lat, origin_lon;
+    float meters_per_deg_lat, meters_per_deg_lon;
+    float dest_east, dest_north;
+    float centre_bearing;
+    int heading_count;
+    float heading_sin[MAX_HEADINGS];
+    float heading_cos[MAX_HEADINGS];
+
+    /**
+     * @brief Expand nodes [begin, end) of isochrone step into best
+     */
+    void expand(int step, double time_s, int begin, int end, StepBest& best) const;
+
+    static void clear(StepBest& best);
+    static void merge(StepBest& into, const StepBest& from);
+    static bool better(const Candidate& a, const Candidate& b);
+    static bool earlier(const Arrival& a, const Arrival& b);
+
+    void to_lat_lon(float east, float north, double* lat, double* lon) const;
+
+    /**
+     * @brief Mark the route nodes kept for a cross-track tolerance
+     * @return Number of nodes kept, start and finish included
+     */
+    int simplify(float tolerance, bool* keep) const;
+};
+
+// Host: fine fan over a full day at one-minute steps (~3 MB, allocate statically or on the heap)
+typedef IsochroneRouter<180, 1440> HostIsochroneRouter;
+// Pico: coarse fan over two hours at three-minute steps (~16 KB)
+typedef IsochroneRouter<32, 40> EmbeddedIsochroneRouter;
+
+#endif // ISOCHRONE_ROUTER_H
@@ -0,0 +1,77 @@
+#ifndef LOCAL_FRAME_H
+#define LOCAL_FRAME_H
+
+#include "scalarMath.h"
+
+/**
+ * @brief Local east/north tangent plane anchored at a leg start
+ *
+ * Over the legs the boat sails (a few hundred metres to a few kilometres) the
+ * Earth is flat to well under the GNSS accuracy, so positions are projected
+ * once with an equirectangular scale computed at the origin. Bearings and
+ * distances then become a subtraction, one atan2 and one hypot instead of the
+ * full haversine/azimuth formulas.
+ *
+ * Points further than MAX_RANGE from the origin are rejected so the caller
+ * can fall back to great-circle formulas (and so Q16.16 never saturates).
+ *
+ * @tparam T Scalar type (double, float or FixedPoint)
+ */
+template <typename T>
+class LocalFrame {
+private:
+    typedef ScalarMath<T> M;
+
+    static constexpr T KM_PER_DEGREE = T(111.19493);   // Earth radius * PI / 180, in km
+
+    T origin_lat, origin_lon;        // Frame origin (degrees)
+    T km_per_deg_lat;                // North scale (km per degree of latitude)
+    T km_per_deg_lon;                // East scale (km per degree of longitude at the origin)
+    T max_dlat, max_dlon;            // Largest offsets still inside MAX_RANGE (degrees)
+    bool valid;                      // Flag indicating an origin has been set
+
+public:
+    static constexpr T MAX_RANGE = T(10000.0);           // Largest offset handled in the frame (meters)
+
+    /**
+     * @brief Constructor - Frame without origin, every projection is rejected
+     */
+    LocalFrame();
+
+    /**
+     * @brief Anchor the frame and precompute its scales
+     * @param lat Origin latitude (degrees)
+     * @param lon Origin longitude (degrees)
+     */
+    void set_origin(T lat, T lon);
+
+    /**
+     * @brief Forget the origin
+     */
+    void invalidate();
+
+    bool is_valid() const { return valid; }
+
+    /**
+     * @brief Project a position onto the frame
+     * @param lat Latitude (degrees)
+     * @param lon Longitude (degrees)
+     * @param east Output east offset from the origin (meters)
+     * @param north Output north offset from the origin (meters)
+     * @return false if the frame is unset or the point is beyond MAX_RANGE (outputs untouched)
+     */
+    bool project(T lat, T lon, T* east, T* north) const;
+
+    /**
+     * @brief Bearing of a local vector
+     * @return Degrees clockwise from north, in [0, 360)
+     */
+    static T bearing(T east, T north);
+
+    /**
+     * @brief Length of a local vector (meters)
+     */
+    static T length(T east, T north);
+};
+
+#endif // LOCAL_FRAME_H
@@ -0,0 +1,116 @@
+#ifndef MISSION_H
+#define MISSION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "scalarMath.h"
+#include "localFrame.h"
+
+static constexpr int MISSION_MAX_WAYPOINTS = 16;
+
+/**
+ * @brief Waypoint list received over the radio
+ *
+ * The XBee task builds it in its own copy ("wp:lat,lon" appends,
+ * "mission_clear:1" empties) and publishes the finished list to
+ * sharedData.mission on "mission_start:1"; the path planning task reloads
+ * its mission from a coherent copy whenever a new version is published.
+ */
+struct MissionUpload {
+    double lat[MISSION_MAX_WAYPOINTS];
+    double lon[MISSION_MAX_WAYPOINTS];
+    int count;
+};
+
+/**
+ * @brief Geometry of one mission leg, computed once when the mission is loaded
+ */
+template <typename T>
+struct MissionLeg {
+    T start_lat, start_lon;          // Leg start (previous waypoint, or boat position for the first leg)
+    T end_lat, end_lon;              // Waypoint closing the leg
+    T bearing;                       // Bearing from start to end (degrees)
+    T length;                        // Leg length (meters)
+    LocalFrame<T> frame;             // Tangent plane anchored at the leg start
+    T end_east, end_north;           // Waypoint position in the frame (meters)
+    bool end_in_frame;               // false when the leg is longer than LocalFrame::MAX_RANGE
+    int expected_tacks;              // 0 if the leg can be sailed direct, 1 for a beat to the layline
+};
+
+/**
+ * @brief Ordered waypoint list with precomputed legs
+ *
+ * Storage is a fixed array of MAX_WAYPOINTS legs, nothing is allocated.
+ * The planner consumes the active leg and advances the mission on arrival
+ * (see BasicLaylinePathPlanner::calculate_mission_direction).
+ *
+ * @tparam T Scalar type (double, float or FixedPoint)
+ */
+template <typename T>
+class BasicMission {
+public:
+    static constexpr int MAX_WAYPOINTS = MISSION_MAX_WAYPOINTS;
+
+private:
+    MissionLeg<T> legs[MAX_WAYPOINTS];
+    int leg_count;                   // Number of legs (= number of waypoints)
+    int active;                      // Index of the leg being sailed, leg_count when finished
+
+public:
+    /**
+     * @brief Constructor - Empty mission
+     */
+    BasicMission();
+
+    /**
+     * @brief Remove every waypoint
+     */
+    void clear();
+
+    /**
+     * @brief Replace the mission and precompute every leg
+     * @param lats Waypoint latitudes (degrees)
+     * @param lons Waypoint longitudes (degrees)
+     * @param count Number of waypoints, 1 to MAX_WAYPOINTS
+     * @param start_lat Boat latitude, start of the first leg
+     * @param start_lon Boat longitude, start of the first leg
+     * @return false if count is out of range (the mission is left empty)
+     */
+    bool load(const double* lats, const double* lons, int count, T start_lat, T start_lon);
+
+    /**
+     * @brief Recompute the expected tack count of every leg for a wind
+     * @param wind_direction True wind direction (degrees)
+     * @param wind_speed Wind speed (m/s)
+     */
+    void estimate_tacks(T wind_direction, T wind_speed);
+
+    /**
+     * @brief Move on to the next leg
+     * @return false if the mission is now finished
+     */
+    bool advance();
+
+    int size() const { return leg_count; }
+    int active_index() const { return active; }
+    bool is_finished() const { return active >= leg_count; }
+
+    /**
+     * @brief Leg being sailed, NULL when the mission is finished
+     */
+    const MissionLeg<T>* active_leg() const { return is_finished() ? NULL : &legs[active]; }
+
+    /**
+     * @brief Leg after the active one, NULL on the last leg
+     */
+    const MissionLeg<T>* next_leg() const { return active + 1 < leg_count ? &legs[active + 1] : NULL; }
+
+    const MissionLeg<T>* leg(int index) const { return (index >= 0 && index < leg_count) ? &legs[index] : NULL; }
+
+    /**
+     * @brief Expected tacks from the active leg to the end of the mission
+     */
+    int remaining_tacks() const;
+};
+
+#endif // MISSION_H
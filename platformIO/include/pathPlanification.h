@@ -1,12 +1,42 @@
 #ifndef PATH_PLANIFICATION_H
 #define PATH_PLANIFICATION_H
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
 #include <math.h>
-#include <vector>
+#include <stdint.h>
+#include "scalarMath.h"
+#include "polarTable.h"
+#include "localFrame.h"
+#include "headingSmoother.h"
+#include "mission.h"
+#include "trace.h"
 
-#ifndef PI
-#define PI 3.14159265358979323846
+/**
+ * Scalar build mode for the planner hot loop.
+ *
+ * The RP2040 has no FPU: double costs the most, float roughly halves the
+ * soft-float work, and Q16.16 fixed point stays entirely on the integer ALU.
+ * Select with -DPLANNER_USE_DOUBLE or -DPLANNER_USE_FIXED_POINT in build_flags
+ * (float is the default).
+ *
+ * Documented tolerances against the double implementation (legs of 20 m to 50 km):
+ * - float:  bearing within 0.5 deg beyond 100 m (1.5 deg down to 20 m), distance
+ *           within 1 m. Both are dominated by the float quantisation of lat/lon.
+ * - Q16.16: positions are quantised to 1/65536 deg (~1.7 m), so bearing is within
+ *           1 deg beyond 100 m (4 deg down to 20 m) and distance within
+ *           3 m + 0.5 %. Distances saturate at ~32 km, which is above every
+ *           threshold the decision logic compares against.
+ * Time is passed as uint32_t milliseconds in every mode so long missions never
+ * saturate a fixed-point clock.
+ */
+#if defined(PLANNER_USE_DOUBLE)
+typedef double PlannerScalar;
+#elif defined(PLANNER_USE_FIXED_POINT)
+typedef q16_16 PlannerScalar;
+#else
+typedef float PlannerScalar;
 #endif
 
 /**
@@ -14,20 +44,24 @@
  * 
  * This class implements a sophisticated upwind sailing strategy using layline tactics,
  * VMG optimization, and intelligent tacking decisions with confirmation logic.
+ *
+ * @tparam T Scalar type used for every computation (double, float or FixedPoint)
  */
-class LaylinePathPlanner {
+template <typename T>
+class BasicLaylinePathPlanner {
 private:
+    typedef ScalarMath<T> M;
+
     // Constants for path planning behavior
-    static constexpr double WAYPOINT_ARRIVAL_DISTANCE = 15.0;        // Distance threshold for waypoint arrival (meters)
-    static constexpr double WAYPOINT_TIGHT_ARRIVAL_DISTANCE = 7.0;   // Close approach distance (meters)
-    static constexpr double DECISION_COOLDOWN = 4.0;                 // Cooldown period after tack decisions (seconds)
-    static constexpr int TACK_CONFIRMATION_THRESHOLD = 5;            // Required confirmations before tacking
-    static constexpr int HEADING_HISTORY_SIZE = 5;                  // Size of heading history for smoothing
-    static constexpr double TACK_HYSTERESIS_ANGLE_MARGIN = 8.0;     // Additional margin before layline crossing (degrees)
-    static constexpr double HEADING_SMOOTHING_FACTOR = 0.3;         // Base smoothing factor for heading changes
-    static constexpr double NO_GO_ZONE_BUFFER = 7.0;               // Buffer added to no-go zone (degrees)
-    static constexpr double MINIMUM_INITIAL_DISTANCE = 15.0;        // Minimum distance before first tack (meters)
-    static constexpr double MINIMUM_INITIAL_TIME = 7.0;            // Minimum time before first tack (seconds)
+    static constexpr T WAYPOINT_ARRIVAL_DISTANCE = T(15.0);          // Distance threshold for waypoint arrival (meters)
+    static constexpr T WAYPOINT_TIGHT_ARRIVAL_DISTANCE = T(7.0);     // Close approach distance (meters)
+    static constexpr uint32_t DECISION_COOLDOWN_MS = 4000;           // Cooldown period after tack decisions (milliseconds)
+    static constexpr int TACK_CONFIRMATION_THRESHOLD = 5;            // Required confirmations before tacking (runs, PLANNER_MIN_PERIOD_MS apart)
+    static constexpr int HEADING_HISTORY_SIZE = 5;                  // Window of the circular-mean heading smoother (runs)
+    static constexpr T TACK_HYSTERESIS_ANGLE_MARGIN = T(8.0);       // Additional margin before layline crossing (degrees)
+    static constexpr T NO_GO_ZONE_BUFFER = T(7.0);                 // Buffer added to no-go zone (degrees)
+    static constexpr T MINIMUM_INITIAL_DISTANCE = T(15.0);          // Minimum distance before first tack (meters)
+    static constexpr uint32_t MINIMUM_INITIAL_TIME_MS = 7000;        // Minimum time before first tack (milliseconds)
 
     // State variables for tacking logic
     bool current_tack_is_port;           // Current tack: true=port, false=starboard, null=direct sailing
@@ -37,50 +71,88 @@ private:
     int tack_confirmation_count;         // Count of consistent tack confirmations
     
     // Timing and position tracking
-    double last_decision_time;           // Time of last major decision
-    double last_optimal_heading;         // Last smoothed optimal heading
-    bool last_optimal_heading_set;       // Flag to indicate if last_optimal_heading is valid
-    double last_raw_optimal_heading;     // Last raw heading before smoothing
+    uint32_t last_decision_time;         // Time of last major decision (milliseconds)
+    T last_raw_optimal_heading;          // Last raw heading before smoothing
     bool last_raw_optimal_heading_set;   // Flag to indicate if last_raw_optimal_heading is valid
     
     // Leg tracking for beginning protection
-    double initial_lat, initial_lon;     // Starting position of current upwind leg
-    double initial_time;                 // Starting time of current upwind leg
+    T initial_lat, initial_lon;          // Starting position of current upwind leg
+    uint32_t initial_time;               // Starting time of current upwind leg (milliseconds)
     bool initial_tack_chosen_for_leg;    // Flag indicating first tack has been chosen for this leg
     bool leg_initialized;                // Flag indicating leg tracking is initialized
     
+    // Leg geometry: waypoint bearings, distances and layline tests run in a
+    // local frame anchored at the leg start, great-circle beyond its range
+    LocalFrame<T> leg_frame;             // Tangent plane of the current leg
+    T frame_wpt_lat, frame_wpt_lon;      // Waypoint the frame was built for
+    T frame_wpt_east, frame_wpt_north;   // Waypoint position in the frame (meters)
+    bool frame_wpt_in_range;             // Flag indicating the waypoint lies inside the frame range
+    
+    // Mission lookahead: board chosen for the next leg when its mark is rounded
+    bool preferred_tack_is_port;         // First board of the new leg
+    bool preferred_tack_is_set;          // Flag to indicate if preferred_tack_is_port is valid
+    
     // Heading smoothing
-    std::vector<double> heading_history; // History of headings for moving average
+    HeadingSmoother<T, HEADING_HISTORY_SIZE> heading_smoother;  // Circular mean and adaptive blending
+    
+    // Boat performance
+    const BasicPolarTable<T>* polar_table;  // Polar used for VMG-optimal angles
     
     /**
      * @brief Calculate VMG-optimal tack angle based on polar performance
      * @param wind_speed Current wind speed (m/s)
      * @return Optimal tack angle relative to true wind (degrees)
      */
-    double find_vmg_optimal_tack_angle(double wind_speed);
+    T find_vmg_optimal_tack_angle(T wind_speed);
     
     /**
-     * @brief Check if a point is in the no-go zone with optional buffer
-     * @param boat_lat Current boat latitude
-     * @param boat_lon Current boat longitude
-     * @param point_lat Target point latitude
-     * @param point_lon Target point longitude
+     * @brief Check if a bearing is in the no-go zone with optional buffer
+     * @param azimuth Bearing from the boat to the target point (degrees)
      * @param wind_direction Wind direction (degrees)
      * @param wind_speed Wind speed (m/s)
      * @param buffer Additional buffer to apply to no-go zone (degrees)
-     * @return true if point is in buffered no-go zone
+     * @return true if the bearing is in buffered no-go zone
+     */
+    bool is_point_in_no_go_zone_buffered(T azimuth, T wind_direction, T wind_speed,
+                                         T buffer = T(0)) const;
+    
+    /**
+     * @brief Rebuild the leg frame when there is none or the waypoint changed
+     * @param boat_lat Current boat latitude, used as the frame origin
+     * @param boat_lon Current boat longitude, used as the frame origin
+     * @param wpt_lat Waypoint latitude
+     * @param wpt_lon Waypoint longitude
+     */
+    void update_leg_frame(T boat_lat, T boat_lon, T wpt_lat, T wpt_lon);
+    
+    /**
+     * @brief Bearing and distance between two positions, in the leg frame when both fit
+     * @param from_lat Start latitude
+     * @param from_lon Start longitude
+     * @param to_lat End latitude
+     * @param to_lon End longitude
+     * @param bearing Output bearing (degrees)
+     * @param distance Output distance (meters)
+     */
+    void leg_vector(T from_lat, T from_lon, T to_lat, T to_lon, T* bearing, T* distance) const;
+    
+    /**
+     * @brief Bearing and distance from the boat to the frame waypoint
      */
-    bool is_point_in_no_go_zone_buffered(double boat_lat, double boat_lon, 
-                                         double point_lat, double point_lon,
-                                         double wind_direction, double wind_speed, 
-                                         double buffer = 0.0);
+    void vector_to_waypoint(T boat_lat, T boat_lon, T* bearing, T* distance) const;
     
     /**
-     * @brief Apply smoothing to heading changes using moving average and adaptive blending
+     * @brief Use the frame precomputed for a mission leg instead of building one
+     */
+    void adopt_mission_leg(const MissionLeg<T>& leg);
+
+    
+    /**
+     * @brief Apply smoothing to heading changes using circular mean and adaptive blending
      * @param new_raw_heading New raw heading to smooth
      * @return Smoothed heading
      */
-    double apply_heading_smoothing(double new_raw_heading);
+    T apply_heading_smoothing(T new_raw_heading);
     
     /**
      * @brief Core decision logic for optimal heading before smoothing
@@ -91,12 +163,12 @@ private:
      * @param compass Current compass heading (degrees)
      * @param wind_vane_relative Wind direction relative to boat (degrees)
      * @param wind_speed Wind speed (m/s)
-     * @param current_time Current time (seconds)
+     * @param current_time Current time (milliseconds, wrap-around safe)
      * @return Raw optimal heading before smoothing
      */
-    double calculate_raw_direction(double boat_lat, double boat_lon, double wpt_lat, double wpt_lon,
-                                  double compass, double wind_vane_relative, double wind_speed, 
-                                  double current_time);
+    T calculate_raw_direction(T boat_lat, T boat_lon, T wpt_lat, T wpt_lon,
+                              T compass, T wind_vane_relative, T wind_speed,
+                              uint32_t current_time);
     
     /**
      * @brief Reset conditions that mark the start of a new upwind leg
@@ -107,7 +179,7 @@ public:
     /**
      * @brief Constructor - Initialize all state variables
      */
-    LaylinePathPlanner();
+    BasicLaylinePathPlanner();
     
     /**
      * @brief Calculate optimal sailing direction using layline tactics
@@ -118,23 +190,60 @@ public:
      * @param compass Current compass heading (degrees)
      * @param wind_vane Wind direction relative to boat (degrees)
      * @param wind_speed Wind speed (m/s)
-     * @param current_time Current time (seconds)
+     * @param current_time Current time (milliseconds, e.g. millis())
      * @return Optimal heading (degrees)
      */
-    double calculate_direction(double boat_lat, double boat_lon, double waypoint_lat, double waypoint_lon,
-                              double compass, double wind_vane, double wind_speed, double current_time);
+    T calculate_direction(T boat_lat, T boat_lon, T waypoint_lat, T waypoint_lon,
+                          T compass, T wind_vane, T wind_speed, uint32_t current_time);
+    
+    /**
+     * @brief Calculate optimal sailing direction towards the active mission waypoint
+     * 
+     * Advances the mission when the boat is within WAYPOINT_ARRIVAL_DISTANCE of
+     * the active waypoint and uses the precomputed leg frames. At each mark
+     * the first board of the next leg is taken from that leg's bearing rather
+     * than from the approach heading, so the boat does not start the leg on a
+     * board that is already past its layline and tack again right away.
+     * 
+     * @param mission Mission being sailed
+     * @param boat_lat Current boat latitude
+     * @param boat_lon Current boat longitude
+     * @param compass Current compass heading (degrees)
+     * @param wind_vane Wind direction relative to boat (degrees)
+     * @param wind_speed Wind speed (m/s)
+     * @param current_time Current time (milliseconds, e.g. millis())
+     * @return Optimal heading (degrees), or the compass heading once the mission is finished
+     */
+    T calculate_mission_direction(BasicMission<T>& mission, T boat_lat, T boat_lon,
+                                  T compass, T wind_vane, T wind_speed, uint32_t current_time);
     
     /**
      * @brief Reset planner state for new waypoint or simulation reset
      */
     void reset_planner_state();
     
+    /**
+     * @brief Use a specific polar table (e.g. one loaded from LittleFS)
+     * @param table Polar table, must outlive the planner
+     */
+    void set_polar_table(const BasicPolarTable<T>& table);
+    
+    /**
+     * @brief Tune the adaptive blending of the heading smoother
+     * @param blend Change thresholds (degrees) and blending factors
+     */
+    void set_heading_blend(const HeadingBlend<T>& blend);
+    
     // Utility functions (shared with base implementation)
-    static double calculate_azimuth(double lat1, double lon1, double lat2, double lon2);
-    static double calculate_distance(double lat1, double lon1, double lat2, double lon2);
-    static void define_no_go_zone(double wind_direction, double wind_speed, double* min_angle, double* max_angle);
-    static bool is_in_no_go_zone(double azimuth, double min_angle, double max_angle);
-    static double get_boat_speed_from_polars(double wind_angle, double wind_speed);
+    static T calculate_azimuth(T lat1, T lon1, T lat2, T lon2);
+    static T calculate_distance(T lat1, T lon1, T lat2, T lon2);
+    static void define_no_go_zone(T wind_direction, T wind_speed, T* min_angle, T* max_angle);
+    static bool is_in_no_go_zone(T azimuth, T min_angle, T max_angle);
+    static T get_boat_speed_from_polars(T wind_angle, T wind_speed);
 };
 
+// Planner used by the firmware, built with the scalar selected above
+typedef BasicLaylinePathPlanner<PlannerScalar> LaylinePathPlanner;
+typedef BasicMission<PlannerScalar> Mission;
+
 #endif // PATH_PLANIFICATION_H
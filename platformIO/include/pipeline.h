@@ -0,0 +1,157 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Event-driven task pipeline: sensors -> pathFinding -> controlTask
+ *
+ * A new GNSS fix or compass sample notifies pathFinding. The idle period
+ * below is only the fallback when no sample arrives, so the planner keeps its
+ * timers running without sensors. Runs stay at least PLANNER_MIN_PERIOD_MS
+ * apart (PlannerPacer): tack confirmations and the heading smoother count
+ * planner runs, so a 10 Hz fix rate must not shorten their time window.
+ * controlTask is periodic (see controlLoop.h) and picks up each new heading
+ * at its next step.
+ *
+ * Each sample carries its capture time in microseconds (trace_clock_us()),
+ * the planner forwards the newest one with its heading and controlTask
+ * measures the sensor-to-servo latency when it applies that heading.
+ */
+
+// Fallback period of pathFinding without sensor event
+#ifndef PLANNER_IDLE_PERIOD_MS
+#define PLANNER_IDLE_PERIOD_MS 500
+#endif
+
+// Shortest interval between two planner runs, the decision period the planner is tuned for
+#ifndef PLANNER_MIN_PERIOD_MS
+#define PLANNER_MIN_PERIOD_MS 500
+#endif
+
+// GNSS drain period: a fix waits at most this long in the receiver buffer
+#ifndef GPS_POLL_PERIOD_MS
+#define GPS_POLL_PERIOD_MS 25
+#endif
+
+// Navigation rate of the ZED-F9P (fixes per second), "gps_rate:" changes it at run time
+#ifndef GNSS_NAV_RATE_HZ
+#define GNSS_NAV_RATE_HZ 10
+#endif
+
+// Highest accepted navigation rate (ZED-F9P RTK limit)
+#define GNSS_NAV_RATE_MAX_HZ 20
+
+// A navigation rate the receiver did not acknowledge is requested again after this delay
+#define GNSS_RATE_RETRY_MS 1000
+
+// No new fix for this long is traced once (EVT_GPS_NO_DATA)
+#define GNSS_NO_DATA_MS 2000
+
+/**
+ * @brief Capture time of the newest of two samples (wrap-around safe)
+ * @param a_us, b_us Capture times, 0 when the sample does not exist
+ * @return Newest capture time, 0 if neither exists
+ */
+inline uint32_t newest_sample_us(uint32_t a_us, uint32_t b_us) {
+    if (a_us == 0) {
+        return b_us;
+    }
+    if (b_us == 0) {
+        return a_us;
+    }
+    return (int32_t)(a_us - b_us) >= 0 ? a_us : b_us;
+}
+
+/**
+ * @brief Rate limit of the planner runs (single task, no locking)
+ *
+ * A sample that arrives after an idle gap is planned on at once, samples
+ * that arrive sooner wait for the end of the minimum period and the run
+ * then uses the newest of them.
+ */
+class PlannerPacer {
+    uint32_t min_period_ms;
+    uint32_t last_ms;
+    bool started;
+
+public:
+    explicit PlannerPacer(uint32_t min_period_ms = PLANNER_MIN_PERIOD_MS)
+        : min_period_ms(min_period_ms), last_ms(0), started(false) {}
+
+    /**
+     * @brief Time left before the next run may start (wrap-around safe)
+     * @param now_ms Current time
+     * @return 0 if the planner may run now
+     */
+    uint32_t hold_ms(uint32_t now_ms) const {
+        if (!started) {
+            return 0;
+        }
+        uint32_t elapsed_ms = now_ms - last_ms;
+        return elapsed_ms >= min_period_ms ? 0 : min_period_ms - elapsed_ms;
+    }
+
+    /**
+     * @brief Record the start of a run
+     */
+    void ran(uint32_t now_ms) {
+        last_ms = now_ms;
+        started = true;
+    }
+};
+
+/**
+ * @brief Sensor-to-servo latency statistics, measured by controlTask
+ */
+struct LatencyData {
+    uint32_t last_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t mean_us;
+    uint32_t count;
+};
+
+/**
+ * @brief Accumulates latency samples (single task, no locking)
+ */
+class LatencyStats {
+    LatencyData stats;
+    uint64_t total_us;
+
+public:
+    LatencyStats() { reset(); }
+
+    void reset() {
+        stats = LatencyData();
+        total_us = 0;
+    }
+
+    /**
+     * @brief Add the latency of one heading applied to the servos
+     * @param sample_us Capture time of the sample behind the heading (0: none, ignored)
+     * @param now_us Time the servos were written
+     * @return true if the sample was counted
+     */
+    bool record(uint32_t sample_us, uint32_t now_us) {
+        if (sample_us == 0) {
+            return false;
+        }
+        uint32_t latency_us = now_us - sample_us;
+        stats.last_us = latency_us;
+        if (stats.count == 0 || latency_us < stats.min_us) {
+            stats.min_us = latency_us;
+        }
+        if (latency_us > stats.max_us) {
+            stats.max_us = latency_us;
+        }
+        stats.count++;
+        total_us += latency_us;
+        stats.mean_us = (uint32_t)(total_us / stats.count);
+        return true;
+    }
+
+    const LatencyData& data() const { return stats; }
+};
+
+#endif // PIPELINE_H
@@ -0,0 +1,101 @@
+#ifndef PLANNER_BATCH_H
+#define PLANNER_BATCH_H
+
+#include <stdint.h>
+#include "polarTable.h"
+
+/**
+ * @brief Tunable thresholds of the planner decision core
+ *
+ * Defaults are the constants of BasicLaylinePathPlanner, so a batch run with
+ * default parameters reproduces the firmware decisions.
+ */
+struct PlannerBatchParams {
+    float no_go_buffer = 7.0f;              // Buffer added to the no-go zone for direct sailing (degrees)
+    float tack_hysteresis_margin = 8.0f;    // Margin added to the layline angle (degrees)
+    int tack_confirmation_threshold = 5;    // Confirmations required before tacking
+    float far_distance = 50.0f;             // Beyond this distance 1.5x confirmations are required (meters)
+};
+
+/**
+ * @brief Planner states, structure of arrays
+ *
+ * Positions are east/north meters in the leg frame (see LocalFrame), which is
+ * what calculate_raw_direction works with once the frame is built.
+ */
+struct PlannerBatchStates {
+    const float* boat_east;                 // Boat position (meters)
+    const float* boat_north;
+    const float* wpt_east;                  // Waypoint position (meters)
+    const float* wpt_north;
+    const float* compass;                   // Compass heading (degrees)
+    const float* wind_vane;                 // Wind direction relative to the boat (degrees)
+    const float* wind_speed;                // Wind speed (m/s)
+    const uint8_t* on_port_tack;            // Current board: 1 = port, 0 = starboard
+};
+
+/**
+ * @brief Decision core outputs, structure of arrays
+ */
+struct PlannerBatchResults {
+    float* azimuth;                         // Bearing to the waypoint (degrees, [0, 360))
+    float* distance;                        // Distance to the waypoint (meters)
+    float* port_heading;                    // Port tack target heading (degrees)
+    float* starboard_heading;               // Starboard tack target heading (degrees)
+    uint8_t* can_sail_direct;               // 1 if the waypoint is outside the buffered no-go zone
+    uint8_t* tack_proposed;                 // 1 if the waypoint is past the layline of the current board
+    uint8_t* required_confirmations;        // Confirmations needed before the proposed tack is taken
+};
+
+/**
+ * @brief Stateless batch evaluation of the geometric core of calculate_raw_direction
+ *
+ * For each state: bearing and distance to the waypoint, VMG tack headings,
+ * buffered no-go test and layline crossing test, with the same formulas as
+ * the planner but none of its state (cooldown, confirmation counters,
+ * beginning-of-leg protection) and no logging. Intended for host-side tuning
+ * runs over millions of states.
+ *
+ * The loop body is branch-free float code (polynomial atan2, selects instead
+ * of branches, the VMG angle as a sum of clamped ramps instead of a table
+ * lookup), so GCC vectorises it on SSE/AVX/NEON hosts at
+ * -O3 -fno-math-errno -fno-trapping-math (see the native_bench environment).
+ * On the Pico it runs as plain soft-float code.
+ */
+class PlannerBatch {
+public:
+    /**
+     * @brief Constructor
+     * @param polar Polar giving the upwind VMG angle per wind speed
+     */
+    explicit PlannerBatch(const BasicPolarTable<float>& polar = BasicPolarTable<float>::default_table());
+
+    void set_params(const PlannerBatchParams& new_params) { params = new_params; }
+    const PlannerBatchParams& get_params() const { return params; }
+
+    /**
+     * @brief Evaluate count states
+     *
+     * Output arrays must not alias the inputs.
+     */
+    void evaluate(const PlannerBatchStates& states, const PlannerBatchResults& results, int count) const;
+
+    /**
+     * @brief Bearing and length of count east/north vectors (degrees, meters)
+     */
+    static void vectors(const float* east, const float* north, float* bearing, float* length, int count);
+
+    /**
+     * @brief Branch-free atan2 in degrees, within 0.001 degree of atan2f
+     */
+    static float atan2_deg(float y, float x);
+
+private:
+    static constexpr int TWS_COUNT = PolarGrid::TWS_COUNT;
+
+    PlannerBatchParams params;
+    float vmg_angle0;                       // Upwind VMG angle at 0 m/s (degrees)
+    float vmg_slope[TWS_COUNT - 1];         // Change of the VMG angle over each 1 m/s bin (degrees)
+};
+
+#endif // PLANNER_BATCH_H
@@ -0,0 +1,215 @@
+#ifndef POLAR_TABLE_H
+#define POLAR_TABLE_H
+
+#include <stdint.h>
+#include "scalarMath.h"
+
+/**
+ * @brief Boat polar grid: speed (m/s) for each true wind angle / true wind speed pair
+ *
+ * Axes are uniform so a lookup is two multiplications and an index:
+ * - TWA from 0 to 180 deg in 5 deg steps (37 rows)
+ * - TWS from 0 to 12 m/s in 1 m/s steps (13 columns)
+ *
+ * The VMG-optimal upwind and downwind TWA are stored for each TWS column.
+ */
+struct PolarGrid {
+    static constexpr int TWA_COUNT = 37;
+    static constexpr int TWS_COUNT = 13;
+    static constexpr double TWA_STEP = 5.0;    // degrees
+    static constexpr double TWS_STEP = 1.0;    // m/s
+
+    double speed[TWA_COUNT][TWS_COUNT];
+    double upwind_twa[TWS_COUNT];
+    double downwind_twa[TWS_COUNT];
+};
+
+/**
+ * @brief Compile-time polar model of our IOM hull (1 m LOA, B-rig)
+ *
+ * Speed is the product of a wind-speed response that saturates towards hull
+ * speed (~1.6 m/s for a 1 m waterline) and an angular efficiency that is zero
+ * inside the pointing angle (wider in light air), peaks on a beam reach and
+ * drops again when running.
+ * Everything here is constexpr so the default table and its VMG cache are
+ * built by the compiler and end up in flash.
+ */
+struct PolarModel {
+    static constexpr double HULL_SPEED = 1.6;        // Asymptotic boat speed (m/s)
+    static constexpr double WIND_HALF_SPEED = 3.0;   // TWS giving half of HULL_SPEED (m/s)
+    static constexpr double VMG_SEARCH_STEP = 1.0;   // Angular resolution of the VMG search (degrees)
+
+    static constexpr double cos_deg(double deg) {
+        // Reduce to [0, 180] then Taylor series around 0 or 180
+        while (deg < 0.0) deg += 360.0;
+        while (deg >= 360.0) deg -= 360.0;
+        if (deg > 180.0) deg = 360.0 - deg;
+        double sign = 1.0;
+        if (deg > 90.0) {
+            deg = 180.0 - deg;
+            sign = -1.0;
+        }
+        double x = deg * 3.14159265358979323846 / 180.0;
+        double x2 = x * x;
+        double term = 1.0;
+        double sum = 1.0;
+        for (int n = 1; n < 12; n++) {
+            term *= -x2 / ((2 * n - 1) * (2 * n));
+            sum += term;
+        }
+        return sign * sum;
+    }
+
+    /**
+     * @brief Closest TWA the rig can drive at: ~42 deg in a drift, ~31 deg at 12 m/s
+     */
+    static constexpr double pointing_angle(double tws) {
+        return 28.0 + 14.0 / (1.0 + tws / 2.0);
+    }
+
+    static constexpr double angle_efficiency(double twa, double tws) {
+        double pointing = pointing_angle(tws);
+        if (twa < pointing) return 0.0;
+        if (twa < pointing + 15.0) return 0.75 * (twa - pointing) / 15.0;
+        if (twa < 60.0) return 0.75 + 0.15 * (twa - pointing - 15.0) / (45.0 - pointing);
+        if (twa < 100.0) return 0.90 + 0.10 * (twa - 60.0) / 40.0;
+        if (twa < 140.0) return 1.00 - 0.05 * (twa - 100.0) / 40.0;
+        return 0.95 - 0.15 * (twa - 140.0) / 40.0;
+    }
+
+    static constexpr double boat_speed(double twa, double tws) {
+        return HULL_SPEED * (tws / (tws + WIND_HALF_SPEED)) * angle_efficiency(twa, tws);
+    }
+
+    /**
+     * @brief Bilinear interpolation in TWA on a single TWS column of a grid
+     */
+    static constexpr double column_speed(const PolarGrid& grid, int tws_index, double twa) {
+        int i = (int)(twa / PolarGrid::TWA_STEP);
+        if (i >= PolarGrid::TWA_COUNT - 1) return grid.speed[PolarGrid::TWA_COUNT - 1][tws_index];
+        double f = (twa - i * PolarGrid::TWA_STEP) / PolarGrid::TWA_STEP;
+        return grid.speed[i][tws_index] * (1.0 - f) + grid.speed[i + 1][tws_index] * f;
+    }
+
+    /**
+     * @brief Search the VMG-optimal angles for every TWS column of a grid
+     */
+    static constexpr void fill_vmg_cache(PolarGrid& grid) {
+        for (int j = 0; j < PolarGrid::TWS_COUNT; j++) {
+            double best_up = 0.0, best_up_twa = 45.0;
+            double best_down = 0.0, best_down_twa = 150.0;
+            for (double twa = 0.0; twa <= 180.0; twa += VMG_SEARCH_STEP) {
+                double vmg = column_speed(grid, j, twa) * cos_deg(twa);
+                if (vmg > best_up) {
+                    best_up = vmg;
+                    best_up_twa = twa;
+                }
+                if (-vmg > best_down) {
+                    best_down = -vmg;
+                    best_down_twa = twa;
+                }
+            }
+            grid.upwind_twa[j] = best_up_twa;
+            grid.downwind_twa[j] = best_down_twa;
+        }
+    }
+
+    static constexpr PolarGrid make_grid() {
+        PolarGrid grid = {};
+        for (int i = 0; i < PolarGrid::TWA_COUNT; i++) {
+            for (int j = 0; j < PolarGrid::TWS_COUNT; j++) {
+                grid.speed[i][j] = boat_speed(i * PolarGrid::TWA_STEP, j * PolarGrid::TWS_STEP);
+            }
+        }
+        fill_vmg_cache(grid);
+        return grid;
+    }
+};
+
+/**
+ * @brief Interpolated polar table with an O(1) VMG-optimum lookup
+ *
+ * Holds the grid converted to the planner scalar type. It starts from the
+ * compile-time PolarModel and can be replaced by a measured polar loaded from
+ * the LittleFS partition (or a file on the host).
+ *
+ * @tparam T Scalar type (double, float or FixedPoint)
+ */
+template <typename T>
+class BasicPolarTable {
+private:
+    typedef ScalarMath<T> M;
+
+    T speed[PolarGrid::TWA_COUNT][PolarGrid::TWS_COUNT];   // Boat speed grid (m/s)
+    T upwind_twa[PolarGrid::TWS_COUNT];                     // VMG-optimal upwind TWA per TWS bin (degrees)
+    T downwind_twa[PolarGrid::TWS_COUNT];                   // VMG-optimal downwind TWA per TWS bin (degrees)
+
+    /**
+     * @brief Copy a double grid (speeds and VMG cache) into the scalar arrays
+     */
+    void assign(const PolarGrid& grid);
+
+    /**
+     * @brief Locate a TWS value on the column axis
+     * @param tws True wind speed (m/s)
+     * @param index Lower column index
+     * @param fraction Position between index and index + 1, in [0, 1]
+     */
+    static void locate_tws(T tws, int* index, T* fraction);
+
+public:
+    static constexpr PolarGrid DEFAULT_GRID = PolarModel::make_grid();
+
+    /**
+     * @brief Constructor - Load the compile-time default polar
+     */
+    BasicPolarTable();
+
+    /**
+     * @brief Boat speed by bilinear interpolation on the grid
+     * @param twa True wind angle relative to the bow (degrees, any sign or range)
+     * @param tws True wind speed (m/s), clamped to the table range
+     * @return Boat speed (m/s)
+     */
+    T boat_speed(T twa, T tws) const;
+
+    /**
+     * @brief VMG-optimal upwind TWA, interpolated between the cached TWS bins
+     * @param tws True wind speed (m/s)
+     * @return Angle to the true wind maximising upwind VMG (degrees)
+     */
+    T upwind_vmg_angle(T tws) const;
+
+    /**
+     * @brief VMG-optimal downwind TWA, interpolated between the cached TWS bins
+     * @param tws True wind speed (m/s)
+     * @return Angle to the true wind maximising downwind VMG (degrees)
+     */
+    T downwind_vmg_angle(T tws) const;
+
+    /**
+     * @brief Load a polar from a text file and rebuild the VMG cache
+     *
+     * Format: one line per TWA row (0, 5, ..., 180 deg), each holding the 13
+     * comma-separated speeds in m/s for TWS = 0, 1, ..., 12 m/s. Lines starting
+     * with '#' are comments. On the Pico the path refers to the LittleFS
+     * partition, on the host to a regular file.
+     *
+     * @param path File path (e.g. "/polar.csv")
+     * @return true if a complete grid was read; the table is unchanged otherwise
+     */
+    bool load_from_file(const char* path);
+
+    /**
+     * @brief Replace the grid from raw speeds and rebuild the VMG cache
+     * @param speeds TWA_COUNT x TWS_COUNT speeds (m/s), row-major by TWA
+     */
+    void set_speeds(const double speeds[PolarGrid::TWA_COUNT][PolarGrid::TWS_COUNT]);
+
+    /**
+     * @brief Shared instance holding the compile-time default polar
+     */
+    static const BasicPolarTable& default_table();
+};
+
+#endif // POLAR_TABLE_H
@@ -2,21 +2,21 @@
 #define QMC5883L_H
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "i2cBus.h"
 
 class QMC5883L {
 public:
-  // Constructeur : on passe l'instance TwoWire et l'adresse I2C (par défaut 0x0D)
-  QMC5883L(TwoWire &wire, uint8_t addr = 0x0D);
+  // Constructeur : on passe le bus I2C (i2cBus.h), l'adresse I2C (par défaut 0x0D)
+  // et la priorité du capteur sur ce bus (0 : servi en premier)
+  QMC5883L(I2cBus &bus, uint8_t addr = 0x0D, uint8_t priority = 1);
 
   void begin();
   float getHeading(); // Retourne l'orientation en degrés
 
 private:
-  TwoWire &_wire;
+  I2cBus &_bus;
+  I2cChannel _channel;
   uint8_t _addr;
-  int16_t read16BitRegister(uint8_t reg);
 };
 
 #endif
-
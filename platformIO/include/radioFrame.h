@@ -0,0 +1,86 @@
+#ifndef RADIO_FRAME_H
+#define RADIO_FRAME_H
+
+#include <stdint.h>
+
+/**
+ * @brief Incremental parser of the ground station uplink
+ *
+ * The ground station sends "key:value|" frames (interface/xbee.py), RTK
+ * corrections as "rtk:<hex of the RTCM bytes>|". feed() takes one byte at a
+ * time and does a constant amount of work per byte, so XbeeTask can hand it
+ * whatever the UART ring holds and return: a partial frame stays in the
+ * parser until its next bytes arrive.
+ *
+ * Commands come out trimmed and NUL-terminated. RTK corrections are decoded
+ * on the fly and come out one RTCM byte at a time, so a 2 KB correction
+ * never needs a buffer.
+ */
+
+// Longest command kept, "key:value" without the terminator
+#define RADIO_COMMAND_SIZE 96
+#define RADIO_FRAME_END '|'
+
+/**
+ * @brief One complete "key:value" command
+ */
+struct RadioCommand {
+    char text[RADIO_COMMAND_SIZE];
+};
+
+/**
+ * @brief What a byte completed
+ */
+enum RadioEvent : uint8_t {
+    RADIO_NONE,         // Nothing yet
+    RADIO_COMMAND,      // command() holds a complete command
+    RADIO_RTK_BYTE,     // rtk_byte() holds the next RTCM byte
+    RADIO_DROPPED       // Frame dropped, see drop_reason(); bytes are skipped up to its end
+};
+
+enum RadioDrop : uint8_t {
+    RADIO_DROP_TOO_LONG,    // Command longer than RADIO_COMMAND_SIZE - 1
+    RADIO_DROP_BAD_HEX      // RTK value with a non-hex character or an odd digit count
+};
+
+class RadioFrameParser {
+    enum State : uint8_t {
+        IDLE,           // Between frames, spaces and line ends skipped
+        TEXT,           // Inside a command
+        RTK_HIGH,       // RTK value, expecting the high nibble
+        RTK_LOW,        // RTK value, expecting the low nibble
+        DISCARD         // Dropped frame, up to its end
+    };
+
+    State state;
+    RadioDrop drop;
+    uint8_t rtk_value;
+    uint16_t length;            // Characters in current.text
+    uint16_t trimmed_length;    // Up to the last non-space character
+    RadioCommand current;
+
+public:
+    RadioFrameParser();
+
+    /**
+     * @brief Consume one received byte
+     */
+    RadioEvent feed(uint8_t byte);
+
+    /**
+     * @brief Command completed by the last feed() (valid until the next one)
+     */
+    const RadioCommand& command() const { return current; }
+
+    /**
+     * @brief RTCM byte decoded by the last feed()
+     */
+    uint8_t rtk_byte() const { return rtk_value; }
+
+    /**
+     * @brief Why the last RADIO_DROPPED frame was dropped
+     */
+    RadioDrop drop_reason() const { return drop; }
+};
+
+#endif // RADIO_FRAME_H
@@ -0,0 +1,119 @@
+#ifndef REGATTA_RUNNER_H
+#define REGATTA_RUNNER_H
+
+#include <stdint.h>
+#include "sailboatSim.h"
+
+/**
+ * @brief Ranges the Monte Carlo scenarios are drawn from
+ */
+struct RegattaSettings {
+    // Course: one leg from the start to a waypoint
+    double start_lat = 47.2537;             // Start position (degrees)
+    double start_lon = -1.3702;
+    double course_length_m = 300.0;         // Start to waypoint (meters)
+    double course_bearing_deg = 0.0;        // Start to waypoint (degrees)
+
+    // Wind: mean direction relative to the course, speed, shifts and gusts
+    double wind_angle_min_deg = 0.0;        // Mean wind off the course bearing, either side (degrees)
+    double wind_angle_max_deg = 180.0;
+    double wind_speed_min = 2.0;            // Mean wind speed (m/s)
+    double wind_speed_max = 12.0;
+    double shift_amplitude_max_deg = 15.0;  // Oscillating shift amplitude (degrees)
+    double shift_period_min_s = 60.0;       // Oscillating shift period (seconds)
+    double shift_period_max_s = 300.0;
+    double persistent_shift_max_deg_per_min = 2.0; // Steady veer or back rate
+    double gust_fraction_max = 0.2;         // Gust amplitude as a fraction of the mean speed
+    double current_speed_max = 0.3;         // Water current speed (m/s), random direction
+
+    // Sensors
+    double gps_noise_m = 1.0;               // GPS position noise (meters)
+    double wind_vane_noise_deg = 5.0;       // Wind vane noise (degrees)
+
+    // Run
+    double dt_s = 0.1;                      // Physics step (seconds)
+    double planner_period_s = 1.0;          // Path planning task period (seconds)
+    double fix_period_s = 0.0;              // GNSS fix period waking the planner (seconds), 0: fixed planner period
+    double arrival_radius_m = 15.0;         // Finish when this close to the waypoint (meters, planner arrival distance)
+    double time_limit_s = 1800.0;           // Give up after (seconds)
+    uint64_t seed = 1;                      // Scenario k uses stream seed + k
+};
+
+/**
+ * @brief Outcome of one scenario
+ */
+struct ScenarioResult {
+    bool arrived;                           // Waypoint reached within the time limit
+    float time_s;                           // Time to the waypoint, or the time limit
+    float distance_m;                       // Distance sailed over ground (meters)
+    int tacks;                              // Bow-through-the-wind turns
+    float wind_speed;                       // Drawn mean wind speed (m/s)
+    float wind_angle;                       // Drawn mean wind off the course (degrees, signed)
+};
+
+/**
+ * @brief Distribution of one metric over the scenarios
+ */
+struct RegattaDistribution {
+    double mean, stddev;
+    double min, p10, p50, p90, max;
+};
+
+/**
+ * @brief Statistics over a Monte Carlo run
+ *
+ * Time and distance cover the scenarios that arrived, tacks cover all of them.
+ */
+struct RegattaSummary {
+    int scenarios;
+    int arrived;
+    RegattaDistribution time_s;
+    RegattaDistribution tacks;
+    RegattaDistribution distance_m;
+};
+
+/**
+ * @brief Monte Carlo regatta: the real LaylinePathPlanner sailing the simulated boat
+ *
+ * Each scenario draws a wind (mean direction and speed, oscillating and
+ * persistent shifts, gusts), a water current and sensor noise from its own
+ * random stream, then sails the leg with the simulator autopilot: the planner
+ * runs every planner_period_s on noisy GPS and wind vane readings, and its
+ * heading is held by the proportional rudder and the sail table of
+ * simulator.py. With fix_period_s set, each fix wakes the planner as on the
+ * boat, and a PlannerPacer keeps the runs planner_period_s apart. Results
+ * only depend on the seed and the scenario index.
+ *
+ * On the host, run() spreads the scenarios over a pool of std::thread
+ * workers that take the next index from a shared counter; on the Pico it
+ * runs them one after the other.
+ */
+class RegattaRunner {
+public:
+    explicit RegattaRunner(const RegattaSettings& settings = RegattaSettings());
+
+    const RegattaSettings& get_settings() const { return settings; }
+
+    /**
+     * @brief Sail one scenario
+     */
+    ScenarioResult run_scenario(int index) const;
+
+    /**
+     * @brief Sail count scenarios
+     * @param results Output, one entry per scenario in index order
+     * @param threads Worker threads (host only, ignored on the Pico)
+     */
+    void run(ScenarioResult* results, int count, int threads = 1) const;
+
+    /**
+     * @brief Distribution statistics of a run
+     * @param results Scenario results
+     */
+    static RegattaSummary summarize(const ScenarioResult* results, int count);
+
+private:
+    RegattaSettings settings;
+};
+
+#endif // REGATTA_RUNNER_H
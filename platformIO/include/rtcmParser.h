@@ -0,0 +1,111 @@
+#ifndef RTCM_PARSER_H
+#define RTCM_PARSER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Streaming RTCM 3 frame checker for the corrections sent to the ZED-F9P
+ *
+ * A frame is 0xD3, 6 zero bits and a 10-bit payload length, the payload
+ * (message type in its first 12 bits) and a CRC-24Q over all of it.
+ * feed() takes one byte at a time and tells the caller what to do with it,
+ * so the bytes can go straight to the UART ring (UartDmaTx::stage()) and be
+ * sent only once the whole frame is known to be good:
+ *
+ *   RTCM_STAGE      store the byte with the frame being received
+ *   RTCM_FRAME      store the byte, the frame is complete and valid: commit it
+ *   RTCM_DROPPED    forget the stored bytes, see drop_reason()
+ *   RTCM_NONE       skip the byte (between frames, or in a dropped one)
+ *
+ * Messages the receiver does not use (RTCM_FORWARDED_TYPES) are dropped as
+ * soon as their type is known, and the rest of the frame is skipped.
+ */
+
+// Longest payload allowed by the 10-bit length
+#define RTCM_MAX_PAYLOAD 1023
+// Whole frame: header, payload, CRC
+#define RTCM_MAX_FRAME (3 + RTCM_MAX_PAYLOAD + 3)
+
+enum RtcmEvent : uint8_t {
+    RTCM_NONE,
+    RTCM_STAGE,
+    RTCM_FRAME,
+    RTCM_DROPPED
+};
+
+enum RtcmDrop : uint8_t {
+    RTCM_DROP_BAD_CRC,      // CRC-24Q mismatch
+    RTCM_DROP_FILTERED,     // Message type not forwarded
+    RTCM_DROP_BAD_HEADER,   // 0xD3 not followed by the 6 zero bits
+    RTCM_DROP_OVERFLOW      // Set by the caller: no room left for the frame (drop_frame())
+};
+
+/**
+ * @brief Counters since start
+ */
+struct RtcmStats {
+    uint32_t frames;            // Frames forwarded
+    uint32_t bytes;             // Bytes of these frames
+    uint32_t bad_crc;
+    uint32_t filtered;
+    uint32_t overflows;
+    uint32_t skipped_bytes;     // Bytes outside any frame
+};
+
+/**
+ * @brief CRC-24Q (polynomial 0x1864CFB, initial value 0), continuing from crc
+ */
+uint32_t rtcm_crc24q(const uint8_t* data, uint32_t length, uint32_t crc = 0);
+
+/**
+ * @brief Whether a message type is sent to the receiver
+ */
+bool rtcm_type_forwarded(uint16_t type);
+
+class RtcmParser {
+    enum State : uint8_t {
+        SYNC,           // Looking for 0xD3
+        LENGTH_HIGH,    // Reserved bits and length bits 9..8
+        LENGTH_LOW,     // Length bits 7..0
+        BODY,           // Payload and CRC
+        SKIP            // Rest of a dropped frame
+    };
+
+    State state;
+    RtcmDrop drop;
+    uint16_t length;        // Payload length
+    uint16_t received;      // Payload and CRC bytes received
+    uint16_t type;
+    uint32_t crc;           // Running CRC of header and payload
+    uint32_t frame_crc;     // CRC bytes of the frame
+    RtcmStats counters;
+
+public:
+    RtcmParser();
+
+    /**
+     * @brief Consume one RTCM byte
+     */
+    RtcmEvent feed(uint8_t byte);
+
+    /**
+     * @brief Drop the frame being received, or just completed, because the caller could not store it
+     *
+     * The other bytes of the frame are skipped.
+     */
+    void drop_frame();
+
+    /**
+     * @brief Type of the last frame seen
+     */
+    uint16_t message_type() const { return type; }
+
+    /**
+     * @brief Why the last RTCM_DROPPED frame was dropped
+     */
+    RtcmDrop drop_reason() const { return drop; }
+
+    const RtcmStats& stats() const { return counters; }
+};
+
+#endif // RTCM_PARSER_H
@@ -0,0 +1,158 @@
+#ifndef SAILBOAT_SIM_H
+#define SAILBOAT_SIM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Small deterministic random generator for the simulation
+ *
+ * xorshift64* with a Box-Muller normal draw: same sequence on the host and
+ * on the Pico, and one independent stream per Monte Carlo scenario.
+ */
+class SimRandom {
+private:
+    uint64_t state;
+    bool spare_set;
+    double spare;
+
+public:
+    explicit SimRandom(uint64_t seed = 1);
+
+    void seed(uint64_t value);
+    uint64_t next();
+
+    /**
+     * @brief Uniform draw in [low, high)
+     */
+    double uniform(double low = 0.0, double high = 1.0);
+
+    /**
+     * @brief Normal draw
+     */
+    double normal(double mean, double stddev);
+};
+
+/**
+ * @brief Wind and water current around the boat
+ */
+struct SailboatEnvironment {
+    double wind_speed = 5.0;         // Wind speed (m/s)
+    double wind_heading = 0.0;       // Direction the wind comes from (degrees)
+    double water_speed = 0.25;       // Water current speed (m/s)
+    double water_heading = -135.0;   // Direction the current flows to (degrees)
+};
+
+/**
+ * @brief Direction and speed of a drift or wind vector
+ */
+struct SimVector {
+    double heading_to_north;         // Direction (degrees)
+    double speed;                    // Speed (m/s)
+};
+
+/**
+ * @brief Apparent wind seen from the boat
+ */
+struct ApparentWind {
+    double speed;                    // Apparent wind speed (m/s)
+    double heading;                  // Relative to the bow, in (-180, 180] (degrees)
+    double heading_to_north;         // Absolute direction (degrees)
+};
+
+/**
+ * @brief Headless port of the physics of "4 - path planification/simulator.py"
+ *
+ * Same constants and formulas as SailboatPhysics and BoatProperties in the
+ * Python simulator: speed from a polar approximation and the sail setting,
+ * first-order speed and heel response, heading change from the rudder, wind
+ * and water drift, and a flat-earth position update.
+ */
+class SailboatPhysics {
+public:
+    static constexpr double B_RIG_FACTOR = 0.9;               // Overall boat efficiency factor
+    static constexpr double ROLL_COEFFICIENT = -8.37;         // Heel response to apparent wind
+    static constexpr double RUDDER_IMPACT = 25.0;             // Rudder effectiveness factor
+    static constexpr double RUDDER_A = 0.028;                 // Rudder speed-dependent coefficient
+    static constexpr double RUDDER_B = 0.393;                 // Rudder base effectiveness
+    static constexpr double ROLL_INERTIA = 0.1;               // Heel damping factor
+    static constexpr double SPEED_INERTIA = 0.3;              // Speed change damping when accelerating
+    static constexpr double SPEED_MOMENTUM = 0.7;             // Speed change damping when decelerating
+    static constexpr double WIND_DRIFT_COEFFICIENT = 0.08;    // Wind-induced drift factor
+    static constexpr double WATER_DRIFT_COEFFICIENT = 0.5;    // Water current effect factor
+    static constexpr double RUDDER_SLOWING_FACTOR = 0.2;      // Speed loss from rudder drag
+    static constexpr double EARTH_CIRCUMFERENCE = 40075000.0; // Meters
+
+    /**
+     * @brief Boat speed from the wind and sail setting (BoatProperties.get_speed)
+     * @param true_wind_speed True wind speed (m/s)
+     * @param true_wind_heading True wind relative to the bow (degrees)
+     * @param sail Sail setting (0 = sheeted in, 1 = fully out)
+     */
+    static double boat_speed(double true_wind_speed, double true_wind_heading, double sail);
+
+    static double calculate_roll(double dt, double aws, double awh, double current_roll);
+    static double calculate_heading_change(double dt, double boat_speed, double rudder);
+
+    /**
+     * @brief Speed after one step, with rudder drag and acceleration damping
+     */
+    static double calculate_speed(double tws, double twh, double sail, double rudder, double current_speed);
+
+    static SimVector calculate_wind_drift(double heading, double tws, double twh);
+    static SimVector calculate_water_drift(const SailboatEnvironment& env);
+    static ApparentWind calculate_apparent_wind(double tws, double twh, double bs, double hdg);
+    static double apply_linear_change(double dt, double current_val, double wanted_val, double change_speed);
+
+    /**
+     * @brief Position after one step of boat motion plus drift
+     */
+    static void calculate_next_position(double lat, double lon, double speed, double hdg,
+                                        const SimVector* wind_drift, const SimVector* water_drift,
+                                        double dt, double* new_lat, double* new_lon);
+};
+
+/**
+ * @brief Simulated boat: state, actuators and noisy sensors (Sailboat in simulator.py)
+ */
+class Sailboat {
+public:
+    static constexpr double RUDDER_SPEED = 20.0;   // Rudder movement rate (per second)
+    static constexpr double SAIL_SPEED = 25.0;     // Sail adjustment rate (per second)
+
+    double x, y;                     // Local coordinates (meters)
+    double heading;                  // Compass heading (degrees)
+    double speed;                    // Speed through water (m/s)
+    double roll;                     // Heel angle (degrees)
+    double actual_rudder, actual_sail;
+    double wanted_rudder, wanted_sail;
+    ApparentWind apparent_wind;
+    double true_wind_speed;          // True wind speed (m/s)
+    double true_wind_heading;        // True wind relative to the bow, in (-180, 180] (degrees)
+    double latitude, longitude;      // Position (degrees)
+    double direction;                // Course over ground (degrees)
+
+    double gps_error_stddev_m;       // GPS position noise (meters)
+    double wind_vane_error_stddev_deg; // Wind vane noise (degrees)
+
+    Sailboat(double lat = 0.0, double lon = 0.0, double initial_heading = 0.0);
+
+    /**
+     * @brief Target rudder position, clamped to [-1, 1]
+     */
+    void set_rudder(double value);
+
+    /**
+     * @brief Target sail position, clamped to [0, 1]
+     */
+    void set_sail(double value);
+
+    /**
+     * @brief Advance the boat by one time step
+     */
+    void update(double dt, const SailboatEnvironment& env);
+
+    void noisy_gps_reading(SimRandom& rng, double* lat, double* lon) const;
+    double noisy_wind_vane_reading(SimRandom& rng) const;
+};
+
+#endif // SAILBOAT_SIM_H
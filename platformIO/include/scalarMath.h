@@ -0,0 +1,202 @@
+#ifndef SCALAR_MATH_H
+#define SCALAR_MATH_H
+
+#include <math.h>
+#include <float.h>
+#include "fixedPoint.h"
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+
+/**
+ * @brief Math primitives used by the navigation code, specialised per scalar type
+ *
+ * All angles are expressed in degrees, which is what the planner manipulates
+ * everywhere. The floating-point specialisations simply forward to libm; the
+ * fixed-point one uses integer polynomial kernels evaluated in Q2.30 so no
+ * soft-float call is ever made on the Cortex-M0+.
+ */
+template <typename T>
+struct ScalarMath;
+
+template <>
+struct ScalarMath<double> {
+    static constexpr bool IS_FIXED = false;
+
+    static double sin_deg(double deg) { return sin(deg * (PI / 180.0)); }
+    static double cos_deg(double deg) { return cos(deg * (PI / 180.0)); }
+    static double atan2_deg(double y, double x) { return atan2(y, x) * (180.0 / PI); }
+    static double sqrt(double x) { return ::sqrt(x); }
+    static double hypot(double x, double y) { return ::sqrt(x * x + y * y); }
+    static double fmod(double x, double y) { return ::fmod(x, y); }
+    static double fabs(double x) { return ::fabs(x); }
+    static double fmin(double x, double y) { return ::fmin(x, y); }
+    static double fmax(double x, double y) { return ::fmax(x, y); }
+    static bool is_nan(double x) { return isnan(x); }
+    static double lowest() { return -DBL_MAX; }
+    static double to_double(double x) { return x; }
+};
+
+template <>
+struct ScalarMath<float> {
+    static constexpr bool IS_FIXED = false;
+
+    static float sin_deg(float deg) { return sinf(deg * (float)(PI / 180.0)); }
+    static float cos_deg(float deg) { return cosf(deg * (float)(PI / 180.0)); }
+    static float atan2_deg(float y, float x) { return atan2f(y, x) * (float)(180.0 / PI); }
+    static float sqrt(float x) { return sqrtf(x); }
+    static float hypot(float x, float y) { return sqrtf(x * x + y * y); }
+    static float fmod(float x, float y) { return fmodf(x, y); }
+    static float fabs(float x) { return fabsf(x); }
+    static float fmin(float x, float y) { return fminf(x, y); }
+    static float fmax(float x, float y) { return fmaxf(x, y); }
+    static bool is_nan(float x) { return isnan(x); }
+    static float lowest() { return -FLT_MAX; }
+    static double to_double(float x) { return x; }
+};
+
+template <int FracBits>
+struct ScalarMath<FixedPoint<FracBits> > {
+    typedef FixedPoint<FracBits> T;
+    static constexpr bool IS_FIXED = true;
+
+    /**
+     * @brief Sine of an angle in degrees (max error ~1e-7 before rounding to FracBits)
+     */
+    static T sin_deg(T deg) {
+        const int64_t full_turn = int64_t(360) << FracBits;
+        const int64_t half_turn = int64_t(180) << FracBits;
+        const int64_t quarter_turn = int64_t(90) << FracBits;
+
+        // Reduce to [-180, 180) then fold onto [-90, 90] where the series converges fast
+        int64_t r = deg.raw() % full_turn;
+        if (r >= half_turn) r -= full_turn;
+        if (r < -half_turn) r += full_turn;
+        if (r > quarter_turn) r = half_turn - r;
+        else if (r < -quarter_turn) r = -half_turn - r;
+
+        // z = angle / 90deg in Q2.30, sin(pi/2 * z) by odd Taylor series up to z^11
+        const int64_t z = (r << (30 - FracBits)) / 90;
+        const int64_t z2 = (z * z) >> 30;
+        int64_t acc = SIN_C11;
+        acc = SIN_C9 + ((acc * z2) >> 30);
+        acc = SIN_C7 + ((acc * z2) >> 30);
+        acc = SIN_C5 + ((acc * z2) >> 30);
+        acc = SIN_C3 + ((acc * z2) >> 30);
+        acc = SIN_C1 + ((acc * z2) >> 30);
+        const int64_t sin_q30 = (acc * z) >> 30;
+        return T::from_raw(T::saturate(round_shift(sin_q30, 30 - FracBits)));
+    }
+
+    static T cos_deg(T deg) { return sin_deg(deg + T(90)); }
+
+    /**
+     * @brief Four-quadrant arctangent in degrees (max error ~6e-4 deg)
+     *
+     * atan2 is scale invariant, so the raw integers are used directly as a
+     * ratio: tiny inputs (e.g. a few metres expressed in degrees) keep their
+     * full relative precision.
+     */
+    static T atan2_deg(T y, T x) {
+        int64_t ax = x.raw() < 0 ? -(int64_t)x.raw() : x.raw();
+        int64_t ay = y.raw() < 0 ? -(int64_t)y.raw() : y.raw();
+        if (ax == 0 && ay == 0) {
+            return T(0);
+        }
+        const bool swapped = ay > ax;
+        const int64_t num = swapped ? ax : ay;
+        const int64_t den = swapped ? ay : ax;
+
+        // t in [0, 1] as Q2.30, atan(t) by minimax polynomial (|err| < 1e-5 rad)
+        const int64_t t = (num << 30) / den;
+        const int64_t t2 = (t * t) >> 30;
+        int64_t acc = ATAN_C11;
+        acc = ATAN_C9 + ((acc * t2) >> 30);
+        acc = ATAN_C7 + ((acc * t2) >> 30);
+        acc = ATAN_C5 + ((acc * t2) >> 30);
+        acc = ATAN_C3 + ((acc * t2) >> 30);
+        acc = ATAN_C1 + ((acc * t2) >> 30);
+        const int64_t angle_rad_q30 = (acc * t) >> 30;
+
+        // Radians (Q2.30) to degrees (Q.FracBits)
+        int64_t angle = round_shift(angle_rad_q30 * RAD_TO_DEG_Q16, 30 + 16 - FracBits);
+        const int64_t quarter_turn = int64_t(90) << FracBits;
+        const int64_t half_turn = int64_t(180) << FracBits;
+        if (swapped) angle = quarter_turn - angle;
+        if (x.raw() < 0) angle = half_turn - angle;
+        if (y.raw() < 0) angle = -angle;
+        return T::from_raw(T::saturate(angle));
+    }
+
+    static T sqrt(T x) {
+        if (x.raw() <= 0) {
+            return T(0);
+        }
+        return T::from_raw(T::saturate(isqrt((uint64_t)x.raw() << FracBits)));
+    }
+
+    /**
+     * @brief sqrt(x^2 + y^2) on the raw 64-bit sum, so it cannot overflow before the root
+     */
+    static T hypot(T x, T y) {
+        const uint64_t sum = (uint64_t)((int64_t)x.raw() * x.raw()) + (uint64_t)((int64_t)y.raw() * y.raw());
+        return T::from_raw(T::saturate(isqrt(sum)));
+    }
+
+    // Same sign convention as libm fmod: the result takes the sign of x
+    static T fmod(T x, T y) { return y.raw() == 0 ? T(0) : T::from_raw(x.raw() % y.raw()); }
+    static T fabs(T x) { return x.raw() < 0 ? -x : x; }
+    static T fmin(T x, T y) { return x < y ? x : y; }
+    static T fmax(T x, T y) { return x > y ? x : y; }
+    static bool is_nan(T) { return false; }
+    static T lowest() { return T::from_raw(T::RAW_MIN); }
+    static double to_double(T x) { return static_cast<double>(x); }
+
+private:
+    static constexpr int64_t q30(double value) { return static_cast<int64_t>(value * 1073741824.0 + (value >= 0 ? 0.5 : -0.5)); }
+
+    // sin(pi/2 * z) Taylor coefficients
+    static constexpr int64_t SIN_C1 = q30(1.5707963267948966);
+    static constexpr int64_t SIN_C3 = q30(-0.6459640975062462);
+    static constexpr int64_t SIN_C5 = q30(0.07969262624616703);
+    static constexpr int64_t SIN_C7 = q30(-0.004681754135318687);
+    static constexpr int64_t SIN_C9 = q30(0.00016044118478735982);
+    static constexpr int64_t SIN_C11 = q30(-3.598843235212085e-06);
+
+    // atan(t) minimax coefficients on [0, 1]
+    static constexpr int64_t ATAN_C1 = q30(0.99997726);
+    static constexpr int64_t ATAN_C3 = q30(-0.33262347);
+    static constexpr int64_t ATAN_C5 = q30(0.19354346);
+    static constexpr int64_t ATAN_C7 = q30(-0.11643287);
+    static constexpr int64_t ATAN_C9 = q30(0.05265332);
+    static constexpr int64_t ATAN_C11 = q30(-0.01172120);
+
+    // 180/pi in Q16 (kept small so angle_rad_q30 * RAD_TO_DEG_Q16 fits in int64)
+    static constexpr int64_t RAD_TO_DEG_Q16 = static_cast<int64_t>(57.29577951308232 * 65536.0 + 0.5);
+
+    static int64_t round_shift(int64_t value, int shift) {
+        if (shift <= 0) {
+            return value << -shift;
+        }
+        return (value + (int64_t(1) << (shift - 1))) >> shift;
+    }
+
+    static int64_t isqrt(uint64_t value) {
+        uint64_t result = 0;
+        uint64_t bit = uint64_t(1) << 62;
+        while (bit > value) bit >>= 2;
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return (int64_t)result;
+    }
+};
+
+#endif // SCALAR_MATH_H
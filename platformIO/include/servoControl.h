@@ -3,11 +3,9 @@
 
 #include <Arduino.h>
 #include <Servo.h>
-#include <xbeeImpl.h>
+#include "controlLaw.h"
 
-// Value safran
-const int min_angle_safran = 70;
-const int max_angle_safran = 170;
+// Value safran (angle limits in controlLaw.h)
 const int min_ms_safran = 1260;
 const int max_ms_safran = 1740;
 const int init_safran = 1500;
@@ -27,7 +25,7 @@ private:
     Servo sailServo;
 
     // Control Parameters
-    int servoAnglePosition = 125;
+    float servoAnglePosition = 125.0f;  // Fractional, rounded only into the pulse width
     int voileTensionPosition = 100;
     int ms_safran_position;
     int ms_sail_position;
@@ -38,15 +36,19 @@ private:
 
 public:
     servoControl();
-    void servo_control(const xbeeImpl &xbee);
+    // One PI step towards targetAngle (planner heading or manual "cap:", see SharedData::target_angle)
+    void servo_control(int targetAngle);
     int calculateShortestPath(int current, int target);
 
     // Getters for Control Parameters
-    int getServoAnglePosition() const { return servoAnglePosition; }
+    int getServoAnglePosition() const { return (int)(servoAnglePosition + 0.5f); }
     int getVoileTensionPosition() const { return voileTensionPosition; }
     int getSafranPosition() const { return ms_safran_position; }
     int getSailPosition() const { return ms_sail_position; }
 
+    // Sail servo command (microseconds) for the wind vane angle
+    int getSailPosition(double wind_vane);
+
 
     // Getters for PI Control Variables
     float getAdjustement() const { return adjustment; }
@@ -0,0 +1,104 @@
+#ifndef SHARED_SNAPSHOT_H
+#define SHARED_SNAPSHOT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+/**
+ * @brief Versioned, timestamped value shared by one writer task and any number of readers
+ *
+ * Double-buffered seqlock: write number n goes to buffer n & 1 while readers
+ * copy the buffer of the last published write. The writer never waits and
+ * never sees the readers. A reader retries only when the writer has started
+ * the write after next during its copy, i.e. when the reader itself was
+ * preempted for a whole write period; a writer preempted in the middle of
+ * a copy does not hold readers up, they keep reading the other buffer.
+ *
+ * The payload is stored as relaxed 32-bit atomic words (plain loads and
+ * stores on the Cortex-M0+), so a double can no longer be read half-written
+ * and the fields of one write always come out together.
+ *
+ * Only one task may call write() on a given snapshot.
+ *
+ * @tparam T Trivially copyable payload
+ */
+template <typename T>
+class SharedSnapshot {
+    static_assert(std::is_trivially_copyable<T>::value, "SharedSnapshot payload must be trivially copyable");
+
+    static constexpr int WORDS = (int)((sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t)) + 1;  // + timestamp
+
+    std::atomic<uint32_t> started;      // Number of writes begun
+    std::atomic<uint32_t> published;    // Number of writes completed
+    std::atomic<uint32_t> words[2][WORDS];
+
+public:
+    SharedSnapshot() : started(0), published(0) {
+        uint32_t packed[WORDS] = {0};
+        T empty = T();
+        memcpy(packed, &empty, sizeof(T));
+        for (int b = 0; b < 2; b++) {
+            for (int k = 0; k < WORDS; k++) {
+                words[b][k].store(packed[k], std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Publish a new value (single writer)
+     * @param timestamp_ms Time of the measurement or command (millis())
+     */
+    void write(const T& value, uint32_t timestamp_ms) {
+        uint32_t packed[WORDS] = {0};
+        memcpy(packed, &value, sizeof(T));
+        packed[WORDS - 1] = timestamp_ms;
+
+        uint32_t n = published.load(std::memory_order_relaxed) + 1;
+        started.store(n, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::atomic<uint32_t>* buffer = words[n & 1];
+        for (int k = 0; k < WORDS; k++) {
+            buffer[k].store(packed[k], std::memory_order_relaxed);
+        }
+        published.store(n, std::memory_order_release);
+    }
+
+    /**
+     * @brief Coherent copy of the last published value
+     * @param value Output, default-constructed T before the first write
+     * @param timestamp_ms Output (optional), timestamp given to write()
+     * @return Version: number of writes so far, 0 if never written
+     */
+    uint32_t read(T* value, uint32_t* timestamp_ms = nullptr) const {
+        uint32_t packed[WORDS];
+        uint32_t version;
+        for (;;) {
+            version = published.load(std::memory_order_acquire);
+            const std::atomic<uint32_t>* buffer = words[version & 1];
+            for (int k = 0; k < WORDS; k++) {
+                packed[k] = buffer[k].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // Buffer reused only by write version + 2
+            if (started.load(std::memory_order_relaxed) - version < 2) {
+                break;
+            }
+        }
+        memcpy(value, packed, sizeof(T));
+        if (timestamp_ms != nullptr) {
+            *timestamp_ms = packed[WORDS - 1];
+        }
+        return version;
+    }
+
+    /**
+     * @brief Number of writes so far, to detect a new value without copying it
+     */
+    uint32_t version() const {
+        return published.load(std::memory_order_acquire);
+    }
+};
+
+#endif // SHARED_SNAPSHOT_H
@@ -1,7 +1,62 @@
 #ifndef SHAREDDATA_H
 #define SHAREDDATA_H
 
-// Structure partagée par toutes les tâches
+#include <stdint.h>
+#include "sharedSnapshot.h"
+#include "controlLoop.h"
+#include "mission.h"
+
+// Position GNSS, écrite par GpsVersPicoTask
+struct GnssData {
+    double latitude;
+    double longitude;
+    double altitude;
+    uint32_t sample_us;             // Date de la mesure (trace_clock_us(), 0 : aucune)
+    uint32_t time_of_week_ms;       // Date GNSS de la solution (iTOW)
+    float ground_speed;             // Vitesse fond (m/s)
+    float ground_course;            // Route fond (degrés)
+    float horizontal_accuracy;      // Précision horizontale estimée (m)
+    uint8_t fix_type;               // 0 : aucun, 2 : 2D, 3 : 3D, 4 : GNSS + estime
+    uint8_t carrier_solution;       // 0 : pas de RTK, 1 : RTK float, 2 : RTK fixed
+};
+
+// Capteurs d'attitude et de vent, écrits par sensorTask
+struct AttitudeData {
+    double compass;
+    double wind_vane;
+    double wind_speed;
+    double horizontal_tilt;
+    double vertical_tilt;
+    int angleFromNorth;
+    uint32_t sample_us;             // Date de la mesure (trace_clock_us(), 0 : aucune)
+};
+
+// Consignes reçues par radio, écrites par XbeeTask
+struct CommandData {
+    double waypoint_lat;            // Point unique ("point_lat:", "point_lon:")...
+    double waypoint_lon;
+    uint32_t waypoint_ms;           // ...et sa date (0 : jamais reçu)
+    int targetAngle;                // Cap manuel ("cap:")...
+    uint32_t targetAngle_ms;        // ...et sa date (0 : jamais reçu)
+    int targetTension;
+    float kp;                       // Gains du correcteur PI ("kp:", "ki:"), publiés avec le reste
+    float ki;                       // d'une trame : une rafale de réglages s'applique d'un coup
+    uint8_t gps_rate_hz;            // Cadence GNSS demandée ("gps_rate:", 0 : GNSS_NAV_RATE_HZ)
+    uint8_t gps_txready;            // Ingestion GNSS demandée ("gps_txready:") : 0 aucune demande,
+                                    // 1 interrogation, 2 réveil par la broche TX-ready...
+    uint32_t gps_txready_ms;        // ...et sa date (0 : jamais reçu), chaque demande s'applique une fois
+};
+
+// Sortie du planificateur, écrite par pathFinding
+struct NavigationData {
+    double waypoint_lat;            // Point en cours (étape de mission ou point unique)
+    double waypoint_lon;
+    int targetAngle;
+    uint32_t sample_us;             // Date de la mesure la plus récente utilisée pour ce cap
+    uint32_t heading_ms;            // Date de publication (millis), comparée à celle du cap manuel
+};
+
+// Vue à plat de toutes les données, pour la télémétrie
 typedef struct {
     double latitude;
     double longitude;
@@ -16,8 +71,39 @@ typedef struct {
     int targetAngle;
     int targetTension;
     int angleFromNorth;
-} SharedData;
+} TelemetryData;
+
+/**
+ * @brief Données partagées entre les tâches, un instantané par tâche productrice
+ *
+ * Chaque groupe n'a qu'une tâche qui écrit ; les lecteurs obtiennent une copie
+ * cohérente et datée (SharedSnapshot) sans jamais bloquer l'écrivain.
+ */
+struct SharedData {
+    SharedSnapshot<GnssData> gnss;
+    SharedSnapshot<AttitudeData> attitude;
+    SharedSnapshot<CommandData> command;
+    SharedSnapshot<NavigationData> navigation;
+    SharedSnapshot<ControlReport> control;      // Gigue et latence de la boucle de contrôle, écrites par XbeeTask
+    SharedSnapshot<MissionUpload> mission;      // Liste de points publiée par XbeeTask sur "mission_start:1"
+
+    /**
+     * @brief Consigne de cap la plus récente : planificateur, ou cap manuel reçu après
+     */
+    int target_angle() const;
+
+    /**
+     * @brief Même règle pour un cap du planificateur reçu par ailleurs (headingQueue)
+     * @param heading_ms Date de publication de ce cap (millis)
+     */
+    int target_angle(int planner_angle, uint32_t heading_ms) const;
+
+    /**
+     * @brief Copie à plat de tous les groupes (chaque groupe est cohérent)
+     */
+    TelemetryData telemetry() const;
+};
 
 extern SharedData sharedData;
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,65 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Bounded lock-free queue between one producer task and one consumer task
+ *
+ * Used to hand values from one core to the other without a FreeRTOS queue:
+ * neither side takes a lock, disables interrupts or waits on the other.
+ * Each index is written by a single side, so only plain atomic loads and
+ * stores are needed (the Cortex-M0+ has no compare-and-swap).
+ *
+ * @tparam T Copyable element
+ * @tparam CAPACITY Number of elements, power of two
+ */
+template <typename T, uint32_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    T slots[CAPACITY];
+    std::atomic<uint32_t> head;     // Next slot to write, producer only
+    std::atomic<uint32_t> tail;     // Next slot to read, consumer only
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    /**
+     * @brief Append a value (producer only)
+     * @return false if the queue is full, the value is not stored
+     */
+    bool push(const T& value) {
+        uint32_t position = head.load(std::memory_order_relaxed);
+        if (position - tail.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+        slots[position & (CAPACITY - 1)] = value;
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest value (consumer only)
+     * @return false if the queue is empty
+     */
+    bool pop(T* value) {
+        uint32_t position = tail.load(std::memory_order_relaxed);
+        if (position == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        *value = slots[position & (CAPACITY - 1)];
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Number of values waiting, the other side may change it meanwhile
+     */
+    uint32_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,82 @@
+#ifndef STATIC_ALLOC_H
+#define STATIC_ALLOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Heap-free build mode (-DSTATIC_ALLOCATION, env:pico_static)
+ *
+ * Tasks are created with their stack and control block taken from fixed
+ * pools in .bss (create_task), the queues and buffers are already
+ * fixed-size members or globals. Once every task has finished its initialization, heap_lock()
+ * closes the heap: from then on operator new calls the heap trap, and
+ * monitorTask reports any malloc() growth of the heap in use. The RAM
+ * budget per subsystem is printed after the link by host/ram_budget.py.
+ *
+ * Without STATIC_ALLOCATION, create_task is xTaskCreateAffinitySet and
+ * the heap is never locked.
+ */
+
+// Task stack pool (words) and control block pool of the STATIC_ALLOCATION build
+#ifndef TASK_STACK_POOL_WORDS
+#define TASK_STACK_POOL_WORDS 8192
+#endif
+#ifndef TASK_POOL_SIZE
+#define TASK_POOL_SIZE 10
+#endif
+
+#ifdef ARDUINO
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief xTaskCreateAffinitySet, stack and control block from the pools under STATIC_ALLOCATION
+ * @param handle Created task, may be NULL
+ * @return false if the task was not created (pool or heap exhausted)
+ */
+bool create_task(TaskFunction_t function, const char* name, uint32_t stack_words, void* parameters,
+                 UBaseType_t priority, UBaseType_t core_mask, TaskHandle_t* handle);
+#endif
+
+/**
+ * @brief Called with the size and the caller of an allocation made after heap_lock()
+ */
+typedef void (*HeapTrapHandler)(size_t size, void* caller);
+
+/**
+ * @brief Close the heap: records the heap in use, later allocations trap
+ */
+void heap_lock();
+
+/**
+ * @brief true once heap_lock() has been called
+ */
+bool heap_locked();
+
+/**
+ * @brief Heap in use (bytes), from the C library allocator
+ */
+uint32_t heap_used();
+
+/**
+ * @brief Heap in use when heap_lock() was called (bytes)
+ */
+uint32_t heap_used_at_lock();
+
+/**
+ * @brief Number of operator new calls made after heap_lock()
+ */
+uint32_t heap_trap_count();
+
+/**
+ * @brief Replace the heap trap (the default traces and halts), nullptr restores it
+ */
+void set_heap_trap_handler(HeapTrapHandler handler);
+
+/**
+ * @brief Entry point of the operator new replacements
+ */
+void heap_trap(size_t size, void* caller);
+
+#endif // STATIC_ALLOC_H
@@ -0,0 +1,190 @@
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * @brief Per-task stack, CPU and loop timing instrumentation
+ *
+ * Each task brackets the work of its loop with its LoopProbe: begin() when
+ * the work starts, end() just before it blocks again. Every
+ * TASK_MONITOR_PERIOD_MS, monitorTask takes one TaskUsage record per task
+ * from the probes, the FreeRTOS stack high-water marks and the run-time
+ * counters. It traces a summary and queues the records for the XBee telemetry.
+ */
+
+#ifndef TASK_MONITOR_PERIOD_MS
+#define TASK_MONITOR_PERIOD_MS 5000
+#endif
+
+// A task with less free stack than this is reported with EVT_TASK_STACK_LOW
+#ifndef TASK_STACK_WARN_WORDS
+#define TASK_STACK_WARN_WORDS 64
+#endif
+
+// Histogram buckets: < 64 us, then one per power of two, the last one >= 2^20 us (~1 s)
+#define TASK_HIST_BUCKETS 16
+#define TASK_HIST_FIRST_SHIFT 6
+
+/**
+ * @brief Instrumented tasks. The names in traceEvents.h follow this order.
+ */
+enum MonitoredTask : uint8_t {
+    TASK_BLINK,
+    TASK_CONTROL,
+    TASK_PATH,
+    TASK_SENSOR,
+    TASK_GPS,
+    TASK_XBEE,
+    TASK_TRACE,
+    TASK_MONITOR,
+    TASK_I2C0,
+    TASK_I2C1,
+    MONITORED_TASK_COUNT
+};
+
+extern const char* const monitored_task_names[MONITORED_TASK_COUNT];
+
+/**
+ * @brief Histogram bucket of a duration in microseconds
+ */
+inline int task_hist_bucket(uint32_t us) {
+    int bucket = 0;
+    us >>= TASK_HIST_FIRST_SHIFT;
+    while (us != 0 && bucket < TASK_HIST_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/**
+ * @brief Loop timing of one task
+ *
+ * Only the owning task calls begin() and end(). The counters only grow, and
+ * monitorTask computes the window values from their differences. The min/max
+ * values are reset by the task itself when monitorTask starts a new window.
+ * All fields are 32-bit atomics, so plain loads and stores are enough on the
+ * M0+.
+ */
+class LoopProbe {
+    friend class TaskMonitor;
+
+    std::atomic<uint32_t> loops;
+    std::atomic<uint32_t> busy_us;
+    std::atomic<uint32_t> exec_hist[TASK_HIST_BUCKETS];
+    std::atomic<uint32_t> period_hist[TASK_HIST_BUCKETS];
+    std::atomic<uint32_t> exec_max_us;
+    std::atomic<uint32_t> period_min_us;
+    std::atomic<uint32_t> period_max_us;
+    std::atomic<uint32_t> deadline_misses;
+    std::atomic<uint32_t> window;       // Written by monitorTask only
+    std::atomic<uint32_t> deadline_us;  // 0: no deadline, set before the task starts
+
+    // Owning task only
+    uint32_t seen_window;
+    uint32_t start_us;
+    uint32_t last_start_us;
+    bool started;
+
+    static void add(std::atomic<uint32_t>& counter, uint32_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+public:
+    LoopProbe();
+
+    /**
+     * @brief Start of the work of one loop
+     * @param now_us micros()
+     */
+    void begin(uint32_t now_us);
+
+    /**
+     * @brief End of the work of one loop, before the task blocks
+     * @param now_us micros()
+     */
+    void end(uint32_t now_us);
+};
+
+/**
+ * @brief Usage of one task over one monitor window
+ */
+struct TaskUsage {
+    uint8_t task;                               // MonitoredTask
+    uint16_t cpu_permille;                      // Share of one core, 0.1 % steps
+    uint16_t stack_free_words;                  // Lowest free stack since the task started, 0: unknown
+    uint32_t loops;
+    uint32_t exec_max_us;
+    uint32_t period_min_us;                     // 0 when fewer than two loops ran
+    uint32_t period_max_us;
+    uint16_t exec_hist[TASK_HIST_BUCKETS];      // Loops per bucket, saturated at 65535
+    uint16_t period_hist[TASK_HIST_BUCKETS];
+    uint32_t deadline_misses;                   // Steps longer than the task deadline
+};
+
+/**
+ * @brief Probes of all monitored tasks and the state of the previous sample
+ */
+class TaskMonitor {
+    LoopProbe probes[MONITORED_TASK_COUNT];
+    std::atomic<void*> handles[MONITORED_TASK_COUNT];  // TaskHandle_t, set by attach()
+    std::atomic<bool> is_attached[MONITORED_TASK_COUNT];
+
+    // monitorTask only
+    uint32_t last_loops[MONITORED_TASK_COUNT];
+    uint32_t last_busy_us[MONITORED_TASK_COUNT];
+    uint32_t last_deadline_misses[MONITORED_TASK_COUNT];
+    uint32_t last_exec_hist[MONITORED_TASK_COUNT][TASK_HIST_BUCKETS];
+    uint32_t last_period_hist[MONITORED_TASK_COUNT][TASK_HIST_BUCKETS];
+    uint32_t last_run_time[MONITORED_TASK_COUNT];
+    uint32_t last_total_run_time;
+    uint32_t last_sample_us;
+
+public:
+    TaskMonitor();
+
+    /**
+     * @brief Register the calling task and return its probe
+     */
+    LoopProbe& attach(MonitoredTask task);
+
+    /**
+     * @brief true once the task has called attach(), i.e. finished its initialization
+     */
+    bool attached(MonitoredTask task) const;
+
+    /**
+     * @brief Longest step of a task before it counts as a deadline miss, 0: none
+     */
+    void set_deadline(MonitoredTask task, uint32_t deadline_us);
+
+    /**
+     * @brief Usage of every task since the previous call (monitorTask only)
+     * @param now_us micros()
+     * @param usage Output, MONITORED_TASK_COUNT records in MonitoredTask order
+     *
+     * CPU comes from the FreeRTOS run-time counters when they are enabled,
+     * otherwise from the loop durations (which then include preemption).
+     */
+    void sample(uint32_t now_us, TaskUsage* usage);
+};
+
+extern TaskMonitor taskMonitor;
+
+/**
+ * @brief Telemetry line of a record, without the line end
+ *
+ * "task_<name>:<cpu permille>,<stack free words>,<loops>,<exec max us>,
+ * <period min us>,<period max us>,<exec hist>,<period hist>,<deadline misses>".
+ * Each histogram
+ * is written as "<first bucket>/<count>/<count>...": the counts run from the
+ * first non-empty bucket to the last one, and "-" means an empty histogram.
+ *
+ * @return Length written (snprintf semantics: >= size means truncated)
+ */
+int format_task_usage(const TaskUsage& usage, char* buffer, size_t size);
+
+#endif // TASK_MONITOR_H
@@ -0,0 +1,93 @@
+#ifndef TASK_TABLE_H
+#define TASK_TABLE_H
+
+#include <stdint.h>
+#include "taskMonitor.h"
+
+/**
+ * @brief Declarative task table with rate-monotonic priorities
+ *
+ * main.cpp describes every task in one TaskConfig per MonitoredTask (the
+ * FreeRTOS name is monitored_task_names[task]). At boot:
+ * - load_task_rates() applies the periods and deadlines of TASK_RATES_FILE
+ *   (LittleFS), so loop rates can be retuned without a new firmware;
+ * - assign_rate_monotonic_priorities() gives the shortest periods the
+ *   highest priorities, background tasks get the idle priority;
+ * - start_tasks() hands each deadline to the task monitor and creates the
+ *   tasks. Each loop then counts the steps that end after their deadline.
+ *
+ * The tasks read their period from the table at every loop.
+ */
+
+// Persisted periods: "<task>,<period ms>[,<deadline ms>]" per line, '#' for comments
+#define TASK_RATES_FILE "/tasks.cfg"
+
+// FreeRTOS priority range given to the periodic tasks
+#ifndef TASK_LOWEST_PRIORITY
+#define TASK_LOWEST_PRIORITY 1
+#endif
+#ifndef TASK_HIGHEST_PRIORITY
+#define TASK_HIGHEST_PRIORITY 6
+#endif
+
+// Accepted periods, a file value outside is ignored
+#define TASK_MIN_PERIOD_MS 1
+#define TASK_MAX_PERIOD_MS 60000
+
+typedef void (*TaskEntry)(void* parameters);
+
+/**
+ * @brief One task of the table
+ */
+struct TaskConfig {
+    TaskEntry entry;            // NULL: task not created in this build
+    uint32_t period_ms;         // Release period, or longest wait for an event-driven task
+    uint32_t deadline_ms;       // Latest end of a step after its release, 0: the period
+    uint16_t stack_words;
+    uint8_t core;               // IO_CORE or CONTROL_CORE
+    bool background;            // Idle priority whatever its period (trace drain)
+    uint8_t priority;           // Set by assign_rate_monotonic_priorities()
+    void* handle;               // TaskHandle_t, set by start_tasks()
+};
+
+/**
+ * @brief Deadline of a step in microseconds
+ */
+inline uint32_t task_deadline_us(const TaskConfig& config) {
+    return (config.deadline_ms != 0 ? config.deadline_ms : config.period_ms) * 1000UL;
+}
+
+/**
+ * @brief Rate-monotonic priorities: one level per distinct period, shortest period highest
+ * @param table MONITORED_TASK_COUNT entries in MonitoredTask order
+ * @param lowest Priority of the longest period
+ * @param highest Priority of the shortest period; extra levels are merged at lowest
+ * @return Number of distinct periods
+ */
+int assign_rate_monotonic_priorities(TaskConfig* table, uint8_t lowest, uint8_t highest);
+
+/**
+ * @brief Apply one "<task>,<period ms>[,<deadline ms>]" line
+ * @return false if the line is not valid, the table is unchanged then
+ */
+bool apply_task_rate(TaskConfig* table, const char* line);
+
+/**
+ * @brief Apply the lines of a rates file
+ * @param path File path (e.g. TASK_RATES_FILE)
+ * @return Number of lines applied, 0 if the file is missing
+ */
+int load_task_rates(TaskConfig* table, const char* path);
+
+/**
+ * @brief Set the deadlines of the task monitor and create every task with an entry
+ * @return Number of tasks that could not be created
+ */
+int start_tasks(TaskConfig* table);
+
+/**
+ * @brief The table of main.cpp
+ */
+extern TaskConfig taskTable[MONITORED_TASK_COUNT];
+
+#endif // TASK_TABLE_H
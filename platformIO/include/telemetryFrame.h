@@ -0,0 +1,138 @@
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "shared_data.h"
+
+/**
+ * @brief Binary downlink frames (reference decoder: "3 - control/interface/telemetry.py")
+ *
+ * Every frame sent to the ground station is
+ *
+ *   COBS(version, type, sequence, payload..., CRC-16 low, CRC-16 high) 0x00
+ *
+ * COBS removes the zero bytes, so 0x00 only appears as the frame delimiter
+ * and the decoder resynchronizes on the next one. The CRC is CRC-16/CCITT-
+ * FALSE over version..payload. The sequence counts every frame, so the
+ * ground station sees the lost ones.
+ *
+ * TELEMETRY_STATE payload: a 16-bit mask of the fields in the frame, then
+ * those fields in TELEMETRY_FIELDS order, as little-endian fixed-point
+ * integers. Which fields go in which frame is decided by TelemetryScheduler
+ * (telemetryScheduler.h).
+ *
+ * TELEMETRY_TEXT payload: one ASCII "key:value" line (task usage...).
+ */
+
+#define TELEMETRY_VERSION 1
+
+enum TelemetryFrameType : uint8_t {
+    TELEMETRY_STATE = 1,
+    TELEMETRY_TEXT = 2
+};
+
+enum TelemetryKind : uint8_t {
+    TLM_INT,        // Signed, saturated
+    TLM_ANGLE       // Unsigned, wrapped to [0, 360)
+};
+
+// X(id, ground key, TelemetryData member, bytes, kind, scale, period_ms, priority, deadband)
+//   Sent as round(value * scale), at most once per period_ms, when it moved by more than
+//   deadband (same unit as the value). Priority 0 goes first when the link budget is short.
+// Append only: the ground decoder has the same table (period, priority and deadband excepted)
+#define TELEMETRY_FIELDS(X) \
+    X(TLM_LATITUDE,         "latitude",         latitude,        4, TLM_INT,   1e7, 500,  0, 0.0000005) \
+    X(TLM_LONGITUDE,        "longitude",        longitude,       4, TLM_INT,   1e7, 500,  0, 0.0000005) \
+    X(TLM_COMPASS,          "compass",          compass,         2, TLM_ANGLE, 100, 200,  1, 0.5) \
+    X(TLM_WIND_VANE,        "wind_vane",        wind_vane,       2, TLM_ANGLE, 100, 1000, 2, 3.0) \
+    X(TLM_HORIZONTAL_TILT,  "horizontal_tilt",  horizontal_tilt, 2, TLM_INT,   100, 500,  2, 1.0) \
+    X(TLM_VERTICAL_TILT,    "vertical_tilt",    vertical_tilt,   2, TLM_INT,   100, 1000, 3, 1.0) \
+    X(TLM_TARGET_ANGLE,     "target_angle",     targetAngle,     2, TLM_INT,   1,   100,  0, 0) \
+    X(TLM_TARGET_TENSION,   "target_tension",   targetTension,   2, TLM_INT,   1,   100,  0, 0) \
+    X(TLM_ANGLE_FROM_NORTH, "angle_from_north", angleFromNorth,  2, TLM_INT,   1,   500,  1, 0)
+
+#define TELEMETRY_FIELD_ID(id, key, member, bytes, kind, scale, period_ms, priority, deadband) id,
+enum TelemetryField : uint8_t {
+    TELEMETRY_FIELDS(TELEMETRY_FIELD_ID)
+    TELEMETRY_FIELD_COUNT
+};
+#undef TELEMETRY_FIELD_ID
+
+static_assert(TELEMETRY_FIELD_COUNT <= 16, "the changed-field mask is 16 bits");
+
+// Longest text payload
+#define TELEMETRY_TEXT_SIZE 200
+
+// Encoded size of raw_length bytes: COBS overhead and delimiter
+#define TELEMETRY_ENCODED_SIZE(raw_length) ((raw_length) + (raw_length) / 254 + 2)
+
+// Largest encoded frame: header, payload and CRC
+#define TELEMETRY_FRAME_SIZE TELEMETRY_ENCODED_SIZE(3 + TELEMETRY_TEXT_SIZE + 2)
+
+extern const char* const telemetry_field_keys[TELEMETRY_FIELD_COUNT];
+extern const uint8_t telemetry_field_bytes[TELEMETRY_FIELD_COUNT];
+extern const uint8_t telemetry_field_kinds[TELEMETRY_FIELD_COUNT];
+extern const double telemetry_field_scales[TELEMETRY_FIELD_COUNT];
+
+/**
+ * @brief CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF)
+ */
+uint16_t telemetry_crc16(const uint8_t* data, size_t length);
+
+/**
+ * @brief COBS encoding of length bytes, without the delimiter
+ * @param out At least length + length / 254 + 1 bytes
+ * @return Encoded length
+ */
+size_t cobs_encode(const uint8_t* data, size_t length, uint8_t* out);
+
+/**
+ * @brief COBS decoding of one frame, without its delimiter
+ * @return Decoded length, 0 if the frame is not valid COBS
+ */
+size_t cobs_decode(const uint8_t* data, size_t length, uint8_t* out);
+
+/**
+ * @brief Fixed-point value of a field as sent
+ */
+int32_t telemetry_quantize(TelemetryField field, double value);
+
+/**
+ * @brief Fixed-point values of every field
+ */
+void telemetry_quantize_all(const TelemetryData& data, int32_t* values);
+
+/**
+ * @brief Encoded size of a state frame with the fields of mask
+ */
+size_t telemetry_state_size(uint16_t mask);
+
+/**
+ * @brief Builds the downlink frames (one task, numbers them)
+ */
+class TelemetryEncoder {
+    uint8_t sequence;
+
+    size_t finish(uint8_t* raw, size_t length, uint8_t* frame);
+
+public:
+    TelemetryEncoder() : sequence(0) {}
+
+    /**
+     * @brief State frame with the fields of mask
+     * @param values Quantized values of every field (telemetry_quantize_all)
+     * @param frame At least TELEMETRY_FRAME_SIZE bytes
+     * @return Bytes to send
+     */
+    size_t encode_state(const int32_t* values, uint16_t mask, uint8_t* frame);
+
+    /**
+     * @brief Text frame (cut at TELEMETRY_TEXT_SIZE characters)
+     * @param frame At least TELEMETRY_FRAME_SIZE bytes
+     * @return Bytes to send
+     */
+    size_t encode_text(const char* text, uint8_t* frame);
+};
+
+#endif // TELEMETRY_FRAME_H
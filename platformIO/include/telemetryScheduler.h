@@ -0,0 +1,104 @@
+#ifndef TELEMETRY_SCHEDULER_H
+#define TELEMETRY_SCHEDULER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "telemetryFrame.h"
+
+/**
+ * @brief Chooses the fields of each downlink state frame
+ *
+ * A field is due when it moved by more than its deadband, or was not sent
+ * for TELEMETRY_REFRESH_MS (a ground station that joins late or lost a
+ * frame catches up), and its own period has elapsed. Due fields are packed
+ * by priority, then oldest first, as long as the frame fits the byte
+ * budget; the others wait for the next call.
+ *
+ * The budget is a token bucket in bytes, refilled at budget() bytes/s and
+ * holding at most TELEMETRY_BURST_MS of it. The rate goes from
+ * TELEMETRY_BUDGET_MIN (no link) to TELEMETRY_BUDGET_MAX (best link) with
+ * set_link_quality(). Text frames are charged to the same bucket, but only
+ * from the bytes above a state frame of the priority-0 fields: text never
+ * delays them. A text frame that does not fit is refused and the caller
+ * keeps it for a later call (with the weakest link, one never fits).
+ */
+
+// Bytes per second with the weakest and the best link
+#ifndef TELEMETRY_BUDGET_MIN
+#define TELEMETRY_BUDGET_MIN 64
+#endif
+#ifndef TELEMETRY_BUDGET_MAX
+#define TELEMETRY_BUDGET_MAX 1024
+#endif
+// Bytes that can be saved up, in ms of budget
+#define TELEMETRY_BURST_MS 500
+// Every field is sent at least this often, even unchanged
+#define TELEMETRY_REFRESH_MS 5000
+#define TELEMETRY_MAX_PERIOD_MS 60000
+
+struct TelemetryFieldConfig {
+    uint16_t period_ms;     // Shortest time between two sends
+    uint8_t priority;       // 0 first
+    int32_t deadband;       // Quantized units
+};
+
+/**
+ * @brief Parses one "key,period_ms,priority,deadband" line, deadband in the unit of the value
+ * @return false if the key is unknown or a value is out of range
+ */
+bool parse_telemetry_config(const char* line, TelemetryField* field, TelemetryFieldConfig* config);
+
+class TelemetryScheduler {
+    TelemetryEncoder encoder;
+    TelemetryFieldConfig config[TELEMETRY_FIELD_COUNT];
+    int32_t last[TELEMETRY_FIELD_COUNT];
+    uint32_t last_sent_ms[TELEMETRY_FIELD_COUNT];
+    uint16_t never_sent;        // Mask of the fields not sent yet
+    float rate;                 // Bytes per second
+    float tokens;               // Bytes that can be sent now
+    uint32_t last_ms;
+    bool started;
+
+    float burst() const;
+    float reserve() const;
+    void refill(uint32_t now_ms);
+    void charge(size_t length);
+    bool due(int field, int32_t value, uint32_t now_ms) const;
+
+public:
+    TelemetryScheduler();
+
+    /**
+     * @brief Next state frame
+     * @param frame At least TELEMETRY_FRAME_SIZE bytes
+     * @return Bytes to send, 0 if no field is due or the budget is spent
+     */
+    size_t encode_state(const TelemetryData& data, uint32_t now_ms, uint8_t* frame);
+
+    /**
+     * @brief Text frame, charged to the budget left above the priority-0 reserve
+     * @param frame At least TELEMETRY_FRAME_SIZE bytes
+     * @return Bytes to send, 0 if the budget cannot take it now (nothing encoded)
+     */
+    size_t encode_text(const char* text, uint32_t now_ms, uint8_t* frame);
+
+    /**
+     * @brief Sets the budget from the link quality, 0 (no link) to 1 (best)
+     */
+    void set_link_quality(float quality);
+
+    /**
+     * @brief Current budget, bytes per second
+     */
+    uint16_t budget() const { return (uint16_t)rate; }
+
+    /**
+     * @brief Applies one "key,period_ms,priority,deadband" line (parse_telemetry_config)
+     */
+    bool configure(const char* line);
+
+    const TelemetryFieldConfig& field_config(TelemetryField field) const { return config[field]; }
+    void set_field_config(TelemetryField field, const TelemetryFieldConfig& settings) { config[field] = settings; }
+};
+
+#endif // TELEMETRY_SCHEDULER_H
@@ -0,0 +1,94 @@
+#ifndef TEXT_PARSE_H
+#define TEXT_PARSE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Parse a decimal number ("-1.3702", "+47.25", "1e-3", "12.")
+ *
+ * Replaces String::toDouble()/strtod() in the radio command parser:
+ * newlib's strtod allocates its big integers on the heap, this does not.
+ * Up to 18 significant digits are kept, which is exact for coordinates.
+ *
+ * @param text Start of the number, surrounding spaces allowed
+ * @param end Last character to read (exclusive), nullptr: up to the '\0'
+ * @param value Output, unchanged on failure
+ * @return false if the text is not a number
+ */
+inline bool parse_decimal(const char* text, const char* end, double* value) {
+    const char* p = text;
+    auto more = [&]() { return (end == nullptr ? *p != '\0' : p < end); };
+    while (more() && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+        p++;
+    }
+    bool negative = false;
+    if (more() && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any = false;
+    for (; more() && *p >= '0' && *p <= '9'; p++) {
+        any = true;
+        if (digits < 18) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            digits += mantissa != 0;
+        } else {
+            exponent++;
+        }
+    }
+    if (more() && *p == '.') {
+        p++;
+        for (; more() && *p >= '0' && *p <= '9'; p++) {
+            any = true;
+            if (digits < 18) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                digits += mantissa != 0;
+                exponent--;
+            }
+        }
+    }
+    if (!any) {
+        return false;
+    }
+    if (more() && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool exponent_negative = false;
+        if (more() && (*p == '-' || *p == '+')) {
+            exponent_negative = *p == '-';
+            p++;
+        }
+        if (!more() || *p < '0' || *p > '9') {
+            return false;
+        }
+        int e = 0;
+        for (; more() && *p >= '0' && *p <= '9'; p++) {
+            if (e < 1000) {
+                e = e * 10 + (*p - '0');
+            }
+        }
+        exponent += exponent_negative ? -e : e;
+    }
+    while (more() && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+        p++;
+    }
+    if (more()) {
+        return false;
+    }
+
+    // One multiplication or division by a power of ten (exact up to 1e22)
+    double result = (double)mantissa;
+    double scale = 1.0;
+    int magnitude = exponent < 0 ? -exponent : exponent;
+    for (int k = 0; k < magnitude && k < 400; k++) {
+        scale *= 10.0;
+    }
+    result = exponent < 0 ? result / scale : result * scale;
+    *value = negative ? -result : result;
+    return true;
+}
+
+#endif // TEXT_PARSE_H
@@ -0,0 +1,209 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include "traceEvents.h"
+
+/**
+ * @brief Binary trace: compile-time levels, lock-free ring buffer, drain task
+ *
+ * A trace point stores an event id, a microsecond timestamp and up to three
+ * 32-bit arguments in a ring buffer; the formatting happens on the host
+ * (host/trace_decode.py). A low-priority task drains the buffer to the
+ * serial port, so the tasks that trace never wait on USB.
+ *
+ * TRACE_LEVEL selects what is compiled in. A trace point above the level
+ * expands to ((void)0): its arguments are not evaluated and no code is
+ * emitted. The Pico defaults to TRACE_LEVEL_INFO; host builds (simulation,
+ * Monte Carlo runs, benchmarks) default to TRACE_LEVEL_OFF.
+ *
+ *   TRACE_INFO(EVT_PATH_DIRECTION, direction);
+ *   TRACE_DEBUG(EVT_PLANNER_TACK_CONTINUES, count, required);
+ */
+#define TRACE_LEVEL_OFF   0
+#define TRACE_LEVEL_ERROR 1
+#define TRACE_LEVEL_WARN  2
+#define TRACE_LEVEL_INFO  3
+#define TRACE_LEVEL_DEBUG 4
+
+#ifndef TRACE_LEVEL
+#ifdef ARDUINO
+#define TRACE_LEVEL TRACE_LEVEL_INFO
+#else
+#define TRACE_LEVEL TRACE_LEVEL_OFF
+#endif
+#endif
+
+// Ring buffer size in records (power of two)
+#ifndef TRACE_BUFFER_CAPACITY
+#define TRACE_BUFFER_CAPACITY 128
+#endif
+
+static constexpr int TRACE_MAX_ARGS = 3;
+
+/**
+ * @brief Event identifiers, in the order of TRACE_EVENT_TABLE
+ */
+#define TRACE_EVENT_ID(name, format) name,
+enum TraceEvent : uint16_t {
+    TRACE_EVENT_TABLE(TRACE_EVENT_ID)
+    TRACE_EVENT_COUNT
+};
+#undef TRACE_EVENT_ID
+
+/**
+ * @brief One trace record, 20 bytes
+ */
+struct TraceRecord {
+    uint32_t timestamp_us;              // micros() when the event was traced (wraps after 71 min)
+    uint16_t event;                     // TraceEvent
+    uint8_t level;                      // TRACE_LEVEL_ERROR .. TRACE_LEVEL_DEBUG
+    uint8_t arg_count;
+    uint32_t args[TRACE_MAX_ARGS];      // Integers as two's complement, floats as IEEE-754 bits
+};
+
+/**
+ * @brief Bounded multi-producer, single-consumer ring of trace records
+ *
+ * Each slot carries a sequence number (bounded MPMC queue of D. Vyukov,
+ * reduced to one consumer): a producer claims a slot with a compare-and-swap
+ * on the write index, copies the record and publishes it by advancing the
+ * slot sequence. Tasks on both cores can trace at the same time and never
+ * block; when the buffer is full the record is dropped and counted. On the
+ * RP2040 the Cortex-M0+ has no exclusive load/store, so the compiler's atomic
+ * helpers hold a hardware spinlock for a few cycles instead.
+ *
+ * pop() must only be called from one task (the drain task).
+ */
+class TraceBuffer {
+public:
+    static constexpr uint32_t CAPACITY = TRACE_BUFFER_CAPACITY;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "TRACE_BUFFER_CAPACITY must be a power of two");
+
+    TraceBuffer();
+
+    /**
+     * @brief Append a record, from any task or core
+     * @return false if the buffer is full (the record is dropped)
+     */
+    bool push(const TraceRecord& record);
+
+    /**
+     * @brief Take the oldest record (single consumer)
+     * @return false if the buffer is empty
+     */
+    bool pop(TraceRecord* record);
+
+    /**
+     * @brief Records dropped since the last call, and reset the count
+     */
+    uint32_t take_dropped();
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        TraceRecord record;
+    };
+
+    Slot slots[CAPACITY];
+    std::atomic<uint32_t> write_index;
+    uint32_t read_index;
+    std::atomic<uint32_t> dropped;
+};
+
+extern TraceBuffer traceBuffer;
+
+/**
+ * @brief Serial frame size: sync bytes, record, checksum
+ */
+static constexpr size_t TRACE_FRAME_SIZE = 2 + 20 + 1;
+
+/**
+ * @brief Encode a record as a serial frame
+ *
+ * 0xA5 0x5A, then the record little-endian (timestamp, event, level,
+ * arg_count, args), then the two's complement of the byte sum of the record
+ * so that the record plus checksum sums to zero. The decoder resynchronises
+ * on the sync bytes and passes any text between frames through.
+ *
+ * @param out TRACE_FRAME_SIZE bytes
+ */
+void trace_encode_frame(const TraceRecord& record, uint8_t* out);
+
+/**
+ * @brief Microsecond clock of the timestamps
+ */
+uint32_t trace_clock_us();
+
+/**
+ * @brief Degrees as int32 * 1e7 (u-blox convention), decoded by %D
+ */
+inline int32_t trace_degrees(double degrees) {
+    return (int32_t)(degrees * 1e7 + (degrees < 0.0 ? -0.5 : 0.5));
+}
+
+inline uint32_t trace_pack(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline uint32_t trace_pack(double value) {
+    return trace_pack((float)value);
+}
+
+inline uint32_t trace_pack(bool value) {
+    return value ? 1u : 0u;
+}
+
+template <typename V>
+inline uint32_t trace_pack(V value) {
+    return (uint32_t)value;
+}
+
+/**
+ * @brief Build a record and push it; use the TRACE_* macros instead
+ */
+template <typename... Args>
+inline void trace_emit(uint8_t level, TraceEvent event, Args... args) {
+    static_assert(sizeof...(Args) <= TRACE_MAX_ARGS, "too many trace arguments");
+    const uint32_t packed[TRACE_MAX_ARGS + 1] = {trace_pack(args)..., 0u};
+    TraceRecord record;
+    record.timestamp_us = trace_clock_us();
+    record.event = event;
+    record.level = level;
+    record.arg_count = sizeof...(Args);
+    for (int k = 0; k < TRACE_MAX_ARGS; k++) {
+        record.args[k] = packed[k];
+    }
+    traceBuffer.push(record);
+}
+
+#if TRACE_LEVEL >= TRACE_LEVEL_ERROR
+#define TRACE_ERROR(...) trace_emit(TRACE_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define TRACE_ERROR(...) ((void)0)
+#endif
+
+#if TRACE_LEVEL >= TRACE_LEVEL_WARN
+#define TRACE_WARN(...) trace_emit(TRACE_LEVEL_WARN, __VA_ARGS__)
+#else
+#define TRACE_WARN(...) ((void)0)
+#endif
+
+#if TRACE_LEVEL >= TRACE_LEVEL_INFO
+#define TRACE_INFO(...) trace_emit(TRACE_LEVEL_INFO, __VA_ARGS__)
+#else
+#define TRACE_INFO(...) ((void)0)
+#endif
+
+#if TRACE_LEVEL >= TRACE_LEVEL_DEBUG
+#define TRACE_DEBUG(...) trace_emit(TRACE_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define TRACE_DEBUG(...) ((void)0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,76 @@
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+/**
+ * @brief Trace event table: identifier and message format
+ *
+ * The identifier is the position in the table, so new events go at the end
+ * and existing lines are never reordered. host/trace_decode.py reads this
+ * file to turn the binary records back into text.
+ *
+ * Formats take at most TRACE_MAX_ARGS arguments:
+ *   %d, %u, %x     32-bit integers
+ *   %f, %.Nf       float
+ *   %D             int32 degrees * 1e7 (see trace_degrees), printed with 7 decimals
+ *   %{a|b|...}     unsigned index into the listed words
+ */
+#define TRACE_EVENT_TABLE(X) \
+    X(EVT_TRACE_DROPPED,                "trace: %u records dropped") \
+    X(EVT_PLANNER_FRAME_REBUILT,        "planner: leg frame rebuilt (%{great-circle|local})") \
+    X(EVT_PLANNER_LEG_RESET,            "planner: leg start conditions reset") \
+    X(EVT_PLANNER_COOLDOWN,             "planner: in decision cooldown, maintaining course") \
+    X(EVT_PLANNER_DIRECT_NEAR_WAYPOINT, "planner: switching from tacking to direct sailing near waypoint") \
+    X(EVT_PLANNER_DIRECT,               "planner: direct sailing to waypoint") \
+    X(EVT_PLANNER_UPWIND_LEG,           "planner: initializing new upwind leg") \
+    X(EVT_PLANNER_INITIAL_TACK,         "planner: initial tack %{starboard|port} from %{heading|mission lookahead}") \
+    X(EVT_PLANNER_BEGIN_PROTECTION,     "planner: beginning protection, traveled %.1f m, elapsed %.1f s") \
+    X(EVT_PLANNER_TACK_PROPOSED,        "planner: tack to %{starboard|port} proposed (conf %d/%d)") \
+    X(EVT_PLANNER_TACK_CONTINUES,       "planner: tack proposal continues (conf %d/%d)") \
+    X(EVT_PLANNER_TACK_CONFIRMED,       "planner: *** tack confirmed to %{starboard|port} ***") \
+    X(EVT_PLANNER_TACK_CANCELLED,       "planner: tack conditions no longer met, confirmation reset") \
+    X(EVT_PLANNER_WAYPOINT_REACHED,     "planner: waypoint %d reached (%.1f m)") \
+    X(EVT_PLANNER_MISSION_COMPLETE,     "planner: mission complete") \
+    X(EVT_PLANNER_RESET,                "planner: state completely reset") \
+    X(EVT_PATH_POLAR_LOADED,            "path: polar loaded from /polar.csv") \
+    X(EVT_PATH_POSITION,                "path: iteration %u, boat %D, %D") \
+    X(EVT_PATH_WAYPOINT,                "path: waypoint %D, %D") \
+    X(EVT_PATH_SENSORS,                 "path: compass %.1f, wind %.1f @ %.1f m/s") \
+    X(EVT_PATH_MISSION_LOADED,          "path: mission loaded, %d waypoints, %d expected tacks") \
+    X(EVT_PATH_DIRECTION,               "path: optimal direction %.1f") \
+    X(EVT_SENSOR_ATTITUDE,              "sensor: compass %.1f, pitch %d, roll %d") \
+    X(EVT_SENSOR_CALIBRATION,           "sensor: CMPS12 calibration state 0x%x") \
+    X(EVT_SERVO_RUDDER,                 "servo: rudder angle %d, safran %d us, sail %d us") \
+    X(EVT_GPS_RTK,                      "gps: fix type %u, carrier solution %u (%{no RTK|RTK float|RTK fixed})") \
+    X(EVT_GPS_POSITION,                 "gps: %D, %D, altitude %.2f m") \
+    X(EVT_GPS_NO_DATA,                  "gps: no GNSS data available") \
+    X(EVT_PIPELINE_LATENCY,             "pipeline: sensor to servo %u us (min %u, max %u)") \
+    X(EVT_CONTROL_PERIOD,               "control: period %u..%u us, max jitter %u us") \
+    X(EVT_CONTROL_LOAD,                 "control: mean jitter %u us, %u overruns, step %u us max") \
+    X(EVT_TASK_USAGE,                   "task %{blink|control|path|sensor|gps|xbee|trace|monitor|i2c0|i2c1}: cpu %.1f%%, %u stack words free") \
+    X(EVT_TASK_TIMING,                  "task %{blink|control|path|sensor|gps|xbee|trace|monitor|i2c0|i2c1}: %u loops, step %u us max") \
+    X(EVT_TASK_PERIOD,                  "task %{blink|control|path|sensor|gps|xbee|trace|monitor|i2c0|i2c1}: period %u..%u us") \
+    X(EVT_TASK_STACK_LOW,               "task %{blink|control|path|sensor|gps|xbee|trace|monitor|i2c0|i2c1}: only %u stack words free") \
+    X(EVT_HEAP_LOCKED,                  "heap: locked after init, %u bytes in use") \
+    X(EVT_HEAP_TRAP,                    "heap: %u bytes allocated after init from 0x%x") \
+    X(EVT_HEAP_GROWTH,                  "heap: %u bytes in use, %u more than at lock") \
+    X(EVT_TASK_RATES_LOADED,            "task: %u rates loaded from /tasks.cfg") \
+    X(EVT_TASK_CONFIG,                  "task %{blink|control|path|sensor|gps|xbee|trace|monitor|i2c0|i2c1}: period %u ms, priority %u") \
+    X(EVT_TASK_DEADLINE,                "task %{blink|control|path|sensor|gps|xbee|trace|monitor|i2c0|i2c1}: %u deadline misses, step %u us max") \
+    X(EVT_RTCM_DROPPED,                 "rtcm: frame type %u dropped (%{bad crc|filtered|bad header|tx ring full})") \
+    X(EVT_RTCM_STATS,                   "rtcm: %u B/s forwarded, %u frames, correction age %u ms") \
+    X(EVT_RTCM_ERRORS,                  "rtcm: %u bad crc, %u filtered, %u tx ring full") \
+    X(EVT_COMMAND_REJECTED,             "xbee: frame rejected at pair %u (%{ok|no ':'|unknown key|bad value|too many pairs|refused})") \
+    X(EVT_SENSOR_READ_FAILED,           "sensor: CMPS12 did not answer") \
+    X(EVT_I2C_FAILED,                   "i2c%u: transaction to 0x%x failed (%{ok|nack|timeout|queue full|not ready})") \
+    X(EVT_I2C_DEVICE,                   "i2c%u: device 0x%x %{absent|present}") \
+    X(EVT_GPS_NAV_RATE,                 "gps: navigation rate %u Hz") \
+    X(EVT_GPS_MOTION,                   "gps: SOG %.2f m/s, COG %.1f, accuracy %.2f m") \
+    X(EVT_GPS_TXREADY,                  "gps: ingestion %{polled|on TX-ready}") \
+    X(EVT_GPS_TXREADY_LOST,             "gps: %u fixes without TX-ready edge, back to polling") \
+    X(EVT_GPS_INGEST,                   "gps: %{polled|TX-ready}, %u polls (%u empty)") \
+    X(EVT_GPS_INGEST_BYTES,             "gps: %u fixes, %u bytes per fix, %u reads") \
+    X(EVT_GPS_WAKE_LATENCY,             "gps: TX-ready edge to fix %u us (min %u, max %u)") \
+    X(EVT_XBEE_FRAME_DROPPED,           "xbee: uplink frame dropped (%{too long|bad rtk hex})") \
+    X(EVT_GPS_NAV_RATE_FAILED,          "gps: navigation rate %u Hz not acknowledged, retrying")
+
+#endif // TRACE_EVENTS_H
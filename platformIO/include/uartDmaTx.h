@@ -0,0 +1,78 @@
+#ifndef UART_DMA_TX_H
+#define UART_DMA_TX_H
+
+#include <stdint.h>
+
+// Bytes queued for the UART, power of two
+// (2 KB: a whole RTCM frame, up to 1029 bytes, can be staged behind one being sent)
+#ifndef UART_DMA_TX_SIZE
+#define UART_DMA_TX_SIZE 2048
+#endif
+
+/**
+ * @brief Non-blocking UART transmitter: bytes are queued in a ring and sent by DMA
+ *
+ * SerialUART::write() waits for room in the 32-byte hardware FIFO, i.e.
+ * for the line to send the previous bytes. Here put() only stores the byte
+ * and poll() starts a DMA transfer of the pending bytes, paced by the UART
+ * TX DREQ, when the previous one is done. Both are called by the same task,
+ * and the UART must not be written through its Serial object meanwhile.
+ *
+ * Bytes can also be staged: they are stored in the ring but only sent once
+ * commit() is called, or forgotten by discard(). A frame can thus be
+ * written as it arrives and validated afterwards, without a copy.
+ */
+class UartDmaTx {
+    static_assert((UART_DMA_TX_SIZE & (UART_DMA_TX_SIZE - 1)) == 0, "UART_DMA_TX_SIZE must be a power of two");
+
+    uint8_t ring[UART_DMA_TX_SIZE];
+    uint32_t head;          // End of the committed bytes
+    uint32_t staged;        // Next byte to store, staged bytes are [head, staged)
+    uint32_t tail;          // First byte not sent yet
+    uint32_t in_flight;     // Bytes of the running transfer, from tail
+    uint32_t dropped;
+    int channel;            // DMA channel, -1 before begin()
+
+public:
+    UartDmaTx();
+
+    /**
+     * @brief Claim a DMA channel for the TX FIFO of UART uart_index (after Serial.begin())
+     * @return false if no channel is free; put() then only counts drops
+     */
+    bool begin(unsigned uart_index);
+
+    /**
+     * @brief Queue one byte
+     * @return false if the ring is full, the byte is dropped
+     */
+    bool put(uint8_t byte);
+
+    /**
+     * @brief Store one byte without sending it yet
+     * @return false if the ring is full, the byte is dropped
+     */
+    bool stage(uint8_t byte);
+
+    /**
+     * @brief Send the staged bytes
+     */
+    void commit() { head = staged; }
+
+    /**
+     * @brief Forget the staged bytes
+     */
+    void discard() { staged = head; }
+
+    /**
+     * @brief Start sending the queued bytes if the previous transfer is done
+     */
+    void poll();
+
+    /**
+     * @brief Bytes dropped because the ring was full
+     */
+    uint32_t dropped_bytes() const { return dropped; }
+};
+
+#endif // UART_DMA_TX_H
@@ -0,0 +1,102 @@
+#ifndef WIND_FIELD_H
+#define WIND_FIELD_H
+
+#include <stdint.h>
+
+/**
+ * @brief One grid node of the wind field, stored as a velocity vector
+ *
+ * Components are interpolated rather than direction/speed so that a wind
+ * veering through north does not average to a southerly.
+ */
+struct WindSample {
+    float u;    // Air velocity towards east (m/s)
+    float v;    // Air velocity towards north (m/s)
+};
+
+/**
+ * @brief Axes of a regular time x latitude x longitude wind grid
+ */
+struct WindGridSpec {
+    int time_count;                  // Number of forecast times
+    int lat_count;                   // Number of latitude rows
+    int lon_count;                   // Number of longitude columns
+    double time0_s;                  // Time of the first forecast (seconds, same clock as the router)
+    double time_step_s;              // Time between forecasts (seconds)
+    double lat0, lat_step;           // First row and spacing (degrees)
+    double lon0, lon_step;           // First column and spacing (degrees)
+};
+
+/**
+ * @brief Gridded wind forecast with trilinear interpolation
+ *
+ * The caller provides the sample storage, so the same class runs on the host
+ * with a large heap buffer and on the Pico with a small static one. Queries
+ * outside the grid are clamped to its border.
+ */
+class WindField {
+private:
+    WindSample* samples;             // time-major, then latitude, then longitude
+    int capacity;                    // Number of samples the storage can hold
+    WindGridSpec spec;
+    bool ready;
+
+    int index(int t, int i, int j) const { return (t * spec.lat_count + i) * spec.lon_count + j; }
+
+public:
+    /**
+     * @brief Constructor
+     * @param storage Sample buffer, must outlive the field
+     * @param storage_capacity Number of samples in the buffer
+     */
+    WindField(WindSample* storage, int storage_capacity);
+
+    /**
+     * @brief Define the grid axes
+     * @return false if the grid is empty or larger than the storage
+     */
+    bool set_grid(const WindGridSpec& grid_spec);
+
+    /**
+     * @brief Set one grid node
+     * @param direction_deg Direction the wind comes from (degrees)
+     * @param speed_ms Wind speed (m/s)
+     */
+    void set_sample(int t, int i, int j, float direction_deg, float speed_ms);
+
+    /**
+     * @brief Fill the whole grid with a constant wind (tests, fallback)
+     */
+    void fill(float direction_deg, float speed_ms);
+
+    /**
+     * @brief Load a grid from a text file
+     *
+     * Format ('#' starts a comment line):
+     *   time_count lat_count lon_count
+     *   time0_s time_step_s lat0 lat_step lon0 lon_step
+     *   direction_deg,speed_ms      (one line per node, time-major, then latitude, then longitude)
+     *
+     * On the Pico the path refers to the LittleFS partition, on the host to a
+     * regular file.
+     *
+     * @return true if the header and every node were read
+     */
+    bool load_from_file(const char* path);
+
+    /**
+     * @brief Interpolated wind at a time and position
+     * @param time_s Time (seconds)
+     * @param lat Latitude (degrees)
+     * @param lon Longitude (degrees)
+     * @param direction_deg Output direction the wind comes from (degrees, [0, 360))
+     * @param speed_ms Output wind speed (m/s)
+     * @return false if no grid is loaded
+     */
+    bool sample(double time_s, double lat, double lon, float* direction_deg, float* speed_ms) const;
+
+    bool is_ready() const { return ready; }
+    const WindGridSpec& grid() const { return spec; }
+};
+
+#endif // WIND_FIELD_H
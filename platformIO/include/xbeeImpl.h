@@ -3,6 +3,12 @@
 
 #include <Arduino.h>
 #include "shared_data.h"
+#include "taskMonitor.h"
+#include "radioFrame.h"
+#include "uartDmaTx.h"
+#include "rtcmParser.h"
+#include "telemetryScheduler.h"
+#include "commandRegistry.h"
 
 const int XBee_reset_pin = 21;
 const int XBee_rssi_pin = 27;
@@ -12,36 +18,70 @@ const int XBee_din_pin = 0;
 const int rtk_rx_pin = 9;
 const int rtk_tx_pin = 8;
 
+// Serial1 RX ring, filled by the UART interrupt: 100 ms of uplink at 115200 baud fits
+const int XBee_rx_buffer_size = 2048;
+// The RSSI PWM is measured by the PWM slice of XBee_rssi_pin, counting at clk_sys / this while the pin is high
+// (~520 kHz: the 16-bit counter holds 125 ms, more than the XbeeTask period)
+const float XBee_rssi_clkdiv = 255.0f;
+// Period of the RTCM throughput and correction age traces
+const uint32_t XBee_rtcm_report_ms = 5000;
+
 class xbeeImpl
 {
 private:
-    // PID Parameters
-    float Kp = 1.0;
-    float Ki = 1.0;
-    double lon = 0.0;
-    double lat = 0.0;
+    // Radio commands, published to sharedData.command (this task is its only writer)
+    CommandData command = {};
+    // Mission being uploaded, published to sharedData.mission on "mission_start:1"
+    MissionUpload missionDraft = {};
+
+    // Checks what parse_commands() cannot (mission room, telemetry settings), false to reject the frame
+    bool checkCommands(const Command* parsed, int count);
+    // Applies one checked command to next (published by getValue), true if it changed it
+    bool applyCommand(const Command& parsed, CommandData* next, uint32_t now);
+
+    // Uplink: frames are parsed as bytes arrive, each complete command is applied by getValue()
+    RadioFrameParser parser;
+    // RTK corrections to the ZED-F9P (Serial2): RTCM frames checked as they arrive, sent by DMA once valid
+    RtcmParser rtcm;
+    UartDmaTx rtkTx;
+    uint32_t lastCorrection_ms = 0;
+    bool correctionReceived = false;
+    uint32_t rtcmReport_ms = 0;
+    uint32_t rtcmReportBytes = 0;
 
-    // RTK Parameter
-    String rtk = "";
+    // Stage one RTCM byte in rtkTx, commit or discard the frame when it ends
+    void forwardRtcm(uint8_t byte);
+    void reportRtcm(uint32_t now);
 
-    // Message
-    String receivedMessage;
+    // Downlink: fields by rate, priority and deadband, within a budget set by the RSSI
+    TelemetryScheduler telemetry;
+
+    // RSSI measurement window
+    unsigned int rssiSlice = 0;
+    uint32_t rssiWindowStart_us = 0;
+
+    // Fraction of the window the RSSI PWM was high (0: no link), -1 if the window was too long
+    float readLinkQuality();
 
 public:
     xbeeImpl();
 
     // Initialize the XBee and RTK serial ports
     void initialize();
-    // Read from Serial1(xbee) and write to Serial2 (for RTK)
+    // Parse the bytes received on Serial1(xbee), forward RTK corrections to Serial2; never waits
     void read();
-    // Parse the last received message and extract key-value pairs
-    void getValue(String receivedMessage);
-    // Send shared data to Serial1(xbee) if values have changed
-    void send(const SharedData& data) const;
-
-    // Getters for PID Parameters
-    float getKp() const { return Kp; }
-    float getKi() const { return Ki; }
+    // Apply the "key:value[;key:value...]" pairs of one frame, all of them or none (parsed in place)
+    void getValue(char* receivedMessage);
+    // Send the telemetry fields that are due to Serial1(xbee), in one binary frame (see TelemetryScheduler)
+    void send(const TelemetryData& data);
+    // Apply a "tlm:key,period_ms,priority,deadband" command
+    bool configureTelemetry(const char* line) { return telemetry.configure(line); }
+    // Send one task usage record to Serial1(xbee) as a text frame (see format_task_usage),
+    // false if the telemetry budget cannot take it now (keep it for the next call)
+    bool sendTaskUsage(const TaskUsage& usage);
+
+    // Time since the last valid RTCM frame was forwarded, UINT32_MAX if none yet
+    uint32_t correctionAge_ms(uint32_t now) const { return correctionReceived ? now - lastCorrection_ms : UINT32_MAX; }
 };
 
 #endif // XBEE_IMPL_H
\ No newline at end of file
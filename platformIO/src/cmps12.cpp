@@ -1,34 +1,96 @@
 #include "cmps12.h"
 
-CMPS12::CMPS12(TwoWire &wire, uint8_t addr) : _wire(wire), _addr(addr) {}
+CMPS12::CMPS12(I2cBus &bus, uint8_t addr, uint8_t priority) : _bus(bus), _channel(priority), _addr(addr) {}
 
 void CMPS12::begin() {
-  _wire.begin();
+  if (!_channel.attached())
+    _bus.attach(_channel);
   delay(1000); // Stabilisation du bus
 }
 
 uint8_t CMPS12::read8BitRegister(uint8_t reg) {
-  _wire.beginTransmission(_addr);
-  _wire.write(reg);
-  _wire.endTransmission(false);
-  _wire.requestFrom(_addr, (uint8_t)1);
-  if (_wire.available() == 1)
-    return _wire.read();
-  else
+  uint8_t value;
+  if (_channel.read_registers(_addr, reg, &value, 1) != I2C_OK)
     return 0;
+  return value;
 }
 
 int16_t CMPS12::read16BitRegister(uint8_t reg) {
-  _wire.beginTransmission(_addr);
-  _wire.write(reg);
-  _wire.endTransmission(false);
-  _wire.requestFrom(_addr, (uint8_t)2);
-  if (_wire.available() >= 2) {
-    uint8_t highByte = _wire.read();
-    uint8_t lowByte  = _wire.read();
-    return (int16_t)((highByte << 8) | lowByte);
+  uint8_t bytes[2];
+  if (_channel.read_registers(_addr, reg, bytes, 2) != I2C_OK)
+    return 0;
+  return (int16_t)((bytes[0] << 8) | bytes[1]);
+}
+
+// Écriture d'une commande dans le registre 0x00
+bool CMPS12::sendCommand(uint8_t command) {
+  const uint8_t bytes[] = {0x00, command};
+  return _channel.write(_addr, bytes, sizeof(bytes)) == I2C_OK;
+}
+
+uint8_t CMPS12::burstLength(uint8_t blocks) {
+  uint8_t last = CMPS12_REG_ROLL;
+  if (blocks & CMPS12_MAGNETOMETER)  last = CMPS12_REG_MAGNETOMETER + 5;
+  if (blocks & CMPS12_ACCELEROMETER) last = CMPS12_REG_ACCELEROMETER + 5;
+  if (blocks & CMPS12_GYROSCOPE)     last = CMPS12_REG_GYROSCOPE + 5;
+  if (blocks & CMPS12_TEMPERATURE)   last = CMPS12_REG_TEMPERATURE + 1;
+  if (blocks & CMPS12_CALIBRATION)   last = CMPS12_REG_CALIBRATION;
+  return last - CMPS12_REG_BEARING + 1;
+}
+
+// 16 bits signés, poids fort d'abord, au registre reg
+static int16_t registerWord(const uint8_t *registers, uint8_t reg) {
+  const uint8_t *p = registers + (reg - CMPS12_REG_BEARING);
+  return (int16_t)((p[0] << 8) | p[1]);
+}
+
+static void registerVector(const uint8_t *registers, uint8_t reg, int16_t *out) {
+  for (int axis = 0; axis < 3; axis++)
+    out[axis] = registerWord(registers, reg + 2 * axis);
+}
+
+void CMPS12::decode(const uint8_t *registers, uint8_t length, CMPS12Orientation *out) {
+  // Registre de fin (exclu) de la rafale
+  uint8_t end = CMPS12_REG_BEARING + length;
+  out->bearing = (uint16_t)registerWord(registers, CMPS12_REG_BEARING);
+  out->pitch = (int8_t)registers[CMPS12_REG_PITCH - CMPS12_REG_BEARING];
+  out->roll = (int8_t)registers[CMPS12_REG_ROLL - CMPS12_REG_BEARING];
+  out->blocks = 0;
+  if (end >= CMPS12_REG_MAGNETOMETER + 6) {
+    registerVector(registers, CMPS12_REG_MAGNETOMETER, out->magnetometer);
+    out->blocks |= CMPS12_MAGNETOMETER;
+  }
+  if (end >= CMPS12_REG_ACCELEROMETER + 6) {
+    registerVector(registers, CMPS12_REG_ACCELEROMETER, out->accelerometer);
+    out->blocks |= CMPS12_ACCELEROMETER;
+  }
+  if (end >= CMPS12_REG_GYROSCOPE + 6) {
+    registerVector(registers, CMPS12_REG_GYROSCOPE, out->gyroscope);
+    out->blocks |= CMPS12_GYROSCOPE;
+  }
+  if (end >= CMPS12_REG_TEMPERATURE + 2) {
+    out->temperature = registerWord(registers, CMPS12_REG_TEMPERATURE);
+    out->blocks |= CMPS12_TEMPERATURE;
+  }
+  if (end >= CMPS12_REG_CALIBRATION + 1) {
+    out->calibration = registers[CMPS12_REG_CALIBRATION - CMPS12_REG_BEARING];
+    out->blocks |= CMPS12_CALIBRATION;
   }
-  return 0;
+}
+
+bool CMPS12::readOrientation(CMPS12Orientation *out, uint8_t blocks) {
+  uint8_t length = burstLength(blocks);
+  uint8_t registers[CMPS12_BURST_MAX];
+
+  // Une écriture du registre de départ, puis une lecture avec auto-incrément ;
+  // la tâche dort pendant le transfert DMA
+  if (_channel.read_registers(_addr, CMPS12_REG_BEARING, registers, length) != I2C_OK)
+    return false;
+  uint32_t sample_us = micros();
+
+  decode(registers, length, out);
+  out->sample_us = sample_us;
+  return true;
 }
 
 uint16_t CMPS12::readCompassBearing() {
@@ -48,23 +110,14 @@ uint8_t CMPS12::readCalibrationState() {
 }
 
 void CMPS12::startCalibration() {
-  _wire.beginTransmission(_addr);
-  _wire.write(0x00);
-  _wire.write(0xF0); // Active le mode calibration
-  uint8_t error = _wire.endTransmission();
-  if (error == 0)
+  if (sendCommand(0xF0)) // Active le mode calibration
     Serial.println("Calibration mode activated. Rotate the sensor.");
-  else {
-    Serial.print("Failed to activate calibration mode. Erreur I2C: ");
-    Serial.println(error);
-  }
+  else
+    Serial.println("Failed to activate calibration mode.");
 }
 
 void CMPS12::endCalibration() {
-  _wire.beginTransmission(_addr);
-  _wire.write(0x00);
-  _wire.write(0xF1); // Quitte le mode calibration
-  if (_wire.endTransmission() == 0) {
+  if (sendCommand(0xF1)) { // Quitte le mode calibration
     Serial.println("Calibration completed.");
     saveCalibration();
   } else
@@ -74,10 +127,7 @@ void CMPS12::endCalibration() {
 void CMPS12::saveCalibration() {
   const uint8_t commands[] = {0xF0, 0xF5, 0xF6};
   for (int i = 0; i < 3; i++) {
-    _wire.beginTransmission(_addr);
-    _wire.write(0x00);
-    _wire.write(commands[i]);
-    if (_wire.endTransmission() != 0) {
+    if (!sendCommand(commands[i])) {
       Serial.print("Failed to send command: 0x");
       Serial.println(commands[i], HEX);
       return;
@@ -0,0 +1,154 @@
+#include "commandRegistry.h"
+#include "textParse.h"
+
+#include <string.h>
+
+#define UPLINK_COMMAND_KEY(id, key, value) key,
+const char* const command_keys[CMD_COUNT] = {
+    UPLINK_COMMANDS(UPLINK_COMMAND_KEY)
+};
+#undef UPLINK_COMMAND_KEY
+
+#define UPLINK_COMMAND_VALUE(id, key, value) value,
+static const CommandValue command_values[CMD_COUNT] = {
+    UPLINK_COMMANDS(UPLINK_COMMAND_VALUE)
+};
+#undef UPLINK_COMMAND_VALUE
+
+// Slots of the hash table, power of two
+#define COMMAND_SLOTS 32
+static_assert(CMD_COUNT < COMMAND_SLOTS, "more commands than hash slots");
+
+// FNV-1a, starting from a seed
+static constexpr uint32_t command_hash(const char* key, size_t length, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)key[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static constexpr size_t key_length(const char* key) {
+    size_t length = 0;
+    while (key[length] != '\0') {
+        length++;
+    }
+    return length;
+}
+
+// Slot -> command, with the first seed that puts every key in its own slot
+struct CommandTable {
+    uint32_t seed;
+    uint8_t slot[COMMAND_SLOTS];
+
+    constexpr CommandTable() : seed(0), slot() {
+#define UPLINK_COMMAND_KEY(id, key, value) key,
+        const char* keys[CMD_COUNT] = { UPLINK_COMMANDS(UPLINK_COMMAND_KEY) };
+#undef UPLINK_COMMAND_KEY
+        for (;; seed++) {
+            for (int s = 0; s < COMMAND_SLOTS; s++) {
+                slot[s] = CMD_COUNT;
+            }
+            bool distinct = true;
+            for (int c = 0; c < CMD_COUNT && distinct; c++) {
+                uint32_t s = command_hash(keys[c], key_length(keys[c]), seed) & (COMMAND_SLOTS - 1);
+                distinct = slot[s] == CMD_COUNT;
+                slot[s] = (uint8_t)c;
+            }
+            if (distinct) {
+                return;
+            }
+        }
+    }
+};
+static constexpr CommandTable command_table;
+
+CommandId find_command(const char* key, size_t length) {
+    uint8_t c = command_table.slot[command_hash(key, length, command_table.seed) & (COMMAND_SLOTS - 1)];
+    if (c == CMD_COUNT || strncmp(command_keys[c], key, length) != 0 || command_keys[c][length] != '\0') {
+        return CMD_COUNT;
+    }
+    return (CommandId)c;
+}
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// One "key:value" pair in [pair, end), end is a NUL
+static CommandError parse_pair(char* pair, const char* end, Command* command) {
+    while (pair < end && is_space(*pair)) {
+        pair++;
+    }
+    char* separator = strchr(pair, ':');
+    const char* key_end = separator != NULL ? separator : end;
+    while (key_end > pair && is_space(key_end[-1])) {
+        key_end--;
+    }
+    command->id = find_command(pair, key_end - pair);
+    if (command->id == CMD_COUNT) {
+        return CMD_ERROR_UNKNOWN_KEY;
+    }
+    CommandValue type = command_values[command->id];
+    if (separator == NULL) {
+        return type == CMD_VALUE_NONE ? CMD_ERROR_NONE : CMD_ERROR_FORMAT;
+    }
+
+    const char* value = separator + 1;
+    command->text = value;
+    switch (type) {
+    case CMD_VALUE_NUMBER:
+        return parse_decimal(value, end, &command->value[0]) ? CMD_ERROR_NONE : CMD_ERROR_BAD_VALUE;
+    case CMD_VALUE_PAIR: {
+        const char* comma = strchr(value, ',');
+        if (comma == NULL || !parse_decimal(value, comma, &command->value[0]) ||
+            !parse_decimal(comma + 1, end, &command->value[1])) {
+            return CMD_ERROR_BAD_VALUE;
+        }
+        return CMD_ERROR_NONE;
+    }
+    default:
+        return CMD_ERROR_NONE;
+    }
+}
+
+int parse_commands(char* frame, Command* commands, CommandError* error, int* failed_pair) {
+    int count = 0;
+    char* pair = frame;
+    *error = CMD_ERROR_NONE;
+    *failed_pair = 0;
+    while (true) {
+        char* end = strchr(pair, COMMAND_SEPARATOR);
+        bool last = end == NULL;
+        if (last) {
+            end = pair + strlen(pair);
+        } else {
+            *end = '\0';
+        }
+
+        // Empty pairs ("a:1;;b:2", a trailing ';') are skipped
+        const char* p = pair;
+        while (p < end && is_space(*p)) {
+            p++;
+        }
+        if (p < end) {
+            if (count == COMMAND_MAX_PER_FRAME) {
+                *error = CMD_ERROR_TOO_MANY;
+            } else {
+                commands[count].value[0] = 0.0;
+                commands[count].value[1] = 0.0;
+                commands[count].text = "";
+                *error = parse_pair(pair, end, &commands[count]);
+            }
+            if (*error != CMD_ERROR_NONE) {
+                *failed_pair = count;
+                return -1;
+            }
+            count++;
+        }
+        if (last) {
+            return count;
+        }
+        pair = end + 1;
+    }
+}
@@ -1,32 +1,102 @@
 #include "gps.hpp"
 #include "shared_data.h"
+#include "trace.h"
+#include "task.h"
 
-TwoWire I2C1Instance(i2c1, 2, 3);
+I2cBus i2c1Bus(1, 2, 3);
 
-GNSS::GNSS() : myGNSS()
+// Front TX-ready : premier front depuis la dernière vidange (0 : aucun), horodaté par l'interruption
+// dans les deux modes, pour comparer leurs latences
+static volatile uint32_t frontTxReady_us = 0;
+// Tâche à réveiller par le front, en mode TX-ready seulement
+static void *volatile tacheReveillee = NULL;
+static volatile bool reveilActif = false;
+
+static void interruptionTxReady()
 {
+    if (frontTxReady_us == 0)
+    {
+        uint32_t maintenant = micros();
+        frontTxReady_us = maintenant != 0 ? maintenant : 1;
+    }
+    void *tache = tacheReveillee;
+    if (reveilActif && tache != NULL)
+    {
+        BaseType_t reveil = pdFALSE;
+        vTaskNotifyGiveFromISR((TaskHandle_t)tache, &reveil);
+        portYIELD_FROM_ISR(reveil);
+    }
+}
 
+// Registres du ZED-F9P : octets en attente (0xFD-0xFE, poids fort d'abord), puis le flux (0xFF)
+#define ZED_F9P_REG_AVAILABLE 0xFD
+
+void GnssI2cBus::begin(I2cBus &bus)
+{
+    if (!canal.attached())
+    {
+        bus.attach(canal);
+    }
 }
 
-GNSS::~GNSS()
+bool GnssI2cBus::envoyer(const uint8_t *data, uint16_t length)
 {
-    I2C1Instance.end();
-    Serial.println("GNSS instance destroyed.");
+    return canal.write(adresse, data, length) == I2C_OK;
+}
+
+bool GnssI2cBus::ping()
+{
+    return canal.probe(adresse);
 }
 
-void GNSS::scanI2C()
+uint16_t GnssI2cBus::available()
 {
-    Serial.println("Scanning I2C bus...");
-    for (uint8_t address = 1; address < 127; address++)
+    uint8_t octets[2];
+    if (canal.read_registers(adresse, ZED_F9P_REG_AVAILABLE, octets, 2) != I2C_OK)
     {
-        I2C1Instance.beginTransmission(address);
-        if (I2C1Instance.endTransmission() == 0)
-        {
-            Serial.print("Device found at address 0x");
-            Serial.println(address, HEX);
-        }
+        return 0;
+    }
+    uint16_t disponibles = (uint16_t)((octets[0] << 8) | octets[1]);
+    if (disponibles == 0xFFFF) // Pas encore prêt
+    {
+        disponibles = 0;
+    }
+    mesures.record_poll(disponibles);
+    return disponibles;
+}
+
+uint8_t GnssI2cBus::writeBytes(uint8_t *data, uint8_t length)
+{
+    return envoyer(data, length) ? length : 0;
+}
+
+uint8_t GnssI2cBus::readBytes(uint8_t *data, uint8_t length)
+{
+    if (canal.transfer(adresse, NULL, 0, data, length) != I2C_OK)
+    {
+        return 0;
     }
-    Serial.println("I2C scan complete.");
+    mesures.record_read(length);
+    octets += length;
+    return length;
+}
+
+GNSS::GNSS() : bus(ZED_F9P_I2C_ADDRESS, mesures), myGNSS()
+{
+
+}
+
+GNSS::~GNSS()
+{
+    Serial.println("GNSS instance destroyed.");
+}
+
+bool GNSS::detecterModule()
+{
+    // Une seule adresse sondée : le ZED-F9P est le seul module de ce bus
+    bool present = bus.ping();
+    TRACE_INFO(EVT_I2C_DEVICE, i2c1Bus.bus_index(), ZED_F9P_I2C_ADDRESS, present);
+    return present;
 }
 
 void GNSS::activeUBX_RTK()
@@ -41,10 +111,7 @@ void GNSS::activeUBX_RTK()
         0x23, 0x71              // Checksum
     };
 
-    I2C1Instance.beginTransmission(ZED_F9P_I2C_ADDRESS);
-    for (size_t i = 0; i < sizeof(enableUBX_I2C); i++)
-        I2C1Instance.write(enableUBX_I2C[i]);
-    I2C1Instance.endTransmission();
+    bus.envoyer(enableUBX_I2C, sizeof(enableUBX_I2C));
 
     delay(500);
 
@@ -57,64 +124,205 @@ void GNSS::activeUBX_RTK()
         0x3F, 0x4C              // Checksum
     };
 
-    I2C1Instance.beginTransmission(ZED_F9P_I2C_ADDRESS);
-    for (size_t i = 0; i < sizeof(enable_RXM_RTCM_on_I2C); i++)
-        I2C1Instance.write(enable_RXM_RTCM_on_I2C[i]);
-    I2C1Instance.endTransmission();
+    bus.envoyer(enable_RXM_RTCM_on_I2C, sizeof(enable_RXM_RTCM_on_I2C));
 
     Serial.println("Sortie UBX activée et UBX-RXM-RTCM activé sur I2C.");
 }
 
-void GNSS::lireFluxGPS()
+// Instance servie par les callbacks de la bibliothèque (pointeurs de fonction sans contexte)
+static GNSS *gnssActif = NULL;
+
+static void recevoirPVT(UBX_NAV_PVT_data_t *pvt)
 {
-    if (myGNSS.getPVT())
+    if (gnssActif != NULL)
     {
-        if (myGNSS.getRELPOSNED()) // Si on reçois des corrections RTK
-        {
-            uint8_t fixType = myGNSS.packetUBXNAVPVT->data.fixType;
-            uint8_t carrSoln = myGNSS.packetUBXNAVRELPOSNED->data.flags.bits.carrSoln;
+        gnssActif->publierPVT(*pvt);
+    }
+}
 
-            Serial.print("FixType: ");
-            Serial.print(fixType);
-            Serial.print(" | Carrier Solution: ");
-            Serial.print(carrSoln);
-            Serial.print(" -> ");
+static void recevoirRELPOSNED(UBX_NAV_RELPOSNED_data_t *relposned)
+{
+    if (gnssActif != NULL)
+    {
+        gnssActif->suivreRELPOSNED(*relposned);
+    }
+}
 
-            if (fixType == 5 && carrSoln == 2)
-            {
-                Serial.println("RTK Fixed");
-            }
-            else if (fixType >= 4 && carrSoln == 1)
-            {
-                Serial.println("RTK Float");
-            }
-            else
+bool GNSS::configurerCadence(uint8_t hz)
+{
+    if (hz < 1)
+    {
+        hz = 1;
+    }
+    if (hz > GNSS_NAV_RATE_MAX_HZ)
+    {
+        hz = GNSS_NAV_RATE_MAX_HZ;
+    }
+    if (!myGNSS.setNavigationFrequency(hz))
+    {
+        return false;
+    }
+    // setNavigationFrequency recalcule l'attente entre deux interrogations (un quart de période) :
+    // c'est la tâche GPS qui cadence les lectures, la bibliothèque ne doit pas en sauter
+    myGNSS.setI2CpollingWait(0);
+    cadence_hz = hz;
+    TRACE_INFO(EVT_GPS_NAV_RATE, hz);
+    return true;
+}
+
+bool GNSS::configurerTxReady()
+{
+    if (ZED_F9P_TXREADY_GPIO < 0)
+    {
+        return false;
+    }
+    // Sortie TX-ready du port I2C, active haut (configuration en RAM, refaite à chaque démarrage)
+    bool configure = myGNSS.setVal8(UBLOX_CFG_TXREADY_PIN, ZED_F9P_TXREADY_PIO, VAL_LAYER_RAM)
+        && myGNSS.setVal8(UBLOX_CFG_TXREADY_POLARITY, 0, VAL_LAYER_RAM)
+        && myGNSS.setVal16(UBLOX_CFG_TXREADY_THRESHOLD, ZED_F9P_TXREADY_THRESHOLD, VAL_LAYER_RAM)
+        && myGNSS.setVal8(UBLOX_CFG_TXREADY_INTERFACE, 0, VAL_LAYER_RAM) // 0 : I2C
+        && myGNSS.setVal8(UBLOX_CFG_TXREADY_ENABLED, 1, VAL_LAYER_RAM);
+    if (!configure)
+    {
+        return false;
+    }
+    pinMode(ZED_F9P_TXREADY_GPIO, INPUT_PULLDOWN);
+    attachInterrupt(digitalPinToInterrupt(ZED_F9P_TXREADY_GPIO), interruptionTxReady, RISING);
+    return true;
+}
+
+void GNSS::utiliserTxReady(bool actif)
+{
+    txReady = actif && ZED_F9P_TXREADY_GPIO >= 0;
+    reveilActif = txReady;
+    frontsManques = 0;
+    TRACE_INFO(EVT_GPS_TXREADY, txReady);
+}
+
+void GNSS::demarrerIngestion(void *tache)
+{
+    tacheReveillee = tache;
+}
+
+void GNSS::attendreDonnees(uint32_t periode_ms)
+{
+    if (!txReady)
+    {
+        reveilParBroche = false;
+        vTaskDelay(pdMS_TO_TICKS(periode_ms));
+        return;
+    }
+    // Les fronts arrivés pendant la vidange précédente sont comptés : pas de front perdu
+    reveilParBroche = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(GNSS_TXREADY_TIMEOUT_MS)) != 0;
+}
+
+bool GNSS::lireFluxGPS()
+{
+    nouvelleSolution = false;
+    uint32_t octetsAvant = bus.octetsLus();
+    // Front qui annonce les données de cette vidange ; un front pendant la lecture annonce les suivantes
+    frontVidange_us = frontTxReady_us;
+    frontTxReady_us = 0;
+    // Un available() puis le nombre exact d'octets en attente, en une transaction
+    // (setI2CTransactionSize dans gpsInit)
+    myGNSS.checkUblox();
+    myGNSS.checkCallbacks();    // Un appel de publierPVT / suivreRELPOSNED par message reçu
+
+    if (txReady)
+    {
+        if (reveilParBroche)
+        {
+            frontsManques = 0;
+            // Des octets sont arrivés pendant la lecture (fin de l'époque) : la broche reste haute
+            // sans nouveau front, on revient tout de suite. Sans progrès, on attend le front suivant
+            if (digitalRead(ZED_F9P_TXREADY_GPIO) == HIGH && bus.octetsLus() != octetsAvant)
             {
-                Serial.println("Pas de RTK");
+                xTaskNotifyGive(xTaskGetCurrentTaskHandle());
             }
         }
+        else if (nouvelleSolution && ++frontsManques >= GNSS_TXREADY_MISSED_MAX)
+        {
+            // Des solutions sans front : la broche n'est pas câblée ou pas configurée
+            TRACE_WARN(EVT_GPS_TXREADY_LOST, frontsManques);
+            utiliserTxReady(false);
+        }
+    }
 
-        double latitude = myGNSS.getLatitude() / 1e7;  // Latitude ...
-        double longitude = myGNSS.getLongitude() / 1e7; // ... et longitude en degrés.
-        double altitude = myGNSS.getAltitude() / 1e3;  // Altitude en mètres
+    uint32_t maintenant = millis();
+    if (nouvelleSolution)
+    {
+        derniereSolution_ms = maintenant;
+        sansDonnees = false;
+    }
+    else if (!sansDonnees && maintenant - derniereSolution_ms > GNSS_NO_DATA_MS) // Un seul avertissement par coupure
+    {
+        TRACE_WARN(EVT_GPS_NO_DATA);
+        sansDonnees = true;
+    }
+    return nouvelleSolution;
+}
 
-        Serial.print("Latitude : ");
-        Serial.print(latitude, 7);
-        sharedData.latitude = latitude; // Stocker la latitude dans sharedData
-        Serial.print(", Longitude : ");
-        Serial.print(longitude, 7);
-        sharedData.longitude = longitude;
-        Serial.print(", Altitude : ");
-        Serial.print(altitude, 2);
-        sharedData.altitude = altitude;
+void GNSS::publierPVT(const UBX_NAV_PVT_data_t &pvt)
+{
+    uint32_t sample_us = trace_clock_us();
 
-        Serial.println(" m");
+    // Le module peut répéter sa dernière solution : on ne publie que les nouvelles, avec un fix valide
+    if (pvt.iTOW == dernierTimeOfWeek || !pvt.flags.bits.gnssFixOK)
+    {
+        return;
     }
-    else
+    dernierTimeOfWeek = pvt.iTOW;
+    dernierFixType = pvt.fixType;
+    mesures.record_fix(frontVidange_us, micros());
+
+    GnssData fix = {};
+    fix.latitude = pvt.lat / 1e7;           // Latitude ...
+    fix.longitude = pvt.lon / 1e7;          // ... et longitude en degrés.
+    fix.altitude = pvt.height / 1e3;        // Altitude en mètres
+    fix.sample_us = sample_us;
+    fix.time_of_week_ms = pvt.iTOW;
+    fix.ground_speed = pvt.gSpeed / 1e3f;   // mm/s
+    fix.ground_course = pvt.headMot / 1e5f; // 1e-5 degré
+    fix.horizontal_accuracy = pvt.hAcc / 1e3f; // mm
+    fix.fix_type = pvt.fixType;
+    fix.carrier_solution = pvt.flags.bits.carrSoln;
+    sharedData.gnss.write(fix, millis()); // Publier la position dans sharedData
+    nouvelleSolution = true;
+
+    TRACE_INFO(EVT_GPS_POSITION, trace_degrees(fix.latitude), trace_degrees(fix.longitude), fix.altitude);
+    TRACE_DEBUG(EVT_GPS_MOTION, fix.ground_speed, fix.ground_course, fix.horizontal_accuracy);
+}
+
+void GNSS::rapporterMesures()
+{
+    GnssIngestReport rapport = mesures.take();
+    TRACE_INFO(EVT_GPS_INGEST, txReady, rapport.polls, rapport.empty_polls);
+    TRACE_INFO(EVT_GPS_INGEST_BYTES, rapport.fixes, rapport.bytes_per_fix, rapport.reads);
+    if (rapport.latency.count != 0)
     {
-       Serial.println("Pas de données GNSS disponibles.");
+        TRACE_INFO(EVT_GPS_WAKE_LATENCY, rapport.latency.mean_us, rapport.latency.min_us, rapport.latency.max_us);
+    }
+}
+
+void GNSS::suivreRELPOSNED(const UBX_NAV_RELPOSNED_data_t &relposned)
+{
+    uint8_t carrSoln = relposned.flags.bits.carrSoln;
+
+    uint8_t rtk = 0;                                    // Pas de RTK
+    if (dernierFixType == 5 && carrSoln == 2)
+    {
+        rtk = 2;                                        // RTK Fixed
+    }
+    else if (dernierFixType >= 4 && carrSoln == 1)
+    {
+        rtk = 1;                                        // RTK Float
+    }
+    // Tracé aux changements seulement : à 10 Hz, une trace par solution saturerait la console
+    if (rtk != dernierRtk)
+    {
+        TRACE_INFO(EVT_GPS_RTK, dernierFixType, carrSoln, rtk);
+        dernierRtk = rtk;
     }
-    delay(1000);
 }
 
 void GNSS::configurerUART_RX2()
@@ -135,19 +343,20 @@ void GNSS::configurerUART_RX2()
         0x00, 0x00              // reserved
     };
 
-    // Calcul du checksum
+    // Calcul du checksum, envoyé dans la même transaction que le message
+    uint8_t message[sizeof(cfg_prt_uart2) + 2];
     uint8_t ckA = 0, ckB = 0;
-    for (size_t i = 2; i < sizeof(cfg_prt_uart2); i++) {
-        ckA += cfg_prt_uart2[i];
-        ckB += ckA;
+    for (size_t i = 0; i < sizeof(cfg_prt_uart2); i++) {
+        message[i] = cfg_prt_uart2[i];
+        if (i >= 2) {
+            ckA += cfg_prt_uart2[i];
+            ckB += ckA;
+        }
     }
+    message[sizeof(cfg_prt_uart2)] = ckA;
+    message[sizeof(cfg_prt_uart2) + 1] = ckB;
 
-    I2C1Instance.beginTransmission(ZED_F9P_I2C_ADDRESS);
-    for (size_t i = 0; i < sizeof(cfg_prt_uart2); i++)
-        I2C1Instance.write(cfg_prt_uart2[i]);
-    I2C1Instance.write(ckA);
-    I2C1Instance.write(ckB);
-    I2C1Instance.endTransmission();
+    bus.envoyer(message, sizeof(message));
 
     Serial.println("Configuration de RX2 pour réception RTCM terminée.");
 }
@@ -156,9 +365,13 @@ void GNSS::gpsInit()
 {
     delay(2000);
 
-    I2C1Instance.begin();
+    // Bus du ZED-F9P piloté par DMA ; avant le démarrage de sa tâche propriétaire,
+    // les transactions s'exécutent dans la tâche appelante
+    i2c1Bus.begin();
+    bus.begin(i2c1Bus);
 
-    if (!myGNSS.begin(I2C1Instance, ZED_F9P_I2C_ADDRESS))
+    detecterModule();
+    if (!myGNSS.begin(bus))
     {
         Serial.println("Erreur : Impossible de communiquer avec le ZED-F9P !");
         // while (1); // Bloquer si échec
@@ -168,8 +381,24 @@ void GNSS::gpsInit()
     delay(1000);
 
 
-    scanI2C(); // A garder pour debug, si rien ne marche, peut être utile ...
     activeUBX_RTK();
 
+    // Solutions poussées par le module à chaque époque (auto-PVT/RELPOSNED) et livrées par callback :
+    // plus de requête getPVT. La bibliothèque alloue ses paquets ici, avant la fermeture du tas
+    // (STATIC_ALLOCATION)
+    gnssActif = this;
+    myGNSS.setAutoPVTcallbackPtr(&recevoirPVT);
+    myGNSS.setAutoRELPOSNEDcallbackPtr(&recevoirRELPOSNED);
+    if (!configurerCadence(GNSS_NAV_RATE_HZ))
+    {
+        Serial.println("Erreur : cadence de navigation non appliquée !");
+    }
+
+    // Une époque (NAV-PVT + NAV-RELPOSNED, ~180 octets) lue en une seule transaction
+    // au lieu de paquets de 32 octets (limite de Wire)
+    myGNSS.setI2CTransactionSize(255);
+    // Réveil par la broche TX-ready quand elle est câblée, sinon interrogation
+    utiliserTxReady(configurerTxReady());
+
     configurerUART_RX2();
 }
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include "i2cBus.h"
+#include "trace.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include "task.h"
+#include <hardware/dma.h>
+#include <hardware/gpio.h>
+#include <hardware/i2c.h>
+#include <hardware/irq.h>
+
+// Bus of each controller, for the interrupt handlers
+static I2cBus* interruptBus[2];
+
+static void i2c0_interrupt() {
+    interruptBus[0]->on_interrupt();
+}
+
+static void i2c1_interrupt() {
+    interruptBus[1]->on_interrupt();
+}
+#endif
+
+size_t i2c_build_commands(const I2cRequest& request, uint16_t* commands) {
+    size_t total = (size_t)request.write_length + request.read_length;
+    if (total == 0 || total > I2C_TRANSFER_MAX) {
+        return 0;
+    }
+    size_t length = 0;
+    for (uint16_t i = 0; i < request.write_length; i++) {
+        commands[length++] = request.write[i];
+    }
+    for (uint16_t i = 0; i < request.read_length; i++) {
+        uint16_t command = I2C_CMD_READ;
+        // Repeated start between the register write and the read
+        if (i == 0 && request.write_length > 0) {
+            command |= I2C_CMD_RESTART;
+        }
+        commands[length++] = command;
+    }
+    commands[length - 1] |= I2C_CMD_STOP;
+    return length;
+}
+
+I2cChannel::I2cChannel(uint8_t priority) : bus(NULL), priority(priority), last_status(I2C_OK) {
+#ifdef ARDUINO
+    done = NULL;
+#endif
+}
+
+I2cStatus I2cChannel::submit(const I2cRequest& request) {
+    if (bus == NULL) {
+        return I2C_NOT_READY;
+    }
+    if (!queue.push(request)) {
+        return I2C_QUEUE_FULL;
+    }
+    bus->wake();
+    return I2C_OK;
+}
+
+void I2cChannel::on_transfer_done(I2cStatus status, void* context) {
+    I2cChannel* channel = (I2cChannel*)context;
+    channel->last_status.store(status, std::memory_order_release);
+#ifdef ARDUINO
+    xSemaphoreGive(channel->done);
+#endif
+}
+
+I2cStatus I2cChannel::transfer(uint8_t address, const uint8_t* write, uint16_t write_length,
+                               uint8_t* read, uint16_t read_length) {
+    if (bus == NULL) {
+        return I2C_NOT_READY;
+    }
+    I2cRequest request = {address, write_length, read_length, write, read, NULL, NULL, NULL};
+    // No owner yet (setup): the caller drives the bus itself
+    if (!bus->has_owner()) {
+        return bus->execute(request);
+    }
+    request.callback = on_transfer_done;
+    request.context = this;
+    I2cStatus status = submit(request);
+    if (status != I2C_OK) {
+        return status;
+    }
+#ifdef ARDUINO
+    // Bounded: the owner aborts every transaction after I2C_TIMEOUT_MS
+    xSemaphoreTake(done, portMAX_DELAY);
+#endif
+    return (I2cStatus)last_status.load(std::memory_order_acquire);
+}
+
+bool I2cChannel::probe(uint8_t address) {
+    uint8_t byte;
+    return transfer(address, NULL, 0, &byte, 1) == I2C_OK;
+}
+
+I2cBus::I2cBus(uint8_t index, uint8_t sda_pin, uint8_t scl_pin)
+    : index(index), sda_pin(sda_pin), scl_pin(scl_pin), channel_count(0), owner(NULL), finished(false),
+      abort_source(0), waiting(NULL), tx_channel(-1), rx_channel(-1), counters() {
+    for (int c = 0; c < I2C_BUS_CHANNELS; c++) {
+        channels[c] = NULL;
+    }
+}
+
+bool I2cBus::begin(uint32_t baudrate) {
+#ifdef ARDUINO
+    i2c_inst_t* i2c = i2c_get_instance(index);
+    i2c_init(i2c, baudrate);
+    gpio_set_function(sda_pin, GPIO_FUNC_I2C);
+    gpio_set_function(scl_pin, GPIO_FUNC_I2C);
+    gpio_pull_up(sda_pin);
+    gpio_pull_up(scl_pin);
+
+    tx_channel = dma_claim_unused_channel(false);
+    rx_channel = dma_claim_unused_channel(false);
+    if (tx_channel < 0 || rx_channel < 0) {
+        return false;
+    }
+    i2c_hw_t* hw = i2c_get_hw(i2c);
+
+    // Command words to IC_DATA_CMD, paced by the TX FIFO
+    dma_channel_config config = dma_channel_get_default_config(tx_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, i2c_get_dreq(i2c, true));
+    dma_channel_configure(tx_channel, &config, &hw->data_cmd, commands, 0, false);
+
+    // Received bytes from IC_DATA_CMD, paced by the RX FIFO
+    config = dma_channel_get_default_config(rx_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_dreq(&config, i2c_get_dreq(i2c, false));
+    dma_channel_configure(rx_channel, &config, NULL, &hw->data_cmd, 0, false);
+
+    // End of a transaction: stop condition, or abort (followed by a stop)
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+    interruptBus[index] = this;
+    unsigned irq = index == 0 ? I2C0_IRQ : I2C1_IRQ;
+    irq_set_exclusive_handler(irq, index == 0 ? i2c0_interrupt : i2c1_interrupt);
+    irq_set_enabled(irq, true);
+    return true;
+#else
+    (void)baudrate;
+    return false;
+#endif
+}
+
+bool I2cBus::attach(I2cChannel& channel) {
+    uint8_t count = channel_count.load(std::memory_order_relaxed);
+    if (count == I2C_BUS_CHANNELS) {
+        return false;
+    }
+#ifdef ARDUINO
+    channel.done = xSemaphoreCreateBinaryStatic(&channel.done_buffer);
+#endif
+    channel.bus = this;
+    channels[count] = &channel;
+    // The owner only scans the channels below the published count
+    channel_count.store(count + 1, std::memory_order_release);
+    return true;
+}
+
+void I2cBus::bind_owner(void* task) {
+    owner.store(task, std::memory_order_release);
+}
+
+void I2cBus::wake() {
+#ifdef ARDUINO
+    void* task = owner.load(std::memory_order_acquire);
+    if (task != NULL) {
+        xTaskNotifyGive((TaskHandle_t)task);
+    }
+#endif
+}
+
+bool I2cBus::next(I2cRequest* request) {
+    uint8_t count = channel_count.load(std::memory_order_acquire);
+    I2cChannel* best = NULL;
+    for (uint8_t c = 0; c < count; c++) {
+        I2cChannel* channel = channels[c];
+        if (channel->queue.size() != 0 && (best == NULL || channel->priority < best->priority)) {
+            best = channel;
+        }
+    }
+    return best != NULL && best->queue.pop(request);
+}
+
+I2cStatus I2cBus::execute(const I2cRequest& request) {
+    size_t length = i2c_build_commands(request, commands);
+    if (tx_channel < 0 || length == 0) {
+        return I2C_NOT_READY;
+    }
+#ifdef ARDUINO
+    i2c_hw_t* hw = i2c_get_hw(i2c_get_instance(index));
+    hw->enable = 0;
+    hw->tar = request.address;
+    hw->enable = 1;
+    // A stop or abort left over from the previous transaction would end this one at once
+    (void)hw->clr_intr;
+
+    finished.store(false, std::memory_order_relaxed);
+    abort_source = 0;
+    waiting = xTaskGetCurrentTaskHandle();
+    uint32_t start_us = micros();
+    if (request.read_length > 0) {
+        dma_channel_transfer_to_buffer_now(rx_channel, request.read, request.read_length);
+    }
+    dma_channel_transfer_from_buffer_now(tx_channel, commands, length);
+
+    // Sleep until the interrupt; other notifications (submissions) only re-check
+    uint32_t start_ms = millis();
+    while (!finished.load(std::memory_order_acquire)) {
+        uint32_t waited = millis() - start_ms;
+        if (waited >= I2C_TIMEOUT_MS) {
+            break;
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(I2C_TIMEOUT_MS - waited));
+    }
+
+    I2cStatus status = I2C_OK;
+    if (!finished.load(std::memory_order_acquire)) {
+        // Bus stuck (clock stretched, no pull-ups...)
+        status = I2C_TIMEOUT;
+    } else if (abort_source != 0) {
+        status = I2C_NACK;
+        counters.nacks++;
+    } else if (request.read_length > 0) {
+        // The stop follows the last byte into the RX FIFO, its DMA read is a few cycles behind;
+        // let the other tasks of this core run meanwhile
+        while (dma_channel_is_busy(rx_channel)) {
+            if (micros() - start_us >= I2C_TIMEOUT_MS * 1000UL) {
+                // The buffer is only partly filled: not a good read
+                status = I2C_TIMEOUT;
+                break;
+            }
+            taskYIELD();
+        }
+    }
+    if (status == I2C_TIMEOUT) {
+        // Abort and let the controller send a stop
+        dma_channel_abort(tx_channel);
+        hw->enable |= I2C_IC_ENABLE_ABORT_BITS;
+        while (hw->enable & I2C_IC_ENABLE_ABORT_BITS) {
+            tight_loop_contents();
+        }
+        counters.timeouts++;
+    }
+    if (status != I2C_OK) {
+        dma_channel_abort(tx_channel);
+        dma_channel_abort(rx_channel);
+        while (hw->rxflr != 0) {
+            (void)hw->data_cmd;
+        }
+        (void)hw->clr_intr;
+    }
+    counters.transactions++;
+    counters.bytes += length;
+    counters.busy_us += micros() - start_us;
+    return status;
+#else
+    return I2C_NOT_READY;
+#endif
+}
+
+void I2cBus::complete(const I2cRequest& request, I2cStatus status) {
+    if (status != I2C_OK) {
+        TRACE_WARN(EVT_I2C_FAILED, index, request.address, status);
+    }
+    if (request.callback != NULL) {
+        request.callback(status, request.context);
+    }
+#ifdef ARDUINO
+    if (request.notify != NULL) {
+        xTaskNotifyGive((TaskHandle_t)request.notify);
+    }
+#endif
+}
+
+int I2cBus::service() {
+    int served = 0;
+    I2cRequest request;
+    while (next(&request)) {
+        complete(request, execute(request));
+        served++;
+    }
+    return served;
+}
+
+void I2cBus::on_interrupt() {
+#ifdef ARDUINO
+    i2c_hw_t* hw = i2c_get_hw(i2c_get_instance(index));
+    uint32_t status = hw->intr_stat;
+    if (status & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        // Stop the command words first: once the abort is cleared the FIFO accepts them again
+        dma_channel_abort(tx_channel);
+        abort_source = hw->tx_abrt_source;
+        (void)hw->clr_tx_abrt;
+    }
+    if (status & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+        (void)hw->clr_stop_det;
+    }
+    finished.store(true, std::memory_order_release);
+    BaseType_t woken = pdFALSE;
+    if (waiting != NULL) {
+        vTaskNotifyGiveFromISR((TaskHandle_t)waiting, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+#endif
+}
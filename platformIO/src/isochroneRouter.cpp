@@ -0,0 +1,387 @@
+#include "isochroneRouter.h"
+#include "scalarMath.h"
+
+#ifndef ARDUINO
+#include <thread>
+#include <vector>
+#endif
+
+typedef ScalarMath<float> MF;
+
+/**
+ * @brief Constructor - Bind the polar and the wind field
+ */
+template <int MaxSectors, int MaxSteps>
+IsochroneRouter<MaxSectors, MaxSteps>::IsochroneRouter(const BasicPolarTable<float>& polar_table,
+                                                       const WindField& wind_field)
+    : polar(polar_table), wind(wind_field) {
+    path_length = 0;
+    reached_destination = false;
+    heading_count = 0;
+}
+
+template <int MaxSectors, int MaxSteps>
+void IsochroneRouter<MaxSectors, MaxSteps>::clear(StepBest& best) {
+    for (int s = 0; s < MaxSectors; s++) {
+        best.sectors[s].distance2 = -1.0f;
+    }
+    best.arrival.fraction = 2.0f;
+}
+
+/**
+ * @brief Candidate ordering; ties are broken on the node identity so the
+ * result does not depend on how the isochrone was split between threads
+ */
+template <int MaxSectors, int MaxSteps>
+bool IsochroneRouter<MaxSectors, MaxSteps>::better(const Candidate& a, const Candidate& b) {
+    if (a.distance2 != b.distance2) {
+        return a.distance2 > b.distance2;
+    }
+    if (a.node.parent != b.node.parent) {
+        return a.node.parent < b.node.parent;
+    }
+    return a.node.heading_index < b.node.heading_index;
+}
+
+template <int MaxSectors, int MaxSteps>
+bool IsochroneRouter<MaxSectors, MaxSteps>::earlier(const Arrival& a, const Arrival& b) {
+    if (a.fraction != b.fraction) {
+        return a.fraction < b.fraction;
+    }
+    if (a.node.parent != b.node.parent) {
+        return a.node.parent < b.node.parent;
+    }
+    return a.node.heading_index < b.node.heading_index;
+}
+
+template <int MaxSectors, int MaxSteps>
+void IsochroneRouter<MaxSectors, MaxSteps>::merge(StepBest& into, const StepBest& from) {
+    for (int s = 0; s < MaxSectors; s++) {
+        if (better(from.sectors[s], into.sectors[s])) {
+            into.sectors[s] = from.sectors[s];
+        }
+    }
+    if (earlier(from.arrival, into.arrival)) {
+        into.arrival = from.arrival;
+    }
+}
+
+template <int MaxSectors, int MaxSteps>
+void IsochroneRouter<MaxSectors, MaxSteps>::to_lat_lon(float east, float north, double* lat, double* lon) const {
+    *lat = origin_lat + north / meters_per_deg_lat;
+    *lon = origin_lon + east / meters_per_deg_lon;
+}
+
+/**
+ * @brief Expand a slice of one isochrone over the heading grid
+ *
+ * Wind is sampled once per node; each heading then costs a polar lookup, a
+ * few multiply-adds and the atan2 giving its sector.
+ */
+template <int MaxSectors, int MaxSteps>
+void IsochroneRouter<MaxSectors, MaxSteps>::expand(int step, double time_s, int begin, int end, StepBest& best) const {
+    const float half_span = settings.sector_span_deg / 2.0f;
+    const float sector_width = settings.sector_span_deg / MaxSectors;
+    const float arrival_radius2 = settings.arrival_radius_m * settings.arrival_radius_m;
+
+    for (int n = begin; n < end; n++) {
+        const Node& node = isochrones[step][n];
+        double lat, lon;
+        to_lat_lon(node.east, node.north, &lat, &lon);
+        float wind_direction, wind_speed;
+        if (!wind.sample(time_s, lat, lon, &wind_direction, &wind_speed)) {
+            return;
+        }
+
+        // Side of the boat the wind was on when sailing into this node
+        const float heading_in = (float)(node.heading_index * settings.heading_step_deg);
+        const bool has_course = node.parent >= 0;
+        const bool wind_to_port_in = MF::fmod(heading_in - wind_direction + 540.0f, 360.0f) - 180.0f > 0.0f;
+
+        const float to_dest_east = dest_east - node.east;
+        const float to_dest_north = dest_north - node.north;
+        const float to_dest2 = to_dest_east * to_dest_east + to_dest_north * to_dest_north;
+
+        for (int h = 0; h < heading_count; h++) {
+            float heading = (float)(h * settings.heading_step_deg);
+            float speed = polar.boat_speed(heading - wind_direction, wind_speed);
+            if (speed <= 0.01f) {
+                continue;
+            }
+            float sailing_time = settings.time_step_s;
+            if (has_course) {
+                bool wind_to_port = MF::fmod(heading - wind_direction + 540.0f, 360.0f) - 180.0f > 0.0f;
+                if (wind_to_port != wind_to_port_in) {
+                    sailing_time -= settings.tack_penalty_s;
+                    if (sailing_time <= 0.0f) {
+                        continue;
+                    }
+                }
+            }
+            float run = speed * sailing_time;
+            float east = node.east + run * heading_sin[h];
+            float north = node.north + run * heading_cos[h];
+
+            // Closest approach of this leg to the destination
+            float along = to_dest_east * heading_sin[h] + to_dest_north * heading_cos[h];
+            if (along > 0.0f) {
+                float clamped = along < run ? along : run;
+                float miss2 = to_dest2 - 2.0f * clamped * along + clamped * clamped;
+                if (miss2 <= arrival_radius2) {
+                    Arrival arrival;
+                    arrival.fraction = (settings.time_step_s - sailing_time + clamped / speed) / settings.time_step_s;
+                    arrival.node.east = node.east + clamped * heading_sin[h];
+                    arrival.node.north = node.north + clamped * heading_cos[h];
+                    arrival.node.parent = (int16_t)n;
+                    arrival.node.heading_index = (int16_t)h;
+                    if (earlier(arrival, best.arrival)) {
+                        best.arrival = arrival;
+                    }
+                }
+            }
+
+            // Keep the furthest candidate per sector of the fan
+            float bearing = MF::atan2_deg(east, north);
+            float offset = MF::fmod(bearing - centre_bearing + 540.0f, 360.0f) - 180.0f;
+            if (MF::fabs(offset) > half_span) {
+                continue;
+            }
+            int sector = (int)((offset + half_span) / sector_width);
+            if (sector >= MaxSectors) {
+                sector = MaxSectors - 1;
+            }
+            Candidate candidate;
+            candidate.distance2 = east * east + north * north;
+            candidate.node.east = east;
+            candidate.node.north = north;
+            candidate.node.parent = (int16_t)n;
+            candidate.node.heading_index = (int16_t)h;
+            if (better(candidate, best.sectors[sector])) {
+                best.sectors[sector] = candidate;
+            }
+        }
+    }
+}
+
+template <int MaxSectors, int MaxSteps>
+RouteResult IsochroneRouter<MaxSectors, MaxSteps>::route(double start_lat, double start_lon,
+                                                         double dest_lat, double dest_lon,
+                                                         double start_time_s, int threads) {
+    RouteResult result = {false, 0.0f, 0, 0};
+    path_length = 0;
+    reached_destination = false;
+    route_dest_lat = dest_lat;
+    route_dest_lon = dest_lon;
+    if (!wind.is_ready() || settings.heading_step_deg < 1 || settings.heading_step_deg > MAX_HEADINGS) {
+        return result;
+    }
+
+    // Route frame centred on the start
+    origin_lat = start_lat;
+    origin_lon = start_lon;
+    meters_per_deg_lat = 111194.93f;
+    meters_per_deg_lon = meters_per_deg_lat * MF::cos_deg((float)start_lat);
+    dest_east = (float)((dest_lon - start_lon) * meters_per_deg_lon);
+    dest_north = (float)((dest_lat - start_lat) * meters_per_deg_lat);
+    centre_bearing = MF::atan2_deg(dest_east, dest_north);
+
+    heading_count = MAX_HEADINGS / settings.heading_step_deg;
+    for (int h = 0; h < heading_count; h++) {
+        heading_sin[h] = MF::sin_deg((float)(h * settings.heading_step_deg));
+        heading_cos[h] = MF::cos_deg((float)(h * settings.heading_step_deg));
+    }
+
+    isochrones[0][0].east = 0.0f;
+    isochrones[0][0].north = 0.0f;
+    isochrones[0][0].parent = -1;
+    isochrones[0][0].heading_index = 0;
+    isochrone_size[0] = 1;
+
+#ifndef ARDUINO
+    if (threads < 1) {
+        threads = 1;
+    }
+    std::vector<StepBest> partial(threads);
+    std::vector<std::thread> workers;
+#else
+    (void)threads;
+#endif
+    StepBest best;
+
+    int last_step = 0;
+    Node final_node = isochrones[0][0];
+    int final_step = -1;          // Isochrone holding final_node's parent, -1 if final_node is the start
+    for (int step = 0; step < MaxSteps; step++) {
+        double time_s = start_time_s + step * (double)settings.time_step_s;
+        int count = isochrone_size[step];
+        clear(best);
+
+#ifndef ARDUINO
+        if (threads > 1 && count >= 2 * threads) {
+            // Contiguous slices; merge order is irrelevant thanks to the tie-breaks
+            workers.clear();
+            for (int t = 0; t < threads; t++) {
+                int begin = count * t / threads;
+                int end = count * (t + 1) / threads;
+                clear(partial[t]);
+                workers.emplace_back([this, step, time_s, begin, end, &partial, t]() {
+                    expand(step, time_s, begin, end, partial[t]);
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            for (int t = 0; t < threads; t++) {
+                merge(best, partial[t]);
+            }
+        } else
+#endif
+        {
+            expand(step, time_s, 0, count, best);
+        }
+
+        result.steps = step + 1;
+        if (best.arrival.fraction <= 1.0f) {
+            result.reached = true;
+            result.duration_s = (step + best.arrival.fraction) * settings.time_step_s;
+            final_node = best.arrival.node;
+            final_step = step;
+            break;
+        }
+
+        int next_count = 0;
+        for (int s = 0; s < MaxSectors; s++) {
+            if (best.sectors[s].distance2 >= 0.0f) {
+                isochrones[step + 1][next_count++] = best.sectors[s].node;
+            }
+        }
+        isochrone_size[step + 1] = next_count;
+        if (next_count == 0) {
+            break;          // Becalmed: nothing moved
+        }
+        last_step = step + 1;
+    }
+
+    if (!result.reached) {
+        // Route to the node closest to the destination over every isochrone
+        float closest2 = -1.0f;
+        for (int step = 0; step <= last_step; step++) {
+            for (int n = 0; n < isochrone_size[step]; n++) {
+                const Node& node = isochrones[step][n];
+                float de = dest_east - node.east;
+                float dn = dest_north - node.north;
+                float d2 = de * de + dn * dn;
+                if (closest2 < 0.0f || d2 < closest2) {
+                    closest2 = d2;
+                    final_node = node;
+                    final_step = step - 1;
+                    result.duration_s = step * settings.time_step_s;
+                }
+            }
+        }
+    }
+
+    // Walk the parents back to the start, filling the path from its end
+    int length = 1;
+    Node current = final_node;
+    for (int step = final_step; step >= 0 && current.parent >= 0; step--) {
+        current = isochrones[step][current.parent];
+        length++;
+    }
+    path[length - 1] = final_node;
+    current = final_node;
+    int k = length - 2;
+    for (int step = final_step; step >= 0 && current.parent >= 0; step--) {
+        current = isochrones[step][current.parent];
+        path[k--] = current;
+    }
+    path_length = length;
+    reached_destination = result.reached;
+    result.nodes = length;
+    return result;
+}
+
+template <int MaxSectors, int MaxSteps>
+int IsochroneRouter<MaxSectors, MaxSteps>::simplify(float tolerance, bool* keep) const {
+    // Iterative Douglas-Peucker over the node chain, with an explicit stack of spans
+    int stack_first[MaxSteps + 2];
+    int stack_last[MaxSteps + 2];
+    int depth = 0;
+    for (int k = 0; k < path_length; k++) {
+        keep[k] = false;
+    }
+    keep[0] = true;
+    keep[path_length - 1] = true;
+    int kept = 2;
+
+    stack_first[depth] = 0;
+    stack_last[depth] = path_length - 1;
+    depth++;
+    const float tolerance2 = tolerance * tolerance;
+    while (depth > 0) {
+        depth--;
+        int first = stack_first[depth];
+        int last = stack_last[depth];
+        float ax = path[first].east, ay = path[first].north;
+        float dx = path[last].east - ax, dy = path[last].north - ay;
+        float length2 = dx * dx + dy * dy;
+
+        int farthest = -1;
+        float farthest2 = tolerance2;
+        for (int k = first + 1; k < last; k++) {
+            float px = path[k].east - ax, py = path[k].north - ay;
+            float t = length2 > 0.0f ? (px * dx + py * dy) / length2 : 0.0f;
+            t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+            float ex = px - t * dx, ey = py - t * dy;
+            float error2 = ex * ex + ey * ey;
+            if (error2 > farthest2) {
+                farthest2 = error2;
+                farthest = k;
+            }
+        }
+        if (farthest >= 0) {
+            keep[farthest] = true;
+            kept++;
+            stack_first[depth] = first;
+            stack_last[depth] = farthest;
+            depth++;
+            stack_first[depth] = farthest;
+            stack_last[depth] = last;
+            depth++;
+        }
+    }
+    return kept;
+}
+
+template <int MaxSectors, int MaxSteps>
+int IsochroneRouter<MaxSectors, MaxSteps>::waypoints(double* lats, double* lons, int max_waypoints) const {
+    if (path_length < 2 || max_waypoints < 1) {
+        return 0;
+    }
+
+    // The start is not a waypoint: the boat is already there
+    bool keep[MaxSteps + 2];
+    float tolerance = settings.waypoint_tolerance_m > 0.0f ? settings.waypoint_tolerance_m : 1.0f;
+    while (simplify(tolerance, keep) - 1 > max_waypoints) {
+        tolerance *= 2.0f;
+    }
+
+    int count = 0;
+    for (int k = 1; k < path_length - 1; k++) {
+        if (keep[k]) {
+            to_lat_lon(path[k].east, path[k].north, &lats[count], &lons[count]);
+            count++;
+        }
+    }
+    // The last node only comes within the arrival radius: close on the destination itself
+    if (reached_destination) {
+        lats[count] = route_dest_lat;
+        lons[count] = route_dest_lon;
+    } else {
+        to_lat_lon(path[path_length - 1].east, path[path_length - 1].north, &lats[count], &lons[count]);
+    }
+    return count + 1;
+}
+
+template class IsochroneRouter<180, 1440>;
+template class IsochroneRouter<32, 40>;
@@ -0,0 +1,71 @@
+#include "localFrame.h"
+
+/**
+ * @brief Constructor - Start without origin
+ */
+template <typename T>
+LocalFrame<T>::LocalFrame() {
+    origin_lat = T(0);
+    origin_lon = T(0);
+    km_per_deg_lat = T(0);
+    km_per_deg_lon = T(0);
+    max_dlat = T(0);
+    max_dlon = T(0);
+    valid = false;
+}
+
+/**
+ * @brief Anchor the frame at a new origin
+ *
+ * This is the only place where trigonometry is needed: the east scale is
+ * frozen at the origin latitude, which keeps the scale error under 0.1 %
+ * within MAX_RANGE at our latitudes.
+ */
+template <typename T>
+void LocalFrame<T>::set_origin(T lat, T lon) {
+    origin_lat = lat;
+    origin_lon = lon;
+    km_per_deg_lat = KM_PER_DEGREE;
+    km_per_deg_lon = KM_PER_DEGREE * M::cos_deg(lat);
+
+    // Range limits are checked in degrees, before any product can saturate
+    T max_range_km = MAX_RANGE / T(1000);
+    max_dlat = max_range_km / km_per_deg_lat;
+    max_dlon = max_range_km / km_per_deg_lon;
+    valid = true;
+}
+
+template <typename T>
+void LocalFrame<T>::invalidate() {
+    valid = false;
+}
+
+template <typename T>
+bool LocalFrame<T>::project(T lat, T lon, T* east, T* north) const {
+    if (!valid) {
+        return false;
+    }
+    T dlat = lat - origin_lat;
+    T dlon = lon - origin_lon;
+    if (M::fabs(dlat) > max_dlat || M::fabs(dlon) > max_dlon) {
+        return false;
+    }
+    // Scales are in km so they fit in Q16.16; convert to meters last
+    *east = (dlon * km_per_deg_lon) * T(1000);
+    *north = (dlat * km_per_deg_lat) * T(1000);
+    return true;
+}
+
+template <typename T>
+T LocalFrame<T>::bearing(T east, T north) {
+    return M::fmod(M::atan2_deg(east, north) + T(360.0), T(360.0));
+}
+
+template <typename T>
+T LocalFrame<T>::length(T east, T north) {
+    return M::hypot(east, north);
+}
+
+template class LocalFrame<double>;
+template class LocalFrame<float>;
+template class LocalFrame<q16_16>;
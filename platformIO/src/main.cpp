@@ -8,6 +8,14 @@
 #include "shared_data.h"
 #include "servoControl.h"
 #include "xbeeImpl.h"
+#include "trace.h"
+#include "pipeline.h"
+#include "controlLoop.h"
+#include "spscQueue.h"
+#include "taskMonitor.h"
+#include "staticAlloc.h"
+#include "taskTable.h"
+#include "i2cBus.h"
 
 #define LED_PIN 25 // Broche LED pour Raspberry Pi Pico
 
@@ -17,6 +25,15 @@ servoControl boat;
 xbeeImpl xbee;
 SharedData sharedData;
 
+// Planificateur réveillé par notification à chaque nouvelle mesure
+TaskHandle_t pathFindingHandle = NULL;
+
+
+// Échanges entre les cœurs sans verrou : caps vers la boucle de contrôle, rapports vers la télémétrie
+SpscQueue<NavigationData, 8> headingQueue;              // pathFinding -> controlTask
+SpscQueue<ControlReport, 4> controlReportQueue;         // controlTask -> XbeeTask
+SpscQueue<TaskUsage, 16> taskUsageQueue;                // monitorTask -> XbeeTask
+
 // Déclaration des tâches existantes
 void TaskBlink(void *pvParameters);
 void exampleTask(void *pvParameters);
@@ -27,15 +44,43 @@ void XbeeTask(void *pvParameters);
 // Nouvelle tâche pour les capteurs
 void sensorTask(void *pvParameters);
 void i2cScanTask(void *pvParameters);
-
-// Création des instances TwoWire pour chaque capteur
-// (Attention : selon votre carte, il faudra adapter la création des instances)
-// TwoWire I2C1Instance(i2c1, 2, 3); // Pour le QMC5883L : instance i2c1, SDA = GP2, SCL = GP3
-TwoWire I2C0Instance(i2c0, 4, 5); // Pour le CMPS12 : instance i2c0, SDA = GP4, SCL = GP5
-
-// Instanciation des capteurs avec leurs bus I2C respectifs
-CMPS12 cmps12(I2C0Instance, 0x60);
-// QMC5883L qmc5883l(I2C0Instance, 0x0D);
+// Envoi des traces binaires sur le port série
+void traceDrainTask(void *pvParameters);
+// Pile, CPU et durées de boucle de chaque tâche (taskMonitor.h)
+void monitorTask(void *pvParameters);
+// Tâches propriétaires des bus I2C (i2cBus.h)
+void i2c0Task(void *pvParameters);
+void i2c1Task(void *pvParameters);
+
+// Table des tâches, dans l'ordre de MonitoredTask (nom FreeRTOS : monitored_task_names).
+// Priorités attribuées au démarrage d'après les périodes (taskTable.h) ; le cœur 1 est
+// réservé à la boucle de contrôle, tout le reste est sur le cœur 0 (voir controlLoop.h).
+TaskConfig taskTable[MONITORED_TASK_COUNT] = {
+  // fonction        période (ms)             échéance  pile  cœur          fond
+  {TaskBlink,       1000,                     0,        1024, IO_CORE,      false},  // TASK_BLINK
+  {controlTask,     1000 / CONTROL_RATE_HZ,   0,        1024, CONTROL_CORE, false},  // TASK_CONTROL
+  {pathFinding,     PLANNER_IDLE_PERIOD_MS,   0,        1024, IO_CORE,      false},  // TASK_PATH
+  {sensorTask,      500,                      0,        1024, IO_CORE,      false},  // TASK_SENSOR
+  {GpsVersPicoTask, GPS_POLL_PERIOD_MS,       0,        1024, IO_CORE,      false},  // TASK_GPS
+  {XbeeTask,        100,                      0,        1024, IO_CORE,      false},  // TASK_XBEE
+#if TRACE_LEVEL > TRACE_LEVEL_OFF
+  {traceDrainTask,  20,                       0,        512,  IO_CORE,      true},   // TASK_TRACE
+#else
+  {NULL,            20,                       0,        512,  IO_CORE,      true},   // TASK_TRACE
+#endif
+  {monitorTask,     TASK_MONITOR_PERIOD_MS,   0,        512,  IO_CORE,      false},  // TASK_MONITOR
+  {i2c0Task,        20,                       0,        512,  IO_CORE,      false},  // TASK_I2C0
+  {i2c1Task,        20,                       0,        512,  IO_CORE,      false},  // TASK_I2C1
+};
+
+// Bus I2C des capteurs, chacun piloté par sa tâche propriétaire (i2c0Task, i2c1Task)
+// (Attention : selon votre carte, il faudra adapter les broches)
+// i2c1Bus (SDA = GP2, SCL = GP3) est défini dans gps.cpp, pour le ZED-F9P
+I2cBus i2c0Bus(0, 4, 5); // Pour le CMPS12 : i2c0, SDA = GP4, SCL = GP5
+
+// Instanciation des capteurs avec leur bus I2C et leur priorité sur ce bus
+CMPS12 cmps12(i2c0Bus, 0x60, 0);
+// QMC5883L qmc5883l(i2c0Bus, 0x0D, 1);
 
 void setup()
 {
@@ -44,60 +89,26 @@ void setup()
         ; // Attendre que la connexion série soit établie
 
   m_GNSS.gpsInit();
+  if (!i2c0Bus.begin()) {
+    Serial.println("Erreur : pas de canal DMA libre pour le bus I2C 0 !");
+  }
+
+  // Périodes persistées (/tasks.cfg), puis priorités rate-monotonic : la plus courte période passe en premier
+  int rates = load_task_rates(taskTable, TASK_RATES_FILE);
+  if (rates > 0) {
+    TRACE_INFO(EVT_TASK_RATES_LOADED, rates);
+  }
+  assign_rate_monotonic_priorities(taskTable, TASK_LOWEST_PRIORITY, TASK_HIGHEST_PRIORITY);
+  for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+    if (taskTable[t].entry != NULL) {
+      TRACE_INFO(EVT_TASK_CONFIG, t, taskTable[t].period_ms, taskTable[t].priority);
+    }
+  }
 
-  xTaskCreate(
-    TaskBlink,  // Fonction de la tâche
-    "LED Task", // Nom de la tâche
-    1024,       // Taille de la pile
-    NULL,       // Paramètre
-    1,          // Priorité
-    NULL        // Handle de tâche (inutile ici)
-  );
-
-  xTaskCreate(
-    controlTask,  // Fonction de la tâche
-    "control task", // Nom de la tâche
-    1024,       // Taille de la pile
-    NULL,       // Paramètre
-    1,          // Priorité
-    NULL        // Handle de tâche (inutile ici)
-  );
-
-  xTaskCreate(
-    pathFinding,        // Fonction de la tâche
-    "pathPlanification",       // Nom de la tâche
-    1024,             // Taille de la pile
-    NULL,             // Paramètre
-    1,                // Priorité
-    NULL              // Handle de tâche (inutile ici)
-  );
-
-  xTaskCreate(
-    sensorTask,  // Fonction de la tâche
-    "LED Task", // Nom de la tâche
-    1024,       // Taille de la pile
-    NULL,       // Paramètre
-    1,          // Priorité
-    NULL        // Handle de tâche (inutile ici)
-  );
-
-  xTaskCreate(
-    GpsVersPicoTask,        // Fonction de la tâche
-    "GpsVersPicoTask",      // Nom de la tâche
-    1024,                   // Taille de la pile
-    NULL,                   // Paramètre
-    1,                      // Priorité
-    NULL                    // Handle de tâche (inutile ici)
-  );
-
-  xTaskCreate(
-    XbeeTask,               // Fonction de la tâche
-    "XbeeTask",             // Nom de la tâche
-    1024,                   // Taille de la pile
-    NULL,                   // Paramètre
-    1,                      // Priorité
-    NULL                    // Handle de tâche (inutile ici)
-  );
+  if (start_tasks(taskTable) != 0) {
+    Serial.println("Erreur : tâche non créée (pile ou tas insuffisant) !");
+  }
+  pathFindingHandle = (TaskHandle_t)taskTable[TASK_PATH].handle;
 
   // Démarrer le planificateur FreeRTOS (optionnel sur Arduino)
   // vTaskStartScheduler();
@@ -108,47 +119,184 @@ void loop()
     // Rien ici, car FreeRTOS gère les tâches
 }
 
+// Réveille une tâche du pipeline (sans effet tant qu'elle n'est pas créée)
+static void notifyTask(TaskHandle_t task)
+{
+    if (task != NULL)
+    {
+        xTaskNotifyGive(task);
+    }
+}
+
 void GpsVersPicoTask(void *pvParameters)
 {
+    LoopProbe& probe = taskMonitor.attach(TASK_GPS);
+    // Les fronts TX-ready réveillent cette tâche (si la broche est câblée)
+    m_GNSS.demarrerIngestion(xTaskGetCurrentTaskHandle());
+    uint32_t essaiCadence_ms = 0;   // Dernière cadence refusée par le module (0 : aucune)
+    uint32_t demandeMode_ms = 0;    // Date de la dernière demande de mode appliquée
+    uint32_t rapport_ms = millis();
     while (1)
     {
-        m_GNSS.lireFluxGPS();
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        // Front TX-ready (au plus GNSS_TXREADY_TIMEOUT_MS), ou une période en interrogation
+        m_GNSS.attendreDonnees(taskTable[TASK_GPS].period_ms);
+        probe.begin(micros());
+        // Cadence et mode demandés par la station sol ("gps_rate:", "gps_txready:"),
+        // appliqués une fois par demande
+        CommandData command;
+        sharedData.command.read(&command);
+        // La cadence n'est retenue par le pilote qu'une fois acquittée par le module :
+        // une demande refusée est renvoyée toutes les GNSS_RATE_RETRY_MS
+        if (command.gps_rate_hz != 0 && command.gps_rate_hz != m_GNSS.cadence()
+            && (essaiCadence_ms == 0 || millis() - essaiCadence_ms >= GNSS_RATE_RETRY_MS))
+        {
+            if (m_GNSS.configurerCadence(command.gps_rate_hz))
+            {
+                essaiCadence_ms = 0;
+            }
+            else
+            {
+                TRACE_WARN(EVT_GPS_NAV_RATE_FAILED, command.gps_rate_hz);
+                essaiCadence_ms = millis() | 1;
+            }
+        }
+        // Le mode est comparé à celui du pilote, pas à la demande précédente : après un repli
+        // sur l'interrogation (EVT_GPS_TXREADY_LOST), un nouveau "gps_txready:1" le réactive
+        if (command.gps_txready_ms != demandeMode_ms)
+        {
+            demandeMode_ms = command.gps_txready_ms;
+            bool txReadyDemande = command.gps_txready == 2;
+            if (command.gps_txready != 0 && txReadyDemande != m_GNSS.modeTxReady())
+            {
+                m_GNSS.utiliserTxReady(txReadyDemande);
+            }
+        }
+
+        // Vide le tampon du module ; chaque nouvelle position réveille le planificateur
+        if (m_GNSS.lireFluxGPS())
+        {
+            notifyTask(pathFindingHandle);
+        }
+
+        // Coût de l'ingestion dans le mode courant (interrogations, octets par solution, latence)
+        if (millis() - rapport_ms >= GNSS_INGEST_REPORT_MS)
+        {
+            m_GNSS.rapporterMesures();
+            rapport_ms = millis();
+        }
+        probe.end(micros());
     }
 }
 
 // Tâche pour faire clignoter la LED
 void TaskBlink(void *pvParameters)
 {
+    LoopProbe& probe = taskMonitor.attach(TASK_BLINK);
     pinMode(2, OUTPUT);
+    bool allumee = false;
     while (1)
     {
-        digitalWrite(2, HIGH);
-        vTaskDelay(pdMS_TO_TICKS(1000));
-        digitalWrite(2, LOW);
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        probe.begin(micros());
+        // Un changement d'état par période
+        allumee = !allumee;
+        digitalWrite(2, allumee ? HIGH : LOW);
+        probe.end(micros());
+        vTaskDelay(pdMS_TO_TICKS(taskTable[TASK_BLINK].period_ms));
     }
 }
 
 void XbeeTask(void *pvParameters) {
   // Initialisation de l'interface série pour XBee
   xbee.initialize();
+  LoopProbe& probe = taskMonitor.attach(TASK_XBEE);
+  TaskUsage usage;
+  bool usagePending = false;  // usage refusé par le budget, renvoyé en premier
   while (1)
   {
+    probe.begin(micros());
     xbee.read();
-    xbee.send(sharedData);
-    vTaskDelay(pdMS_TO_TICKS(100));
+
+    // Rapports de la boucle de contrôle (cœur 1) : publiés et tracés ici, sur le cœur 0
+    ControlReport report;
+    while (controlReportQueue.pop(&report))
+    {
+      sharedData.control.write(report, millis());
+      TRACE_INFO(EVT_CONTROL_PERIOD, report.jitter.min_period_us, report.jitter.max_period_us, report.jitter.max_jitter_us);
+      TRACE_INFO(EVT_CONTROL_LOAD, report.jitter.mean_jitter_us, report.jitter.overruns, report.jitter.max_exec_us);
+      TRACE_INFO(EVT_PIPELINE_LATENCY, report.latency.last_us, report.latency.min_us, report.latency.max_us);
+    }
+
+    xbee.send(sharedData.telemetry());
+
+    // Relevés de monitorTask, une ligne par tâche ; une ligne refusée par le budget de télémétrie
+    // attend le passage suivant (les suivantes restent dans la file, monitorTask perd les plus récentes)
+    while (usagePending || taskUsageQueue.pop(&usage))
+    {
+      usagePending = !xbee.sendTaskUsage(usage);
+      if (usagePending)
+      {
+        break;
+      }
+    }
+    probe.end(micros());
+    vTaskDelay(pdMS_TO_TICKS(taskTable[TASK_XBEE].period_ms));
   }
 }
 
+// Boucle de contrôle strictement périodique, seule sur le cœur 1
 void controlTask(void *pvParameters) {
+  const TickType_t period = pdMS_TO_TICKS(taskTable[TASK_CONTROL].period_ms);
+  LatencyStats latency;
+  JitterStats jitter(period * portTICK_PERIOD_MS * 1000);
+  // Dernier cap reçu du planificateur, suivi jusqu'au suivant
+  NavigationData navigation = {};
+  TickType_t release = xTaskGetTickCount();
+  uint32_t report_start_us = trace_clock_us();
+  LoopProbe& probe = taskMonitor.attach(TASK_CONTROL);
   while (1)
   {
-    boat.servo_control(xbee);
-    vTaskDelay(pdMS_TO_TICKS(100));
+    uint32_t release_us = trace_clock_us();
+    probe.begin(release_us);
+
+    // Caps publiés par le planificateur depuis le pas précédent, on garde le dernier ;
+    // un cap manuel ("cap:") plus récent que lui l'emporte
+    bool new_heading = false;
+    while (headingQueue.pop(&navigation))
+    {
+      new_heading = true;
+    }
+
+    boat.servo_control(sharedData.target_angle(navigation.targetAngle, navigation.heading_ms));
+
+    // Latence capteur -> servo, mesurée une fois par cap du planificateur
+    uint32_t end_us = trace_clock_us();
+    if (new_heading)
+    {
+      latency.record(navigation.sample_us, end_us);
+    }
+    jitter.record(release_us, end_us - release_us);
+
+    // Rapport vers le cœur 0 ; si la file est pleine il est perdu, la boucle n'attend jamais
+    if (end_us - report_start_us >= CONTROL_REPORT_PERIOD_MS * 1000UL)
+    {
+      ControlReport report = {jitter.data(), latency.data()};
+      controlReportQueue.push(report);
+      jitter.start_window();
+      report_start_us = end_us;
+    }
+    probe.end(trace_clock_us());
+
+    // Date de réveil fixe : la durée du pas ne décale pas la période
+    if (xTaskDelayUntil(&release, period) == pdFALSE)
+    {
+      jitter.add_overrun();
+    }
   }
 }
 
+// Échantillons entre deux lectures de l'état de calibration du CMPS12
+#define CMPS12_CALIBRATION_EVERY 10
+
 // Nouvelle tâche pour la gestion des capteurs
 void sensorTask(void *pvParameters) {
     vTaskDelay(pdMS_TO_TICKS(10000));
@@ -164,41 +312,44 @@ void sensorTask(void *pvParameters) {
     // cmps12.endCalibration();
     // Serial.println("Calibration terminée. Début de la lecture des données.");
 
+    // Seule tâche qui écrit le groupe attitude
+    AttitudeData attitude = {};
+    LoopProbe& probe = taskMonitor.attach(TASK_SENSOR);
+
+    uint32_t sample = 0;
+
     while (1) {
-        // Lecture des données du CMPS12
-        uint16_t compassBearing16 = cmps12.readCompassBearing();
-        int8_t pitch = cmps12.readPitch();
-        int8_t roll = cmps12.readRoll();
-        uint8_t calibrationState = cmps12.readCalibrationState();
-
-        sharedData.horizontal_tilt = roll;
-        sharedData.vertical_tilt = pitch;
-        sharedData.angleFromNorth = compassBearing16 / 10;
-
-        Serial.println("Inclinaison de l'appareil (avant/arrière) :");
-        Serial.print("Pitch angle: ");
-        Serial.println(pitch);
-        Serial.println("Rotation (gauche/droite) :");
-        Serial.print("Roll angle: ");
-        Serial.println(roll);
-        Serial.print("Calibration State: ");
-        Serial.println(calibrationState);
-        Serial.println("-------------------------------------------------------");
+        probe.begin(micros());
+        // Cap, tangage et roulis du CMPS12 en une seule transaction I2C ;
+        // l'état de calibration (registre 0x1E, en fin de rafale) un échantillon sur CMPS12_CALIBRATION_EVERY
+        CMPS12Orientation orientation;
+        uint8_t blocks = (sample++ % CMPS12_CALIBRATION_EVERY == 0) ? CMPS12_CALIBRATION : 0;
+        if (cmps12.readOrientation(&orientation, blocks)) {
+            attitude.horizontal_tilt = orientation.roll;
+            attitude.vertical_tilt = orientation.pitch;
+            attitude.angleFromNorth = orientation.bearing / 10;
+            attitude.sample_us = orientation.sample_us;
+            sharedData.attitude.write(attitude, millis());
+            notifyTask(pathFindingHandle);
+
+            TRACE_INFO(EVT_SENSOR_ATTITUDE, orientation.bearing / 10.0f, orientation.pitch, orientation.roll);
+            if (orientation.blocks & CMPS12_CALIBRATION) {
+                TRACE_DEBUG(EVT_SENSOR_CALIBRATION, orientation.calibration);
+            }
+        } else {
+            TRACE_WARN(EVT_SENSOR_READ_FAILED);
+        }
 
         //  // Lecture et calcul de l'orientation via QMC5883L
         //  float headingQMC = qmc5883l.getHeading();
 
-        Serial.print("Direction (CMPS12) : ");
-        Serial.print(compassBearing16 / 10);
-        Serial.print(".");
-        Serial.print(compassBearing16 % 10);
-        Serial.println(" degrees");
         //  Serial.print("Direction (QMC5883L) : ");
         //  Serial.print(headingQMC);
         //  Serial.println(" degres");
         //  Serial.println("-------------------------------------------------------");
 
-        vTaskDelay(pdMS_TO_TICKS(500));
+        probe.end(micros());
+        vTaskDelay(pdMS_TO_TICKS(taskTable[TASK_SENSOR].period_ms));
 
     }
 }
@@ -207,41 +358,221 @@ void sensorTask(void *pvParameters) {
 void pathFinding(void *pvParameters) {
     // Create static instance of LaylinePathPlanner
     static LaylinePathPlanner laylinePlanner;
+    // Measured polar from the LittleFS partition if present, compile-time model otherwise
+    static BasicPolarTable<PlannerScalar> polarTable;
+    if (polarTable.load_from_file("/polar.csv")) {
+        laylinePlanner.set_polar_table(polarTable);
+        TRACE_INFO(EVT_PATH_POLAR_LOADED);
+    }
+    // Multi-waypoint mission, reloaded when the XBee task publishes a new one
+    static Mission mission;
+    static MissionUpload upload;
+    uint32_t mission_version = sharedData.mission.version();
+    // Single waypoint, followed by the active mission leg
+    double waypoint_lat = 47.253699;
+    double waypoint_lon = -1.370199;
+    uint32_t waypoint_seen_ms = 0;
+    // Sensor versions already planned on, to stamp headings with new samples only
+    uint32_t gnss_version = 0;
+    uint32_t attitude_version = 0;
     int iteration = 0;
+    // Confirmations de virement et lissage du cap comptent les itérations : au plus une par PLANNER_MIN_PERIOD_MS
+    PlannerPacer pacer;
+    LoopProbe& probe = taskMonitor.attach(TASK_PATH);
     
     while (1) {
+        // Woken by a new GNSS fix or compass sample, or after its table period (PLANNER_IDLE_PERIOD_MS)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(taskTable[TASK_PATH].period_ms));
+        // Trop tôt depuis la dernière itération : attendre la fin de la période, les échantillons reçus entre-temps restent dans sharedData
+        uint32_t hold_ms = pacer.hold_ms(millis());
+        if (hold_ms > 0) {
+            vTaskDelay(pdMS_TO_TICKS(hold_ms));
+        }
+        pacer.ran(millis());
+        probe.begin(micros());
         iteration++;
         
+        // Coherent copies of the producer groups
+        GnssData gnss;
+        AttitudeData attitude;
+        CommandData command;
+        uint32_t new_gnss_version = sharedData.gnss.read(&gnss);
+        uint32_t new_attitude_version = sharedData.attitude.read(&attitude);
+        sharedData.command.read(&command);
+        
+        // Capture time of the newest sample this iteration is the first to use (0: none)
+        uint32_t sample_us = newest_sample_us(
+            new_gnss_version != gnss_version ? gnss.sample_us : 0,
+            new_attitude_version != attitude_version ? attitude.sample_us : 0);
+        gnss_version = new_gnss_version;
+        attitude_version = new_attitude_version;
+        
+        // A waypoint received over the radio replaces the current one (mission legs included)
+        if (command.waypoint_ms != waypoint_seen_ms) {
+            waypoint_seen_ms = command.waypoint_ms;
+            if (command.waypoint_lat != 0.0) {
+                waypoint_lat = command.waypoint_lat;
+            }
+            if (command.waypoint_lon != 0.0) {
+                waypoint_lon = command.waypoint_lon;
+            }
+        }
+        
         // Use real sensor data when available, otherwise use test data
-        double boat_lat = sharedData.latitude != 0.0 ? sharedData.latitude : 48.8566;
-        double boat_lon = sharedData.longitude != 0.0 ? sharedData.longitude : 2.3522;
-        double waypoint_lat = sharedData.waypoint_lat != 0.0 ? sharedData.waypoint_lat : 47.253699;
-        double waypoint_lon = sharedData.waypoint_lon != 0.0 ? sharedData.waypoint_lon : -1.370199;
+        double boat_lat = gnss.latitude != 0.0 ? gnss.latitude : 48.8566;
+        double boat_lon = gnss.longitude != 0.0 ? gnss.longitude : 2.3522;
         
-        double compass = sharedData.angleFromNorth != 0 ? sharedData.angleFromNorth : 90.0;
-        double wind_vane = sharedData.wind_vane != 0.0 ? sharedData.wind_vane : 180.0; // Wind direction relative to boat
-        double wind_speed = sharedData.wind_speed != 0.0 ? sharedData.wind_speed : 5.0; // Wind speed
+        double compass = attitude.angleFromNorth != 0 ? attitude.angleFromNorth : 90.0;
+        double wind_vane = attitude.wind_vane != 0.0 ? attitude.wind_vane : 180.0; // Wind direction relative to boat
+        double wind_speed = attitude.wind_speed != 0.0 ? attitude.wind_speed : 5.0; // Wind speed
 
-        // Get current time in seconds (convert from millis)
-        double current_time = millis() / 1000.0;
+        // Planner clock is in milliseconds (wrap-around safe)
+        uint32_t current_time = millis();
         
-        Serial.printf("=== Path Planning Iteration %d ===\n", iteration);
-        Serial.printf("Boat Position: %.6f, %.6f\n", boat_lat, boat_lon);
-        Serial.printf("Waypoint: %.6f, %.6f\n", waypoint_lat, waypoint_lon);
-        Serial.printf("Compass: %.1f°, Wind: %.1f° @ %.1f m/s\n", compass, wind_vane, wind_speed);
+        TRACE_DEBUG(EVT_PATH_POSITION, iteration, trace_degrees(boat_lat), trace_degrees(boat_lon));
+        TRACE_DEBUG(EVT_PATH_WAYPOINT, trace_degrees(waypoint_lat), trace_degrees(waypoint_lon));
+        TRACE_DEBUG(EVT_PATH_SENSORS, compass, wind_vane, wind_speed);
         
-        // Calculate optimal direction using LaylinePathPlanner
-        double direction = laylinePlanner.calculate_direction(
-            boat_lat, boat_lon, waypoint_lat, waypoint_lon,
-            compass, wind_vane, wind_speed, current_time
-        );
+        // Load a mission uploaded over the radio, legs start at the current position
+        if (sharedData.mission.version() != mission_version) {
+            mission_version = sharedData.mission.read(&upload);
+            if (mission.load(upload.lat, upload.lon, upload.count, boat_lat, boat_lon)) {
+                mission.estimate_tacks(fmod(compass + wind_vane, 360.0), wind_speed);
+                laylinePlanner.reset_planner_state();
+                TRACE_INFO(EVT_PATH_MISSION_LOADED, mission.size(), mission.remaining_tacks());
+            }
+        }
         
-        Serial.printf("Optimal direction: %.1f°\n", direction);
-        Serial.println("================================\n");
+        // Calculate optimal direction using LaylinePathPlanner: mission waypoints
+        // first, then the single point_lat/point_lon waypoint
+        double direction;
+        if (!mission.is_finished()) {
+            direction = ScalarMath<PlannerScalar>::to_double(laylinePlanner.calculate_mission_direction(
+                mission, boat_lat, boat_lon, compass, wind_vane, wind_speed, current_time
+            ));
+            const MissionLeg<PlannerScalar>* leg = mission.active_leg();
+            if (leg != NULL) {
+                waypoint_lat = ScalarMath<PlannerScalar>::to_double(leg->end_lat);
+                waypoint_lon = ScalarMath<PlannerScalar>::to_double(leg->end_lon);
+            }
+        } else {
+            direction = ScalarMath<PlannerScalar>::to_double(laylinePlanner.calculate_direction(
+                boat_lat, boat_lon, waypoint_lat, waypoint_lon,
+                compass, wind_vane, wind_speed, current_time
+            ));
+        }
         
-        // Update shared data with calculated direction
-        sharedData.targetAngle = (int)round(direction);
-        vTaskDelay(pdMS_TO_TICKS(500));
+        TRACE_INFO(EVT_PATH_DIRECTION, direction);
         
+        // Publish the calculated direction and the waypoint being sailed, then hand it to the
+        // control loop on the other core (applied at its next step)
+        uint32_t heading_ms = millis();
+        NavigationData navigation = {waypoint_lat, waypoint_lon, (int)round(direction), sample_us, heading_ms};
+        sharedData.navigation.write(navigation, heading_ms);
+        headingQueue.push(navigation);
+        probe.end(micros());
+    }
+}
+
+// Tâche de priorité minimale : vide le tampon de traces vers le port série,
+// les autres tâches n'attendent jamais l'USB (décodage : host/trace_decode.py)
+void traceDrainTask(void *pvParameters) {
+    uint8_t frame[TRACE_FRAME_SIZE];
+    TraceRecord record;
+    LoopProbe& probe = taskMonitor.attach(TASK_TRACE);
+    while (1) {
+        probe.begin(micros());
+        uint32_t dropped = traceBuffer.take_dropped();
+        if (dropped > 0) {
+            record.timestamp_us = trace_clock_us();
+            record.event = EVT_TRACE_DROPPED;
+            record.level = TRACE_LEVEL_WARN;
+            record.arg_count = 1;
+            record.args[0] = dropped;
+            record.args[1] = 0;
+            record.args[2] = 0;
+            trace_encode_frame(record, frame);
+            Serial.write(frame, TRACE_FRAME_SIZE);
+        }
+        while (traceBuffer.pop(&record)) {
+            trace_encode_frame(record, frame);
+            Serial.write(frame, TRACE_FRAME_SIZE);
+        }
+        probe.end(micros());
+        vTaskDelay(pdMS_TO_TICKS(taskTable[TASK_TRACE].period_ms));
+    }
+}
+
+// Tâche propriétaire d'un bus I2C : seule à piloter le contrôleur, elle exécute les
+// transactions des capteurs par ordre de priorité et dort pendant chaque transfert DMA
+static void i2cOwnerLoop(I2cBus &bus, MonitoredTask task) {
+    LoopProbe& probe = taskMonitor.attach(task);
+    bus.bind_owner(xTaskGetCurrentTaskHandle());
+    while (1) {
+        // Réveillée par chaque soumission ; la période ne borne que l'attente
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(taskTable[task].period_ms));
+        probe.begin(micros());
+        bus.service();
+        probe.end(micros());
+    }
+}
+
+void i2c0Task(void *pvParameters) {
+    i2cOwnerLoop(i2c0Bus, TASK_I2C0);
+}
+
+void i2c1Task(void *pvParameters) {
+    i2cOwnerLoop(i2c1Bus, TASK_I2C1);
+}
+
+// Vrai quand chaque tâche a appelé taskMonitor.attach(), après son initialisation
+static bool tachesInitialisees() {
+#ifdef STATIC_ALLOCATION
+  for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+    // Les tâches absentes de ce build (traceDrainTask sans traces) ne comptent pas
+    if (taskTable[t].entry != NULL && !taskMonitor.attached((MonitoredTask)t)) {
+      return false;
+    }
+  }
+  return true;
+#else
+  return false;               // Tas toujours ouvert hors STATIC_ALLOCATION
+#endif
+}
+
+// Relevé périodique de chaque tâche : traces sur la console, lignes "task_<nom>:" sur la XBee
+void monitorTask(void *pvParameters) {
+    LoopProbe& probe = taskMonitor.attach(TASK_MONITOR);
+    TickType_t release = xTaskGetTickCount();
+    while (1) {
+        xTaskDelayUntil(&release, pdMS_TO_TICKS(taskTable[TASK_MONITOR].period_ms));
+        probe.begin(micros());
+
+        // Toutes les tâches ont fini leur initialisation : plus aucune allocation dynamique
+        if (!heap_locked() && tachesInitialisees()) {
+          heap_lock();
+          TRACE_INFO(EVT_HEAP_LOCKED, heap_used());
+        }
+        if (heap_locked() && heap_used() > heap_used_at_lock()) {
+          TRACE_ERROR(EVT_HEAP_GROWTH, heap_used(), heap_used() - heap_used_at_lock());
+        }
+
+        static TaskUsage usage[MONITORED_TASK_COUNT];
+        taskMonitor.sample(micros(), usage);
+        for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+            const TaskUsage& u = usage[t];
+            TRACE_INFO(EVT_TASK_USAGE, t, u.cpu_permille / 10.0f, u.stack_free_words);
+            TRACE_INFO(EVT_TASK_TIMING, t, u.loops, u.exec_max_us);
+            TRACE_DEBUG(EVT_TASK_PERIOD, t, u.period_min_us, u.period_max_us);
+            if (u.stack_free_words != 0 && u.stack_free_words < TASK_STACK_WARN_WORDS) {
+                TRACE_WARN(EVT_TASK_STACK_LOW, t, u.stack_free_words);
+            }
+            if (u.deadline_misses != 0) {
+                TRACE_WARN(EVT_TASK_DEADLINE, t, u.deadline_misses, u.exec_max_us);
+            }
+            // File pleine : l'XBee n'a pas suivi, ce relevé est perdu
+            taskUsageQueue.push(u);
+        }
+        probe.end(micros());
     }
 }
@@ -0,0 +1,89 @@
+#include "mission.h"
+#include "pathPlanification.h"
+
+/**
+ * @brief Constructor - Start with an empty mission
+ */
+template <typename T>
+BasicMission<T>::BasicMission() {
+    clear();
+}
+
+template <typename T>
+void BasicMission<T>::clear() {
+    leg_count = 0;
+    active = 0;
+}
+
+/**
+ * @brief Build every leg: frame, waypoint projection, bearing and length
+ *
+ * Legs inside LocalFrame::MAX_RANGE get their bearing and length from the
+ * frame, longer ones from the great-circle formulas.
+ */
+template <typename T>
+bool BasicMission<T>::load(const double* lats, const double* lons, int count, T start_lat, T start_lon) {
+    clear();
+    if (count < 1 || count > MAX_WAYPOINTS) {
+        return false;
+    }
+
+    T from_lat = start_lat;
+    T from_lon = start_lon;
+    for (int i = 0; i < count; i++) {
+        MissionLeg<T>& leg = legs[i];
+        leg.start_lat = from_lat;
+        leg.start_lon = from_lon;
+        leg.end_lat = T(lats[i]);
+        leg.end_lon = T(lons[i]);
+        leg.frame.set_origin(leg.start_lat, leg.start_lon);
+        leg.end_in_frame = leg.frame.project(leg.end_lat, leg.end_lon, &leg.end_east, &leg.end_north);
+        if (leg.end_in_frame) {
+            leg.bearing = LocalFrame<T>::bearing(leg.end_east, leg.end_north);
+            leg.length = LocalFrame<T>::length(leg.end_east, leg.end_north);
+        } else {
+            leg.bearing = BasicLaylinePathPlanner<T>::calculate_azimuth(leg.start_lat, leg.start_lon,
+                                                                        leg.end_lat, leg.end_lon);
+            leg.length = BasicLaylinePathPlanner<T>::calculate_distance(leg.start_lat, leg.start_lon,
+                                                                        leg.end_lat, leg.end_lon);
+        }
+        leg.expected_tacks = 0;
+        from_lat = leg.end_lat;
+        from_lon = leg.end_lon;
+    }
+    leg_count = count;
+    return true;
+}
+
+/**
+ * @brief A leg inside the no-go zone is a beat: one tack when reaching the layline
+ */
+template <typename T>
+void BasicMission<T>::estimate_tacks(T wind_direction, T wind_speed) {
+    T min_angle, max_angle;
+    BasicLaylinePathPlanner<T>::define_no_go_zone(wind_direction, wind_speed, &min_angle, &max_angle);
+    for (int i = 0; i < leg_count; i++) {
+        legs[i].expected_tacks = BasicLaylinePathPlanner<T>::is_in_no_go_zone(legs[i].bearing, min_angle, max_angle) ? 1 : 0;
+    }
+}
+
+template <typename T>
+bool BasicMission<T>::advance() {
+    if (active < leg_count) {
+        active++;
+    }
+    return !is_finished();
+}
+
+template <typename T>
+int BasicMission<T>::remaining_tacks() const {
+    int tacks = 0;
+    for (int i = active; i < leg_count; i++) {
+        tacks += legs[i].expected_tacks;
+    }
+    return tacks;
+}
+
+template class BasicMission<double>;
+template class BasicMission<float>;
+template class BasicMission<q16_16>;
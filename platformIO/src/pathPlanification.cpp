@@ -3,59 +3,51 @@
 /**
  * @brief Constructor - Initialize LaylinePathPlanner with default state
  */
-LaylinePathPlanner::LaylinePathPlanner() {
+template <typename T>
+BasicLaylinePathPlanner<T>::BasicLaylinePathPlanner() {
     // Initialize tacking state
     current_tack_is_set = false;
     pending_tack_is_set = false;
     tack_confirmation_count = 0;
     
     // Initialize timing and heading state
-    last_decision_time = 0.0;
-    last_optimal_heading_set = false;
+    last_decision_time = 0;
     last_raw_optimal_heading_set = false;
     
     // Initialize leg tracking
     leg_initialized = false;
     initial_tack_chosen_for_leg = false;
     
-    // Initialize heading history vector
-    heading_history.clear();
-    heading_history.reserve(HEADING_HISTORY_SIZE);
+    // The leg frame is built on the first call, once the waypoint is known
+    leg_frame.invalidate();
+    frame_wpt_in_range = false;
+    preferred_tack_is_set = false;
+    
+    // Use the compile-time polar until a measured one is supplied
+    polar_table = &BasicPolarTable<T>::default_table();
 }
 
 /**
  * @brief Calculate VMG-optimal tack angle with wind compensation
  * 
- * Tests various tack angles to find the one that maximizes Velocity Made Good (VMG)
- * upwind, accounting for boat polars and wind conditions.
+ * Looks up the Velocity Made Good (VMG) optimum cached per wind-speed bin in
+ * the polar table, then adds safety buffers for wind conditions.
  */
-double LaylinePathPlanner::find_vmg_optimal_tack_angle(double wind_speed) {
-    double best_vmg = -INFINITY;
-    double optimal_angle_to_true_wind = 50.0;  // Safe default
-    
-    // Test range of upwind sailing angles from 35 to 70 degrees
-    for (int angle_deg = 35; angle_deg <= 70; angle_deg += 5) {
-        double boat_speed = get_boat_speed_from_polars(angle_deg, wind_speed);
-        // VMG = boat_speed * cos(angle_to_wind)
-        double vmg = boat_speed * cos(angle_deg * PI / 180.0);
-        
-        if (vmg > best_vmg) {
-            best_vmg = vmg;
-            optimal_angle_to_true_wind = angle_deg;
-        }
-    }
+template <typename T>
+T BasicLaylinePathPlanner<T>::find_vmg_optimal_tack_angle(T wind_speed) {
+    T optimal_angle_to_true_wind = polar_table->upwind_vmg_angle(wind_speed);
     
     // Add safety buffer that increases with wind speed
-    double base_buffer = 5.0;
-    double wind_buffer = 0.0;
+    T base_buffer = T(5.0);
+    T wind_buffer = T(0.0);
     
-    if (wind_speed > 6.0) {
+    if (wind_speed > T(6.0)) {
         // More buffer in stronger winds where drift is more pronounced
-        wind_buffer = (wind_speed - 6.0) * 0.8;
+        wind_buffer = (wind_speed - T(6.0)) * T(0.8);
     }
     
     // Ensure minimum safe angle and apply buffers
-    return fmax(optimal_angle_to_true_wind, 40.0) + base_buffer + wind_buffer;
+    return M::fmax(optimal_angle_to_true_wind, T(40.0)) + base_buffer + wind_buffer;
 }
 
 /**
@@ -64,89 +56,105 @@ double LaylinePathPlanner::find_vmg_optimal_tack_angle(double wind_speed) {
  * Enhanced no-go zone checking that allows for conservative navigation
  * by adding a buffer to the standard no-go zone.
  */
-bool LaylinePathPlanner::is_point_in_no_go_zone_buffered(double boat_lat, double boat_lon,
-                                                        double point_lat, double point_lon,
-                                                        double wind_direction, double wind_speed,
-                                                        double buffer) {
-    double azimuth = calculate_azimuth(boat_lat, boat_lon, point_lat, point_lon);
-    
+template <typename T>
+bool BasicLaylinePathPlanner<T>::is_point_in_no_go_zone_buffered(T azimuth, T wind_direction, T wind_speed,
+                                                                 T buffer) const {
     // Get base no-go zone angles
-    double min_angle, max_angle;
+    T min_angle, max_angle;
     define_no_go_zone(wind_direction, wind_speed, &min_angle, &max_angle);
     
     // Calculate half-angle of no-go zone
-    double current_no_go_angle;
+    T current_no_go_angle;
     if (max_angle > min_angle) {
-        current_no_go_angle = (max_angle - min_angle) / 2.0;
+        current_no_go_angle = (max_angle - min_angle) / T(2.0);
     } else {
         // Handle case where no-go zone crosses 0 degrees
-        current_no_go_angle = (max_angle + (360.0 - min_angle)) / 2.0;
+        current_no_go_angle = (max_angle + (T(360.0) - min_angle)) / T(2.0);
     }
     
     // Apply buffer to create more conservative no-go zone
-    double effective_no_go_check_angle = current_no_go_angle + buffer;
-    double min_angle_check = fmod(wind_direction - effective_no_go_check_angle + 360.0, 360.0);
-    double max_angle_check = fmod(wind_direction + effective_no_go_check_angle, 360.0);
+    T effective_no_go_check_angle = current_no_go_angle + buffer;
+    T min_angle_check = M::fmod(wind_direction - effective_no_go_check_angle + T(360.0), T(360.0));
+    T max_angle_check = M::fmod(wind_direction + effective_no_go_check_angle, T(360.0));
     
     return is_in_no_go_zone(azimuth, min_angle_check, max_angle_check);
 }
 
 /**
- * @brief Apply adaptive heading smoothing using moving average
- * 
- * Implements sophisticated smoothing that adapts to the magnitude of heading changes.
- * Small oscillations are heavily smoothed while large changes (like tacks) are less smoothed.
+ * @brief Anchor the leg frame at the boat when navigation to a new waypoint starts
  */
-double LaylinePathPlanner::apply_heading_smoothing(double new_raw_heading) {
-    if (isnan(new_raw_heading)) {
-        return last_optimal_heading_set ? last_optimal_heading : 0.0;
+template <typename T>
+void BasicLaylinePathPlanner<T>::update_leg_frame(T boat_lat, T boat_lon, T wpt_lat, T wpt_lon) {
+    if (leg_frame.is_valid() && wpt_lat == frame_wpt_lat && wpt_lon == frame_wpt_lon) {
+        return;
     }
-    
-    // Add new heading to history
-    heading_history.push_back(new_raw_heading);
-    if (heading_history.size() > HEADING_HISTORY_SIZE) {
-        heading_history.erase(heading_history.begin());
+    leg_frame.set_origin(boat_lat, boat_lon);
+    frame_wpt_lat = wpt_lat;
+    frame_wpt_lon = wpt_lon;
+    frame_wpt_in_range = leg_frame.project(wpt_lat, wpt_lon, &frame_wpt_east, &frame_wpt_north);
+    TRACE_DEBUG(EVT_PLANNER_FRAME_REBUILT, frame_wpt_in_range);
+}
+
+/**
+ * @brief Local vector math when both ends fit in the leg frame, great-circle otherwise
+ */
+template <typename T>
+void BasicLaylinePathPlanner<T>::leg_vector(T from_lat, T from_lon, T to_lat, T to_lon,
+                                            T* bearing, T* distance) const {
+    T from_east, from_north, to_east, to_north;
+    if (leg_frame.project(from_lat, from_lon, &from_east, &from_north) &&
+        leg_frame.project(to_lat, to_lon, &to_east, &to_north)) {
+        T east = to_east - from_east;
+        T north = to_north - from_north;
+        *bearing = LocalFrame<T>::bearing(east, north);
+        *distance = LocalFrame<T>::length(east, north);
+        return;
     }
-    
-    // Calculate moving average using circular mean for angles
-    double current_avg_heading;
-    if (heading_history.empty()) {
-        current_avg_heading = new_raw_heading;
-    } else {
-        double sin_sum = 0.0, cos_sum = 0.0;
-        for (double hdg : heading_history) {
-            sin_sum += sin(hdg * PI / 180.0);
-            cos_sum += cos(hdg * PI / 180.0);
-        }
-        current_avg_heading = fmod(atan2(sin_sum, cos_sum) * 180.0 / PI + 360.0, 360.0);
+    *bearing = calculate_azimuth(from_lat, from_lon, to_lat, to_lon);
+    *distance = calculate_distance(from_lat, from_lon, to_lat, to_lon);
+}
+
+template <typename T>
+void BasicLaylinePathPlanner<T>::vector_to_waypoint(T boat_lat, T boat_lon, T* bearing, T* distance) const {
+    T boat_east, boat_north;
+    if (frame_wpt_in_range && leg_frame.project(boat_lat, boat_lon, &boat_east, &boat_north)) {
+        // Waypoint was projected once when the frame was built
+        T east = frame_wpt_east - boat_east;
+        T north = frame_wpt_north - boat_north;
+        *bearing = LocalFrame<T>::bearing(east, north);
+        *distance = LocalFrame<T>::length(east, north);
+        return;
     }
-    
-    if (!last_optimal_heading_set) {
-        last_optimal_heading = current_avg_heading;
-        last_optimal_heading_set = true;
-    } else {
-        // Calculate shortest angular difference
-        double angle_diff = fmod(current_avg_heading - last_optimal_heading + 180.0, 360.0) - 180.0;
-        
-        // Adaptive smoothing factor based on change magnitude
-        double smoothing_factor_to_use = HEADING_SMOOTHING_FACTOR;
-        
-        if (fabs(angle_diff) < 5.0) {
-            // Very small changes - apply heavy smoothing to reduce oscillations
-            smoothing_factor_to_use = 0.1;
-        } else if (fabs(angle_diff) < 15.0) {
-            // Small changes - apply medium smoothing
-            smoothing_factor_to_use = 0.2;
-        } else if (fabs(angle_diff) > 60.0) {
-            // Large changes (likely tacks) - apply faster smoothing
-            smoothing_factor_to_use = 0.5;
-        }
-        
-        // Apply smoothing with adaptive factor
-        last_optimal_heading = fmod(last_optimal_heading + angle_diff * smoothing_factor_to_use + 360.0, 360.0);
+    *bearing = calculate_azimuth(boat_lat, boat_lon, frame_wpt_lat, frame_wpt_lon);
+    *distance = calculate_distance(boat_lat, boat_lon, frame_wpt_lat, frame_wpt_lon);
+}
+
+template <typename T>
+void BasicLaylinePathPlanner<T>::adopt_mission_leg(const MissionLeg<T>& leg) {
+    if (leg_frame.is_valid() && leg.end_lat == frame_wpt_lat && leg.end_lon == frame_wpt_lon) {
+        return;
     }
-    
-    return last_optimal_heading;
+    leg_frame = leg.frame;
+    frame_wpt_lat = leg.end_lat;
+    frame_wpt_lon = leg.end_lon;
+    frame_wpt_east = leg.end_east;
+    frame_wpt_north = leg.end_north;
+    frame_wpt_in_range = leg.end_in_frame;
+}
+
+/**
+ * @brief Apply adaptive heading smoothing using a circular mean
+ * 
+ * Small oscillations are heavily smoothed while large changes (like tacks) are
+ * less smoothed. The window keeps running sin/cos sums, so the cost does not
+ * depend on HEADING_HISTORY_SIZE.
+ */
+template <typename T>
+T BasicLaylinePathPlanner<T>::apply_heading_smoothing(T new_raw_heading) {
+    if (M::is_nan(new_raw_heading)) {
+        return heading_smoother.has_output() ? heading_smoother.output() : T(0.0);
+    }
+    return heading_smoother.update(new_raw_heading);
 }
 
 /**
@@ -155,14 +163,16 @@ double LaylinePathPlanner::apply_heading_smoothing(double new_raw_heading) {
  * Called when starting navigation to a new waypoint or when switching
  * from direct sailing back to tacking mode.
  */
-void LaylinePathPlanner::reset_leg_start_conditions() {
+template <typename T>
+void BasicLaylinePathPlanner<T>::reset_leg_start_conditions() {
     leg_initialized = false;
     initial_tack_chosen_for_leg = false;
     current_tack_is_set = false;
     pending_tack_is_set = false;
+    preferred_tack_is_set = false;
     tack_confirmation_count = 0;
     
-    Serial.println("DEBUG: Leg start conditions reset for new upwind navigation");
+    TRACE_DEBUG(EVT_PLANNER_LEG_RESET);
 }
 
 /**
@@ -175,34 +185,36 @@ void LaylinePathPlanner::reset_leg_start_conditions() {
  * - Wind push compensation
  * - Beginning-of-route protection against premature tacking
  */
-double LaylinePathPlanner::calculate_raw_direction(double boat_lat, double boat_lon, double wpt_lat, double wpt_lon,
-                                                  double compass, double wind_vane_relative, double wind_speed,
-                                                  double current_time) {
-    // Calculate key navigation parameters
-    double vmg_tack_angle = find_vmg_optimal_tack_angle(wind_speed);
-    double azimuth_to_wpt = calculate_azimuth(boat_lat, boat_lon, wpt_lat, wpt_lon);
-    double wind_direction_abs = fmod(compass + wind_vane_relative + 360.0, 360.0);
-    double port_tack_target_hdg = fmod(wind_direction_abs - vmg_tack_angle + 360.0, 360.0);
-    double starboard_tack_target_hdg = fmod(wind_direction_abs + vmg_tack_angle + 360.0, 360.0);
-    double distance_to_wpt = calculate_distance(boat_lat, boat_lon, wpt_lat, wpt_lon);
-    
-    // Cooldown check - prevent rapid decision changes
-    if (last_decision_time > 0 && (current_time - last_decision_time < DECISION_COOLDOWN) && 
+template <typename T>
+T BasicLaylinePathPlanner<T>::calculate_raw_direction(T boat_lat, T boat_lon, T wpt_lat, T wpt_lon,
+                                                      T compass, T wind_vane_relative, T wind_speed,
+                                                      uint32_t current_time) {
+    // Calculate key navigation parameters (bearing and distance in the leg frame)
+    update_leg_frame(boat_lat, boat_lon, wpt_lat, wpt_lon);
+    T azimuth_to_wpt, distance_to_wpt;
+    vector_to_waypoint(boat_lat, boat_lon, &azimuth_to_wpt, &distance_to_wpt);
+    T vmg_tack_angle = find_vmg_optimal_tack_angle(wind_speed);
+    T wind_direction_abs = M::fmod(compass + wind_vane_relative + T(360.0), T(360.0));
+    T port_tack_target_hdg = M::fmod(wind_direction_abs - vmg_tack_angle + T(360.0), T(360.0));
+    T starboard_tack_target_hdg = M::fmod(wind_direction_abs + vmg_tack_angle + T(360.0), T(360.0));
+    
+    // Cooldown check - prevent rapid decision changes (unsigned difference is wrap-around safe)
+    if (last_decision_time > 0 && (current_time - last_decision_time < DECISION_COOLDOWN_MS) && 
         last_raw_optimal_heading_set) {
-        Serial.println("DEBUG: In decision cooldown, maintaining course");
+        TRACE_DEBUG(EVT_PLANNER_COOLDOWN);
         return last_raw_optimal_heading;
     }
     
     // Check if direct sailing is feasible (conservative no-go zone check)
-    double practical_no_go_angle = 45.0 + NO_GO_ZONE_BUFFER;  // Base no-go + buffer
-    bool can_sail_direct = !is_point_in_no_go_zone_buffered(boat_lat, boat_lon, wpt_lat, wpt_lon,
-                                                           wind_direction_abs, wind_speed, NO_GO_ZONE_BUFFER);
+    T practical_no_go_angle = T(45.0) + NO_GO_ZONE_BUFFER;  // Base no-go + buffer
+    bool can_sail_direct = !is_point_in_no_go_zone_buffered(azimuth_to_wpt, wind_direction_abs, wind_speed,
+                                                           NO_GO_ZONE_BUFFER);
     
     // Decision logic: Direct vs Tacking
     if (current_tack_is_set) {
         // Already on a tack - only switch to direct if very close to waypoint AND direct is clear
         if (can_sail_direct && distance_to_wpt < WAYPOINT_ARRIVAL_DISTANCE) {
-            Serial.println("DEBUG: Switching from tacking to direct sailing near waypoint");
+            TRACE_INFO(EVT_PLANNER_DIRECT_NEAR_WAYPOINT);
             reset_leg_start_conditions();
             last_decision_time = current_time;
             return azimuth_to_wpt;
@@ -211,7 +223,7 @@ double LaylinePathPlanner::calculate_raw_direction(double boat_lat, double boat_
     } else {
         // Not currently tacking
         if (can_sail_direct) {
-            Serial.println("DEBUG: Direct sailing to waypoint");
+            TRACE_DEBUG(EVT_PLANNER_DIRECT);
             reset_leg_start_conditions();
             last_decision_time = current_time;
             return azimuth_to_wpt;
@@ -222,7 +234,7 @@ double LaylinePathPlanner::calculate_raw_direction(double boat_lat, double boat_
                 initial_lon = boat_lon;
                 initial_time = current_time;
                 leg_initialized = true;
-                Serial.println("DEBUG: Initializing new upwind leg");
+                TRACE_INFO(EVT_PLANNER_UPWIND_LEG);
             }
         }
     }
@@ -231,18 +243,25 @@ double LaylinePathPlanner::calculate_raw_direction(double boat_lat, double boat_
     
     // Initial tack selection for this leg
     if (!current_tack_is_set) {
-        if (!initial_tack_chosen_for_leg) {
+        if (!initial_tack_chosen_for_leg && preferred_tack_is_set) {
+            // Board picked from the leg bearing when the previous mark was rounded
+            current_tack_is_port = preferred_tack_is_port;
+            current_tack_is_set = true;
+            initial_tack_chosen_for_leg = true;
+            preferred_tack_is_set = false;
+            TRACE_INFO(EVT_PLANNER_INITIAL_TACK, current_tack_is_port, true);
+        } else if (!initial_tack_chosen_for_leg) {
             // Choose tack requiring minimal turning from current heading
-            double port_hdg_diff = fabs(fmod(port_tack_target_hdg - compass + 180.0, 360.0) - 180.0);
-            double stbd_hdg_diff = fabs(fmod(starboard_tack_target_hdg - compass + 180.0, 360.0) - 180.0);
+            T port_hdg_diff = M::fabs(M::fmod(port_tack_target_hdg - compass + T(540.0), T(360.0)) - T(180.0));
+            T stbd_hdg_diff = M::fabs(M::fmod(starboard_tack_target_hdg - compass + T(540.0), T(360.0)) - T(180.0));
             current_tack_is_port = (port_hdg_diff < stbd_hdg_diff);
             current_tack_is_set = true;
             initial_tack_chosen_for_leg = true;
-            Serial.printf("DEBUG: Initial tack selected: %s\n", current_tack_is_port ? "PORT" : "STARBOARD");
+            TRACE_INFO(EVT_PLANNER_INITIAL_TACK, current_tack_is_port, false);
         } else {
             // Fallback: choose based on waypoint bearing
-            double angle_diff_port = fabs(fmod(port_tack_target_hdg - azimuth_to_wpt + 180.0, 360.0) - 180.0);
-            double angle_diff_starboard = fabs(fmod(starboard_tack_target_hdg - azimuth_to_wpt + 180.0, 360.0) - 180.0);
+            T angle_diff_port = M::fabs(M::fmod(port_tack_target_hdg - azimuth_to_wpt + T(540.0), T(360.0)) - T(180.0));
+            T angle_diff_starboard = M::fabs(M::fmod(starboard_tack_target_hdg - azimuth_to_wpt + T(540.0), T(360.0)) - T(180.0));
             current_tack_is_port = (angle_diff_port < angle_diff_starboard);
             current_tack_is_set = true;
         }
@@ -255,29 +274,28 @@ double LaylinePathPlanner::calculate_raw_direction(double boat_lat, double boat_
     
     // Beginning of leg protection - prevent premature tacking
     if (leg_initialized && initial_tack_chosen_for_leg) {
-        double distance_traveled = calculate_distance(boat_lat, boat_lon, initial_lat, initial_lon);
-        double time_elapsed = current_time - initial_time;
+        T bearing_traveled, distance_traveled;
+        leg_vector(initial_lat, initial_lon, boat_lat, boat_lon, &bearing_traveled, &distance_traveled);
+        uint32_t time_elapsed = current_time - initial_time;
         
-        if (distance_traveled < MINIMUM_INITIAL_DISTANCE || time_elapsed < MINIMUM_INITIAL_TIME) {
-            Serial.printf("DEBUG: Beginning protection active - traveled: %.1fm, elapsed: %.1fs\n", 
-                         distance_traveled, time_elapsed);
+        if (distance_traveled < MINIMUM_INITIAL_DISTANCE || time_elapsed < MINIMUM_INITIAL_TIME_MS) {
+            TRACE_DEBUG(EVT_PLANNER_BEGIN_PROTECTION, M::to_double(distance_traveled), time_elapsed / 1000.0);
             return current_tack_is_port ? port_tack_target_hdg : starboard_tack_target_hdg;
         }
     }
     
     // Layline crossing detection with enhanced margins
-    double bearing_to_wpt = calculate_azimuth(boat_lat, boat_lon, wpt_lat, wpt_lon);
-    double relative_wpt_bearing_to_wind = fmod(bearing_to_wpt - wind_direction_abs + 180.0, 360.0) - 180.0;
+    T relative_wpt_bearing_to_wind = M::fmod(azimuth_to_wpt - wind_direction_abs + T(540.0), T(360.0)) - T(180.0);
     
     // Dynamic layline margin calculation
-    double wind_push_factor = (wind_speed > 5.0) ? fmin((wind_speed - 5.0) * 2.5, 20.0) : 0.0;
-    double distance_factor = fmin(15.0, fmax(7.0, distance_to_wpt / 10.0));
-    double effective_layline_check_angle = vmg_tack_angle + TACK_HYSTERESIS_ANGLE_MARGIN + 
-                                         fmax(wind_push_factor, distance_factor);
+    T wind_push_factor = (wind_speed > T(5.0)) ? M::fmin((wind_speed - T(5.0)) * T(2.5), T(20.0)) : T(0.0);
+    T distance_factor = M::fmin(T(15.0), M::fmax(T(7.0), distance_to_wpt / T(10.0)));
+    T effective_layline_check_angle = vmg_tack_angle + TACK_HYSTERESIS_ANGLE_MARGIN + 
+                                      M::fmax(wind_push_factor, distance_factor);
     
     // Require more confirmations when far from waypoint
     int required_confirmation = TACK_CONFIRMATION_THRESHOLD;
-    if (distance_to_wpt > 50.0) {
+    if (distance_to_wpt > T(50.0)) {
         required_confirmation = (int)(TACK_CONFIRMATION_THRESHOLD * 1.5);
     }
     
@@ -306,20 +324,17 @@ double LaylinePathPlanner::calculate_raw_direction(double boat_lat, double boat_
             pending_tack_is_port = newly_proposed_tack_is_port;
             pending_tack_is_set = true;
             tack_confirmation_count = 1;
-            Serial.printf("DEBUG: Tack to %s proposed (conf %d/%d)\n", 
-                         newly_proposed_tack_is_port ? "PORT" : "STARBOARD", 
-                         tack_confirmation_count, required_confirmation);
+            TRACE_DEBUG(EVT_PLANNER_TACK_PROPOSED, newly_proposed_tack_is_port,
+                        tack_confirmation_count, required_confirmation);
         } else {
             // Same tack proposal continues
             tack_confirmation_count++;
-            Serial.printf("DEBUG: Tack proposal continues (conf %d/%d)\n", 
-                         tack_confirmation_count, required_confirmation);
+            TRACE_DEBUG(EVT_PLANNER_TACK_CONTINUES, tack_confirmation_count, required_confirmation);
         }
         
         if (tack_confirmation_count >= required_confirmation) {
             // CONFIRMED TACK
-            Serial.printf("DEBUG: *** TACK CONFIRMED to %s ***\n", 
-                         pending_tack_is_port ? "PORT" : "STARBOARD");
+            TRACE_INFO(EVT_PLANNER_TACK_CONFIRMED, pending_tack_is_port);
             current_tack_is_port = pending_tack_is_port;
             pending_tack_is_set = false;
             tack_confirmation_count = 0;
@@ -328,7 +343,7 @@ double LaylinePathPlanner::calculate_raw_direction(double boat_lat, double boat_
     } else {
         // No tack conditions met - reset pending if it existed
         if (pending_tack_is_set) {
-            Serial.println("DEBUG: Tack conditions no longer met, resetting confirmation");
+            TRACE_DEBUG(EVT_PLANNER_TACK_CANCELLED);
             pending_tack_is_set = false;
             tack_confirmation_count = 0;
         }
@@ -341,11 +356,12 @@ double LaylinePathPlanner::calculate_raw_direction(double boat_lat, double boat_
 /**
  * @brief Main entry point for direction calculation with smoothing
  */
-double LaylinePathPlanner::calculate_direction(double boat_lat, double boat_lon, double waypoint_lat, double waypoint_lon,
-                                              double compass, double wind_vane, double wind_speed, double current_time) {
+template <typename T>
+T BasicLaylinePathPlanner<T>::calculate_direction(T boat_lat, T boat_lon, T waypoint_lat, T waypoint_lon,
+                                                  T compass, T wind_vane, T wind_speed, uint32_t current_time) {
     // Get raw optimal heading from decision logic
-    double raw_heading_decision = calculate_raw_direction(boat_lat, boat_lon, waypoint_lat, waypoint_lon,
-                                                         compass, wind_vane, wind_speed, current_time);
+    T raw_heading_decision = calculate_raw_direction(boat_lat, boat_lon, waypoint_lat, waypoint_lon,
+                                                     compass, wind_vane, wind_speed, current_time);
     
     // Store raw heading for reference
     last_raw_optimal_heading = raw_heading_decision;
@@ -355,63 +371,150 @@ double LaylinePathPlanner::calculate_direction(double boat_lat, double boat_lon,
     return apply_heading_smoothing(raw_heading_decision);
 }
 
+/**
+ * @brief Mission entry point: arrival detection, leg switch and lookahead
+ */
+template <typename T>
+T BasicLaylinePathPlanner<T>::calculate_mission_direction(BasicMission<T>& mission, T boat_lat, T boat_lon,
+                                                          T compass, T wind_vane, T wind_speed, uint32_t current_time) {
+    const MissionLeg<T>* leg = mission.active_leg();
+    if (leg == NULL) {
+        return compass;
+    }
+    adopt_mission_leg(*leg);
+    
+    T azimuth_to_wpt, distance_to_wpt;
+    vector_to_waypoint(boat_lat, boat_lon, &azimuth_to_wpt, &distance_to_wpt);
+    if (distance_to_wpt < WAYPOINT_ARRIVAL_DISTANCE) {
+        TRACE_INFO(EVT_PLANNER_WAYPOINT_REACHED, mission.active_index(), M::to_double(distance_to_wpt));
+        mission.advance();
+        leg = mission.active_leg();
+        if (leg == NULL) {
+            TRACE_INFO(EVT_PLANNER_MISSION_COMPLETE);
+            return compass;
+        }
+        // New leg: no cooldown inherited from the previous mark, and if it is a
+        // beat start on the board heading closest to the leg bearing
+        adopt_mission_leg(*leg);
+        reset_leg_start_conditions();
+        last_decision_time = 0;
+        
+        T vmg_tack_angle = find_vmg_optimal_tack_angle(wind_speed);
+        T wind_direction_abs = M::fmod(compass + wind_vane + T(360.0), T(360.0));
+        T port_diff = M::fabs(M::fmod(wind_direction_abs - vmg_tack_angle - leg->bearing + T(540.0), T(360.0)) - T(180.0));
+        T stbd_diff = M::fabs(M::fmod(wind_direction_abs + vmg_tack_angle - leg->bearing + T(540.0), T(360.0)) - T(180.0));
+        preferred_tack_is_port = port_diff < stbd_diff;
+        preferred_tack_is_set = true;
+    }
+    
+    return calculate_direction(boat_lat, boat_lon, leg->end_lat, leg->end_lon,
+                               compass, wind_vane, wind_speed, current_time);
+}
+
+/**
+ * @brief Select the polar table used for VMG decisions
+ */
+template <typename T>
+void BasicLaylinePathPlanner<T>::set_polar_table(const BasicPolarTable<T>& table) {
+    polar_table = &table;
+}
+
+/**
+ * @brief Replace the blending thresholds and factors of the heading smoother
+ */
+template <typename T>
+void BasicLaylinePathPlanner<T>::set_heading_blend(const HeadingBlend<T>& blend) {
+    heading_smoother.set_blend(blend);
+}
+
 /**
  * @brief Reset planner state for new waypoint or simulation reset
  */
-void LaylinePathPlanner::reset_planner_state() {
+template <typename T>
+void BasicLaylinePathPlanner<T>::reset_planner_state() {
     reset_leg_start_conditions();
-    last_optimal_heading_set = false;
     last_raw_optimal_heading_set = false;
-    last_decision_time = 0.0;
-    heading_history.clear();
-    Serial.println("DEBUG: LaylinePathPlanner state completely reset");
+    last_decision_time = 0;
+    leg_frame.invalidate();
+    frame_wpt_in_range = false;
+    heading_smoother.reset();
+    TRACE_INFO(EVT_PLANNER_RESET);
 }
 
 // Static utility functions (shared with original implementation)
 
-double LaylinePathPlanner::calculate_azimuth(double lat1, double lon1, double lat2, double lon2) {
-    double dLon = (lon2 - lon1) * (PI / 180.0);
-    double lat1_rad = lat1 * (PI / 180.0);
-    double lat2_rad = lat2 * (PI / 180.0);
+/**
+ * The fixed-point build cannot resolve the spherical formulas below: over a
+ * few hundred metres the haversine term is ~1e-12, far under the Q2.30
+ * resolution. It uses an equirectangular projection around the mid-latitude
+ * instead, which is exact to well under 0.1 % over the ~32 km range Q16.16
+ * can express.
+ */
+template <typename T>
+T BasicLaylinePathPlanner<T>::calculate_azimuth(T lat1, T lon1, T lat2, T lon2) {
+    if (M::IS_FIXED) {
+        // atan2 only needs the ratio: pre-scale both legs so the cos(lat)
+        // product keeps its low bits on short legs (|dlon| * 64 < 32768)
+        const T SCALE = T(64);
+        T mid_lat = (lat1 + lat2) / T(2);
+        T east = ((lon2 - lon1) * SCALE) * M::cos_deg(mid_lat);
+        T north = (lat2 - lat1) * SCALE;
+        return M::fmod(M::atan2_deg(east, north) + T(360.0), T(360.0));
+    }
+
+    T dLon = lon2 - lon1;
     
-    double y = sin(dLon) * cos(lat2_rad);
-    double x = cos(lat1_rad) * sin(lat2_rad) - sin(lat1_rad) * cos(lat2_rad) * cos(dLon);
+    T y = M::sin_deg(dLon) * M::cos_deg(lat2);
+    T x = M::cos_deg(lat1) * M::sin_deg(lat2) - M::sin_deg(lat1) * M::cos_deg(lat2) * M::cos_deg(dLon);
     
-    double azimuth = atan2(y, x) * (180.0 / PI);
-    return fmod(azimuth + 360.0, 360.0);
+    T azimuth = M::atan2_deg(y, x);
+    return M::fmod(azimuth + T(360.0), T(360.0));
 }
 
-double LaylinePathPlanner::calculate_distance(double lat1, double lon1, double lat2, double lon2) {
-    const double R = 6371000;  // Earth radius in meters
-    double lat1_rad = lat1 * PI / 180.0;
-    double lat2_rad = lat2 * PI / 180.0;
-    double dLat = (lat2 - lat1) * PI / 180.0;
-    double dLon = (lon2 - lon1) * PI / 180.0;
+template <typename T>
+T BasicLaylinePathPlanner<T>::calculate_distance(T lat1, T lon1, T lat2, T lon2) {
+    if (M::IS_FIXED) {
+        // Earth radius * PI / 180 = 111194.93 m/deg, applied in two steps
+        // because the constant itself does not fit in Q16.16
+        const T KM_PER_DEGREE = T(111.19493);
+        T mid_lat = (lat1 + lat2) / T(2);
+        T east_km = (lon2 - lon1) * M::cos_deg(mid_lat) * KM_PER_DEGREE;
+        T north_km = (lat2 - lat1) * KM_PER_DEGREE;
+        return M::hypot(east_km * T(1000), north_km * T(1000));
+    }
+
+    const T R = T(6371000.0);  // Earth radius in meters
+    T dLat = lat2 - lat1;
+    T dLon = lon2 - lon1;
     
-    double a = sin(dLat/2) * sin(dLat/2) + 
-               cos(lat1_rad) * cos(lat2_rad) * sin(dLon/2) * sin(dLon/2);
-    double c = 2 * atan2(sqrt(a), sqrt(1-a));
+    T sin_half_dlat = M::sin_deg(dLat / T(2));
+    T sin_half_dlon = M::sin_deg(dLon / T(2));
+    T a = sin_half_dlat * sin_half_dlat + 
+          M::cos_deg(lat1) * M::cos_deg(lat2) * sin_half_dlon * sin_half_dlon;
+    T c = T(2) * M::atan2_deg(M::sqrt(a), M::sqrt(T(1) - a)) * T(PI / 180.0);
     
     return R * c;
 }
 
-void LaylinePathPlanner::define_no_go_zone(double wind_direction, double wind_speed, double* min_angle, double* max_angle) {
-    const double NO_GO_ZONE_ANGLE = 45.0;
-    double wind_abs = fmod(wind_direction + 360.0, 360.0);
+template <typename T>
+void BasicLaylinePathPlanner<T>::define_no_go_zone(T wind_direction, T wind_speed, T* min_angle, T* max_angle) {
+    const T NO_GO_ZONE_ANGLE = T(45.0);
+    T wind_abs = M::fmod(wind_direction + T(360.0), T(360.0));
     
     // Adjust no-go zone based on wind speed
-    double adjusted_no_go = NO_GO_ZONE_ANGLE;
-    if (wind_speed > 15) {
-        adjusted_no_go = NO_GO_ZONE_ANGLE * 1.2;  // Wider no-go in strong winds
-    } else if (wind_speed < 5) {
-        adjusted_no_go = NO_GO_ZONE_ANGLE * 0.8;  // Narrower no-go in light winds
+    T adjusted_no_go = NO_GO_ZONE_ANGLE;
+    if (wind_speed > T(15)) {
+        adjusted_no_go = NO_GO_ZONE_ANGLE * T(1.2);  // Wider no-go in strong winds
+    } else if (wind_speed < T(5)) {
+        adjusted_no_go = NO_GO_ZONE_ANGLE * T(0.8);  // Narrower no-go in light winds
     }
     
-    *min_angle = fmod(wind_abs - adjusted_no_go + 360.0, 360.0);
-    *max_angle = fmod(wind_abs + adjusted_no_go, 360.0);
+    *min_angle = M::fmod(wind_abs - adjusted_no_go + T(360.0), T(360.0));
+    *max_angle = M::fmod(wind_abs + adjusted_no_go, T(360.0));
 }
 
-bool LaylinePathPlanner::is_in_no_go_zone(double azimuth, double min_angle, double max_angle) {
+template <typename T>
+bool BasicLaylinePathPlanner<T>::is_in_no_go_zone(T azimuth, T min_angle, T max_angle) {
     if (min_angle < max_angle) {
         return (azimuth >= min_angle && azimuth <= max_angle);
     } else {
@@ -419,21 +522,13 @@ bool LaylinePathPlanner::is_in_no_go_zone(double azimuth, double min_angle, doub
     }
 }
 
-double LaylinePathPlanner::get_boat_speed_from_polars(double wind_angle, double wind_speed) {
-    double abs_wind_angle = fabs(wind_angle);
-    while (abs_wind_angle > 180) {
-        abs_wind_angle = 360 - abs_wind_angle;
-    }
-    
-    if (abs_wind_angle < 35) {
-        return 0.0;  // Can't sail this close to the wind
-    } else if (abs_wind_angle < 50) {
-        return 0.5 * wind_speed * 0.4;  // Close-hauled, reduced from original
-    } else if (abs_wind_angle < 90) {
-        return 0.8 * wind_speed * 0.5;  // Reaching
-    } else if (abs_wind_angle < 150) {
-        return 1.0 * wind_speed * 0.6;  // Broad reach, fastest point of sail
-    } else {
-        return 0.7 * wind_speed * 0.5;  // Running
-    }
+template <typename T>
+T BasicLaylinePathPlanner<T>::get_boat_speed_from_polars(T wind_angle, T wind_speed) {
+    return BasicPolarTable<T>::default_table().boat_speed(wind_angle, wind_speed);
 }
+
+// Scalar instantiations: PlannerScalar is used by the firmware, the others
+// stay available for tolerance tests and host-side comparisons
+template class BasicLaylinePathPlanner<double>;
+template class BasicLaylinePathPlanner<float>;
+template class BasicLaylinePathPlanner<q16_16>;
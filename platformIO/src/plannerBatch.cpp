@@ -0,0 +1,164 @@
+#include "plannerBatch.h"
+#include <math.h>
+
+// Every helper below is branch-free so the loops that inline them vectorise
+#if defined(__GNUC__)
+#define BATCH_INLINE static inline __attribute__((always_inline))
+#else
+#define BATCH_INLINE static inline
+#endif
+
+static const float RAD_TO_DEG = 57.29577951308232f;
+
+BATCH_INLINE float select(bool condition, float a, float b) {
+    return condition ? a : b;
+}
+
+BATCH_INLINE float absolute(float x) {
+    return select(x < 0.0f, -x, x);
+}
+
+BATCH_INLINE float minimum(float a, float b) {
+    return select(a < b, a, b);
+}
+
+BATCH_INLINE float maximum(float a, float b) {
+    return select(a > b, a, b);
+}
+
+/**
+ * @brief Angle in [0, 360), truncation instead of fmodf
+ */
+BATCH_INLINE float wrap_360(float deg) {
+    float turns = (float)(int32_t)(deg * (1.0f / 360.0f));
+    float r = deg - 360.0f * turns;
+    return select(r < 0.0f, r + 360.0f, r);
+}
+
+/**
+ * @brief Angle in [-180, 180)
+ */
+BATCH_INLINE float wrap_180(float deg) {
+    return wrap_360(deg + 180.0f) - 180.0f;
+}
+
+/**
+ * @brief atan2 in degrees: minimax polynomial on [0, 1] and octant folding
+ */
+BATCH_INLINE float fast_atan2_deg(float y, float x) {
+    float ax = absolute(x);
+    float ay = absolute(y);
+    float hi = maximum(ax, ay);
+    float lo = minimum(ax, ay);
+    float a = lo / maximum(hi, 1e-30f);
+    float s = a * a;
+    float r = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f +
+              s * (0.05265332f + s * -0.01172120f)))));
+    r *= RAD_TO_DEG;
+    r = select(ay > ax, 90.0f - r, r);
+    r = select(x < 0.0f, 180.0f - r, r);
+    return select(y < 0.0f, -r, r);
+}
+
+float PlannerBatch::atan2_deg(float y, float x) {
+    return fast_atan2_deg(y, x);
+}
+
+/**
+ * @brief Constructor - Turn the polar VMG cache into ramp slopes
+ *
+ * upwind_vmg_angle interpolates linearly between 1 m/s bins and clamps
+ * outside the table, which is exactly angle0 + sum of slope_k * clamp(tws - k, 0, 1).
+ */
+PlannerBatch::PlannerBatch(const BasicPolarTable<float>& polar) {
+    vmg_angle0 = polar.upwind_vmg_angle(0.0f);
+    float previous = vmg_angle0;
+    for (int k = 0; k < TWS_COUNT - 1; k++) {
+        float next = polar.upwind_vmg_angle((float)((k + 1) * PolarGrid::TWS_STEP));
+        vmg_slope[k] = next - previous;
+        previous = next;
+    }
+}
+
+void PlannerBatch::vectors(const float* __restrict east, const float* __restrict north,
+                           float* __restrict bearing, float* __restrict length, int count) {
+    for (int k = 0; k < count; k++) {
+        float e = east[k];
+        float n = north[k];
+        bearing[k] = wrap_360(fast_atan2_deg(e, n));
+        length[k] = sqrtf(e * e + n * n);
+    }
+}
+
+/**
+ * @brief Decision core over count states
+ *
+ * Same formulas as calculate_raw_direction, find_vmg_optimal_tack_angle and
+ * define_no_go_zone, written as selects. The arrays are restrict parameters
+ * of a plain function so the compiler needs no run-time alias checks.
+ */
+static void evaluate_kernel(const float* __restrict boat_east, const float* __restrict boat_north,
+                            const float* __restrict wpt_east, const float* __restrict wpt_north,
+                            const float* __restrict compass, const float* __restrict wind_vane,
+                            const float* __restrict wind_speed, const uint8_t* __restrict on_port_tack,
+                            float* __restrict azimuth, float* __restrict distance,
+                            float* __restrict port_heading, float* __restrict starboard_heading,
+                            uint8_t* __restrict can_sail_direct, uint8_t* __restrict tack_proposed,
+                            uint8_t* __restrict required_confirmations,
+                            const PlannerBatchParams& params, float vmg_angle0,
+                            const float (&vmg_slope)[PolarGrid::TWS_COUNT - 1], int count) {
+    const float no_go_buffer = params.no_go_buffer;
+    const float hysteresis = params.tack_hysteresis_margin;
+    const float far_distance = params.far_distance;
+    const uint8_t near_confirmations = (uint8_t)params.tack_confirmation_threshold;
+    const uint8_t far_confirmations = (uint8_t)(params.tack_confirmation_threshold * 1.5);
+    float slope[PolarGrid::TWS_COUNT - 1];
+    for (int j = 0; j < PolarGrid::TWS_COUNT - 1; j++) {
+        slope[j] = vmg_slope[j];
+    }
+
+    for (int k = 0; k < count; k++) {
+        // Bearing and distance to the waypoint
+        float east = wpt_east[k] - boat_east[k];
+        float north = wpt_north[k] - boat_north[k];
+        float az = wrap_360(fast_atan2_deg(east, north));
+        float dist = sqrtf(east * east + north * north);
+        float ws = wind_speed[k];
+
+        // VMG-optimal tack angle with the strong-wind safety buffer
+        float vmg = vmg_angle0;
+        for (int j = 0; j < PolarGrid::TWS_COUNT - 1; j++) {
+            vmg += slope[j] * minimum(maximum(ws - (float)j, 0.0f), 1.0f);
+        }
+        float wind_buffer = select(ws > 6.0f, (ws - 6.0f) * 0.8f, 0.0f);
+        float vmg_tack = maximum(vmg, 40.0f) + 5.0f + wind_buffer;
+
+        float wind_abs = wrap_360(compass[k] + wind_vane[k]);
+        port_heading[k] = wrap_360(wind_abs - vmg_tack);
+        starboard_heading[k] = wrap_360(wind_abs + vmg_tack);
+
+        // Buffered no-go zone, half angle scaled with the wind speed
+        float relative = wrap_180(az - wind_abs);
+        float no_go = select(ws > 15.0f, 54.0f, select(ws < 5.0f, 36.0f, 45.0f));
+        can_sail_direct[k] = absolute(relative) > no_go + no_go_buffer;
+
+        // Layline crossing on the current board
+        float wind_push = select(ws > 5.0f, minimum((ws - 5.0f) * 2.5f, 20.0f), 0.0f);
+        float distance_factor = minimum(15.0f, maximum(7.0f, dist * 0.1f));
+        float layline = vmg_tack + hysteresis + maximum(wind_push, distance_factor);
+        bool port = on_port_tack[k] != 0;
+        tack_proposed[k] = port ? (relative > layline) : (relative < -layline);
+        required_confirmations[k] = dist > far_distance ? far_confirmations : near_confirmations;
+
+        azimuth[k] = az;
+        distance[k] = dist;
+    }
+}
+
+void PlannerBatch::evaluate(const PlannerBatchStates& states, const PlannerBatchResults& results, int count) const {
+    evaluate_kernel(states.boat_east, states.boat_north, states.wpt_east, states.wpt_north,
+                    states.compass, states.wind_vane, states.wind_speed, states.on_port_tack,
+                    results.azimuth, results.distance, results.port_heading, results.starboard_heading,
+                    results.can_sail_direct, results.tack_proposed, results.required_confirmations,
+                    params, vmg_angle0, vmg_slope, count);
+}
@@ -0,0 +1,181 @@
+#include "polarTable.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <LittleFS.h>
+#else
+#include <stdio.h>
+#endif
+
+/**
+ * @brief Constructor - Initialize the table from the compile-time polar model
+ */
+template <typename T>
+BasicPolarTable<T>::BasicPolarTable() {
+    assign(DEFAULT_GRID);
+}
+
+template <typename T>
+void BasicPolarTable<T>::assign(const PolarGrid& grid) {
+    for (int i = 0; i < PolarGrid::TWA_COUNT; i++) {
+        for (int j = 0; j < PolarGrid::TWS_COUNT; j++) {
+            speed[i][j] = T(grid.speed[i][j]);
+        }
+    }
+    for (int j = 0; j < PolarGrid::TWS_COUNT; j++) {
+        upwind_twa[j] = T(grid.upwind_twa[j]);
+        downwind_twa[j] = T(grid.downwind_twa[j]);
+    }
+}
+
+template <typename T>
+void BasicPolarTable<T>::locate_tws(T tws, int* index, T* fraction) {
+    const T max_tws = T((PolarGrid::TWS_COUNT - 1) * PolarGrid::TWS_STEP);
+    if (!(tws > T(0))) {
+        *index = 0;
+        *fraction = T(0);
+        return;
+    }
+    if (tws >= max_tws) {
+        *index = PolarGrid::TWS_COUNT - 2;
+        *fraction = T(1);
+        return;
+    }
+    T position = tws / T(PolarGrid::TWS_STEP);
+    *index = static_cast<int>(position);
+    *fraction = position - T(*index);
+}
+
+/**
+ * @brief Bilinear interpolation between the four surrounding grid nodes
+ */
+template <typename T>
+T BasicPolarTable<T>::boat_speed(T twa, T tws) const {
+    // Fold the angle onto [0, 180]: the polar is symmetric port/starboard
+    T abs_twa = M::fabs(M::fmod(twa, T(360.0)));
+    if (abs_twa > T(180)) {
+        abs_twa = T(360) - abs_twa;
+    }
+
+    T twa_position = abs_twa / T(PolarGrid::TWA_STEP);
+    int i = static_cast<int>(twa_position);
+    if (i > PolarGrid::TWA_COUNT - 2) {
+        i = PolarGrid::TWA_COUNT - 2;
+    }
+    T twa_fraction = twa_position - T(i);
+
+    int j;
+    T tws_fraction;
+    locate_tws(tws, &j, &tws_fraction);
+
+    T low = speed[i][j] + (speed[i + 1][j] - speed[i][j]) * twa_fraction;
+    T high = speed[i][j + 1] + (speed[i + 1][j + 1] - speed[i][j + 1]) * twa_fraction;
+    return low + (high - low) * tws_fraction;
+}
+
+template <typename T>
+T BasicPolarTable<T>::upwind_vmg_angle(T tws) const {
+    int j;
+    T fraction;
+    locate_tws(tws, &j, &fraction);
+    return upwind_twa[j] + (upwind_twa[j + 1] - upwind_twa[j]) * fraction;
+}
+
+template <typename T>
+T BasicPolarTable<T>::downwind_vmg_angle(T tws) const {
+    int j;
+    T fraction;
+    locate_tws(tws, &j, &fraction);
+    return downwind_twa[j] + (downwind_twa[j + 1] - downwind_twa[j]) * fraction;
+}
+
+template <typename T>
+void BasicPolarTable<T>::set_speeds(const double speeds[PolarGrid::TWA_COUNT][PolarGrid::TWS_COUNT]) {
+    // Build the double grid first so the VMG search runs once, at full precision
+    PolarGrid grid = {};
+    memcpy(grid.speed, speeds, sizeof(grid.speed));
+    PolarModel::fill_vmg_cache(grid);
+    assign(grid);
+}
+
+/**
+ * @brief Parse one CSV row of TWS_COUNT speeds
+ * @return true if the row held exactly TWS_COUNT numbers
+ */
+static bool parse_polar_row(const char* line, double row[PolarGrid::TWS_COUNT]) {
+    const char* cursor = line;
+    for (int j = 0; j < PolarGrid::TWS_COUNT; j++) {
+        char* end;
+        row[j] = strtod(cursor, &end);
+        if (end == cursor) {
+            return false;
+        }
+        cursor = end;
+        while (*cursor == ' ' || *cursor == '\t') cursor++;
+        if (j < PolarGrid::TWS_COUNT - 1) {
+            if (*cursor != ',') {
+                return false;
+            }
+            cursor++;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool BasicPolarTable<T>::load_from_file(const char* path) {
+    static double rows[PolarGrid::TWA_COUNT][PolarGrid::TWS_COUNT];
+    char line[160];
+    int row_count = 0;
+
+#ifdef ARDUINO
+    if (!LittleFS.begin()) {
+        Serial.println("Polar: LittleFS mount failed, keeping default polar");
+        return false;
+    }
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        Serial.printf("Polar: %s not found, keeping default polar\n", path);
+        return false;
+    }
+    while (file.available() && row_count < PolarGrid::TWA_COUNT) {
+        size_t length = file.readBytesUntil('\n', line, sizeof(line) - 1);
+        line[length] = '\0';
+#else
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+    while (row_count < PolarGrid::TWA_COUNT && fgets(line, sizeof(line), file) != NULL) {
+#endif
+        if (line[0] == '#' || line[0] == '\r' || line[0] == '\n' || line[0] == '\0') {
+            continue;
+        }
+        if (!parse_polar_row(line, rows[row_count])) {
+            break;
+        }
+        row_count++;
+    }
+#ifdef ARDUINO
+    file.close();
+#else
+    fclose(file);
+#endif
+
+    if (row_count != PolarGrid::TWA_COUNT) {
+        return false;
+    }
+    set_speeds(rows);
+    return true;
+}
+
+template <typename T>
+const BasicPolarTable<T>& BasicPolarTable<T>::default_table() {
+    static const BasicPolarTable<T> table;
+    return table;
+}
+
+template class BasicPolarTable<double>;
+template class BasicPolarTable<float>;
+template class BasicPolarTable<q16_16>;
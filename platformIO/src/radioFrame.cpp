@@ -0,0 +1,96 @@
+#include "radioFrame.h"
+
+static bool is_space(uint8_t c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// 0-15, or -1 if not a hex digit
+static int hex_value(uint8_t c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+RadioFrameParser::RadioFrameParser()
+    : state(IDLE), drop(RADIO_DROP_TOO_LONG), rtk_value(0), length(0), trimmed_length(0) {
+    current.text[0] = '\0';
+}
+
+RadioEvent RadioFrameParser::feed(uint8_t byte) {
+    switch (state) {
+    case IDLE:
+        if (byte == RADIO_FRAME_END || is_space(byte)) {
+            return RADIO_NONE;
+        }
+        state = TEXT;
+        length = 0;
+        trimmed_length = 0;
+        // First character of the command
+        [[fallthrough]];
+    case TEXT:
+        if (byte == RADIO_FRAME_END) {
+            current.text[trimmed_length] = '\0';
+            state = IDLE;
+            return RADIO_COMMAND;
+        }
+        // "rtk:" switches to the streamed hex decoding
+        if (byte == ':' && length == 3 && current.text[0] == 'r' && current.text[1] == 't' && current.text[2] == 'k') {
+            state = RTK_HIGH;
+            return RADIO_NONE;
+        }
+        if (length >= RADIO_COMMAND_SIZE - 1) {
+            state = DISCARD;
+            drop = RADIO_DROP_TOO_LONG;
+            return RADIO_DROPPED;
+        }
+        current.text[length++] = (char)byte;
+        if (!is_space(byte)) {
+            trimmed_length = length;
+        }
+        return RADIO_NONE;
+
+    case RTK_HIGH:
+    case RTK_LOW: {
+        if (byte == RADIO_FRAME_END) {
+            bool odd_digits = state == RTK_LOW;
+            state = IDLE;
+            if (odd_digits) {
+                drop = RADIO_DROP_BAD_HEX;
+                return RADIO_DROPPED;
+            }
+            return RADIO_NONE;
+        }
+        if (is_space(byte)) {
+            return RADIO_NONE;
+        }
+        int nibble = hex_value(byte);
+        if (nibble < 0) {
+            state = DISCARD;
+            drop = RADIO_DROP_BAD_HEX;
+            return RADIO_DROPPED;
+        }
+        if (state == RTK_HIGH) {
+            rtk_value = (uint8_t)(nibble << 4);
+            state = RTK_LOW;
+            return RADIO_NONE;
+        }
+        rtk_value |= (uint8_t)nibble;
+        state = RTK_HIGH;
+        return RADIO_RTK_BYTE;
+    }
+
+    case DISCARD:
+        if (byte == RADIO_FRAME_END) {
+            state = IDLE;
+        }
+        return RADIO_NONE;
+    }
+    return RADIO_NONE;
+}
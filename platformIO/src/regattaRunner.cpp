@@ -0,0 +1,214 @@
+#include "regattaRunner.h"
+#include "pathPlanification.h"
+#include "pipeline.h"
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#ifndef ARDUINO
+#include <atomic>
+#include <thread>
+#endif
+
+static const double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+RegattaRunner::RegattaRunner(const RegattaSettings& new_settings) {
+    settings = new_settings;
+}
+
+/**
+ * @brief Autopilot of simulator.py: proportional rudder and sail table
+ */
+static void autopilot(Sailboat& boat, double target_heading, double wind_speed) {
+    double heading_error = fmod(target_heading - boat.heading + 540.0, 360.0) - 180.0;
+    double rudder = heading_error / 30.0;
+    boat.set_rudder(rudder < -1.0 ? -1.0 : (rudder > 1.0 ? 1.0 : rudder));
+
+    double wind_angle = fabs(boat.true_wind_heading);
+    double sail;
+    if (wind_angle < 50.0) {
+        sail = wind_speed > 8.0 ? 0.15 : 0.1;   // Close hauled, eased in stronger wind
+    } else if (wind_angle < 90.0) {
+        sail = 0.4;                             // Close reach
+    } else if (wind_angle < 150.0) {
+        sail = 0.7;                             // Beam to broad reach
+    } else {
+        sail = 0.9;                             // Running
+    }
+    boat.set_sail(sail);
+}
+
+ScenarioResult RegattaRunner::run_scenario(int index) const {
+    SimRandom rng(settings.seed + (uint64_t)index);
+
+    // Draw the scenario
+    double side = rng.uniform() < 0.5 ? -1.0 : 1.0;
+    double wind_angle = side * rng.uniform(settings.wind_angle_min_deg, settings.wind_angle_max_deg);
+    double wind_speed = rng.uniform(settings.wind_speed_min, settings.wind_speed_max);
+    double mean_wind_heading = settings.course_bearing_deg + wind_angle;
+    double shift_amplitude = rng.uniform(0.0, settings.shift_amplitude_max_deg);
+    double shift_period = rng.uniform(settings.shift_period_min_s, settings.shift_period_max_s);
+    double shift_phase = rng.uniform(0.0, 360.0);
+    double persistent_rate = rng.uniform(-settings.persistent_shift_max_deg_per_min,
+                                         settings.persistent_shift_max_deg_per_min) / 60.0;
+    double gust_amplitude = wind_speed * rng.uniform(0.0, settings.gust_fraction_max);
+    double gust_period = rng.uniform(10.0, 40.0);
+
+    SailboatEnvironment env;
+    env.water_speed = rng.uniform(0.0, settings.current_speed_max);
+    env.water_heading = rng.uniform(0.0, 360.0);
+
+    // Waypoint on the course, flat-earth offset like the simulator
+    double m_per_deg_lat = SailboatPhysics::EARTH_CIRCUMFERENCE / 360.0;
+    double m_per_deg_lon = m_per_deg_lat * cos(settings.start_lat * DEG_TO_RAD);
+    double wpt_lat = settings.start_lat +
+                     settings.course_length_m * cos(settings.course_bearing_deg * DEG_TO_RAD) / m_per_deg_lat;
+    double wpt_lon = settings.start_lon +
+                     settings.course_length_m * sin(settings.course_bearing_deg * DEG_TO_RAD) / m_per_deg_lon;
+
+    Sailboat boat(settings.start_lat, settings.start_lon, settings.course_bearing_deg);
+    boat.gps_error_stddev_m = settings.gps_noise_m;
+    boat.wind_vane_error_stddev_deg = settings.wind_vane_noise_deg;
+
+    LaylinePathPlanner planner;
+    ScenarioResult result;
+    result.arrived = false;
+    result.distance_m = 0.0f;
+    result.tacks = 0;
+    result.wind_speed = (float)wind_speed;
+    result.wind_angle = (float)wind_angle;
+
+    const int steps_per_decision = (int)(settings.planner_period_s / settings.dt_s + 0.5);
+    const int steps_per_fix = (int)(settings.fix_period_s / settings.dt_s + 0.5);
+    const long max_steps = (long)(settings.time_limit_s / settings.dt_s);
+    PlannerPacer pacer((uint32_t)(settings.planner_period_s * 1000.0 + 0.5));
+    bool fix_pending = false;
+    int wind_side = 0;
+    double time = 0.0;
+    long step = 0;
+    for (; step < max_steps; step++) {
+        time = step * settings.dt_s;
+        env.wind_speed = fmax(0.0, wind_speed + gust_amplitude * sin(2.0 * 3.14159265358979323846 * time / gust_period));
+        env.wind_heading = mean_wind_heading + persistent_rate * time +
+                           shift_amplitude * sin(2.0 * 3.14159265358979323846 * time / shift_period + shift_phase * DEG_TO_RAD);
+
+        // Physics first, as in simulator.py, so the sensors see the current wind
+        double x_before = boat.x, y_before = boat.y;
+        boat.update(settings.dt_s, env);
+        result.distance_m += (float)hypot(boat.x - x_before, boat.y - y_before);
+
+        // Path planning task on noisy sensors, held by the autopilot between runs
+        bool decide;
+        if (steps_per_fix > 0) {
+            // Woken by each fix, at most once per planner period (pathFinding on the boat)
+            uint32_t now_ms = (uint32_t)(step * settings.dt_s * 1000.0 + 0.5);
+            fix_pending = fix_pending || step % steps_per_fix == 0;
+            decide = fix_pending && pacer.hold_ms(now_ms) == 0;
+            if (decide) {
+                pacer.ran(now_ms);
+                fix_pending = false;
+            }
+        } else {
+            decide = step % steps_per_decision == 0;
+        }
+        if (decide) {
+            double gps_lat, gps_lon;
+            boat.noisy_gps_reading(rng, &gps_lat, &gps_lon);
+            double vane = boat.noisy_wind_vane_reading(rng);
+            PlannerScalar target = planner.calculate_direction(
+                PlannerScalar(gps_lat), PlannerScalar(gps_lon), PlannerScalar(wpt_lat), PlannerScalar(wpt_lon),
+                PlannerScalar(boat.heading), PlannerScalar(vane), PlannerScalar(env.wind_speed),
+                (uint32_t)(time * 1000.0));
+            autopilot(boat, ScalarMath<PlannerScalar>::to_double(target), env.wind_speed);
+        }
+
+        // A tack is the bow crossing the wind; 5 degrees of hysteresis against noise
+        int new_side = boat.true_wind_heading > 5.0 ? 1 : (boat.true_wind_heading < -5.0 ? -1 : wind_side);
+        if (wind_side != 0 && new_side != wind_side && fabs(boat.true_wind_heading) < 90.0) {
+            result.tacks++;
+        }
+        wind_side = new_side;
+
+        double east = (boat.longitude - wpt_lon) * m_per_deg_lon;
+        double north = (boat.latitude - wpt_lat) * m_per_deg_lat;
+        if (hypot(east, north) < settings.arrival_radius_m) {
+            result.arrived = true;
+            step++;
+            break;
+        }
+    }
+    result.time_s = (float)(step * settings.dt_s);
+    return result;
+}
+
+void RegattaRunner::run(ScenarioResult* results, int count, int threads) const {
+#ifndef ARDUINO
+    if (threads > 1 && count > 1) {
+        // Pool of workers pulling the next scenario index
+        std::atomic<int> next(0);
+        std::vector<std::thread> workers;
+        int worker_count = threads < count ? threads : count;
+        for (int w = 0; w < worker_count; w++) {
+            workers.emplace_back([this, results, count, &next]() {
+                for (int k = next.fetch_add(1); k < count; k = next.fetch_add(1)) {
+                    results[k] = run_scenario(k);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        return;
+    }
+#else
+    (void)threads;
+#endif
+    for (int k = 0; k < count; k++) {
+        results[k] = run_scenario(k);
+    }
+}
+
+/**
+ * @brief Mean, standard deviation and nearest-rank percentiles
+ */
+static RegattaDistribution distribution(std::vector<double>& values) {
+    RegattaDistribution d = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    if (values.empty()) {
+        return d;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0.0, sum2 = 0.0;
+    for (double v : values) {
+        sum += v;
+        sum2 += v * v;
+    }
+    size_t n = values.size();
+    d.mean = sum / n;
+    d.stddev = n > 1 ? sqrt(fmax(0.0, (sum2 - sum * d.mean) / (n - 1))) : 0.0;
+    d.min = values.front();
+    d.max = values.back();
+    d.p10 = values[(size_t)(0.10 * (n - 1) + 0.5)];
+    d.p50 = values[(size_t)(0.50 * (n - 1) + 0.5)];
+    d.p90 = values[(size_t)(0.90 * (n - 1) + 0.5)];
+    return d;
+}
+
+RegattaSummary RegattaRunner::summarize(const ScenarioResult* results, int count) {
+    RegattaSummary summary;
+    summary.scenarios = count;
+    summary.arrived = 0;
+
+    std::vector<double> times, tacks, distances;
+    for (int k = 0; k < count; k++) {
+        tacks.push_back(results[k].tacks);
+        if (results[k].arrived) {
+            summary.arrived++;
+            times.push_back(results[k].time_s);
+            distances.push_back(results[k].distance_m);
+        }
+    }
+    summary.time_s = distribution(times);
+    summary.tacks = distribution(tacks);
+    summary.distance_m = distribution(distances);
+    return summary;
+}
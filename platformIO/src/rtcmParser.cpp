@@ -0,0 +1,151 @@
+#include "rtcmParser.h"
+
+// Messages used by the ZED-F9P (HPG firmware): legacy and MSM4/5/7 observations,
+// reference station position and antenna, GLONASS biases, u-blox sub-type
+static const uint16_t forwarded_types[] = {
+    1001, 1002, 1003, 1004, 1005, 1006, 1007, 1009, 1010, 1011, 1012, 1033,
+    1074, 1075, 1077, 1084, 1085, 1087, 1094, 1095, 1097, 1124, 1125, 1127,
+    1230, 4072
+};
+
+struct Crc24Table {
+    uint32_t entry[256];
+    constexpr Crc24Table() : entry() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i << 16;
+            for (int bit = 0; bit < 8; bit++) {
+                crc <<= 1;
+                if (crc & 0x1000000) {
+                    crc ^= 0x1864CFB;
+                }
+            }
+            entry[i] = crc & 0xFFFFFF;
+        }
+    }
+};
+static constexpr Crc24Table crc24_table;
+
+static inline uint32_t crc24_step(uint32_t crc, uint8_t byte) {
+    return ((crc << 8) & 0xFFFFFF) ^ crc24_table.entry[((crc >> 16) ^ byte) & 0xFF];
+}
+
+uint32_t rtcm_crc24q(const uint8_t* data, uint32_t length, uint32_t crc) {
+    for (uint32_t i = 0; i < length; i++) {
+        crc = crc24_step(crc, data[i]);
+    }
+    return crc;
+}
+
+bool rtcm_type_forwarded(uint16_t type) {
+    for (uint16_t forwarded : forwarded_types) {
+        if (forwarded == type) {
+            return true;
+        }
+    }
+    return false;
+}
+
+RtcmParser::RtcmParser()
+    : state(SYNC), drop(RTCM_DROP_BAD_CRC), length(0), received(0), type(0), crc(0), frame_crc(0), counters() {
+}
+
+RtcmEvent RtcmParser::feed(uint8_t byte) {
+    switch (state) {
+    case SYNC:
+        if (byte != 0xD3) {
+            counters.skipped_bytes++;
+            return RTCM_NONE;
+        }
+        crc = crc24_step(0, byte);
+        state = LENGTH_HIGH;
+        return RTCM_STAGE;
+
+    case LENGTH_HIGH:
+        if (byte & 0xFC) {
+            counters.skipped_bytes += 2;
+            state = SYNC;
+            drop = RTCM_DROP_BAD_HEADER;
+            return RTCM_DROPPED;
+        }
+        crc = crc24_step(crc, byte);
+        length = (uint16_t)((byte & 0x03) << 8);
+        state = LENGTH_LOW;
+        return RTCM_STAGE;
+
+    case LENGTH_LOW:
+        crc = crc24_step(crc, byte);
+        length |= byte;
+        received = 0;
+        type = 0;
+        frame_crc = 0;
+        if (length < 2) {
+            // Too short to hold a message type
+            counters.filtered++;
+            state = SKIP;
+            drop = RTCM_DROP_FILTERED;
+            return RTCM_DROPPED;
+        }
+        state = BODY;
+        return RTCM_STAGE;
+
+    case BODY: {
+        uint16_t index = received++;
+        if (index < length) {
+            crc = crc24_step(crc, byte);
+            if (index == 0) {
+                type = (uint16_t)(byte << 4);
+                return RTCM_STAGE;
+            }
+            if (index == 1) {
+                type |= byte >> 4;
+                if (!rtcm_type_forwarded(type)) {
+                    counters.filtered++;
+                    state = SKIP;
+                    drop = RTCM_DROP_FILTERED;
+                    return RTCM_DROPPED;
+                }
+            }
+            return RTCM_STAGE;
+        }
+        frame_crc = (frame_crc << 8) | byte;
+        if (index < length + 2) {
+            return RTCM_STAGE;
+        }
+        state = SYNC;
+        if (frame_crc != crc) {
+            counters.bad_crc++;
+            drop = RTCM_DROP_BAD_CRC;
+            return RTCM_DROPPED;
+        }
+        counters.frames++;
+        counters.bytes += 3 + length + 3;
+        return RTCM_FRAME;
+    }
+
+    case SKIP:
+        if (++received >= length + 3) {
+            state = SYNC;
+        }
+        return RTCM_NONE;
+    }
+    return RTCM_NONE;
+}
+
+void RtcmParser::drop_frame() {
+    counters.overflows++;
+    drop = RTCM_DROP_OVERFLOW;
+    switch (state) {
+    case SYNC:
+        // Just completed by the last feed()
+        counters.frames--;
+        counters.bytes -= 3 + length + 3;
+        break;
+    case BODY:
+        state = SKIP;
+        break;
+    default:
+        // Length not known yet, look for the next frame
+        state = SYNC;
+        break;
+    }
+}
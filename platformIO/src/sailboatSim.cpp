@@ -0,0 +1,277 @@
+#include "sailboatSim.h"
+#include <math.h>
+
+static const double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+/**
+ * @brief Python-style modulo: result has the sign of the divisor
+ */
+static double wrap_360(double deg) {
+    double r = fmod(deg, 360.0);
+    return r < 0.0 ? r + 360.0 : r;
+}
+
+static double clamp(double value, double low, double high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+// ------------------------------------------------------------------
+// SimRandom
+// ------------------------------------------------------------------
+
+SimRandom::SimRandom(uint64_t value) {
+    seed(value);
+}
+
+void SimRandom::seed(uint64_t value) {
+    // splitmix64 so that neighbouring seeds give unrelated streams
+    uint64_t z = value + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    state = (z ^ (z >> 31)) | 1;
+    spare_set = false;
+    spare = 0.0;
+}
+
+uint64_t SimRandom::next() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+double SimRandom::uniform(double low, double high) {
+    double unit = (next() >> 11) * (1.0 / 9007199254740992.0);
+    return low + (high - low) * unit;
+}
+
+double SimRandom::normal(double mean, double stddev) {
+    if (spare_set) {
+        spare_set = false;
+        return mean + stddev * spare;
+    }
+    double u1 = uniform();
+    double u2 = uniform();
+    if (u1 < 1e-300) {
+        u1 = 1e-300;
+    }
+    double radius = sqrt(-2.0 * log(u1));
+    spare = radius * sin(2.0 * 3.14159265358979323846 * u2);
+    spare_set = true;
+    return mean + stddev * radius * cos(2.0 * 3.14159265358979323846 * u2);
+}
+
+// ------------------------------------------------------------------
+// SailboatPhysics
+// ------------------------------------------------------------------
+
+double SailboatPhysics::boat_speed(double true_wind_speed, double true_wind_heading, double sail) {
+    double abs_wind_heading = fabs(true_wind_heading);
+    sail = fabs(sail);
+
+    // Speed factor based on wind angle (polar curve approximation)
+    double speed_factor;
+    if (abs_wind_heading < 45.0) {
+        speed_factor = 0.1;
+    } else if (abs_wind_heading < 90.0) {
+        speed_factor = 0.6 + (abs_wind_heading - 45.0) / 75.0;
+    } else if (abs_wind_heading < 150.0) {
+        speed_factor = 0.8 + (abs_wind_heading - 90.0) / 300.0;
+    } else {
+        speed_factor = 0.7 - (abs_wind_heading - 150.0) / 600.0;
+    }
+
+    // Sail efficiency
+    double max_sail_angle = sail * 90.0;
+    double optimal_angle = fmin(90.0, abs_wind_heading);
+    double actual_angle = fmin(max_sail_angle, optimal_angle);
+    double sail_eff = 1.0 - 0.5 * fabs(optimal_angle - actual_angle) / 90.0;
+
+    // Wind speed factor with diminishing returns at high speeds
+    double wind_factor = sqrt(fmin(true_wind_speed, 15.0) / 5.0);
+    return 4.0 * speed_factor * sail_eff * wind_factor * B_RIG_FACTOR;
+}
+
+double SailboatPhysics::calculate_roll(double dt, double aws, double awh, double current_roll) {
+    double inertialess = ROLL_COEFFICIENT * aws * sin(awh * DEG_TO_RAD);
+    return inertialess * (1.0 - ROLL_INERTIA * dt) + current_roll * (ROLL_INERTIA * dt);
+}
+
+double SailboatPhysics::calculate_heading_change(double dt, double boat_speed, double rudder) {
+    return RUDDER_IMPACT * (RUDDER_A * boat_speed + RUDDER_B * rudder) * dt;
+}
+
+double SailboatPhysics::calculate_speed(double tws, double twh, double sail, double rudder, double current_speed) {
+    double base = boat_speed(tws, twh, sail);
+
+    // Rudder drag
+    double inertialess_speed = base - RUDDER_SLOWING_FACTOR * fabs(rudder) * base;
+
+    // Damping depends on accelerating or decelerating
+    double scale = inertialess_speed > current_speed ? SPEED_INERTIA : SPEED_MOMENTUM;
+    return inertialess_speed * (1.0 - scale) + current_speed * scale;
+}
+
+SimVector SailboatPhysics::calculate_wind_drift(double heading, double tws, double twh) {
+    SimVector drift;
+    drift.heading_to_north = wrap_360(heading + twh + 180.0);
+
+    // Drift grows faster above 7 m/s
+    double wind_factor = tws;
+    if (wind_factor > 7.0) {
+        wind_factor = 7.0 + (tws - 7.0) * 1.5;
+    }
+    drift.speed = WIND_DRIFT_COEFFICIENT * wind_factor;
+    return drift;
+}
+
+SimVector SailboatPhysics::calculate_water_drift(const SailboatEnvironment& env) {
+    SimVector drift;
+    drift.heading_to_north = env.water_heading;
+    drift.speed = WATER_DRIFT_COEFFICIENT * env.water_speed;
+    return drift;
+}
+
+ApparentWind SailboatPhysics::calculate_apparent_wind(double tws, double twh, double bs, double hdg) {
+    double rel_x = tws * sin(twh * DEG_TO_RAD) - bs * sin(hdg * DEG_TO_RAD);
+    double rel_y = tws * cos(twh * DEG_TO_RAD) - bs * cos(hdg * DEG_TO_RAD);
+
+    ApparentWind wind;
+    wind.speed = sqrt(rel_x * rel_x + rel_y * rel_y);
+    wind.heading_to_north = atan2(rel_x, rel_y) / DEG_TO_RAD;
+    wind.heading = wrap_360(wind.heading_to_north - hdg);
+    if (wind.heading > 180.0) {
+        wind.heading -= 360.0;
+    }
+    return wind;
+}
+
+double SailboatPhysics::apply_linear_change(double dt, double current_val, double wanted_val, double change_speed) {
+    if (wanted_val == current_val) {
+        return current_val;
+    }
+    double step = dt * change_speed;
+    double diff = fabs(current_val - wanted_val);
+    if (diff < step) {
+        step = diff;
+    }
+    return wanted_val < current_val ? current_val - step : current_val + step;
+}
+
+void SailboatPhysics::calculate_next_position(double lat, double lon, double speed, double hdg,
+                                              const SimVector* wind_drift, const SimVector* water_drift,
+                                              double dt, double* new_lat, double* new_lon) {
+    double dist = speed * dt;
+    double dx = dist * sin(hdg * DEG_TO_RAD);
+    double dy = dist * cos(hdg * DEG_TO_RAD);
+
+    const SimVector* drifts[2] = {wind_drift, water_drift};
+    for (const SimVector* drift : drifts) {
+        if (drift != nullptr) {
+            double drift_dist = drift->speed * dt;
+            dx += drift_dist * sin(drift->heading_to_north * DEG_TO_RAD);
+            dy += drift_dist * cos(drift->heading_to_north * DEG_TO_RAD);
+        }
+    }
+
+    double m_per_deg_lat = EARTH_CIRCUMFERENCE / 360.0;
+    double m_per_deg_lon = m_per_deg_lat * cos(lat * DEG_TO_RAD);
+    *new_lat = lat + dy / m_per_deg_lat;
+    *new_lon = lon + dx / m_per_deg_lon;
+}
+
+// ------------------------------------------------------------------
+// Sailboat
+// ------------------------------------------------------------------
+
+Sailboat::Sailboat(double lat, double lon, double initial_heading) {
+    x = 0.0;
+    y = 0.0;
+    heading = initial_heading;
+    speed = 0.0;
+    roll = 0.0;
+    actual_rudder = 0.0;
+    actual_sail = 0.0;
+    wanted_rudder = 0.0;
+    wanted_sail = 0.0;
+    apparent_wind = ApparentWind{0.0, 0.0, 0.0};
+    true_wind_speed = 0.0;
+    true_wind_heading = 0.0;
+    latitude = lat;
+    longitude = lon;
+    direction = initial_heading;
+    gps_error_stddev_m = 1.0;
+    wind_vane_error_stddev_deg = 5.0;
+}
+
+void Sailboat::set_rudder(double value) {
+    wanted_rudder = clamp(value, -1.0, 1.0);
+}
+
+void Sailboat::set_sail(double value) {
+    wanted_sail = clamp(value, 0.0, 1.0);
+}
+
+/**
+ * @brief One step, in the order of Sailboat.update in simulator.py
+ */
+void Sailboat::update(double dt, const SailboatEnvironment& env) {
+    apparent_wind = SailboatPhysics::calculate_apparent_wind(env.wind_speed, env.wind_heading, speed, heading);
+
+    // True wind relative to the bow
+    true_wind_speed = env.wind_speed;
+    true_wind_heading = wrap_360(env.wind_heading - heading);
+    if (true_wind_heading > 180.0) {
+        true_wind_heading -= 360.0;
+    }
+
+    // The drag and drift below use the servo positions of the previous step
+    double rudder_before = actual_rudder;
+    double sail_before = actual_sail;
+    actual_rudder = SailboatPhysics::apply_linear_change(dt, actual_rudder, wanted_rudder, RUDDER_SPEED);
+    actual_sail = SailboatPhysics::apply_linear_change(dt, actual_sail, wanted_sail, SAIL_SPEED);
+
+    double new_roll = SailboatPhysics::calculate_roll(dt, apparent_wind.speed, apparent_wind.heading, roll);
+    double new_speed = SailboatPhysics::calculate_speed(true_wind_speed, true_wind_heading,
+                                                        sail_before, rudder_before, speed);
+    double heading_change = SailboatPhysics::calculate_heading_change(dt, speed, actual_rudder);
+    double new_heading = wrap_360(heading + heading_change);
+
+    SimVector wind_drift = SailboatPhysics::calculate_wind_drift(heading, true_wind_speed, true_wind_heading);
+    SimVector water_drift = SailboatPhysics::calculate_water_drift(env);
+
+    roll = new_roll;
+    speed = new_speed;
+    heading = new_heading;
+
+    double new_lat, new_lon;
+    SailboatPhysics::calculate_next_position(latitude, longitude, speed, heading,
+                                             &wind_drift, &water_drift, dt, &new_lat, &new_lon);
+
+    // Local coordinates follow the position change
+    double m_per_deg_lat = SailboatPhysics::EARTH_CIRCUMFERENCE / 360.0;
+    double m_per_deg_lon = m_per_deg_lat * cos(latitude * DEG_TO_RAD);
+    double dx = (new_lon - longitude) * m_per_deg_lon;
+    double dy = (new_lat - latitude) * m_per_deg_lat;
+    x += dx;
+    y += dy;
+    latitude = new_lat;
+    longitude = new_lon;
+
+    if (fabs(dx) > 1e-9 || fabs(dy) > 1e-9) {
+        direction = wrap_360(atan2(dx, dy) / DEG_TO_RAD);
+    }
+}
+
+void Sailboat::noisy_gps_reading(SimRandom& rng, double* lat, double* lon) const {
+    const double earth_radius_m = 6371000.0;
+    double lat_error_m = rng.normal(0.0, gps_error_stddev_m);
+    double lon_error_m = rng.normal(0.0, gps_error_stddev_m);
+    *lat = latitude + (lat_error_m / earth_radius_m) / DEG_TO_RAD;
+    *lon = longitude + (lon_error_m / (earth_radius_m * cos(latitude * DEG_TO_RAD))) / DEG_TO_RAD;
+}
+
+double Sailboat::noisy_wind_vane_reading(SimRandom& rng) const {
+    double reading = true_wind_heading + rng.normal(0.0, wind_vane_error_stddev_deg);
+    return wrap_360(reading + 180.0) - 180.0;
+}
@@ -1,8 +1,10 @@
 #include <Arduino.h>
 #include <Servo.h>
 #include "servoControl.h"
-#include "xbeeImpl.h"
 #include "shared_data.h"
+#include "trace.h"
+#include "controlLoop.h"
+#include "taskTable.h"
 
 // Constructor
 servoControl::servoControl()
@@ -16,57 +18,45 @@ servoControl::servoControl()
     sailServo.writeMicroseconds(init_sail);
 }
 
-void servoControl::servo_control(const xbeeImpl &xbee)
+void servoControl::servo_control(int targetAngle)
 {
-    int targetAngle = sharedData.targetAngle;
-    int targetTension = sharedData.targetTension;
-    int angleFromNorth = sharedData.angleFromNorth;
+    AttitudeData attitude;
+    CommandData command;
+    sharedData.attitude.read(&attitude);
+    sharedData.command.read(&command);
 
-    float Kp = xbee.getKp();
-    float Ki = xbee.getKi();
+    int targetTension = command.targetTension;
+    int angleFromNorth = attitude.angleFromNorth;
+
+    float Kp = command.kp;
+    float Ki = command.ki;
+    scale_pi_gains(&Kp, &Ki, 1000.0f / taskTable[TASK_CONTROL].period_ms);
 
     // Calculate the angle angle between the current angle and the target angle
     int error = calculateShortestPath(angleFromNorth, targetAngle);
 
-    // PI Controller: calculate the proportional and integral terms
-    cumulateError += error;                           // accumulate the error over time
-    adjustment = Kp * error + Ki * cumulateError; // PI control
-
-    // Update safran servo position with the new adjustment
-    servoAnglePosition = constrain(servoAnglePosition - adjustment, min_angle_safran, max_angle_safran);
-    ms_safran_position = map(servoAnglePosition, min_angle_safran, max_angle_safran, min_ms_safran, max_ms_safran);
+    // PI Controller: update the safran servo position with the new adjustment
+    servoAnglePosition = pi_rudder_update(servoAnglePosition, error, Kp, Ki, &cumulateError, &adjustment);
+    ms_safran_position = safran_pulse_us(servoAnglePosition, min_ms_safran, max_ms_safran);
     safranServo.writeMicroseconds(ms_safran_position);
 
     // Update sail servo position with the new adjustment
-    ms_sail_position = getSailPosition();
+    ms_sail_position = getSailPosition(attitude.wind_vane);
     // sailServo.writeMicroseconds(max_ms_sail);
     sailServo.writeMicroseconds(ms_sail_position);
 
-
-    Serial.print("servoAnglePosition:");
-    Serial.println(servoAnglePosition);
-    Serial.print("ms_safran_position:");
-    Serial.println(ms_safran_position);
+    TRACE_DEBUG(EVT_SERVO_RUDDER, getServoAnglePosition(), ms_safran_position, ms_sail_position);
 }
 
 int servoControl::calculateShortestPath(int current, int target)
 {
-    int angleDifference = target - current;
-    if (angleDifference > 180)
-    {
-        angleDifference -= 360;
-    }
-    else if (angleDifference < -180)
-    {
-        angleDifference += 360;
-    }
-    return angleDifference;
+    return shortest_angle_difference(current, target);
 }
 
-int servoControl::getSailPosition()
+int servoControl::getSailPosition(double wind_vane)
 {
 
-    windAngle = (sharedData.wind_vane + 360) % 360;
+    int windAngle = ((int)wind_vane + 360) % 360;
     int sailTension = 0;
 
     if (windAngle >= 330 || windAngle <= 30)
@@ -0,0 +1,46 @@
+#include "shared_data.h"
+
+int SharedData::target_angle() const {
+    NavigationData navigation_data;
+    uint32_t navigation_ms;
+    navigation.read(&navigation_data, &navigation_ms);
+    return target_angle(navigation_data.targetAngle, navigation_ms);
+}
+
+int SharedData::target_angle(int planner_angle, uint32_t heading_ms) const {
+    CommandData command_data;
+    command.read(&command_data);
+
+    // Last writer wins: a manual heading holds until the planner publishes again
+    if (command_data.targetAngle_ms != 0 && (int32_t)(command_data.targetAngle_ms - heading_ms) > 0) {
+        return command_data.targetAngle;
+    }
+    return planner_angle;
+}
+
+TelemetryData SharedData::telemetry() const {
+    GnssData gnss_data;
+    AttitudeData attitude_data;
+    CommandData command_data;
+    NavigationData navigation_data;
+    gnss.read(&gnss_data);
+    attitude.read(&attitude_data);
+    command.read(&command_data);
+    navigation.read(&navigation_data);
+
+    TelemetryData data;
+    data.latitude = gnss_data.latitude;
+    data.longitude = gnss_data.longitude;
+    data.altitude = gnss_data.altitude;
+    data.waypoint_lat = navigation_data.waypoint_lat;
+    data.waypoint_lon = navigation_data.waypoint_lon;
+    data.compass = attitude_data.compass;
+    data.wind_vane = attitude_data.wind_vane;
+    data.wind_speed = attitude_data.wind_speed;
+    data.horizontal_tilt = attitude_data.horizontal_tilt;
+    data.vertical_tilt = attitude_data.vertical_tilt;
+    data.targetAngle = target_angle();
+    data.targetTension = command_data.targetTension;
+    data.angleFromNorth = attitude_data.angleFromNorth;
+    return data;
+}
@@ -0,0 +1,132 @@
+#include "staticAlloc.h"
+#include "trace.h"
+
+#include <stdlib.h>
+#include <malloc.h>
+#include <atomic>
+#include <new>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+static std::atomic<bool> locked(false);
+static std::atomic<uint32_t> trap_count(0);
+static uint32_t used_at_lock = 0;
+static HeapTrapHandler trap_handler = nullptr;
+
+uint32_t heap_used() {
+#ifdef __GLIBC__
+    return (uint32_t)mallinfo2().uordblks;
+#else
+    return (uint32_t)mallinfo().uordblks;
+#endif
+}
+
+void heap_lock() {
+    used_at_lock = heap_used();
+    locked.store(true, std::memory_order_release);
+}
+
+bool heap_locked() {
+    return locked.load(std::memory_order_acquire);
+}
+
+uint32_t heap_used_at_lock() {
+    return used_at_lock;
+}
+
+uint32_t heap_trap_count() {
+    return trap_count.load(std::memory_order_relaxed);
+}
+
+void set_heap_trap_handler(HeapTrapHandler handler) {
+    trap_handler = handler;
+}
+
+void heap_trap(size_t size, void* caller) {
+    // Load and store (no read-modify-write on the M0+): a count lost between the cores only affects the report
+    trap_count.store(trap_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (trap_handler != nullptr) {
+        trap_handler(size, caller);
+        return;
+    }
+    TRACE_ERROR(EVT_HEAP_TRAP, (uint32_t)size, (uint32_t)(uintptr_t)caller);
+#ifdef ARDUINO
+    panic("heap: %u bytes allocated after init from %p", (unsigned)size, caller);
+#else
+    abort();
+#endif
+}
+
+#ifdef ARDUINO
+#ifdef STATIC_ALLOCATION
+// Pools in .bss, charged to "tasks" by host/ram_budget.py; only setup() creates tasks
+static StackType_t taskStackPool[TASK_STACK_POOL_WORDS];
+static StaticTask_t taskTcbPool[TASK_POOL_SIZE];
+static uint32_t stack_pool_used = 0;
+static int tcb_pool_used = 0;
+#endif
+
+bool create_task(TaskFunction_t function, const char* name, uint32_t stack_words, void* parameters,
+                 UBaseType_t priority, UBaseType_t core_mask, TaskHandle_t* handle) {
+#ifdef STATIC_ALLOCATION
+    if (stack_pool_used + stack_words > TASK_STACK_POOL_WORDS || tcb_pool_used >= TASK_POOL_SIZE) {
+        return false;
+    }
+    TaskHandle_t task = xTaskCreateStaticAffinitySet(function, name, stack_words, parameters, priority,
+                                                     &taskStackPool[stack_pool_used],
+                                                     &taskTcbPool[tcb_pool_used], core_mask);
+    stack_pool_used += stack_words;
+    tcb_pool_used++;
+    if (handle != NULL) {
+        *handle = task;
+    }
+    return task != NULL;
+#else
+    return xTaskCreateAffinitySet(function, name, stack_words, parameters, priority, core_mask, handle) == pdPASS;
+#endif
+}
+#endif
+
+#ifdef STATIC_ALLOCATION
+// Every C++ allocation goes through here: after heap_lock() it is a bug
+static void* allocate(size_t size, void* caller) {
+    if (locked.load(std::memory_order_relaxed)) {
+        heap_trap(size, caller);
+    }
+    return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(size_t size) {
+    return allocate(size, __builtin_return_address(0));
+}
+
+void* operator new[](size_t size) {
+    return allocate(size, __builtin_return_address(0));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, __builtin_return_address(0));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, __builtin_return_address(0));
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    free(ptr);
+}
+#endif
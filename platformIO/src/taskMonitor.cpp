@@ -0,0 +1,213 @@
+#include "taskMonitor.h"
+
+#include <stdio.h>
+
+#ifdef ARDUINO
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+const char* const monitored_task_names[MONITORED_TASK_COUNT] = {
+    "blink", "control", "path", "sensor", "gps", "xbee", "trace", "monitor", "i2c0", "i2c1"
+};
+
+TaskMonitor taskMonitor;
+
+static const uint32_t NO_PERIOD = 0xFFFFFFFFu;
+
+LoopProbe::LoopProbe()
+    : loops(0), busy_us(0), exec_max_us(0), period_min_us(NO_PERIOD), period_max_us(0), deadline_misses(0),
+      window(0), deadline_us(0), seen_window(0), start_us(0), last_start_us(0), started(false) {
+    for (int k = 0; k < TASK_HIST_BUCKETS; k++) {
+        exec_hist[k].store(0, std::memory_order_relaxed);
+        period_hist[k].store(0, std::memory_order_relaxed);
+    }
+}
+
+void LoopProbe::begin(uint32_t now_us) {
+    // monitorTask has read the previous window: restart the min/max values
+    uint32_t current_window = window.load(std::memory_order_relaxed);
+    if (current_window != seen_window) {
+        seen_window = current_window;
+        exec_max_us.store(0, std::memory_order_relaxed);
+        period_min_us.store(NO_PERIOD, std::memory_order_relaxed);
+        period_max_us.store(0, std::memory_order_relaxed);
+    }
+
+    if (started) {
+        uint32_t period_us = now_us - last_start_us;
+        add(period_hist[task_hist_bucket(period_us)], 1);
+        if (period_us < period_min_us.load(std::memory_order_relaxed)) {
+            period_min_us.store(period_us, std::memory_order_relaxed);
+        }
+        if (period_us > period_max_us.load(std::memory_order_relaxed)) {
+            period_max_us.store(period_us, std::memory_order_relaxed);
+        }
+    }
+    started = true;
+    last_start_us = now_us;
+    start_us = now_us;
+}
+
+void LoopProbe::end(uint32_t now_us) {
+    uint32_t exec_us = now_us - start_us;
+    add(exec_hist[task_hist_bucket(exec_us)], 1);
+    add(busy_us, exec_us);
+    uint32_t deadline = deadline_us.load(std::memory_order_relaxed);
+    if (deadline != 0 && exec_us > deadline) {
+        add(deadline_misses, 1);
+    }
+    if (exec_us > exec_max_us.load(std::memory_order_relaxed)) {
+        exec_max_us.store(exec_us, std::memory_order_relaxed);
+    }
+    // Last, so that a loop counted by monitorTask has its histograms updated
+    loops.store(loops.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+TaskMonitor::TaskMonitor() : last_total_run_time(0), last_sample_us(0) {
+    for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+        handles[t].store(nullptr, std::memory_order_relaxed);
+        is_attached[t].store(false, std::memory_order_relaxed);
+        last_loops[t] = 0;
+        last_busy_us[t] = 0;
+        last_deadline_misses[t] = 0;
+        last_run_time[t] = 0;
+        for (int k = 0; k < TASK_HIST_BUCKETS; k++) {
+            last_exec_hist[t][k] = 0;
+            last_period_hist[t][k] = 0;
+        }
+    }
+}
+
+LoopProbe& TaskMonitor::attach(MonitoredTask task) {
+#ifdef ARDUINO
+    handles[task].store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+#endif
+    is_attached[task].store(true, std::memory_order_release);
+    return probes[task];
+}
+
+void TaskMonitor::set_deadline(MonitoredTask task, uint32_t deadline_us) {
+    probes[task].deadline_us.store(deadline_us, std::memory_order_relaxed);
+}
+
+bool TaskMonitor::attached(MonitoredTask task) const {
+    return is_attached[task].load(std::memory_order_acquire);
+}
+
+static uint16_t saturate16(uint32_t value) {
+    return value > 0xFFFFu ? 0xFFFFu : (uint16_t)value;
+}
+
+void TaskMonitor::sample(uint32_t now_us, TaskUsage* usage) {
+    uint32_t window_us = now_us - last_sample_us;
+    last_sample_us = now_us;
+
+    for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+        LoopProbe& probe = probes[t];
+        TaskUsage& u = usage[t];
+        u.task = (uint8_t)t;
+
+        uint32_t loops = probe.loops.load(std::memory_order_acquire);
+        u.loops = loops - last_loops[t];
+        last_loops[t] = loops;
+
+        for (int k = 0; k < TASK_HIST_BUCKETS; k++) {
+            uint32_t exec = probe.exec_hist[k].load(std::memory_order_relaxed);
+            uint32_t period = probe.period_hist[k].load(std::memory_order_relaxed);
+            u.exec_hist[k] = saturate16(exec - last_exec_hist[t][k]);
+            u.period_hist[k] = saturate16(period - last_period_hist[t][k]);
+            last_exec_hist[t][k] = exec;
+            last_period_hist[t][k] = period;
+        }
+
+        u.exec_max_us = probe.exec_max_us.load(std::memory_order_relaxed);
+        uint32_t period_min_us = probe.period_min_us.load(std::memory_order_relaxed);
+        u.period_min_us = period_min_us == NO_PERIOD ? 0 : period_min_us;
+        u.period_max_us = probe.period_max_us.load(std::memory_order_relaxed);
+        uint32_t misses = probe.deadline_misses.load(std::memory_order_relaxed);
+        u.deadline_misses = misses - last_deadline_misses[t];
+        last_deadline_misses[t] = misses;
+
+        // The task restarts its min/max values at its next loop
+        probe.window.store(probe.window.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        // Fallback CPU share: time between begin() and end()
+        uint32_t busy_us = probe.busy_us.load(std::memory_order_relaxed);
+        uint32_t busy_window_us = busy_us - last_busy_us[t];
+        last_busy_us[t] = busy_us;
+        u.cpu_permille = window_us == 0 ? 0 : saturate16((uint32_t)((uint64_t)busy_window_us * 1000 / window_us));
+        u.stack_free_words = 0;
+    }
+
+#ifdef ARDUINO
+#if INCLUDE_uxTaskGetStackHighWaterMark == 1
+    for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+        TaskHandle_t handle = (TaskHandle_t)handles[t].load(std::memory_order_acquire);
+        if (handle != NULL) {
+            usage[t].stack_free_words = saturate16(uxTaskGetStackHighWaterMark(handle));
+        }
+    }
+#endif
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1)
+    // Scheduler run-time counters: CPU time actually given to each task
+    static TaskStatus_t status[24];
+#ifdef configRUN_TIME_COUNTER_TYPE
+    configRUN_TIME_COUNTER_TYPE total_run_time = 0;
+#else
+    uint32_t total_run_time = 0;
+#endif
+    UBaseType_t count = uxTaskGetSystemState(status, sizeof(status) / sizeof(status[0]), &total_run_time);
+    uint32_t total_window = (uint32_t)total_run_time - last_total_run_time;
+    last_total_run_time = (uint32_t)total_run_time;
+    for (UBaseType_t k = 0; k < count; k++) {
+        for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+            if (status[k].xHandle == (TaskHandle_t)handles[t].load(std::memory_order_relaxed)) {
+                uint32_t run_time = (uint32_t)status[k].ulRunTimeCounter;
+                uint32_t run_window = run_time - last_run_time[t];
+                last_run_time[t] = run_time;
+                usage[t].cpu_permille = total_window == 0 ? 0 :
+                    saturate16((uint32_t)((uint64_t)run_window * 1000 / total_window));
+            }
+        }
+    }
+#endif
+#endif
+}
+
+// "<first bucket>/<count>/..." from the first to the last non-empty bucket, "-" if empty
+static int format_histogram(const uint16_t* hist, char* buffer, size_t size) {
+    int first = 0, last = TASK_HIST_BUCKETS - 1;
+    while (first < TASK_HIST_BUCKETS && hist[first] == 0) {
+        first++;
+    }
+    if (first == TASK_HIST_BUCKETS) {
+        return snprintf(buffer, size, "-");
+    }
+    while (hist[last] == 0) {
+        last--;
+    }
+    int length = snprintf(buffer, size, "%d", first);
+    for (int k = first; k <= last; k++) {
+        size_t offset = length < (int)size ? (size_t)length : size;
+        length += snprintf(buffer + offset, size - offset, "/%u", (unsigned)hist[k]);
+    }
+    return length;
+}
+
+int format_task_usage(const TaskUsage& usage, char* buffer, size_t size) {
+    int length = snprintf(buffer, size, "task_%s:%u,%u,%lu,%lu,%lu,%lu,",
+                          monitored_task_names[usage.task],
+                          (unsigned)usage.cpu_permille, (unsigned)usage.stack_free_words,
+                          (unsigned long)usage.loops, (unsigned long)usage.exec_max_us,
+                          (unsigned long)usage.period_min_us, (unsigned long)usage.period_max_us);
+    size_t offset = length < (int)size ? (size_t)length : size;
+    length += format_histogram(usage.exec_hist, buffer + offset, size - offset);
+    offset = length < (int)size ? (size_t)length : size;
+    length += snprintf(buffer + offset, size - offset, ",");
+    offset = length < (int)size ? (size_t)length : size;
+    length += format_histogram(usage.period_hist, buffer + offset, size - offset);
+    offset = length < (int)size ? (size_t)length : size;
+    length += snprintf(buffer + offset, size - offset, ",%lu", (unsigned long)usage.deadline_misses);
+    return length;
+}
@@ -0,0 +1,130 @@
+#include "taskTable.h"
+#include "textParse.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "staticAlloc.h"
+#endif
+
+int assign_rate_monotonic_priorities(TaskConfig* table, uint8_t lowest, uint8_t highest) {
+    // Distinct periods of the periodic tasks, in increasing order
+    uint32_t periods[MONITORED_TASK_COUNT];
+    int levels = 0;
+    for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+        if (table[t].background) {
+            continue;
+        }
+        int k = 0;
+        while (k < levels && periods[k] < table[t].period_ms) {
+            k++;
+        }
+        if (k < levels && periods[k] == table[t].period_ms) {
+            continue;
+        }
+        memmove(&periods[k + 1], &periods[k], (levels - k) * sizeof(periods[0]));
+        periods[k] = table[t].period_ms;
+        levels++;
+    }
+
+    for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+        if (table[t].background) {
+            table[t].priority = 0;
+            continue;
+        }
+        int rank = 0;
+        while (periods[rank] != table[t].period_ms) {
+            rank++;
+        }
+        int priority = (int)highest - rank;
+        table[t].priority = (uint8_t)(priority < (int)lowest ? lowest : priority);
+    }
+    return levels;
+}
+
+bool apply_task_rate(TaskConfig* table, const char* line) {
+    const char* comma = strchr(line, ',');
+    if (comma == NULL) {
+        return false;
+    }
+    size_t length = comma - line;
+    int task = 0;
+    while (task < MONITORED_TASK_COUNT &&
+           (strlen(monitored_task_names[task]) != length || strncmp(line, monitored_task_names[task], length) != 0)) {
+        task++;
+    }
+    if (task == MONITORED_TASK_COUNT) {
+        return false;
+    }
+
+    double period = 0.0, deadline = 0.0;
+    const char* second = strchr(comma + 1, ',');
+    if (!parse_decimal(comma + 1, second, &period) ||
+        (second != NULL && !parse_decimal(second + 1, NULL, &deadline))) {
+        return false;
+    }
+    if (period < TASK_MIN_PERIOD_MS || period > TASK_MAX_PERIOD_MS || deadline < 0.0 || deadline > period) {
+        return false;
+    }
+    table[task].period_ms = (uint32_t)period;
+    table[task].deadline_ms = (uint32_t)deadline;
+    return true;
+}
+
+int load_task_rates(TaskConfig* table, const char* path) {
+    char line[64];
+    int applied = 0;
+
+#ifdef ARDUINO
+    if (!LittleFS.begin()) {
+        return 0;
+    }
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return 0;
+    }
+    while (file.available()) {
+        size_t length = file.readBytesUntil('\n', line, sizeof(line) - 1);
+        line[length] = '\0';
+#else
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), file) != NULL) {
+#endif
+        if (line[0] == '#' || line[0] == '\r' || line[0] == '\n' || line[0] == '\0') {
+            continue;
+        }
+        applied += apply_task_rate(table, line);
+    }
+#ifdef ARDUINO
+    file.close();
+#else
+    fclose(file);
+#endif
+    return applied;
+}
+
+#ifdef ARDUINO
+int start_tasks(TaskConfig* table) {
+    int failed = 0;
+    for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+        TaskConfig& config = table[t];
+        if (config.entry == NULL) {
+            continue;
+        }
+        taskMonitor.set_deadline((MonitoredTask)t, task_deadline_us(config));
+        TaskHandle_t handle = NULL;
+        if (!create_task(config.entry, monitored_task_names[t], config.stack_words, NULL,
+                         config.background ? tskIDLE_PRIORITY : config.priority, 1 << config.core, &handle)) {
+            failed++;
+        }
+        config.handle = handle;
+    }
+    return failed;
+}
+#endif
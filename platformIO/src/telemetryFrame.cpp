@@ -0,0 +1,165 @@
+#include "telemetryFrame.h"
+
+#include <math.h>
+
+#define TELEMETRY_FIELD_KEY(id, key, member, bytes, kind, scale, period_ms, priority, deadband) key,
+const char* const telemetry_field_keys[TELEMETRY_FIELD_COUNT] = {
+    TELEMETRY_FIELDS(TELEMETRY_FIELD_KEY)
+};
+#undef TELEMETRY_FIELD_KEY
+
+#define TELEMETRY_FIELD_BYTES(id, key, member, bytes, kind, scale, period_ms, priority, deadband) bytes,
+const uint8_t telemetry_field_bytes[TELEMETRY_FIELD_COUNT] = {
+    TELEMETRY_FIELDS(TELEMETRY_FIELD_BYTES)
+};
+#undef TELEMETRY_FIELD_BYTES
+
+#define TELEMETRY_FIELD_KIND(id, key, member, bytes, kind, scale, period_ms, priority, deadband) kind,
+const uint8_t telemetry_field_kinds[TELEMETRY_FIELD_COUNT] = {
+    TELEMETRY_FIELDS(TELEMETRY_FIELD_KIND)
+};
+#undef TELEMETRY_FIELD_KIND
+
+#define TELEMETRY_FIELD_SCALE(id, key, member, bytes, kind, scale, period_ms, priority, deadband) scale,
+const double telemetry_field_scales[TELEMETRY_FIELD_COUNT] = {
+    TELEMETRY_FIELDS(TELEMETRY_FIELD_SCALE)
+};
+#undef TELEMETRY_FIELD_SCALE
+
+uint16_t telemetry_crc16(const uint8_t* data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t cobs_encode(const uint8_t* data, size_t length, uint8_t* out) {
+    size_t code_index = 0;
+    size_t written = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] != 0) {
+            out[written++] = data[i];
+            code++;
+        }
+        if (data[i] == 0 || code == 0xFF) {
+            out[code_index] = code;
+            code_index = written++;
+            code = 1;
+        }
+    }
+    out[code_index] = code;
+    return written;
+}
+
+size_t cobs_decode(const uint8_t* data, size_t length, uint8_t* out) {
+    size_t read = 0;
+    size_t written = 0;
+    while (read < length) {
+        uint8_t code = data[read++];
+        if (code == 0 || read + code - 1 > length) {
+            return 0;
+        }
+        for (uint8_t i = 1; i < code; i++) {
+            if (data[read] == 0) {
+                return 0;
+            }
+            out[written++] = data[read++];
+        }
+        if (code != 0xFF && read < length) {
+            out[written++] = 0;
+        }
+    }
+    return written;
+}
+
+int32_t telemetry_quantize(TelemetryField field, double value) {
+    if (isnan(value)) {
+        return 0;
+    }
+    if (telemetry_field_kinds[field] == TLM_ANGLE) {
+        value = fmod(value, 360.0);
+        if (value < 0.0) {
+            value += 360.0;
+        }
+    }
+    double scaled = round(value * telemetry_field_scales[field]);
+    double low, high;
+    if (telemetry_field_bytes[field] == 4) {
+        low = -2147483647.0;
+        high = 2147483647.0;
+    } else if (telemetry_field_kinds[field] == TLM_ANGLE) {
+        low = 0.0;
+        high = 65535.0;
+        if (scaled >= 360.0 * telemetry_field_scales[field]) {
+            scaled = 0.0;       // 359.999 rounds to 360
+        }
+    } else {
+        low = -32767.0;
+        high = 32767.0;
+    }
+    return (int32_t)(scaled < low ? low : (scaled > high ? high : scaled));
+}
+
+void telemetry_quantize_all(const TelemetryData& data, int32_t* values) {
+#define TELEMETRY_FIELD_VALUE(id, key, member, bytes, kind, scale, period_ms, priority, deadband) \
+    values[id] = telemetry_quantize(id, (double)data.member);
+    TELEMETRY_FIELDS(TELEMETRY_FIELD_VALUE)
+#undef TELEMETRY_FIELD_VALUE
+}
+
+size_t telemetry_state_size(uint16_t mask) {
+    size_t length = 3 + 2 + 2;
+    for (int f = 0; f < TELEMETRY_FIELD_COUNT; f++) {
+        if (mask & (1u << f)) {
+            length += telemetry_field_bytes[f];
+        }
+    }
+    return TELEMETRY_ENCODED_SIZE(length);
+}
+
+// Adds the CRC, COBS-encodes raw[0..length) into frame and appends the delimiter
+size_t TelemetryEncoder::finish(uint8_t* raw, size_t length, uint8_t* frame) {
+    uint16_t crc = telemetry_crc16(raw, length);
+    raw[length++] = (uint8_t)(crc & 0xFF);
+    raw[length++] = (uint8_t)(crc >> 8);
+    size_t encoded = cobs_encode(raw, length, frame);
+    frame[encoded++] = 0x00;
+    sequence++;
+    return encoded;
+}
+
+size_t TelemetryEncoder::encode_state(const int32_t* values, uint16_t mask, uint8_t* frame) {
+    uint8_t raw[3 + 2 + TELEMETRY_FIELD_COUNT * 4 + 2];
+    size_t length = 0;
+    raw[length++] = TELEMETRY_VERSION;
+    raw[length++] = TELEMETRY_STATE;
+    raw[length++] = sequence;
+    raw[length++] = (uint8_t)(mask & 0xFF);
+    raw[length++] = (uint8_t)(mask >> 8);
+    for (int f = 0; f < TELEMETRY_FIELD_COUNT; f++) {
+        if (mask & (1u << f)) {
+            uint32_t value = (uint32_t)values[f];
+            for (int b = 0; b < telemetry_field_bytes[f]; b++) {
+                raw[length++] = (uint8_t)(value >> (8 * b));
+            }
+        }
+    }
+    return finish(raw, length, frame);
+}
+
+size_t TelemetryEncoder::encode_text(const char* text, uint8_t* frame) {
+    uint8_t raw[3 + TELEMETRY_TEXT_SIZE + 2];
+    size_t length = 0;
+    raw[length++] = TELEMETRY_VERSION;
+    raw[length++] = TELEMETRY_TEXT;
+    raw[length++] = sequence;
+    for (size_t i = 0; text[i] != '\0' && i < TELEMETRY_TEXT_SIZE; i++) {
+        raw[length++] = (uint8_t)text[i];
+    }
+    return finish(raw, length, frame);
+}
@@ -0,0 +1,207 @@
+#include "telemetryScheduler.h"
+#include "textParse.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TELEMETRY_FIELD_CONFIG(id, key, member, bytes, kind, scale, period_ms, priority, deadband) \
+    { period_ms, priority, (int32_t)lround((deadband) * (scale)) },
+static const TelemetryFieldConfig default_config[TELEMETRY_FIELD_COUNT] = {
+    TELEMETRY_FIELDS(TELEMETRY_FIELD_CONFIG)
+};
+#undef TELEMETRY_FIELD_CONFIG
+
+TelemetryScheduler::TelemetryScheduler()
+    : never_sent((uint16_t)((1u << TELEMETRY_FIELD_COUNT) - 1)), rate(TELEMETRY_BUDGET_MAX),
+      tokens(0.0f), last_ms(0), started(false) {
+    memcpy(config, default_config, sizeof(config));
+    memset(last, 0, sizeof(last));
+    memset(last_sent_ms, 0, sizeof(last_sent_ms));
+}
+
+// At least one frame with every field must fit, whatever the budget
+float TelemetryScheduler::burst() const {
+    float saved = rate * TELEMETRY_BURST_MS / 1000.0f;
+    float full = (float)telemetry_state_size((uint16_t)((1u << TELEMETRY_FIELD_COUNT) - 1));
+    return saved > full ? saved : full;
+}
+
+// State frame with every priority-0 field, kept for them whatever text is waiting
+float TelemetryScheduler::reserve() const {
+    uint16_t mask = 0;
+    for (int f = 0; f < TELEMETRY_FIELD_COUNT; f++) {
+        if (config[f].priority == 0) {
+            mask |= (uint16_t)(1u << f);
+        }
+    }
+    return mask != 0 ? (float)telemetry_state_size(mask) : 0.0f;
+}
+
+void TelemetryScheduler::refill(uint32_t now_ms) {
+    if (!started) {
+        started = true;
+        tokens = burst();
+    } else {
+        tokens += rate * (float)(now_ms - last_ms) / 1000.0f;
+        if (tokens > burst()) {
+            tokens = burst();
+        }
+    }
+    last_ms = now_ms;
+}
+
+// Never more than one full frame in debt
+void TelemetryScheduler::charge(size_t length) {
+    tokens -= (float)length;
+    float floor = -(float)telemetry_state_size((uint16_t)((1u << TELEMETRY_FIELD_COUNT) - 1));
+    if (tokens < floor) {
+        tokens = floor;
+    }
+}
+
+bool TelemetryScheduler::due(int field, int32_t value, uint32_t now_ms) const {
+    if (never_sent & (1u << field)) {
+        return true;
+    }
+    uint32_t age = now_ms - last_sent_ms[field];
+    if (age < config[field].period_ms) {
+        return false;
+    }
+    if (age >= TELEMETRY_REFRESH_MS) {
+        return true;
+    }
+    int64_t moved = (int64_t)value - last[field];
+    if (moved < 0) {
+        moved = -moved;
+    }
+    if (telemetry_field_kinds[field] == TLM_ANGLE) {
+        // 359° and 1° are 2° apart
+        int64_t turn = (int64_t)lround(360.0 * telemetry_field_scales[field]);
+        if (turn - moved < moved) {
+            moved = turn - moved;
+        }
+    }
+    return moved > config[field].deadband;
+}
+
+size_t TelemetryScheduler::encode_state(const TelemetryData& data, uint32_t now_ms, uint8_t* frame) {
+    refill(now_ms);
+    int32_t values[TELEMETRY_FIELD_COUNT];
+    telemetry_quantize_all(data, values);
+
+    // Due fields, by priority then oldest first (never sent counts as oldest)
+    int order[TELEMETRY_FIELD_COUNT];
+    uint32_t age[TELEMETRY_FIELD_COUNT];
+    int count = 0;
+    for (int f = 0; f < TELEMETRY_FIELD_COUNT; f++) {
+        if (!due(f, values[f], now_ms)) {
+            continue;
+        }
+        age[f] = (never_sent & (1u << f)) ? UINT32_MAX : now_ms - last_sent_ms[f];
+        int k = count++;
+        while (k > 0) {
+            int other = order[k - 1];
+            bool before = config[f].priority < config[other].priority ||
+                (config[f].priority == config[other].priority && age[f] > age[other]);
+            if (!before) {
+                break;
+            }
+            order[k] = other;
+            k--;
+        }
+        order[k] = f;
+    }
+
+    // As many as the budget allows, stopping at the first that does not fit
+    uint16_t mask = 0;
+    for (int i = 0; i < count; i++) {
+        uint16_t with = (uint16_t)(mask | (1u << order[i]));
+        if ((float)telemetry_state_size(with) > tokens) {
+            break;
+        }
+        mask = with;
+    }
+    if (mask == 0) {
+        return 0;
+    }
+
+    for (int f = 0; f < TELEMETRY_FIELD_COUNT; f++) {
+        if (mask & (1u << f)) {
+            last[f] = values[f];
+            last_sent_ms[f] = now_ms;
+        }
+    }
+    never_sent &= (uint16_t)~mask;
+    size_t length = encoder.encode_state(values, mask, frame);
+    charge(length);
+    return length;
+}
+
+size_t TelemetryScheduler::encode_text(const char* text, uint32_t now_ms, uint8_t* frame) {
+    refill(now_ms);
+    // Checked before encoding: a refused frame must not use a sequence number
+    size_t characters = strlen(text);
+    if (characters > TELEMETRY_TEXT_SIZE) {
+        characters = TELEMETRY_TEXT_SIZE;
+    }
+    if ((float)TELEMETRY_ENCODED_SIZE(3 + characters + 2) > tokens - reserve()) {
+        return 0;
+    }
+    size_t length = encoder.encode_text(text, frame);
+    charge(length);
+    return length;
+}
+
+void TelemetryScheduler::set_link_quality(float quality) {
+    if (!(quality > 0.0f)) {
+        quality = 0.0f;
+    } else if (quality > 1.0f) {
+        quality = 1.0f;
+    }
+    rate = TELEMETRY_BUDGET_MIN + (TELEMETRY_BUDGET_MAX - TELEMETRY_BUDGET_MIN) * quality;
+}
+
+bool parse_telemetry_config(const char* line, TelemetryField* field, TelemetryFieldConfig* config) {
+    const char* first = strchr(line, ',');
+    const char* second = first ? strchr(first + 1, ',') : NULL;
+    const char* third = second ? strchr(second + 1, ',') : NULL;
+    if (third == NULL) {
+        return false;
+    }
+    size_t length = first - line;
+    while (length > 0 && line[length - 1] == ' ') {
+        length--;
+    }
+    int f = 0;
+    while (f < TELEMETRY_FIELD_COUNT &&
+           (strlen(telemetry_field_keys[f]) != length || strncmp(line, telemetry_field_keys[f], length) != 0)) {
+        f++;
+    }
+    if (f == TELEMETRY_FIELD_COUNT) {
+        return false;
+    }
+
+    double period = 0.0, priority = 0.0, deadband = 0.0;
+    if (!parse_decimal(first + 1, second, &period) || !parse_decimal(second + 1, third, &priority) ||
+        !parse_decimal(third + 1, NULL, &deadband)) {
+        return false;
+    }
+    if (period < 0.0 || period > TELEMETRY_MAX_PERIOD_MS || priority < 0.0 || priority > 255.0 || deadband < 0.0) {
+        return false;
+    }
+    *field = (TelemetryField)f;
+    config->period_ms = (uint16_t)period;
+    config->priority = (uint8_t)priority;
+    config->deadband = (int32_t)lround(deadband * telemetry_field_scales[f]);
+    return true;
+}
+
+bool TelemetryScheduler::configure(const char* line) {
+    TelemetryField field;
+    TelemetryFieldConfig settings;
+    if (!parse_telemetry_config(line, &field, &settings)) {
+        return false;
+    }
+    config[field] = settings;
+    return true;
+}
@@ -0,0 +1,93 @@
+#include "trace.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+static_assert(sizeof(TraceRecord) == 20, "TraceRecord layout is decoded by host/trace_decode.py");
+
+TraceBuffer traceBuffer;
+
+TraceBuffer::TraceBuffer() : write_index(0), read_index(0), dropped(0) {
+    for (uint32_t k = 0; k < CAPACITY; k++) {
+        slots[k].sequence.store(k, std::memory_order_relaxed);
+    }
+}
+
+bool TraceBuffer::push(const TraceRecord& record) {
+    uint32_t position = write_index.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[position & (CAPACITY - 1)];
+        uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int32_t difference = (int32_t)(sequence - position);
+        if (difference == 0) {
+            // Slot free for this position, claim it (position is reloaded on failure)
+            if (write_index.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Slot still holds the record of the previous lap: full
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            // Another producer claimed it first
+            position = write_index.load(std::memory_order_relaxed);
+        }
+    }
+    slot->record = record;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool TraceBuffer::pop(TraceRecord* record) {
+    Slot* slot = &slots[read_index & (CAPACITY - 1)];
+    if (slot->sequence.load(std::memory_order_acquire) != read_index + 1) {
+        return false;
+    }
+    *record = slot->record;
+    // Free the slot for the producer one lap ahead
+    slot->sequence.store(read_index + CAPACITY, std::memory_order_release);
+    read_index++;
+    return true;
+}
+
+uint32_t TraceBuffer::take_dropped() {
+    return dropped.exchange(0, std::memory_order_relaxed);
+}
+
+static uint8_t* put_le(uint8_t* out, uint32_t value, int bytes) {
+    for (int k = 0; k < bytes; k++) {
+        *out++ = (uint8_t)(value >> (8 * k));
+    }
+    return out;
+}
+
+void trace_encode_frame(const TraceRecord& record, uint8_t* out) {
+    out[0] = 0xA5;
+    out[1] = 0x5A;
+    uint8_t* p = put_le(out + 2, record.timestamp_us, 4);
+    p = put_le(p, record.event, 2);
+    *p++ = record.level;
+    *p++ = record.arg_count;
+    for (int k = 0; k < TRACE_MAX_ARGS; k++) {
+        p = put_le(p, record.args[k], 4);
+    }
+    uint8_t sum = 0;
+    for (uint8_t* q = out + 2; q < p; q++) {
+        sum += *q;
+    }
+    *p = (uint8_t)(0x100 - sum);
+}
+
+uint32_t trace_clock_us() {
+#ifdef ARDUINO
+    return micros();
+#else
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+#endif
+}
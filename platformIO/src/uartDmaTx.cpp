@@ -0,0 +1,74 @@
+#include "uartDmaTx.h"
+
+#ifdef ARDUINO
+#include <hardware/dma.h>
+#include <hardware/uart.h>
+#endif
+
+UartDmaTx::UartDmaTx() : head(0), staged(0), tail(0), in_flight(0), dropped(0), channel(-1) {
+}
+
+bool UartDmaTx::begin(unsigned uart_index) {
+#ifdef ARDUINO
+    channel = dma_claim_unused_channel(false);
+    if (channel < 0) {
+        return false;
+    }
+    uart_inst_t* uart = uart_get_instance(uart_index);
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, uart_get_dreq(uart, true));
+    dma_channel_configure(channel, &config, &uart_get_hw(uart)->dr, ring, 0, false);
+    return true;
+#else
+    (void)uart_index;
+    return false;
+#endif
+}
+
+bool UartDmaTx::put(uint8_t byte) {
+    if (!stage(byte)) {
+        return false;
+    }
+    commit();
+    return true;
+}
+
+bool UartDmaTx::stage(uint8_t byte) {
+    if (channel < 0 || staged - tail == UART_DMA_TX_SIZE) {
+        dropped++;
+        return false;
+    }
+    ring[staged & (UART_DMA_TX_SIZE - 1)] = byte;
+    staged++;
+    return true;
+}
+
+void UartDmaTx::poll() {
+    if (channel < 0) {
+        return;
+    }
+#ifdef ARDUINO
+    if (dma_channel_is_busy(channel)) {
+        return;
+    }
+#endif
+    tail += in_flight;
+    in_flight = 0;
+    uint32_t pending = head - tail;
+    if (pending == 0) {
+        return;
+    }
+    // Up to the end of the ring, the rest goes with the next transfer
+    uint32_t start = tail & (UART_DMA_TX_SIZE - 1);
+    uint32_t chunk = UART_DMA_TX_SIZE - start;
+    if (chunk > pending) {
+        chunk = pending;
+    }
+#ifdef ARDUINO
+    dma_channel_transfer_from_buffer_now(channel, &ring[start], chunk);
+#endif
+    in_flight = chunk;
+}
@@ -0,0 +1,205 @@
+#include "windField.h"
+#include "scalarMath.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <LittleFS.h>
+#else
+#include <stdio.h>
+#endif
+
+/**
+ * @brief Constructor - Empty field over a caller-provided buffer
+ */
+WindField::WindField(WindSample* storage, int storage_capacity) {
+    samples = storage;
+    capacity = storage_capacity;
+    memset(&spec, 0, sizeof(spec));
+    ready = false;
+}
+
+bool WindField::set_grid(const WindGridSpec& grid_spec) {
+    ready = false;
+    if (grid_spec.time_count < 1 || grid_spec.lat_count < 1 || grid_spec.lon_count < 1) {
+        return false;
+    }
+    long cells = (long)grid_spec.time_count * grid_spec.lat_count * grid_spec.lon_count;
+    if (cells > capacity) {
+        return false;
+    }
+    spec = grid_spec;
+    ready = true;
+    return true;
+}
+
+void WindField::set_sample(int t, int i, int j, float direction_deg, float speed_ms) {
+    // Air moves away from the direction it comes from
+    WindSample& s = samples[index(t, i, j)];
+    s.u = -speed_ms * ScalarMath<float>::sin_deg(direction_deg);
+    s.v = -speed_ms * ScalarMath<float>::cos_deg(direction_deg);
+}
+
+void WindField::fill(float direction_deg, float speed_ms) {
+    for (int t = 0; t < spec.time_count; t++) {
+        for (int i = 0; i < spec.lat_count; i++) {
+            for (int j = 0; j < spec.lon_count; j++) {
+                set_sample(t, i, j, direction_deg, speed_ms);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Position of a coordinate on one axis: lower index and fraction, clamped
+ */
+static void locate_axis(double value, double origin, double step, int count, int* index, float* fraction) {
+    if (count < 2 || step == 0.0) {
+        *index = 0;
+        *fraction = 0.0f;
+        return;
+    }
+    double position = (value - origin) / step;
+    if (position <= 0.0) {
+        *index = 0;
+        *fraction = 0.0f;
+    } else if (position >= count - 1) {
+        *index = count - 2;
+        *fraction = 1.0f;
+    } else {
+        *index = (int)position;
+        *fraction = (float)(position - *index);
+    }
+}
+
+bool WindField::sample(double time_s, double lat, double lon, float* direction_deg, float* speed_ms) const {
+    if (!ready) {
+        return false;
+    }
+    int t, i, j;
+    float ft, fi, fj;
+    locate_axis(time_s, spec.time0_s, spec.time_step_s, spec.time_count, &t, &ft);
+    locate_axis(lat, spec.lat0, spec.lat_step, spec.lat_count, &i, &fi);
+    locate_axis(lon, spec.lon0, spec.lon_step, spec.lon_count, &j, &fj);
+    int t1 = spec.time_count > 1 ? t + 1 : t;
+    int i1 = spec.lat_count > 1 ? i + 1 : i;
+    int j1 = spec.lon_count > 1 ? j + 1 : j;
+
+    // Trilinear interpolation on the velocity components
+    float u = 0.0f, v = 0.0f;
+    const int ts[2] = {t, t1};
+    const int is[2] = {i, i1};
+    const int js[2] = {j, j1};
+    const float wt[2] = {1.0f - ft, ft};
+    const float wi[2] = {1.0f - fi, fi};
+    const float wj[2] = {1.0f - fj, fj};
+    for (int a = 0; a < 2; a++) {
+        for (int b = 0; b < 2; b++) {
+            for (int c = 0; c < 2; c++) {
+                float w = wt[a] * wi[b] * wj[c];
+                const WindSample& s = samples[index(ts[a], is[b], js[c])];
+                u += w * s.u;
+                v += w * s.v;
+            }
+        }
+    }
+
+    *speed_ms = ScalarMath<float>::hypot(u, v);
+    *direction_deg = ScalarMath<float>::fmod(ScalarMath<float>::atan2_deg(-u, -v) + 360.0f, 360.0f);
+    return true;
+}
+
+/**
+ * @brief Read the next non-comment, non-empty line
+ */
+#ifdef ARDUINO
+static bool next_line(File& file, char* line, size_t size) {
+    while (file.available()) {
+        size_t length = file.readBytesUntil('\n', line, size - 1);
+        line[length] = '\0';
+#else
+static bool next_line(FILE* file, char* line, size_t size) {
+    while (fgets(line, size, file) != NULL) {
+#endif
+        if (line[0] == '#' || line[0] == '\r' || line[0] == '\n' || line[0] == '\0') {
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Parse count numbers separated by spaces and/or commas
+ */
+static bool parse_numbers(const char* line, double* values, int count) {
+    const char* cursor = line;
+    for (int k = 0; k < count; k++) {
+        while (*cursor == ' ' || *cursor == '\t' || *cursor == ',') cursor++;
+        char* end;
+        values[k] = strtod(cursor, &end);
+        if (end == cursor) {
+            return false;
+        }
+        cursor = end;
+    }
+    return true;
+}
+
+bool WindField::load_from_file(const char* path) {
+    char line[96];
+    ready = false;
+
+#ifdef ARDUINO
+    if (!LittleFS.begin()) {
+        Serial.println("Wind: LittleFS mount failed");
+        return false;
+    }
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        Serial.printf("Wind: %s not found\n", path);
+        return false;
+    }
+#else
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+#endif
+
+    bool ok = false;
+    double dims[3], axes[6];
+    if (next_line(file, line, sizeof(line)) && parse_numbers(line, dims, 3) &&
+        next_line(file, line, sizeof(line)) && parse_numbers(line, axes, 6)) {
+        WindGridSpec grid_spec;
+        grid_spec.time_count = (int)dims[0];
+        grid_spec.lat_count = (int)dims[1];
+        grid_spec.lon_count = (int)dims[2];
+        grid_spec.time0_s = axes[0];
+        grid_spec.time_step_s = axes[1];
+        grid_spec.lat0 = axes[2];
+        grid_spec.lat_step = axes[3];
+        grid_spec.lon0 = axes[4];
+        grid_spec.lon_step = axes[5];
+        ok = set_grid(grid_spec);
+        for (int t = 0; t < spec.time_count && ok; t++) {
+            for (int i = 0; i < spec.lat_count && ok; i++) {
+                for (int j = 0; j < spec.lon_count && ok; j++) {
+                    double node[2];
+                    ok = next_line(file, line, sizeof(line)) && parse_numbers(line, node, 2);
+                    if (ok) {
+                        set_sample(t, i, j, (float)node[0], (float)node[1]);
+                    }
+                }
+            }
+        }
+    }
+
+#ifdef ARDUINO
+    file.close();
+#else
+    fclose(file);
+#endif
+    ready = ok;
+    return ok;
+}
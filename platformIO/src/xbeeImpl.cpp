@@ -1,11 +1,19 @@
 #include <Arduino.h>
 #include "xbeeImpl.h"
 #include "shared_data.h"
+#include "mission.h"
+#include "trace.h"
+#include "pipeline.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include <hardware/clocks.h>
+#include <hardware/gpio.h>
+#include <hardware/pwm.h>
 
 xbeeImpl::xbeeImpl()
 {
+    command.kp = 1.0f;
+    command.ki = 1.0f;
     pinMode(XBee_rssi_pin, INPUT);
     pinMode(XBee_dout_pin, INPUT_PULLUP);
     pinMode(XBee_reset_pin, OUTPUT);
@@ -23,177 +31,301 @@ void xbeeImpl::initialize()
 
     Serial1.setRX(XBee_dout_pin);
     Serial1.setTX(XBee_din_pin);
+    // Received bytes wait in this ring (filled by the UART interrupt) until read() runs
+    Serial1.setFIFOSize(XBee_rx_buffer_size);
     Serial1.begin(115200, SERIAL_8N1);
 
     Serial2.setRX(rtk_rx_pin);
     Serial2.setTX(rtk_tx_pin);
     Serial2.begin(38400, SERIAL_8N1);
-}
-
-void xbeeImpl::read()
-{
-    if (Serial1.available())
+    // Serial2 is uart1; from now on only rtkTx writes to it
+    if (!rtkTx.begin(1))
     {
-        receivedMessage = "";
-        char c = ' ';
-        while (c != '|')
-        {
-            if (Serial1.available())
-            {
-                c = Serial1.read();
-                if (c != '|')
-                {
-                    receivedMessage += c;
-                }
-            }
-        }
-        // Serial.print("receivedMessage: ");
-        // Serial.println(receivedMessage);
-        receivedMessage.trim();
-        Serial2.write((const uint8_t *)receivedMessage.c_str(), receivedMessage.length());
-
-        getValue(receivedMessage);
+        Serial.println("Erreur : pas de canal DMA libre, corrections RTK ignorées !");
     }
-    vTaskDelay(pdMS_TO_TICKS(100));
+    // Initial PI gains, until the ground station sends others
+    sharedData.command.write(command, millis());
+
+    // GP27 is the B input of its PWM slice: the counter only runs while the RSSI output is high
+    rssiSlice = pwm_gpio_to_slice_num(XBee_rssi_pin);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_clkdiv_mode(&config, PWM_DIV_B_HIGH);
+    pwm_config_set_clkdiv(&config, XBee_rssi_clkdiv);
+    pwm_init(rssiSlice, &config, false);
+    gpio_set_function(XBee_rssi_pin, GPIO_FUNC_PWM);
+    pwm_set_counter(rssiSlice, 0);
+    rssiWindowStart_us = micros();
+    pwm_set_enabled(rssiSlice, true);
 }
 
-void xbeeImpl::getValue(String receivedMessage)
+float xbeeImpl::readLinkQuality()
 {
-    if (receivedMessage.length() == 0)
+    uint32_t now = micros();
+    uint16_t high = pwm_get_counter(rssiSlice);
+    pwm_set_counter(rssiSlice, 0);
+    float window = (float)(now - rssiWindowStart_us) * ((float)clock_get_hz(clk_sys) / XBee_rssi_clkdiv / 1e6f);
+    rssiWindowStart_us = now;
+    // The counter may have wrapped
+    if (window <= 0.0f || window > 65535.0f)
     {
-        return;
+        return -1.0f;
     }
-    // Find the position of the ':'
-    int separatorIndex = receivedMessage.indexOf(':');
-    Serial.println(receivedMessage);
+    float quality = high / window;
+    return quality > 1.0f ? 1.0f : quality;
+}
 
-    if (separatorIndex != -1)
+void xbeeImpl::read()
+{
+    // Only the bytes already received: a partial frame stays in the parser until the next call
+    int available = Serial1.available();
+    while (available-- > 0)
     {
-        // Extract the key and value
-        String key = receivedMessage.substring(0, separatorIndex);
-        String value = receivedMessage.substring(separatorIndex + 1);
-
-        // Convert value to integer or float depending on the key
-        if (key == "ki")
+        switch (parser.feed((uint8_t)Serial1.read()))
         {
-            Ki = value.toFloat();
-            // Serial.print("ki value: ");
-            // Serial.println(Ki);
-        }
-        else if (key == "kp")
-        {
-            Kp = value.toFloat();
-            // Serial.print("kp value: ");
-            // Serial.println(Kp);
-        }
-        if (key == "tension")
+        case RADIO_COMMAND:
         {
-            sharedData.targetTension = value.toFloat();
-            Serial.print("targetTension value: ");
-            Serial.println(sharedData.targetTension);
+            // Applied at once: a mission upload (mission_clear, wp..., mission_start) comes in one burst
+            RadioCommand received = parser.command();
+            getValue(received.text);
+            break;
         }
-        else if (key == "cap")
-        {
-            sharedData.targetAngle = value.toFloat();
-            Serial.print("targetAngle value: ");
-            Serial.println(sharedData.targetAngle);
+        case RADIO_RTK_BYTE:
+            forwardRtcm(parser.rtk_byte());
+            break;
+        case RADIO_DROPPED:
+            TRACE_WARN(EVT_XBEE_FRAME_DROPPED, parser.drop_reason());
+            break;
+        default:
+            break;
         }
-        else if (key == "rtk")
-        {
-            rtk = value;
-            // Serial.println(rtk);
-            Serial2.print(rtk);
-            // Serial.println("rtk value sended to GPS");
-        }
-        else if (key == "point_lon")
+    }
+    rtkTx.poll();
+    reportRtcm(millis());
+}
+
+void xbeeImpl::forwardRtcm(uint8_t byte)
+{
+    RtcmEvent event = rtcm.feed(byte);
+    if (event == RTCM_STAGE || event == RTCM_FRAME)
+    {
+        if (!rtkTx.stage(byte))
         {
-            lon = value.toDouble();
-            sharedData.waypoint_lon = lon;
-            // Serial.println(lon);
-            // Serial.println("rtk value sended to GPS");
+            // A frame is only sent whole
+            rtkTx.discard();
+            rtcm.drop_frame();
+            TRACE_WARN(EVT_RTCM_DROPPED, rtcm.message_type(), rtcm.drop_reason());
         }
-        else if (key == "point_lat")
+        else if (event == RTCM_FRAME)
         {
-            lat = value.toDouble();
-            sharedData.waypoint_lat = lat;
-            // Serial.println(rtk);
-            // Serial.println("rtk value sended to GPS");
+            rtkTx.commit();
+            lastCorrection_ms = millis();
+            correctionReceived = true;
         }
-        else
+    }
+    else if (event == RTCM_DROPPED)
+    {
+        rtkTx.discard();
+        if (rtcm.drop_reason() != RTCM_DROP_FILTERED)
         {
-            Serial.println("Invalid key. Expected 'kp', 'ki', 'point_lat', 'point_lon' or 'rtk'.");
+            TRACE_WARN(EVT_RTCM_DROPPED, rtcm.message_type(), rtcm.drop_reason());
         }
     }
-    else
+}
+
+void xbeeImpl::reportRtcm(uint32_t now)
+{
+    uint32_t elapsed = now - rtcmReport_ms;
+    if (elapsed < XBee_rtcm_report_ms)
     {
-        Serial.println("Invalid format. Expected 'key:value'.");
+        return;
     }
+    const RtcmStats& stats = rtcm.stats();
+    TRACE_INFO(EVT_RTCM_STATS, (stats.bytes - rtcmReportBytes) * 1000 / elapsed, stats.frames, correctionAge_ms(now));
+    TRACE_DEBUG(EVT_RTCM_ERRORS, stats.bad_crc, stats.filtered, stats.overflows);
+    rtcmReport_ms = now;
+    rtcmReportBytes = stats.bytes;
 }
 
-void xbeeImpl::send(const SharedData& data) const
+void xbeeImpl::getValue(char* receivedMessage)
 {
-    static double prev_lat = -9999.0;
-    static double prev_lon = -9999.0;
-    static double prev_compass = -9999.0;
-    static double prev_wind = -9999.0;
-    static double prev_h_tilt = -9999.0;
-    static double prev_v_tilt = -9999.0;
-    static int prev_target_angle = -1;
-    static int prev_target_tension = -1;
-    static int prev_angle_from_north = -1;
-
-    if (data.latitude != prev_lat) {
-        Serial1.print("latitude:");
-        Serial1.println(data.latitude, 6);  // 6 decimal precision
-        prev_lat = data.latitude;
+    if (receivedMessage[0] == '\0')
+    {
+        return;
     }
+    // Echoed before parse_commands() cuts the frame at its separators
+    Serial.println(receivedMessage);
 
-    if (data.longitude != prev_lon) {
-        Serial1.print("longitude:");
-        Serial1.println(data.longitude, 6);
-        prev_lon = data.longitude;
+    Command parsed[COMMAND_MAX_PER_FRAME];
+    CommandError error;
+    int failedPair;
+    int count = parse_commands(receivedMessage, parsed, &error, &failedPair);
+    if (count < 0)
+    {
+        TRACE_WARN(EVT_COMMAND_REJECTED, failedPair, error);
+        // Keys listed from the command table, so a new command shows up here too
+        Serial.print("Frame rejected. Expected 'key:value' pairs separated by ';', keys: ");
+        for (int i = 0; i < CMD_COUNT; i++)
+        {
+            Serial.print(i == 0 ? "" : ", ");
+            Serial.print(command_keys[i]);
+        }
+        Serial.println(".");
+        return;
     }
-
-    if (data.compass != prev_compass) {
-        Serial1.print("compass:");
-        Serial1.println(data.compass, 2);
-        prev_compass = data.compass;
+    if (!checkCommands(parsed, count))
+    {
+        return;
     }
 
-    if (data.wind_vane != prev_wind) {
-        Serial1.print("wind_vane:");
-        Serial1.println(data.wind_vane, 2);
-        prev_wind = data.wind_vane;
+    // Every command of the frame, then one publication: readers see all of them or none
+    uint32_t now = millis();
+    CommandData next = command;
+    bool changed = false;
+    for (int i = 0; i < count; i++)
+    {
+        changed |= applyCommand(parsed[i], &next, now);
     }
-
-    if (data.horizontal_tilt != prev_h_tilt) {
-        Serial1.print("horizontal_tilt:");
-        Serial1.println(data.horizontal_tilt, 2);
-        prev_h_tilt = data.horizontal_tilt;
+    if (changed)
+    {
+        command = next;
+        sharedData.command.write(command, now);
     }
+}
 
-    if (data.vertical_tilt != prev_v_tilt) {
-        Serial1.print("vertical_tilt:");
-        Serial1.println(data.vertical_tilt, 2);
-        prev_v_tilt = data.vertical_tilt;
+bool xbeeImpl::checkCommands(const Command* parsed, int count)
+{
+    int waypoints = missionDraft.count;
+    for (int i = 0; i < count; i++)
+    {
+        TelemetryField field;
+        TelemetryFieldConfig settings;
+        if (parsed[i].id == CMD_TELEMETRY && !parse_telemetry_config(parsed[i].text, &field, &settings))
+        {
+            TRACE_WARN(EVT_COMMAND_REJECTED, i, CMD_ERROR_REFUSED);
+            Serial.println("Telemetry setting rejected. Expected 'tlm:key,period_ms,priority,deadband'.");
+            return false;
+        }
+        if (parsed[i].id == CMD_GPS_RATE && (parsed[i].value[0] < 1 || parsed[i].value[0] > GNSS_NAV_RATE_MAX_HZ))
+        {
+            TRACE_WARN(EVT_COMMAND_REJECTED, i, CMD_ERROR_REFUSED);
+            Serial.println("GNSS rate rejected. Expected 'gps_rate:1' to 'gps_rate:20' (Hz).");
+            return false;
+        }
+        if (parsed[i].id == CMD_GPS_TXREADY && parsed[i].value[0] != 0 && parsed[i].value[0] != 1)
+        {
+            TRACE_WARN(EVT_COMMAND_REJECTED, i, CMD_ERROR_REFUSED);
+            Serial.println("GNSS ingestion mode rejected. Expected 'gps_txready:0' (polled) or 'gps_txready:1'.");
+            return false;
+        }
+        if (parsed[i].id == CMD_MISSION_CLEAR)
+        {
+            waypoints = 0;
+        }
+        if (parsed[i].id == CMD_WAYPOINT && ++waypoints > MISSION_MAX_WAYPOINTS)
+        {
+            TRACE_WARN(EVT_COMMAND_REJECTED, i, CMD_ERROR_REFUSED);
+            Serial.println("Waypoint rejected. At most 16 waypoints.");
+            return false;
+        }
     }
+    return true;
+}
 
-    if (data.targetAngle != prev_target_angle) {
-        Serial1.print("target_angle:");
-        Serial1.println(data.targetAngle);
-        prev_target_angle = data.targetAngle;
+bool xbeeImpl::applyCommand(const Command& parsed, CommandData* next, uint32_t now)
+{
+    switch (parsed.id)
+    {
+    case CMD_KP:
+        next->kp = (float)parsed.value[0];
+        return true;
+    case CMD_KI:
+        next->ki = (float)parsed.value[0];
+        return true;
+    case CMD_TENSION:
+        next->targetTension = (int)parsed.value[0];
+        Serial.print("targetTension value: ");
+        Serial.println(next->targetTension);
+        return true;
+    case CMD_CAP:
+        next->targetAngle = (int)parsed.value[0];
+        next->targetAngle_ms = now;
+        Serial.print("targetAngle value: ");
+        Serial.println(next->targetAngle);
+        return true;
+    case CMD_POINT_LAT:
+        next->waypoint_lat = parsed.value[0];
+        next->waypoint_ms = now;
+        return true;
+    case CMD_POINT_LON:
+        next->waypoint_lon = parsed.value[0];
+        next->waypoint_ms = now;
+        return true;
+    case CMD_POINT:
+        next->waypoint_lat = parsed.value[0];
+        next->waypoint_lon = parsed.value[1];
+        next->waypoint_ms = now;
+        return true;
+    case CMD_WAYPOINT:
+        // Append a mission waypoint: "wp:lat,lon"
+        missionDraft.lat[missionDraft.count] = parsed.value[0];
+        missionDraft.lon[missionDraft.count] = parsed.value[1];
+        missionDraft.count++;
+        Serial.print("Mission waypoints: ");
+        Serial.println(missionDraft.count);
+        break;
+    case CMD_MISSION_CLEAR:
+        missionDraft.count = 0;
+        break;
+    case CMD_MISSION_START:
+        // Published whole: the path planning task loads a coherent copy on its next iteration
+        sharedData.mission.write(missionDraft, now);
+        Serial.print("Mission uploaded, waypoints: ");
+        Serial.println(missionDraft.count);
+        break;
+    case CMD_TELEMETRY:
+        configureTelemetry(parsed.text);
+        break;
+    case CMD_GPS_RATE:
+        // Applied by the GPS task, the only user of the receiver
+        next->gps_rate_hz = (uint8_t)parsed.value[0];
+        return true;
+    case CMD_GPS_TXREADY:
+        next->gps_txready = (uint8_t)parsed.value[0] + 1;   // 0 stays "no request"
+        next->gps_txready_ms = now;                         // A repeated request is applied again
+        return true;
+    default:
+        break;
     }
+    return false;
+}
 
-    if (data.targetTension != prev_target_tension) {
-        Serial1.print("target_tension:");
-        Serial1.println(data.targetTension);
-        prev_target_tension = data.targetTension;
+void xbeeImpl::send(const TelemetryData& data)
+{
+    float quality = readLinkQuality();
+    if (quality >= 0.0f)
+    {
+        telemetry.set_link_quality(quality);
     }
 
-    if (data.angleFromNorth != prev_angle_from_north) {
-        Serial1.print("angle_from_north:");
-        Serial1.println(data.angleFromNorth);
-        prev_angle_from_north = data.angleFromNorth;
+    // One binary frame with the fields that are due (telemetryFrame.h), nothing if none are
+    uint8_t frame[TELEMETRY_FRAME_SIZE];
+    size_t length = telemetry.encode_state(data, millis(), frame);
+    if (length > 0)
+    {
+        Serial1.write(frame, length);
     }
 }
 
+bool xbeeImpl::sendTaskUsage(const TaskUsage& usage)
+{
+    char line[TELEMETRY_TEXT_SIZE + 1];
+    format_task_usage(usage, line, sizeof(line));
+    uint8_t frame[TELEMETRY_FRAME_SIZE];
+    size_t length = telemetry.encode_text(line, millis(), frame);
+    if (length == 0)
+    {
+        return false;
+    }
+    Serial1.write(frame, length);
+    return true;
+}
@@ -0,0 +1,82 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include <string.h>
+#include "cmps12.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// Registers 0x02..0x1E as the CMPS12 sends them
+static void fill_registers(uint8_t* registers) {
+    memset(registers, 0, CMPS12_BURST_MAX);
+    uint8_t* r = registers - CMPS12_REG_BEARING;
+    r[0x02] = 0x0D; r[0x03] = 0xAC;         // 3500: 350.0°
+    r[0x04] = (uint8_t)-12;                 // Pitch
+    r[0x05] = 7;                            // Roll
+    r[0x06] = 0xFF; r[0x07] = 0x38;         // Magnetometer X: -200
+    r[0x0A] = 0x01; r[0x0B] = 0x00;         // Magnetometer Z: 256
+    r[0x0E] = 0x03; r[0x0F] = 0xE8;         // Accelerometer Y: 1000
+    r[0x16] = 0x80; r[0x17] = 0x00;         // Gyroscope Z: -32768
+    r[0x18] = 0x00; r[0x19] = 0x19;         // Temperature: 25
+    r[0x1E] = 0xFF;                         // Fully calibrated
+}
+
+// ------------------------
+// Test: Burst length follows the last block asked for
+// ------------------------
+void test_burst_length() {
+    TEST_ASSERT_EQUAL(4, CMPS12::burstLength(0));
+    TEST_ASSERT_EQUAL(10, CMPS12::burstLength(CMPS12_MAGNETOMETER));
+    TEST_ASSERT_EQUAL(22, CMPS12::burstLength(CMPS12_GYROSCOPE));
+    TEST_ASSERT_EQUAL(24, CMPS12::burstLength(CMPS12_TEMPERATURE | CMPS12_MAGNETOMETER));
+    TEST_ASSERT_EQUAL(CMPS12_BURST_MAX, CMPS12::burstLength(CMPS12_CALIBRATION));
+}
+
+// ------------------------
+// Test: Decoding of the basic and full bursts
+// ------------------------
+void test_decode() {
+    uint8_t registers[CMPS12_BURST_MAX];
+    fill_registers(registers);
+
+    CMPS12Orientation basic = {};
+    CMPS12::decode(registers, CMPS12::burstLength(0), &basic);
+    TEST_ASSERT_EQUAL(3500, basic.bearing);
+    TEST_ASSERT_EQUAL(-12, basic.pitch);
+    TEST_ASSERT_EQUAL(7, basic.roll);
+    TEST_ASSERT_EQUAL(0, basic.blocks);
+
+    CMPS12Orientation full = {};
+    CMPS12::decode(registers, CMPS12_BURST_MAX, &full);
+    TEST_ASSERT_EQUAL(CMPS12_MAGNETOMETER | CMPS12_ACCELEROMETER | CMPS12_GYROSCOPE | CMPS12_TEMPERATURE | CMPS12_CALIBRATION,
+                      full.blocks);
+    TEST_ASSERT_EQUAL(-200, full.magnetometer[0]);
+    TEST_ASSERT_EQUAL(256, full.magnetometer[2]);
+    TEST_ASSERT_EQUAL(1000, full.accelerometer[1]);
+    TEST_ASSERT_EQUAL(-32768, full.gyroscope[2]);
+    TEST_ASSERT_EQUAL(25, full.temperature);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, full.calibration);
+
+    // The gyroscope burst also covers the blocks before it
+    CMPS12Orientation gyro = {};
+    CMPS12::decode(registers, CMPS12::burstLength(CMPS12_GYROSCOPE), &gyro);
+    TEST_ASSERT_EQUAL(CMPS12_MAGNETOMETER | CMPS12_ACCELEROMETER | CMPS12_GYROSCOPE, gyro.blocks);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_burst_length);
+    RUN_TEST(test_decode);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,106 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include <string.h>
+#include "commandRegistry.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Every key is found, nothing else is
+// ------------------------
+void test_find_command() {
+    for (int c = 0; c < CMD_COUNT; c++) {
+        TEST_ASSERT_EQUAL(c, find_command(command_keys[c], strlen(command_keys[c])));
+    }
+    TEST_ASSERT_EQUAL(CMD_COUNT, find_command("k", 1));
+    TEST_ASSERT_EQUAL(CMD_COUNT, find_command("kpp", 3));
+    TEST_ASSERT_EQUAL(CMD_COUNT, find_command("point_la", 8));
+    TEST_ASSERT_EQUAL(CMD_COUNT, find_command("rtk", 3));
+    TEST_ASSERT_EQUAL(CMD_COUNT, find_command("", 0));
+    // Only the given length counts
+    TEST_ASSERT_EQUAL(CMD_POINT, find_command("point_lat", 5));
+}
+
+// ------------------------
+// Test: Several pairs in one frame
+// ------------------------
+void test_parse_frame() {
+    char frame[] = "kp:0.8; ki : 5e-2;cap:270;point:47.2544141,-1.3691732;tlm:compass,200,1,0.5;;mission_start";
+    Command commands[COMMAND_MAX_PER_FRAME];
+    CommandError error;
+    int failed;
+    TEST_ASSERT_EQUAL(6, parse_commands(frame, commands, &error, &failed));
+    TEST_ASSERT_EQUAL(CMD_ERROR_NONE, error);
+
+    TEST_ASSERT_EQUAL(CMD_KP, commands[0].id);
+    TEST_ASSERT_EQUAL_FLOAT(0.8, commands[0].value[0]);
+    TEST_ASSERT_EQUAL(CMD_KI, commands[1].id);
+    TEST_ASSERT_EQUAL_FLOAT(0.05, commands[1].value[0]);
+    TEST_ASSERT_EQUAL(CMD_CAP, commands[2].id);
+    TEST_ASSERT_EQUAL_FLOAT(270.0, commands[2].value[0]);
+    TEST_ASSERT_EQUAL(CMD_POINT, commands[3].id);
+    TEST_ASSERT_TRUE(commands[3].value[0] == 47.2544141);
+    TEST_ASSERT_TRUE(commands[3].value[1] == -1.3691732);
+    TEST_ASSERT_EQUAL(CMD_TELEMETRY, commands[4].id);
+    TEST_ASSERT_EQUAL_STRING("compass,200,1,0.5", commands[4].text);
+    TEST_ASSERT_EQUAL(CMD_MISSION_START, commands[5].id);
+
+    // The values point into the frame
+    TEST_ASSERT_TRUE(commands[4].text > frame && commands[4].text < frame + sizeof(frame));
+}
+
+// ------------------------
+// Test: One bad pair rejects the whole frame
+// ------------------------
+void test_reject_frame() {
+    Command commands[COMMAND_MAX_PER_FRAME];
+    CommandError error;
+    int failed;
+
+    char bad_value[] = "kp:0.8;ki:abc";
+    TEST_ASSERT_EQUAL(-1, parse_commands(bad_value, commands, &error, &failed));
+    TEST_ASSERT_EQUAL(CMD_ERROR_BAD_VALUE, error);
+    TEST_ASSERT_EQUAL(1, failed);
+
+    char unknown[] = "speed:3";
+    TEST_ASSERT_EQUAL(-1, parse_commands(unknown, commands, &error, &failed));
+    TEST_ASSERT_EQUAL(CMD_ERROR_UNKNOWN_KEY, error);
+
+    char no_separator[] = "tension";
+    TEST_ASSERT_EQUAL(-1, parse_commands(no_separator, commands, &error, &failed));
+    TEST_ASSERT_EQUAL(CMD_ERROR_FORMAT, error);
+
+    char half_pair[] = "wp:47.25";
+    TEST_ASSERT_EQUAL(-1, parse_commands(half_pair, commands, &error, &failed));
+    TEST_ASSERT_EQUAL(CMD_ERROR_BAD_VALUE, error);
+
+    char too_many[] = "kp:1;kp:1;kp:1;kp:1;kp:1;kp:1;kp:1;kp:1;kp:1";
+    TEST_ASSERT_EQUAL(-1, parse_commands(too_many, commands, &error, &failed));
+    TEST_ASSERT_EQUAL(CMD_ERROR_TOO_MANY, error);
+    TEST_ASSERT_EQUAL(COMMAND_MAX_PER_FRAME, failed);
+
+    // No value needed
+    char clear[] = "mission_clear";
+    TEST_ASSERT_EQUAL(1, parse_commands(clear, commands, &error, &failed));
+    TEST_ASSERT_EQUAL(CMD_MISSION_CLEAR, commands[0].id);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_find_command);
+    RUN_TEST(test_parse_frame);
+    RUN_TEST(test_reject_frame);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,83 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "controlLaw.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Shortest Heading Difference
+// ------------------------
+void test_shortest_angle_difference(void) {
+    TEST_ASSERT_EQUAL_INT(10, shortest_angle_difference(350, 0));
+    TEST_ASSERT_EQUAL_INT(-10, shortest_angle_difference(10, 0));
+    TEST_ASSERT_EQUAL_INT(20, shortest_angle_difference(180, 200));
+    TEST_ASSERT_EQUAL_INT(-179, shortest_angle_difference(180, 1));
+    TEST_ASSERT_EQUAL_INT(180, shortest_angle_difference(0, 180));
+}
+
+// ------------------------
+// Test: PI Rudder Step
+// ------------------------
+void test_pi_rudder_update(void) {
+    float cumulate_error = 0.0f, adjustment = 0.0f;
+
+    // Proportional and integral terms on the first step
+    float angle = pi_rudder_update(125.0f, 10, 1.0f, 0.5f, &cumulate_error, &adjustment);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 10.0, cumulate_error);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 15.0, adjustment);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 110.0, angle);
+
+    // Integral keeps growing, the servo stops on its limit
+    for (int k = 0; k < 20; k++) {
+        angle = pi_rudder_update(angle, 10, 1.0f, 0.5f, &cumulate_error, &adjustment);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, min_angle_safran, angle);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 210.0, cumulate_error);
+
+    angle = pi_rudder_update(angle, -180, 1.0f, 0.0f, &cumulate_error, &adjustment);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, max_angle_safran, angle);
+}
+
+// ------------------------
+// Test: Small Steady Error Moves the Rudder Alike Both Ways
+// ------------------------
+void test_pi_small_error_symmetry(void) {
+    // 0.3 degree per step: truncating to int would stall one way and move a full degree the other
+    float port_error = 0.0f, port_adjustment = 0.0f;
+    float starboard_error = 0.0f, starboard_adjustment = 0.0f;
+    float port = 125.0f, starboard = 125.0f;
+    for (int k = 0; k < 10; k++) {
+        port = pi_rudder_update(port, 1, 0.3f, 0.0f, &port_error, &port_adjustment);
+        starboard = pi_rudder_update(starboard, -1, 0.3f, 0.0f, &starboard_error, &starboard_adjustment);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 122.0, port);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 128.0, starboard);
+
+    // Same pulse offset from the centre either way once rounded
+    int centre = safran_pulse_us(125.0f, 1260, 1740);
+    TEST_ASSERT_EQUAL_INT(1524, centre);
+    TEST_ASSERT_EQUAL_INT(centre - safran_pulse_us(port, 1260, 1740),
+                          safran_pulse_us(starboard, 1260, 1740) - centre);
+    TEST_ASSERT_EQUAL_INT(1260, safran_pulse_us(min_angle_safran, 1260, 1740));
+    TEST_ASSERT_EQUAL_INT(1740, safran_pulse_us(max_angle_safran, 1260, 1740));
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_shortest_angle_difference);
+    RUN_TEST(test_pi_rudder_update);
+    RUN_TEST(test_pi_small_error_symmetry);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,155 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "controlLoop.h"
+#include "spscQueue.h"
+
+#ifndef ARDUINO
+#include <thread>
+#endif
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Queue Order, Full and Empty, Across Laps
+// ------------------------
+void test_spsc_queue(void) {
+    static SpscQueue<uint32_t, 4> queue;
+    uint32_t value;
+    TEST_ASSERT_FALSE(queue.pop(&value));
+
+    uint32_t next_in = 0, next_out = 0;
+    for (int lap = 0; lap < 5; lap++) {
+        for (int k = 0; k < 4; k++) {
+            TEST_ASSERT_TRUE(queue.push(next_in++));
+        }
+        TEST_ASSERT_FALSE(queue.push(999));
+        TEST_ASSERT_EQUAL_UINT32(4, queue.size());
+        for (int k = 0; k < 3; k++) {
+            TEST_ASSERT_TRUE(queue.pop(&value));
+            TEST_ASSERT_EQUAL_UINT32(next_out++, value);
+        }
+        TEST_ASSERT_TRUE(queue.push(next_in++));
+        while (queue.pop(&value)) {
+            TEST_ASSERT_EQUAL_UINT32(next_out++, value);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(next_in, next_out);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.size());
+}
+
+// ------------------------
+// Test: Period, Jitter and Overrun Statistics
+// ------------------------
+void test_jitter_stats(void) {
+    JitterStats jitter(20000);
+
+    // First step only sets the reference release time
+    jitter.record(1000, 150);
+    TEST_ASSERT_EQUAL_UINT32(0, jitter.data().count);
+    TEST_ASSERT_EQUAL_UINT32(150, jitter.data().max_exec_us);
+
+    jitter.record(21000, 100);          // 20000 us: on time
+    jitter.record(41040, 120);          // 20040 us: 40 us late
+    jitter.record(61010, 300);          // 19970 us: 30 us early
+    jitter.add_overrun();
+
+    const JitterData& stats = jitter.data();
+    TEST_ASSERT_EQUAL_UINT32(3, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(19970, stats.min_period_us);
+    TEST_ASSERT_EQUAL_UINT32(20040, stats.max_period_us);
+    TEST_ASSERT_EQUAL_UINT32(40, stats.max_jitter_us);
+    TEST_ASSERT_EQUAL_UINT32((0 + 40 + 30) / 3, stats.mean_jitter_us);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(300, stats.max_exec_us);
+
+    // A new window keeps measuring from the last release, across the micros() wrap
+    jitter.start_window();
+    TEST_ASSERT_EQUAL_UINT32(0, jitter.data().count);
+    jitter.record(81010, 100);
+    TEST_ASSERT_EQUAL_UINT32(1, jitter.data().count);
+    TEST_ASSERT_EQUAL_UINT32(20000, jitter.data().max_period_us);
+
+    JitterStats wrapped(20000);
+    wrapped.record(0xFFFFD8F0u, 100);   // 10000 us before the wrap
+    wrapped.record(10000, 100);
+    TEST_ASSERT_EQUAL_UINT32(20000, wrapped.data().min_period_us);
+    TEST_ASSERT_EQUAL_UINT32(0, wrapped.data().max_jitter_us);
+}
+
+// ------------------------
+// Test: Gains Tuned at 10 Hz Keep the Same Response at CONTROL_RATE_HZ
+// ------------------------
+void test_scale_pi_gains(void) {
+    float kp = 1.0f;
+    float ki = 0.5f;
+    scale_pi_gains(&kp, &ki);
+    float n = (float)CONTROL_RATE_HZ / CONTROL_TUNING_RATE_HZ;
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f / n, kp);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f / (n * n), ki);
+
+    // Constant error for 1 s: same proportional and integral move as 10 steps at 10 Hz
+    int error = 10;
+    float reference = 0.0f, scaled = 0.0f, sum = 0.0f;
+    for (int k = 1; k <= CONTROL_TUNING_RATE_HZ; k++) {
+        reference += 1.0f * error + 0.5f * error * k;
+    }
+    for (int k = 1; k <= CONTROL_RATE_HZ; k++) {
+        sum += error;
+        scaled += kp * error + ki * sum;
+    }
+    // Proportional part matches exactly, integral part to the first order
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * reference, reference, scaled);
+}
+
+#ifndef ARDUINO
+// ------------------------
+// Test: Producer and Consumer on Two Threads (host only)
+// ------------------------
+void test_spsc_threads(void) {
+    static SpscQueue<uint32_t, 8> queue;
+    const uint32_t COUNT = 200000;
+    std::thread producer([]() {
+        for (uint32_t k = 1; k <= COUNT; k++) {
+            while (!queue.push(k)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 1, errors = 0, value;
+    while (expected <= COUNT) {
+        if (queue.pop(&value)) {
+            errors += value != expected;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    TEST_ASSERT_EQUAL_UINT32(0, errors);
+    TEST_ASSERT_FALSE(queue.pop(&value));
+}
+#endif
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_spsc_queue);
+    RUN_TEST(test_jitter_stats);
+    RUN_TEST(test_scale_pi_gains);
+#ifndef ARDUINO
+    RUN_TEST(test_spsc_threads);
+#endif
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
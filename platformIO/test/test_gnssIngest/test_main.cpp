@@ -0,0 +1,97 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "gnssIngest.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Polled Window
+// ------------------------
+void test_polled_window(void) {
+    GnssIngestStats stats;
+
+    // 25 ms polls at 10 Hz: three empty polls out of four, one burst per epoch, no edge timestamp
+    for (int epoch = 0; epoch < 10; epoch++) {
+        stats.record_poll(0);
+        stats.record_poll(0);
+        stats.record_poll(0);
+        stats.record_poll(180);
+        stats.record_read(180);
+        stats.record_fix(0, 1000);
+    }
+
+    GnssIngestReport report = stats.take();
+    TEST_ASSERT_EQUAL_UINT32(40, report.polls);
+    TEST_ASSERT_EQUAL_UINT32(30, report.empty_polls);
+    TEST_ASSERT_EQUAL_UINT32(10, report.reads);
+    TEST_ASSERT_EQUAL_UINT32(10, report.fixes);
+    TEST_ASSERT_EQUAL_UINT32(180, report.bytes_per_fix);
+    TEST_ASSERT_EQUAL_UINT32(0, report.latency.count);
+}
+
+// ------------------------
+// Test: TX-Ready Window
+// ------------------------
+void test_txready_window(void) {
+    GnssIngestStats stats;
+
+    // One wake per epoch, the data is there; the second epoch arrives in two bursts
+    stats.record_poll(100);
+    stats.record_read(100);
+    stats.record_fix(1000, 1400);
+    stats.record_poll(100);
+    stats.record_read(100);
+    stats.record_fix(101000, 101600);
+    stats.record_poll(80);
+    stats.record_read(80);
+
+    GnssIngestReport report = stats.take();
+    TEST_ASSERT_EQUAL_UINT32(3, report.polls);
+    TEST_ASSERT_EQUAL_UINT32(0, report.empty_polls);
+    TEST_ASSERT_EQUAL_UINT32(280, report.bytes);
+    TEST_ASSERT_EQUAL_UINT32(140, report.bytes_per_fix);
+    TEST_ASSERT_EQUAL_UINT32(2, report.latency.count);
+    TEST_ASSERT_EQUAL_UINT32(400, report.latency.min_us);
+    TEST_ASSERT_EQUAL_UINT32(600, report.latency.max_us);
+    TEST_ASSERT_EQUAL_UINT32(500, report.latency.mean_us);
+}
+
+// ------------------------
+// Test: Window Reset
+// ------------------------
+void test_window_reset(void) {
+    GnssIngestStats stats;
+    stats.record_poll(0);
+    stats.record_fix(10, 20);
+    stats.take();
+
+    // A new window starts empty, no fix gives 0 bytes per fix
+    stats.record_poll(50);
+    stats.record_read(50);
+    GnssIngestReport report = stats.take();
+    TEST_ASSERT_EQUAL_UINT32(1, report.polls);
+    TEST_ASSERT_EQUAL_UINT32(0, report.empty_polls);
+    TEST_ASSERT_EQUAL_UINT32(0, report.fixes);
+    TEST_ASSERT_EQUAL_UINT32(0, report.bytes_per_fix);
+    TEST_ASSERT_EQUAL_UINT32(0, report.latency.count);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_polled_window);
+    RUN_TEST(test_txready_window);
+    RUN_TEST(test_window_reset);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
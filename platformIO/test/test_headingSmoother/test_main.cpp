@@ -0,0 +1,110 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "headingSmoother.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static double angle_error(double a, double b) {
+    return fabs(fmod(a - b + 540.0, 360.0) - 180.0);
+}
+
+// Reference circular mean over the last `window` entries of `headings`
+static double brute_force_mean(const double* headings, int end, int window) {
+    double sin_sum = 0.0, cos_sum = 0.0;
+    int start = end - window < 0 ? 0 : end - window;
+    for (int i = start; i < end; i++) {
+        sin_sum += sin(headings[i] * PI / 180.0);
+        cos_sum += cos(headings[i] * PI / 180.0);
+    }
+    return fmod(atan2(sin_sum, cos_sum) * 180.0 / PI + 360.0, 360.0);
+}
+
+// ------------------------
+// Test: Circular Mean
+// ------------------------
+void test_mean_matches_brute_force(void) {
+    double headings[64];
+    for (int i = 0; i < 64; i++) {
+        headings[i] = fmod(i * 37.0 + (i % 5) * 11.0, 360.0);
+    }
+    HeadingSmoother<double, 7> smoother;
+    for (int i = 0; i < 64; i++) {
+        double mean = smoother.push(headings[i]);
+        TEST_ASSERT_TRUE(angle_error(mean, brute_force_mean(headings, i + 1, 7)) < 1e-9);
+    }
+    TEST_ASSERT_EQUAL(7, smoother.size());
+}
+
+void test_mean_wraps_around_north(void) {
+    HeadingSmoother<float, 4> smoother;
+    smoother.push(350.0f);
+    float mean = smoother.push(10.0f);
+    TEST_ASSERT_TRUE(angle_error(mean, 0.0) < 0.01);
+}
+
+void test_float_sums_do_not_drift(void) {
+    // Long mission: running sums must stay on the exact mean of the window
+    HeadingSmoother<float, 16> smoother;
+    double headings[16];
+    float mean = 0.0f;
+    for (int i = 0; i < 200000; i++) {
+        float heading = (float)fmod(i * 7.3, 360.0);
+        headings[i % 16] = heading;
+        mean = smoother.push(heading);
+    }
+    TEST_ASSERT_TRUE(angle_error(mean, brute_force_mean(headings, 16, 16)) < 0.05);
+}
+
+void test_fixed_point_mean(void) {
+    HeadingSmoother<q16_16, 5> smoother;
+    const double headings[] = {40.0, 44.0, 48.0, 52.0, 56.0, 60.0};
+    q16_16 mean;
+    for (double heading : headings) {
+        mean = smoother.push(heading);
+    }
+    TEST_ASSERT_TRUE(angle_error((double)mean, 52.0) < 0.05);
+}
+
+// ------------------------
+// Test: Adaptive Blending
+// ------------------------
+void test_blending_factors(void) {
+    HeadingBlend<double> blend;
+    blend.small_factor = 0.0;   // Freeze small changes
+    blend.large_factor = 1.0;   // Follow large changes at once
+    HeadingSmoother<double, 1> smoother(blend);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 90.0, smoother.update(90.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 90.0, smoother.update(93.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 180.0, smoother.update(180.0));
+    // Medium change: default factor 0.2 of a 10 degree step
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 182.0, smoother.update(190.0));
+
+    smoother.reset();
+    TEST_ASSERT_FALSE(smoother.has_output());
+    TEST_ASSERT_EQUAL(0, smoother.size());
+}
+
+// ------------------------
+// Unity Main Function
+// ------------------------
+void setup() {
+    delay(2000);  // Give serial port time to connect
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mean_matches_brute_force);
+    RUN_TEST(test_mean_wraps_around_north);
+    RUN_TEST(test_float_sums_do_not_drift);
+    RUN_TEST(test_fixed_point_mean);
+    RUN_TEST(test_blending_factors);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Required by Arduino framework
+}
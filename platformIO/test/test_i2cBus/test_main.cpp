@@ -0,0 +1,139 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "i2cBus.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static I2cRequest make_request(uint8_t address) {
+    I2cRequest request = {address, 0, 1, NULL, NULL, NULL, NULL, NULL};
+    return request;
+}
+
+// ------------------------
+// Test: Command Words
+// ------------------------
+void test_build_commands(void) {
+    uint16_t commands[I2C_TRANSFER_MAX];
+    uint8_t reg = 0x02;
+    uint8_t data[4];
+
+    // Register read: the write, a repeated start on the first read, a stop on the last
+    I2cRequest request = {0x60, 1, 4, &reg, data, NULL, NULL, NULL};
+    TEST_ASSERT_EQUAL_UINT32(5, i2c_build_commands(request, commands));
+    TEST_ASSERT_EQUAL_HEX16(0x02, commands[0]);
+    TEST_ASSERT_EQUAL_HEX16(I2C_CMD_READ | I2C_CMD_RESTART, commands[1]);
+    TEST_ASSERT_EQUAL_HEX16(I2C_CMD_READ, commands[2]);
+    TEST_ASSERT_EQUAL_HEX16(I2C_CMD_READ | I2C_CMD_STOP, commands[4]);
+
+    // Write only: stop on the last byte
+    const uint8_t config[] = {0x09, 0x05};
+    I2cRequest write = {0x0D, 2, 0, config, NULL, NULL, NULL, NULL};
+    TEST_ASSERT_EQUAL_UINT32(2, i2c_build_commands(write, commands));
+    TEST_ASSERT_EQUAL_HEX16(0x09, commands[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x05 | I2C_CMD_STOP, commands[1]);
+
+    // Read only (GNSS stream): no repeated start
+    I2cRequest read = {0x42, 0, 1, NULL, data, NULL, NULL, NULL};
+    TEST_ASSERT_EQUAL_UINT32(1, i2c_build_commands(read, commands));
+    TEST_ASSERT_EQUAL_HEX16(I2C_CMD_READ | I2C_CMD_STOP, commands[0]);
+
+    // Empty or too long: refused
+    I2cRequest empty = {0x42, 0, 0, NULL, NULL, NULL, NULL, NULL};
+    TEST_ASSERT_EQUAL_UINT32(0, i2c_build_commands(empty, commands));
+    I2cRequest longest = {0x42, 1, I2C_TRANSFER_MAX, &reg, NULL, NULL, NULL, NULL};
+    TEST_ASSERT_EQUAL_UINT32(0, i2c_build_commands(longest, commands));
+}
+
+// ------------------------
+// Test: Channel Priorities
+// ------------------------
+void test_priorities(void) {
+    static I2cBus bus(0, 4, 5);
+    static I2cChannel low(2), high(0), middle(1), detached(0);
+
+    TEST_ASSERT_EQUAL_UINT8(I2C_NOT_READY, detached.submit(make_request(0x01)));
+    TEST_ASSERT_TRUE(bus.attach(low));
+    TEST_ASSERT_TRUE(bus.attach(high));
+    TEST_ASSERT_TRUE(bus.attach(middle));
+
+    TEST_ASSERT_EQUAL_UINT8(I2C_OK, low.submit(make_request(0x30)));
+    TEST_ASSERT_EQUAL_UINT8(I2C_OK, middle.submit(make_request(0x20)));
+    TEST_ASSERT_EQUAL_UINT8(I2C_OK, high.submit(make_request(0x10)));
+    TEST_ASSERT_EQUAL_UINT8(I2C_OK, high.submit(make_request(0x11)));
+
+    // Highest priority first, each channel in submission order
+    const uint8_t expected[] = {0x10, 0x11, 0x20, 0x30};
+    I2cRequest request;
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(bus.next(&request));
+        TEST_ASSERT_EQUAL_HEX8(expected[i], request.address);
+    }
+    TEST_ASSERT_FALSE(bus.next(&request));
+
+    // A full channel refuses, the others still accept
+    for (int i = 0; i < I2C_CHANNEL_DEPTH; i++) {
+        TEST_ASSERT_EQUAL_UINT8(I2C_OK, low.submit(make_request(0x30)));
+    }
+    TEST_ASSERT_EQUAL_UINT8(I2C_QUEUE_FULL, low.submit(make_request(0x30)));
+    TEST_ASSERT_EQUAL_UINT8(I2C_OK, middle.submit(make_request(0x20)));
+    TEST_ASSERT_TRUE(bus.next(&request));
+    TEST_ASSERT_EQUAL_HEX8(0x20, request.address);
+    while (bus.next(&request)) {
+    }
+}
+
+static int callback_count = 0;
+static I2cStatus callback_status = I2C_OK;
+
+static void on_done(I2cStatus status, void* context) {
+    callback_count++;
+    callback_status = status;
+    *(int*)context += 1;
+}
+
+// ------------------------
+// Test: Completion
+// ------------------------
+void test_completion(void) {
+    static I2cBus bus(1, 2, 3);
+    static I2cChannel channel(0);
+    TEST_ASSERT_TRUE(bus.attach(channel));
+
+    int context = 0;
+    I2cRequest request = make_request(0x42);
+    request.callback = on_done;
+    request.context = &context;
+    TEST_ASSERT_EQUAL_UINT8(I2C_OK, channel.submit(request));
+
+    // Bus not started: every request completes with I2C_NOT_READY
+    TEST_ASSERT_EQUAL_INT(1, bus.service());
+    TEST_ASSERT_EQUAL_INT(1, callback_count);
+    TEST_ASSERT_EQUAL_INT(1, context);
+    TEST_ASSERT_EQUAL_UINT8(I2C_NOT_READY, callback_status);
+    TEST_ASSERT_EQUAL_INT(0, bus.service());
+
+    // Without an owner task, transfer() runs in the caller
+    uint8_t byte;
+    TEST_ASSERT_EQUAL_UINT8(I2C_NOT_READY, channel.transfer(0x42, NULL, 0, &byte, 1));
+    TEST_ASSERT_EQUAL_INT(1, callback_count);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_build_commands);
+    RUN_TEST(test_priorities);
+    RUN_TEST(test_completion);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,170 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "isochroneRouter.h"
+
+static const double START_LAT = 47.2537;
+static const double START_LON = -1.3702;
+static const double METERS_PER_DEG = 111194.93;
+
+// Constant-in-space wind grid: 2 times x 2 x 2 nodes around the start
+static WindSample wind_storage[8];
+static WindField wind(wind_storage, 8);
+static BasicPolarTable<float> polar;
+static EmbeddedIsochroneRouter router(polar, wind);
+
+static void set_uniform_wind(float direction, float speed) {
+    WindGridSpec spec = {2, 2, 2, 0.0, 3600.0, START_LAT - 0.1, 0.2, START_LON - 0.1, 0.2};
+    wind.set_grid(spec);
+    wind.fill(direction, speed);
+}
+
+void setUp(void) {
+    IsochroneSettings settings;
+    router.set_settings(settings);
+}
+
+void tearDown(void) {
+}
+
+static double angle_error(double a, double b) {
+    return fabs(fmod(a - b + 540.0, 360.0) - 180.0);
+}
+
+// ------------------------
+// Test: Wind Field
+// ------------------------
+void test_wind_interpolates_through_north(void) {
+    WindGridSpec spec = {2, 1, 1, 0.0, 600.0, START_LAT, 0.0, START_LON, 0.0};
+    TEST_ASSERT_TRUE(wind.set_grid(spec));
+    wind.set_sample(0, 0, 0, 350.0f, 4.0f);
+    wind.set_sample(1, 0, 0, 10.0f, 4.0f);
+
+    float direction, speed;
+    TEST_ASSERT_TRUE(wind.sample(300.0, START_LAT, START_LON, &direction, &speed));
+    TEST_ASSERT_TRUE(angle_error(direction, 0.0) < 0.01);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 4.0, speed);
+
+    // Clamped before the first forecast
+    TEST_ASSERT_TRUE(wind.sample(-1000.0, START_LAT, START_LON, &direction, &speed));
+    TEST_ASSERT_TRUE(angle_error(direction, 350.0) < 0.01);
+
+    // Larger than the storage
+    WindGridSpec too_big = {3, 2, 2, 0.0, 600.0, START_LAT, 0.1, START_LON, 0.1};
+    TEST_ASSERT_FALSE(wind.set_grid(too_big));
+    TEST_ASSERT_FALSE(wind.is_ready());
+}
+
+// ------------------------
+// Test: Routing
+// ------------------------
+void test_reach_is_a_straight_line(void) {
+    set_uniform_wind(0.0f, 5.0f);
+    double dest_lon = START_LON + 1000.0 / (METERS_PER_DEG * cos(START_LAT * PI / 180.0));
+
+    RouteResult result = router.route(START_LAT, START_LON, START_LAT, dest_lon, 0.0);
+    TEST_ASSERT_TRUE(result.reached);
+    float expected = 1000.0f / polar.boat_speed(90.0f, 5.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f * expected, expected, result.duration_s);
+
+    double lats[16], lons[16];
+    int count = router.waypoints(lats, lons, 16);
+    TEST_ASSERT_EQUAL(1, count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, dest_lon, lons[0]);
+}
+
+void test_beat_tacks_at_vmg_angle(void) {
+    set_uniform_wind(0.0f, 5.0f);
+    double dest_lat = START_LAT + 1000.0 / METERS_PER_DEG;
+
+    RouteResult result = router.route(START_LAT, START_LON, dest_lat, START_LON, 0.0);
+    TEST_ASSERT_TRUE(result.reached);
+
+    // Time of a perfect beat at the polar VMG optimum
+    float vmg_angle = polar.upwind_vmg_angle(5.0f);
+    float vmg = polar.boat_speed(vmg_angle, 5.0f) * cosf(vmg_angle * (float)PI / 180.0f);
+    float expected = 1000.0f / vmg;
+    TEST_ASSERT_FLOAT_WITHIN(0.1f * expected, expected, result.duration_s);
+
+    // Every leg stays out of the no-go zone and at least one tack is needed
+    for (int k = 1; k < router.route_length(); k++) {
+        int heading = router.route_node(k).heading_index * router.get_settings().heading_step_deg;
+        TEST_ASSERT_TRUE(angle_error(heading, 0.0) >= 40.0);
+    }
+    double lats[16], lons[16];
+    int count = router.waypoints(lats, lons, 16);
+    TEST_ASSERT_TRUE(count >= 2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, dest_lat, lats[count - 1]);
+}
+
+void test_unreachable_destination_stops_closest(void) {
+    // 40 steps of 60 s cannot cover 20 km
+    set_uniform_wind(0.0f, 5.0f);
+    double dest_lon = START_LON + 20000.0 / (METERS_PER_DEG * cos(START_LAT * PI / 180.0));
+    RouteResult result = router.route(START_LAT, START_LON, START_LAT, dest_lon, 0.0);
+    TEST_ASSERT_FALSE(result.reached);
+    TEST_ASSERT_EQUAL(40, result.steps);
+    TEST_ASSERT_TRUE(router.route_node(router.route_length() - 1).east > 2000.0f);
+}
+
+#ifndef ARDUINO
+void test_threads_give_the_same_route(void) {
+    // Varying wind so many sectors compete
+    static WindSample storage[2 * 3 * 3];
+    WindField field(storage, 18);
+    WindGridSpec spec = {2, 3, 3, 0.0, 7200.0, START_LAT - 0.05, 0.05, START_LON - 0.05, 0.05};
+    field.set_grid(spec);
+    for (int t = 0; t < 2; t++) {
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                field.set_sample(t, i, j, 330.0f + 20.0f * t + 10.0f * j, 3.0f + i + t);
+            }
+        }
+    }
+    static HostIsochroneRouter single(polar, field);
+    static HostIsochroneRouter parallel(polar, field);
+    double dest_lat = START_LAT + 3000.0 / METERS_PER_DEG;
+    RouteResult a = single.route(START_LAT, START_LON, dest_lat, START_LON + 0.01, 0.0, 1);
+    RouteResult b = parallel.route(START_LAT, START_LON, dest_lat, START_LON + 0.01, 0.0, 4);
+    TEST_ASSERT_TRUE(a.reached);
+    TEST_ASSERT_EQUAL(a.nodes, b.nodes);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, a.duration_s, b.duration_s);
+    for (int k = 0; k < a.nodes; k++) {
+        TEST_ASSERT_EQUAL(single.route_node(k).heading_index, parallel.route_node(k).heading_index);
+    }
+}
+
+void test_wind_file(void) {
+    const char* path = "/tmp/test_wind_field.txt";
+    FILE* file = fopen(path, "w");
+    fprintf(file, "# two forecasts, single node\n2 1 1\n0 600 47.25 0 -1.37 0\n350,4\n10, 4\n");
+    fclose(file);
+    TEST_ASSERT_TRUE(wind.load_from_file(path));
+    float direction, speed;
+    wind.sample(300.0, START_LAT, START_LON, &direction, &speed);
+    TEST_ASSERT_TRUE(angle_error(direction, 0.0) < 0.01);
+    remove(path);
+}
+#endif
+
+// ------------------------
+// Unity Main Function
+// ------------------------
+void setup() {
+    delay(2000);  // Give serial port time to connect
+    UNITY_BEGIN();
+
+    RUN_TEST(test_wind_interpolates_through_north);
+    RUN_TEST(test_reach_is_a_straight_line);
+    RUN_TEST(test_beat_tacks_at_vmg_angle);
+    RUN_TEST(test_unreachable_destination_stops_closest);
+#ifndef ARDUINO
+    RUN_TEST(test_threads_give_the_same_route);
+    RUN_TEST(test_wind_file);
+#endif
+
+    UNITY_END();
+}
+
+void loop() {
+    // Required by Arduino framework
+}
@@ -0,0 +1,103 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "localFrame.h"
+#include "pathPlanification.h"
+
+// Leg start near Nantes, where the boat is tested
+static const double ORIGIN_LAT = 47.2537;
+static const double ORIGIN_LON = -1.3702;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static double angle_error(double a, double b) {
+    return fabs(fmod(a - b + 540.0, 360.0) - 180.0);
+}
+
+// ------------------------
+// Test: Projection Against Great-Circle Formulas
+// ------------------------
+void test_projection_matches_great_circle(void) {
+    LocalFrame<double> frame;
+    frame.set_origin(ORIGIN_LAT, ORIGIN_LON);
+
+    const double targets[][2] = {
+        {47.2546, -1.3695},   // ~110 m
+        {47.2470, -1.3790},   // ~1 km
+        {47.2900, -1.3100},   // ~6 km
+    };
+    for (const auto& target : targets) {
+        double east, north;
+        TEST_ASSERT_TRUE(frame.project(target[0], target[1], &east, &north));
+        double ref_az = BasicLaylinePathPlanner<double>::calculate_azimuth(ORIGIN_LAT, ORIGIN_LON, target[0], target[1]);
+        double ref_dist = BasicLaylinePathPlanner<double>::calculate_distance(ORIGIN_LAT, ORIGIN_LON, target[0], target[1]);
+        TEST_ASSERT_TRUE(angle_error(LocalFrame<double>::bearing(east, north), ref_az) < 0.1);
+        TEST_ASSERT_FLOAT_WITHIN(0.001 * ref_dist, ref_dist, LocalFrame<double>::length(east, north));
+    }
+}
+
+void test_projection_rejects_out_of_range(void) {
+    LocalFrame<double> frame;
+    double east = 0.0, north = 0.0;
+
+    // No origin yet
+    TEST_ASSERT_FALSE(frame.is_valid());
+    TEST_ASSERT_FALSE(frame.project(ORIGIN_LAT, ORIGIN_LON, &east, &north));
+
+    frame.set_origin(ORIGIN_LAT, ORIGIN_LON);
+    // ~20 km north, beyond MAX_RANGE
+    TEST_ASSERT_FALSE(frame.project(47.4337, ORIGIN_LON, &east, &north));
+    frame.invalidate();
+    TEST_ASSERT_FALSE(frame.project(ORIGIN_LAT, ORIGIN_LON, &east, &north));
+}
+
+void test_fixed_point_projection(void) {
+    LocalFrame<q16_16> frame;
+    frame.set_origin(ORIGIN_LAT, ORIGIN_LON);
+
+    // ~9 km leg: close to MAX_RANGE must not saturate
+    q16_16 east, north;
+    TEST_ASSERT_TRUE(frame.project(47.3000, -1.2800, &east, &north));
+    double ref_az = BasicLaylinePathPlanner<double>::calculate_azimuth(ORIGIN_LAT, ORIGIN_LON, 47.3000, -1.2800);
+    double ref_dist = BasicLaylinePathPlanner<double>::calculate_distance(ORIGIN_LAT, ORIGIN_LON, 47.3000, -1.2800);
+    TEST_ASSERT_TRUE(angle_error((double)LocalFrame<q16_16>::bearing(east, north), ref_az) < 0.5);
+    TEST_ASSERT_FLOAT_WITHIN(3.0 + 0.005 * ref_dist, ref_dist, (double)LocalFrame<q16_16>::length(east, north));
+}
+
+// ------------------------
+// Test: Planner Leg Frame
+// ------------------------
+void test_planner_long_leg_uses_great_circle(void) {
+    // ~60 km leg upwind: must still tack, using the great-circle fallback
+    BasicLaylinePathPlanner<double> planner;
+    double direction = planner.calculate_direction(ORIGIN_LAT, ORIGIN_LON, 47.7937, ORIGIN_LON,
+                                                   0.0, 0.0, 5.0, 0);
+    TEST_ASSERT_TRUE(angle_error(direction, 0.0) > 20.0);
+
+    // Same leg, new waypoint ~5 km east: frame is rebuilt and direct sailing resumes
+    direction = planner.calculate_direction(ORIGIN_LAT, ORIGIN_LON, ORIGIN_LAT, -1.3040,
+                                            0.0, 0.0, 5.0, 10000);
+    TEST_ASSERT_TRUE(angle_error(direction, 90.0) < 45.0);
+}
+
+// ------------------------
+// Unity Main Function
+// ------------------------
+void setup() {
+    delay(2000);  // Give serial port time to connect
+    UNITY_BEGIN();
+
+    RUN_TEST(test_projection_matches_great_circle);
+    RUN_TEST(test_projection_rejects_out_of_range);
+    RUN_TEST(test_fixed_point_projection);
+    RUN_TEST(test_planner_long_leg_uses_great_circle);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Required by Arduino framework
+}
@@ -0,0 +1,120 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "pathPlanification.h"
+
+// Triangle course near Nantes: north (~300 m), then west (~200 m), then back
+static const double START_LAT = 47.2537;
+static const double START_LON = -1.3702;
+static const double COURSE_LAT[] = {47.2564, 47.2564, 47.2537};
+static const double COURSE_LON[] = {-1.3702, -1.3728, -1.3702};
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static double angle_error(double a, double b) {
+    return fabs(fmod(a - b + 540.0, 360.0) - 180.0);
+}
+
+// ------------------------
+// Test: Leg Precomputation
+// ------------------------
+void test_load_precomputes_legs(void) {
+    BasicMission<double> mission;
+    TEST_ASSERT_TRUE(mission.load(COURSE_LAT, COURSE_LON, 3, START_LAT, START_LON));
+    TEST_ASSERT_EQUAL(3, mission.size());
+    TEST_ASSERT_EQUAL(0, mission.active_index());
+
+    for (int i = 0; i < 3; i++) {
+        const MissionLeg<double>* leg = mission.leg(i);
+        TEST_ASSERT_NOT_NULL(leg);
+        TEST_ASSERT_TRUE(leg->end_in_frame);
+        double ref_az = BasicLaylinePathPlanner<double>::calculate_azimuth(leg->start_lat, leg->start_lon, leg->end_lat, leg->end_lon);
+        double ref_dist = BasicLaylinePathPlanner<double>::calculate_distance(leg->start_lat, leg->start_lon, leg->end_lat, leg->end_lon);
+        TEST_ASSERT_TRUE(angle_error(leg->bearing, ref_az) < 0.1);
+        TEST_ASSERT_FLOAT_WITHIN(0.001 * ref_dist, ref_dist, leg->length);
+    }
+    // Legs chain: each one starts at the previous waypoint
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, COURSE_LAT[0], mission.leg(1)->start_lat);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, COURSE_LON[1], mission.leg(2)->start_lon);
+
+    // Wind from the north: only the first leg is a beat
+    mission.estimate_tacks(0.0, 5.0);
+    TEST_ASSERT_EQUAL(1, mission.leg(0)->expected_tacks);
+    TEST_ASSERT_EQUAL(0, mission.leg(1)->expected_tacks);
+    TEST_ASSERT_EQUAL(0, mission.leg(2)->expected_tacks);
+    TEST_ASSERT_EQUAL(1, mission.remaining_tacks());
+}
+
+void test_load_rejects_invalid_count(void) {
+    static double lats[MISSION_MAX_WAYPOINTS + 1];
+    static double lons[MISSION_MAX_WAYPOINTS + 1];
+    BasicMission<double> mission;
+    TEST_ASSERT_FALSE(mission.load(lats, lons, 0, START_LAT, START_LON));
+    TEST_ASSERT_FALSE(mission.load(lats, lons, MISSION_MAX_WAYPOINTS + 1, START_LAT, START_LON));
+    TEST_ASSERT_TRUE(mission.is_finished());
+    TEST_ASSERT_NULL(mission.active_leg());
+}
+
+// ------------------------
+// Test: Planner Mission Navigation
+// ------------------------
+void test_auto_advance_on_arrival(void) {
+    BasicMission<double> mission;
+    BasicLaylinePathPlanner<double> planner;
+    mission.load(COURSE_LAT, COURSE_LON, 3, START_LAT, START_LON);
+
+    // Wind from the east: first leg (north) is a reach
+    double direction = planner.calculate_mission_direction(mission, START_LAT, START_LON, 0.0, 90.0, 5.0, 0);
+    TEST_ASSERT_EQUAL(0, mission.active_index());
+    TEST_ASSERT_TRUE(angle_error(direction, 0.0) < 5.0);
+
+    // ~10 m from the first mark: advance and head west
+    TEST_ASSERT_NOT_NULL(mission.next_leg());
+    planner.calculate_mission_direction(mission, 47.25631, -1.3702, 0.0, 90.0, 5.0, 5000);
+    TEST_ASSERT_EQUAL(1, mission.active_index());
+
+    // Last mark reached: mission finished, compass heading is held
+    mission.advance();
+    direction = planner.calculate_mission_direction(mission, 47.25371, -1.3702, 123.0, 90.0, 5.0, 10000);
+    TEST_ASSERT_TRUE(mission.is_finished());
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 123.0, direction);
+}
+
+void test_first_board_follows_next_leg(void) {
+    // Upwind course: first mark north, second mark north-west, wind from the north
+    const double lats[] = {47.2564, 47.2600};
+    const double lons[] = {-1.3702, -1.3760};
+    BasicMission<double> mission;
+    BasicLaylinePathPlanner<double> planner;
+    mission.load(lats, lons, 2, START_LAT, START_LON);
+
+    // Arrive at the first mark heading north-east (starboard board): minimal
+    // turning would keep starboard, but the next mark lies left of the wind
+    planner.calculate_mission_direction(mission, 47.25631, -1.3702, 50.0, 310.0, 5.0, 0);
+    TEST_ASSERT_EQUAL(1, mission.active_index());
+    double direction = planner.calculate_mission_direction(mission, 47.25631, -1.3702, 50.0, 310.0, 5.0, 0);
+    // Port board: wind minus the VMG tack angle, north-west
+    TEST_ASSERT_TRUE(direction > 270.0 && direction < 330.0);
+}
+
+// ------------------------
+// Unity Main Function
+// ------------------------
+void setup() {
+    delay(2000);  // Give serial port time to connect
+    UNITY_BEGIN();
+
+    RUN_TEST(test_load_precomputes_legs);
+    RUN_TEST(test_load_rejects_invalid_count);
+    RUN_TEST(test_auto_advance_on_arrival);
+    RUN_TEST(test_first_board_follows_next_leg);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Required by Arduino framework
+}
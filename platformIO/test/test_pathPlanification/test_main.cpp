@@ -5,6 +5,11 @@
 // Test fixture
 LaylinePathPlanner planner;
 
+// Planner results in the selected scalar mode, widened for Unity assertions
+static double as_double(PlannerScalar value) {
+    return ScalarMath<PlannerScalar>::to_double(value);
+}
+
 void setUp(void) {
     // Reset planner state before each test
     planner.reset_planner_state();
@@ -18,21 +23,21 @@ void tearDown(void) {
 // Test: Static Utility Functions
 // ------------------------
 void test_calculate_azimuth(void) {
-    double azimuth = LaylinePathPlanner::calculate_azimuth(48.8566, 2.3522, 48.8570, 2.3530);
+    double azimuth = as_double(LaylinePathPlanner::calculate_azimuth(48.8566, 2.3522, 48.8570, 2.3530));
     TEST_ASSERT_FLOAT_WITHIN(0.5, 52.76, azimuth); // Adjust tolerance as needed
 }
 
 void test_calculate_distance(void) {
-    double distance = LaylinePathPlanner::calculate_distance(48.8566, 2.3522, 48.8570, 2.3530);
+    double distance = as_double(LaylinePathPlanner::calculate_distance(48.8566, 2.3522, 48.8570, 2.3530));
     // ~50-60m distance depending on exact calculation
     TEST_ASSERT_TRUE(distance > 45.0 && distance < 65.0);
 }
 
 void test_define_no_go_zone(void) {
-    double min_angle, max_angle;
+    PlannerScalar min_angle, max_angle;
     LaylinePathPlanner::define_no_go_zone(90.0, 5.0, &min_angle, &max_angle);
-    TEST_ASSERT_FLOAT_WITHIN(0.1, 45.0, min_angle);
-    TEST_ASSERT_FLOAT_WITHIN(0.1, 135.0, max_angle);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 45.0, as_double(min_angle));
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 135.0, as_double(max_angle));
 }
 
 void test_is_in_no_go_zone(void) {
@@ -52,34 +57,34 @@ void test_is_in_no_go_zone(void) {
 // ------------------------
 void test_direct_sailing_when_possible(void) {
     // Waypoint is NOT in no-go zone relative to wind
-    double direction = planner.calculate_direction(
+    double direction = as_double(planner.calculate_direction(
         48.8566, 2.3522,     // boat position
         48.8600, 2.3700,     // waypoint (~1km east-northeast)
         90.0,                // compass heading (east)
         270.0,               // wind from west (relative to boat)
         5.0,                 // wind speed 5 m/s
-        0.0                  // current time
-    );
+        0                    // current time (ms)
+    ));
     
     // Direction should be close to direct route since wind is favorable
-    double direct_azimuth = LaylinePathPlanner::calculate_azimuth(48.8566, 2.3522, 48.8600, 2.3700);
+    double direct_azimuth = as_double(LaylinePathPlanner::calculate_azimuth(48.8566, 2.3522, 48.8600, 2.3700));
     TEST_ASSERT_FLOAT_WITHIN(10.0, direct_azimuth, direction);
 }
 
 void test_tacking_when_necessary(void) {
     // Waypoint IS in no-go zone relative to wind (wind from direction of waypoint)
-    double direction = planner.calculate_direction(
+    double direction = as_double(planner.calculate_direction(
         48.8566, 2.3522,     // boat position
         48.8600, 2.3530,     // waypoint (north)
         0.0,                 // compass heading (north)
         0.0,                 // wind from north (relative to boat)
         5.0,                 // wind speed 5 m/s
-        0.0                  // current time
-    );
+        0                    // current time (ms)
+    ));
     
     // Direct azimuth would be 0 degrees (north), but we can't sail there
     // Direction should be on one of the tacks, not directly toward waypoint
-    double direct_azimuth = LaylinePathPlanner::calculate_azimuth(48.8566, 2.3522, 48.8600, 2.3530);
+    double direct_azimuth = as_double(LaylinePathPlanner::calculate_azimuth(48.8566, 2.3522, 48.8600, 2.3530));
     TEST_ASSERT_TRUE(fabs(direction - direct_azimuth) > 20.0);
     
     // Direction should be one of the optimal tack angles
@@ -89,6 +94,57 @@ void test_tacking_when_necessary(void) {
     TEST_ASSERT_TRUE(is_valid_tack);
 }
 
+// ------------------------
+// Test: Scalar Modes Against the Double Reference
+// ------------------------
+static double angle_error(double a, double b) {
+    return fabs(fmod(a - b + 540.0, 360.0) - 180.0);
+}
+
+void test_float_planner_within_tolerance(void) {
+    // Legs from 100 m to ~20 km around Nantes
+    const double legs[][4] = {
+        {47.2537, -1.3702, 47.2546, -1.3695},
+        {47.2537, -1.3702, 47.2470, -1.3790},
+        {47.2537, -1.3702, 47.3100, -1.2001},
+        {47.2537, -1.3702, 47.1000, -1.5500},
+    };
+    for (const auto& leg : legs) {
+        double ref_az = BasicLaylinePathPlanner<double>::calculate_azimuth(leg[0], leg[1], leg[2], leg[3]);
+        double ref_dist = BasicLaylinePathPlanner<double>::calculate_distance(leg[0], leg[1], leg[2], leg[3]);
+        double az = BasicLaylinePathPlanner<float>::calculate_azimuth(leg[0], leg[1], leg[2], leg[3]);
+        double dist = BasicLaylinePathPlanner<float>::calculate_distance(leg[0], leg[1], leg[2], leg[3]);
+        TEST_ASSERT_TRUE(angle_error(az, ref_az) < 0.5);
+        TEST_ASSERT_FLOAT_WITHIN(1.0, ref_dist, dist);
+    }
+}
+
+void test_fixed_point_planner_within_tolerance(void) {
+    const double legs[][4] = {
+        {47.2537, -1.3702, 47.2546, -1.3695},
+        {47.2537, -1.3702, 47.2470, -1.3790},
+        {47.2537, -1.3702, 47.3100, -1.2001},
+        {47.2537, -1.3702, 47.1000, -1.5500},
+    };
+    for (const auto& leg : legs) {
+        double ref_az = BasicLaylinePathPlanner<double>::calculate_azimuth(leg[0], leg[1], leg[2], leg[3]);
+        double ref_dist = BasicLaylinePathPlanner<double>::calculate_distance(leg[0], leg[1], leg[2], leg[3]);
+        double az = (double)BasicLaylinePathPlanner<q16_16>::calculate_azimuth(leg[0], leg[1], leg[2], leg[3]);
+        double dist = (double)BasicLaylinePathPlanner<q16_16>::calculate_distance(leg[0], leg[1], leg[2], leg[3]);
+        TEST_ASSERT_TRUE(angle_error(az, ref_az) < 1.0);
+        TEST_ASSERT_FLOAT_WITHIN(3.0 + 0.005 * ref_dist, ref_dist, dist);
+    }
+}
+
+void test_fixed_point_trigonometry(void) {
+    for (int deg = -360; deg <= 360; deg += 15) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4, sin(deg * PI / 180.0), (double)ScalarMath<q16_16>::sin_deg(q16_16(deg)));
+        TEST_ASSERT_FLOAT_WITHIN(1e-4, cos(deg * PI / 180.0), (double)ScalarMath<q16_16>::cos_deg(q16_16(deg)));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 135.0, (double)ScalarMath<q16_16>::atan2_deg(q16_16(1.0), q16_16(-1.0)));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, -30.0, (double)ScalarMath<q16_16>::atan2_deg(q16_16(-0.5), q16_16(0.8660254)));
+}
+
 // ------------------------
 // Unity Main Function
 // ------------------------
@@ -106,6 +162,11 @@ void setup() {
     RUN_TEST(test_direct_sailing_when_possible);
     RUN_TEST(test_tacking_when_necessary);
 
+    // Test scalar build modes
+    RUN_TEST(test_float_planner_within_tolerance);
+    RUN_TEST(test_fixed_point_planner_within_tolerance);
+    RUN_TEST(test_fixed_point_trigonometry);
+
     UNITY_END();
 }
 
@@ -0,0 +1,99 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "pipeline.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Newest Sample, Missing Samples and micros() Wrap-Around
+// ------------------------
+void test_newest_sample(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, newest_sample_us(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(1500, newest_sample_us(0, 1500));
+    TEST_ASSERT_EQUAL_UINT32(1500, newest_sample_us(1500, 0));
+    TEST_ASSERT_EQUAL_UINT32(2000, newest_sample_us(1500, 2000));
+    TEST_ASSERT_EQUAL_UINT32(2000, newest_sample_us(2000, 1500));
+    // 0xFFFFFF00 was taken just before the wrap, 0x100 just after
+    TEST_ASSERT_EQUAL_UINT32(0x100, newest_sample_us(0xFFFFFF00u, 0x100));
+    TEST_ASSERT_EQUAL_UINT32(0x100, newest_sample_us(0x100, 0xFFFFFF00u));
+}
+
+// ------------------------
+// Test: Latency Statistics
+// ------------------------
+void test_latency_stats(void) {
+    LatencyStats latency;
+    TEST_ASSERT_EQUAL_UINT32(0, latency.data().count);
+
+    // A heading without sensor sample is not counted
+    TEST_ASSERT_FALSE(latency.record(0, 5000));
+    TEST_ASSERT_EQUAL_UINT32(0, latency.data().count);
+
+    TEST_ASSERT_TRUE(latency.record(1000, 4000));
+    TEST_ASSERT_TRUE(latency.record(10000, 11000));
+    TEST_ASSERT_TRUE(latency.record(20000, 25000));
+    // Across the micros() wrap-around
+    TEST_ASSERT_TRUE(latency.record(0xFFFFF000u, 0x1000));
+
+    const LatencyData& stats = latency.data();
+    TEST_ASSERT_EQUAL_UINT32(4, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(0x2000, stats.last_us);
+    TEST_ASSERT_EQUAL_UINT32(1000, stats.min_us);
+    TEST_ASSERT_EQUAL_UINT32(0x2000, stats.max_us);
+    TEST_ASSERT_EQUAL_UINT32((3000 + 1000 + 5000 + 0x2000) / 4, stats.mean_us);
+
+    latency.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, latency.data().count);
+    TEST_ASSERT_TRUE(latency.record(100, 400));
+    TEST_ASSERT_EQUAL_UINT32(300, latency.data().min_us);
+    TEST_ASSERT_EQUAL_UINT32(300, latency.data().mean_us);
+}
+
+// ------------------------
+// Test: Planner Runs Paced at 10 Hz Fixes
+// ------------------------
+void test_planner_pacer(void) {
+    PlannerPacer pacer(500);
+    // The first sample runs at once
+    TEST_ASSERT_EQUAL_UINT32(0, pacer.hold_ms(1000));
+    pacer.ran(1000);
+    // Fixes 100 ms apart wait for the end of the period
+    TEST_ASSERT_EQUAL_UINT32(400, pacer.hold_ms(1100));
+    TEST_ASSERT_EQUAL_UINT32(100, pacer.hold_ms(1400));
+    TEST_ASSERT_EQUAL_UINT32(0, pacer.hold_ms(1500));
+
+    // One run per 500 ms over 10 s of 10 Hz fixes
+    int runs = 0;
+    for (uint32_t now_ms = 1500; now_ms < 11500; now_ms += 100) {
+        if (pacer.hold_ms(now_ms) == 0) {
+            pacer.ran(now_ms);
+            runs++;
+        }
+    }
+    TEST_ASSERT_EQUAL(20, runs);
+
+    // After an idle gap the next sample runs at once, across the millis() wrap-around
+    pacer.ran(0xFFFFFF00u);
+    TEST_ASSERT_EQUAL_UINT32(244, pacer.hold_ms(0xFFFFFF00u + 256));
+    TEST_ASSERT_EQUAL_UINT32(0, pacer.hold_ms(0x200));
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_newest_sample);
+    RUN_TEST(test_latency_stats);
+    RUN_TEST(test_planner_pacer);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,158 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "plannerBatch.h"
+#include "pathPlanification.h"
+
+static const int STATE_COUNT = 64;
+
+static float boat_east[STATE_COUNT], boat_north[STATE_COUNT];
+static float wpt_east[STATE_COUNT], wpt_north[STATE_COUNT];
+static float compass[STATE_COUNT], wind_vane[STATE_COUNT], wind_speed[STATE_COUNT];
+static uint8_t on_port_tack[STATE_COUNT];
+static float azimuth[STATE_COUNT], distance[STATE_COUNT];
+static float port_heading[STATE_COUNT], starboard_heading[STATE_COUNT];
+static uint8_t can_sail_direct[STATE_COUNT], tack_proposed[STATE_COUNT], required_confirmations[STATE_COUNT];
+
+static const PlannerBatchStates STATES = {boat_east, boat_north, wpt_east, wpt_north,
+                                          compass, wind_vane, wind_speed, on_port_tack};
+static const PlannerBatchResults RESULTS = {azimuth, distance, port_heading, starboard_heading,
+                                            can_sail_direct, tack_proposed, required_confirmations};
+
+void setUp(void) {
+    for (int k = 0; k < STATE_COUNT; k++) {
+        boat_east[k] = 0.0f;
+        boat_north[k] = 0.0f;
+        wpt_east[k] = 0.0f;
+        wpt_north[k] = 100.0f;
+        compass[k] = 0.0f;
+        wind_vane[k] = 0.0f;
+        wind_speed[k] = 5.0f;
+        on_port_tack[k] = 1;
+    }
+}
+
+void tearDown(void) {
+}
+
+static float angle_error(float a, float b) {
+    return fabsf(fmodf(a - b + 540.0f, 360.0f) - 180.0f);
+}
+
+// ------------------------
+// Test: Polynomial atan2 Against libm
+// ------------------------
+void test_atan2_accuracy(void) {
+    for (int deg = -180; deg < 180; deg += 7) {
+        for (float radius = 0.5f; radius < 5000.0f; radius *= 7.0f) {
+            float y = radius * sinf(deg * (float)(PI / 180.0));
+            float x = radius * cosf(deg * (float)(PI / 180.0));
+            float expected = atan2f(y, x) * (float)(180.0 / PI);
+            TEST_ASSERT_TRUE(angle_error(PlannerBatch::atan2_deg(y, x), expected) < 0.001f);
+        }
+    }
+}
+
+// ------------------------
+// Test: Vector Kernel Matches LocalFrame
+// ------------------------
+void test_vectors_match_local_frame(void) {
+    float east[STATE_COUNT], north[STATE_COUNT], bearing[STATE_COUNT], length[STATE_COUNT];
+    for (int k = 0; k < STATE_COUNT; k++) {
+        east[k] = 300.0f * sinf(k * 0.37f) - 20.0f;
+        north[k] = 450.0f * cosf(k * 0.53f) + 5.0f;
+    }
+    PlannerBatch::vectors(east, north, bearing, length, STATE_COUNT);
+    for (int k = 0; k < STATE_COUNT; k++) {
+        TEST_ASSERT_TRUE(angle_error(bearing[k], LocalFrame<float>::bearing(east[k], north[k])) < 0.001f);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, LocalFrame<float>::length(east[k], north[k]), length[k]);
+        TEST_ASSERT_TRUE(bearing[k] >= 0.0f && bearing[k] < 360.0f);
+    }
+}
+
+// ------------------------
+// Test: No-Go Decision Matches the Planner Zone
+// ------------------------
+void test_no_go_matches_planner(void) {
+    const float speeds[] = {3.0f, 8.0f, 17.0f};
+    const float buffer = PlannerBatchParams().no_go_buffer;
+    PlannerBatch batch;
+    for (float ws : speeds) {
+        for (int base = 0; base < 360; base += 90) {
+            // Waypoint 100 m away on bearings 3 degrees apart, wind from base
+            for (int k = 0; k < STATE_COUNT; k++) {
+                float bearing = (float)(base + 3 * k - 96);
+                wpt_east[k] = 100.0f * sinf(bearing * (float)(PI / 180.0));
+                wpt_north[k] = 100.0f * cosf(bearing * (float)(PI / 180.0));
+                compass[k] = (float)base;
+                wind_speed[k] = ws;
+            }
+            batch.evaluate(STATES, RESULTS, STATE_COUNT);
+
+            float min_angle, max_angle;
+            BasicLaylinePathPlanner<float>::define_no_go_zone((float)base, ws, &min_angle, &max_angle);
+            float half = angle_error(max_angle, min_angle) / 2.0f + buffer;
+            for (int k = 0; k < STATE_COUNT; k++) {
+                float off_wind = angle_error(azimuth[k], (float)base);
+                if (fabsf(off_wind - half) < 0.5f) {
+                    continue;   // Boundary, either answer is fine
+                }
+                TEST_ASSERT_EQUAL(off_wind > half, can_sail_direct[k] != 0);
+            }
+        }
+    }
+}
+
+// ------------------------
+// Test: Tack Headings and Layline Proposal
+// ------------------------
+void test_layline_proposal(void) {
+    PlannerBatch batch;
+    float vmg = BasicPolarTable<float>::default_table().upwind_vmg_angle(5.0f);
+    float vmg_tack = fmaxf(vmg, 40.0f) + 5.0f;
+
+    // Wind from north, waypoint 80 m away, 90 degrees to the right: past the
+    // starboard layline when sailing on port, fine on starboard
+    wpt_east[0] = 80.0f;
+    wpt_north[0] = 0.0f;
+    on_port_tack[0] = 1;
+    wpt_east[1] = 80.0f;
+    wpt_north[1] = 0.0f;
+    on_port_tack[1] = 0;
+    // Waypoint dead upwind, 30 m away: no tack on either board
+    wpt_north[2] = 30.0f;
+    on_port_tack[2] = 0;
+    batch.evaluate(STATES, RESULTS, 3);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 360.0f - vmg_tack, port_heading[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, vmg_tack, starboard_heading[0]);
+    TEST_ASSERT_EQUAL(1, tack_proposed[0]);
+    TEST_ASSERT_EQUAL(0, tack_proposed[1]);
+    TEST_ASSERT_EQUAL(0, tack_proposed[2]);
+    TEST_ASSERT_EQUAL(7, required_confirmations[0]);
+    TEST_ASSERT_EQUAL(5, required_confirmations[2]);
+    TEST_ASSERT_EQUAL(0, can_sail_direct[2]);
+
+    // A wider hysteresis margin keeps the port board
+    PlannerBatchParams params;
+    params.tack_hysteresis_margin = 60.0f;
+    batch.set_params(params);
+    batch.evaluate(STATES, RESULTS, 1);
+    TEST_ASSERT_EQUAL(0, tack_proposed[0]);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_atan2_accuracy);
+    RUN_TEST(test_vectors_match_local_frame);
+    RUN_TEST(test_no_go_matches_planner);
+    RUN_TEST(test_layline_proposal);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,97 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "polarTable.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Interpolation
+// ------------------------
+void test_grid_nodes_match_model(void) {
+    BasicPolarTable<double> table;
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, PolarModel::boat_speed(90.0, 5.0), table.boat_speed(90.0, 5.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, PolarModel::boat_speed(40.0, 3.0), table.boat_speed(40.0, 3.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, table.boat_speed(20.0, 8.0));
+}
+
+void test_bilinear_interpolation(void) {
+    BasicPolarTable<double> table;
+    // Halfway between four nodes is the mean of the four nodes
+    double expected = (PolarModel::boat_speed(90.0, 4.0) + PolarModel::boat_speed(95.0, 4.0) +
+                       PolarModel::boat_speed(90.0, 5.0) + PolarModel::boat_speed(95.0, 5.0)) / 4.0;
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, expected, table.boat_speed(92.5, 4.5));
+}
+
+void test_symmetry_and_clamping(void) {
+    BasicPolarTable<float> table;
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, table.boat_speed(120.0f, 6.0f), table.boat_speed(-120.0f, 6.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, table.boat_speed(120.0f, 6.0f), table.boat_speed(240.0f, 6.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, table.boat_speed(90.0f, 12.0f), table.boat_speed(90.0f, 25.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 0.0, table.boat_speed(90.0f, -1.0f));
+}
+
+// ------------------------
+// Test: VMG Cache
+// ------------------------
+void test_vmg_cache_matches_brute_force(void) {
+    BasicPolarTable<double> table;
+    for (int tws = 1; tws <= 12; tws++) {
+        double best_vmg = 0.0, best_twa = 0.0;
+        for (double twa = 0.0; twa <= 90.0; twa += 1.0) {
+            double vmg = table.boat_speed(twa, tws) * cos(twa * PI / 180.0);
+            if (vmg > best_vmg) {
+                best_vmg = vmg;
+                best_twa = twa;
+            }
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1.0, best_twa, table.upwind_vmg_angle(tws));
+    }
+    double downwind = table.downwind_vmg_angle(5.0);
+    TEST_ASSERT_TRUE(downwind > 120.0 && downwind <= 180.0);
+}
+
+void test_fixed_point_table(void) {
+    BasicPolarTable<double> reference;
+    BasicPolarTable<q16_16> table;
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, reference.boat_speed(75.0, 6.5), (double)table.boat_speed(q16_16(75.0), q16_16(6.5)));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, reference.upwind_vmg_angle(6.5), (double)table.upwind_vmg_angle(q16_16(6.5)));
+}
+
+void test_set_speeds_rebuilds_cache(void) {
+    // Flat polar from 40 deg: best upwind VMG is right at 40 deg
+    static double speeds[PolarGrid::TWA_COUNT][PolarGrid::TWS_COUNT];
+    for (int i = 0; i < PolarGrid::TWA_COUNT; i++) {
+        for (int j = 0; j < PolarGrid::TWS_COUNT; j++) {
+            speeds[i][j] = (i * PolarGrid::TWA_STEP >= 40.0) ? 1.0 : 0.0;
+        }
+    }
+    BasicPolarTable<double> table;
+    table.set_speeds(speeds);
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 40.0, table.upwind_vmg_angle(5.0));
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 180.0, table.downwind_vmg_angle(5.0));
+}
+
+// ------------------------
+// Unity Main Function
+// ------------------------
+void setup() {
+    delay(2000);  // Give serial port time to connect
+    UNITY_BEGIN();
+
+    RUN_TEST(test_grid_nodes_match_model);
+    RUN_TEST(test_bilinear_interpolation);
+    RUN_TEST(test_symmetry_and_clamping);
+    RUN_TEST(test_vmg_cache_matches_brute_force);
+    RUN_TEST(test_fixed_point_table);
+    RUN_TEST(test_set_speeds_rebuilds_cache);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Required by Arduino framework
+}
@@ -0,0 +1,145 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include <string.h>
+#include "radioFrame.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// Feed a string, keep the commands (separated by ';') and the RTK bytes
+struct Received {
+    char commands[256];
+    uint8_t rtk[64];
+    int rtk_count;
+    int dropped;
+    RadioDrop last_drop;
+};
+
+static void feed(RadioFrameParser& parser, const char* text, Received* received) {
+    for (const char* p = text; *p != '\0'; p++) {
+        switch (parser.feed((uint8_t)*p)) {
+        case RADIO_COMMAND:
+            strcat(received->commands, parser.command().text);
+            strcat(received->commands, ";");
+            break;
+        case RADIO_RTK_BYTE:
+            received->rtk[received->rtk_count++] = parser.rtk_byte();
+            break;
+        case RADIO_DROPPED:
+            received->dropped++;
+            received->last_drop = parser.drop_reason();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+// ------------------------
+// Test: Commands From the Ground Station
+// ------------------------
+void test_commands(void) {
+    RadioFrameParser parser;
+    Received received = {};
+
+    // As sent by interface/xbee.py: "key:value|\n"
+    feed(parser, "kp:1.5|\nki:0.2|\n", &received);
+    TEST_ASSERT_EQUAL_STRING("kp:1.5;ki:0.2;", received.commands);
+
+    // Spaces around the command are trimmed, empty frames ignored
+    received.commands[0] = '\0';
+    feed(parser, "  cap:90 \r\n||wp:47.25,-1.37|", &received);
+    TEST_ASSERT_EQUAL_STRING("cap:90;wp:47.25,-1.37;", received.commands);
+    TEST_ASSERT_EQUAL_INT(0, received.dropped);
+}
+
+// ------------------------
+// Test: Frame Split Across Reads
+// ------------------------
+void test_partial_frame(void) {
+    RadioFrameParser parser;
+    Received received = {};
+
+    feed(parser, "tens", &received);
+    TEST_ASSERT_EQUAL_STRING("", received.commands);
+    feed(parser, "ion:12", &received);
+    TEST_ASSERT_EQUAL_STRING("", received.commands);
+    feed(parser, "0|", &received);
+    TEST_ASSERT_EQUAL_STRING("tension:120;", received.commands);
+}
+
+// ------------------------
+// Test: RTK Corrections Decoded From Hex
+// ------------------------
+void test_rtk_stream(void) {
+    RadioFrameParser parser;
+    Received received = {};
+
+    feed(parser, "rtk:d300", &received);
+    feed(parser, "13Ab|\nkp:2|", &received);
+    TEST_ASSERT_EQUAL_INT(4, received.rtk_count);
+    TEST_ASSERT_EQUAL_UINT8(0xD3, received.rtk[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, received.rtk[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x13, received.rtk[2]);
+    TEST_ASSERT_EQUAL_UINT8(0xAB, received.rtk[3]);
+    TEST_ASSERT_EQUAL_STRING("kp:2;", received.commands);
+
+    // Non-hex digit or odd digit count: the frame is dropped, the next one is parsed
+    received = Received();
+    feed(parser, "rtk:d3x0|cap:10|rtk:d3f|", &received);
+    TEST_ASSERT_EQUAL_INT(2, received.dropped);
+    TEST_ASSERT_EQUAL_INT(RADIO_DROP_BAD_HEX, received.last_drop);
+    TEST_ASSERT_EQUAL_STRING("cap:10;", received.commands);
+    TEST_ASSERT_EQUAL_INT(2, received.rtk_count);
+
+    // "rtk" is only a key at the start of a frame
+    received = Received();
+    feed(parser, "artk:12|", &received);
+    TEST_ASSERT_EQUAL_STRING("artk:12;", received.commands);
+    TEST_ASSERT_EQUAL_INT(0, received.rtk_count);
+}
+
+// ------------------------
+// Test: Command Too Long
+// ------------------------
+void test_too_long(void) {
+    RadioFrameParser parser;
+    Received received = {};
+
+    char line[RADIO_COMMAND_SIZE + 8];
+    memset(line, 'a', sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\0';
+    feed(parser, line, &received);
+    feed(parser, "|ki:1|", &received);
+    TEST_ASSERT_EQUAL_INT(1, received.dropped);
+    TEST_ASSERT_EQUAL_INT(RADIO_DROP_TOO_LONG, received.last_drop);
+    TEST_ASSERT_EQUAL_STRING("ki:1;", received.commands);
+
+    // The longest accepted command
+    received = Received();
+    line[RADIO_COMMAND_SIZE - 1] = '\0';
+    feed(parser, line, &received);
+    feed(parser, "|", &received);
+    TEST_ASSERT_EQUAL_INT(0, received.dropped);
+    TEST_ASSERT_EQUAL_INT(RADIO_COMMAND_SIZE, (int)strlen(received.commands));
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_commands);
+    RUN_TEST(test_partial_frame);
+    RUN_TEST(test_rtk_stream);
+    RUN_TEST(test_too_long);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,188 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include <string.h>
+#include "rtcmParser.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// Builds a frame of the given type with a payload of length bytes
+static uint32_t make_frame(uint16_t type, uint16_t length, uint8_t* frame) {
+    frame[0] = 0xD3;
+    frame[1] = (uint8_t)(length >> 8);
+    frame[2] = (uint8_t)length;
+    frame[3] = (uint8_t)(type >> 4);
+    frame[4] = (uint8_t)((type & 0x0F) << 4);
+    for (uint16_t i = 2; i < length; i++) {
+        frame[3 + i] = (uint8_t)(i * 7);
+    }
+    uint32_t crc = rtcm_crc24q(frame, 3 + length);
+    frame[3 + length] = (uint8_t)(crc >> 16);
+    frame[4 + length] = (uint8_t)(crc >> 8);
+    frame[5 + length] = (uint8_t)crc;
+    return 6 + length;
+}
+
+// Stands for UartDmaTx: staged bytes, and the committed output
+struct Sink {
+    uint8_t out[4096];
+    uint32_t committed;
+    uint32_t staged;
+    int dropped;
+    RtcmDrop last_drop;
+};
+
+static void feed(RtcmParser& parser, const uint8_t* data, uint32_t length, Sink* sink) {
+    for (uint32_t i = 0; i < length; i++) {
+        switch (parser.feed(data[i])) {
+        case RTCM_STAGE:
+            sink->out[sink->staged++] = data[i];
+            break;
+        case RTCM_FRAME:
+            sink->out[sink->staged++] = data[i];
+            sink->committed = sink->staged;
+            break;
+        case RTCM_DROPPED:
+            sink->staged = sink->committed;
+            sink->dropped++;
+            sink->last_drop = parser.drop_reason();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+// ------------------------
+// Test: CRC-24Q
+// ------------------------
+void test_crc() {
+    TEST_ASSERT_EQUAL_HEX32(0xCDE703, rtcm_crc24q((const uint8_t*)"123456789", 9));
+    // Continues from a previous value
+    uint32_t crc = rtcm_crc24q((const uint8_t*)"1234", 4);
+    TEST_ASSERT_EQUAL_HEX32(0xCDE703, rtcm_crc24q((const uint8_t*)"56789", 5, crc));
+}
+
+// ------------------------
+// Test: Valid frames pass whole, garbage between them is skipped
+// ------------------------
+void test_valid_frames() {
+    RtcmParser parser;
+    Sink sink = {};
+    uint8_t stream[2048];
+    uint32_t length = 0;
+    stream[length++] = 0x55;
+    stream[length++] = 0x00;
+    uint32_t first = make_frame(1077, 120, stream + length);
+    length += first;
+    stream[length++] = '\n';
+    uint32_t second = make_frame(1005, 19, stream + length);
+    length += second;
+
+    // Cut inside the first frame
+    feed(parser, stream, 50, &sink);
+    TEST_ASSERT_EQUAL(0, sink.committed);
+    feed(parser, stream + 50, length - 50, &sink);
+
+    TEST_ASSERT_EQUAL(first + second, sink.committed);
+    TEST_ASSERT_EQUAL_MEMORY(stream + 2, sink.out, first);
+    TEST_ASSERT_EQUAL_MEMORY(stream + 3 + first, sink.out + first, second);
+    TEST_ASSERT_EQUAL(0, sink.dropped);
+    TEST_ASSERT_EQUAL(2, parser.stats().frames);
+    TEST_ASSERT_EQUAL(first + second, parser.stats().bytes);
+    TEST_ASSERT_EQUAL(3, parser.stats().skipped_bytes);
+    TEST_ASSERT_EQUAL(1005, parser.message_type());
+
+    // Longest frame
+    uint8_t big[RTCM_MAX_FRAME];
+    TEST_ASSERT_EQUAL(RTCM_MAX_FRAME, make_frame(1127, RTCM_MAX_PAYLOAD, big));
+    feed(parser, big, RTCM_MAX_FRAME, &sink);
+    TEST_ASSERT_EQUAL(3, parser.stats().frames);
+}
+
+// ------------------------
+// Test: Bad CRC, unused type and bad header are dropped
+// ------------------------
+void test_dropped_frames() {
+    RtcmParser parser;
+    Sink sink = {};
+    uint8_t frame[256];
+
+    uint32_t length = make_frame(1074, 40, frame);
+    frame[20] ^= 0x01;
+    feed(parser, frame, length, &sink);
+    TEST_ASSERT_EQUAL(1, sink.dropped);
+    TEST_ASSERT_EQUAL(RTCM_DROP_BAD_CRC, sink.last_drop);
+
+    // Ephemeris: not used by the receiver, dropped as soon as the type is known
+    length = make_frame(1019, 60, frame);
+    TEST_ASSERT_EQUAL(RTCM_STAGE, parser.feed(frame[0]));
+    for (int i = 1; i < 4; i++) {
+        TEST_ASSERT_EQUAL(RTCM_STAGE, parser.feed(frame[i]));
+    }
+    TEST_ASSERT_EQUAL(RTCM_DROPPED, parser.feed(frame[4]));
+    TEST_ASSERT_EQUAL(RTCM_DROP_FILTERED, parser.drop_reason());
+    for (uint32_t i = 5; i < length; i++) {
+        TEST_ASSERT_EQUAL(RTCM_NONE, parser.feed(frame[i]));
+    }
+
+    uint8_t bad_header[] = { 0xD3, 0x40 };
+    feed(parser, bad_header, sizeof(bad_header), &sink);
+    TEST_ASSERT_EQUAL(RTCM_DROP_BAD_HEADER, sink.last_drop);
+
+    // Still in sync
+    length = make_frame(1087, 30, frame);
+    feed(parser, frame, length, &sink);
+    TEST_ASSERT_EQUAL(length, sink.committed);
+    TEST_ASSERT_EQUAL(1, parser.stats().frames);
+    TEST_ASSERT_EQUAL(1, parser.stats().bad_crc);
+    TEST_ASSERT_EQUAL(1, parser.stats().filtered);
+}
+
+// ------------------------
+// Test: Frame dropped by the caller
+// ------------------------
+void test_drop_frame() {
+    RtcmParser parser;
+    Sink sink = {};
+    uint8_t frame[256];
+    uint32_t length = make_frame(1097, 80, frame);
+
+    feed(parser, frame, 30, &sink);
+    parser.drop_frame();
+    sink.staged = sink.committed;
+    feed(parser, frame + 30, length - 30, &sink);
+    TEST_ASSERT_EQUAL(0, sink.committed);
+    TEST_ASSERT_EQUAL(RTCM_DROP_OVERFLOW, parser.drop_reason());
+
+    // Right after its last byte
+    feed(parser, frame, length, &sink);
+    TEST_ASSERT_EQUAL(1, parser.stats().frames);
+    parser.drop_frame();
+    TEST_ASSERT_EQUAL(0, parser.stats().frames);
+    TEST_ASSERT_EQUAL(0, parser.stats().bytes);
+    TEST_ASSERT_EQUAL(2, parser.stats().overflows);
+
+    feed(parser, frame, length, &sink);
+    TEST_ASSERT_EQUAL(1, parser.stats().frames);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_crc);
+    RUN_TEST(test_valid_frames);
+    RUN_TEST(test_dropped_frames);
+    RUN_TEST(test_drop_frame);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,173 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "sailboatSim.h"
+#include "regattaRunner.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Speed Model of simulator.py
+// ------------------------
+void test_boat_speed_model(void) {
+    // Beam reach, sail fully out, 5 m/s: 4 * 0.8 * 1.0 * 1.0 * 0.9
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 2.88, SailboatPhysics::boat_speed(5.0, 90.0, 1.0));
+    // Sign of the wind angle does not matter
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, SailboatPhysics::boat_speed(5.0, 60.0, 0.4),
+                             SailboatPhysics::boat_speed(5.0, -60.0, 0.4));
+    // Head to wind is slow, wind speed capped at 15 m/s
+    TEST_ASSERT_TRUE(SailboatPhysics::boat_speed(5.0, 20.0, 0.1) < 0.5);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, SailboatPhysics::boat_speed(15.0, 120.0, 0.7),
+                             SailboatPhysics::boat_speed(25.0, 120.0, 0.7));
+}
+
+// ------------------------
+// Test: Apparent Wind and Actuator Rates
+// ------------------------
+void test_apparent_wind_and_rates(void) {
+    ApparentWind wind = SailboatPhysics::calculate_apparent_wind(5.0, 90.0, 2.0, 0.0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 5.385, wind.speed);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 111.8, wind.heading);
+
+    // Rudder moves at RUDDER_SPEED per second and stops on the target
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.2, SailboatPhysics::apply_linear_change(0.01, 0.0, 1.0, 20.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1.0, SailboatPhysics::apply_linear_change(0.1, 0.9, 1.0, 20.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, SailboatPhysics::calculate_heading_change(0.1, 0.0, 0.0));
+}
+
+// ------------------------
+// Test: Current Carries a Boat at Rest
+// ------------------------
+void test_current_drift(void) {
+    SailboatEnvironment env;
+    env.wind_speed = 0.0;
+    env.water_speed = 0.25;
+    env.water_heading = 90.0;
+    Sailboat boat(47.2537, -1.3702, 0.0);
+    for (int k = 0; k < 100; k++) {
+        boat.update(0.1, env);
+    }
+    // 10 s at 0.5 * 0.25 m/s towards east
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1.25, boat.x);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 0.0, boat.y);
+    TEST_ASSERT_TRUE(boat.longitude > -1.3702);
+}
+
+// ------------------------
+// Test: Broad Reach Scenario Arrives Without Tacking
+// ------------------------
+void test_reaching_scenario(void) {
+    RegattaSettings settings;
+    settings.wind_angle_min_deg = 130.0;
+    settings.wind_angle_max_deg = 160.0;
+    settings.wind_speed_min = 4.0;
+    settings.wind_speed_max = 6.0;
+    settings.course_length_m = 200.0;
+    RegattaRunner runner(settings);
+
+    ScenarioResult result = runner.run_scenario(0);
+    TEST_ASSERT_TRUE(result.arrived);
+    TEST_ASSERT_EQUAL(0, result.tacks);
+    TEST_ASSERT_TRUE(result.distance_m > 170.0f && result.distance_m < 260.0f);
+    TEST_ASSERT_TRUE(result.time_s < 200.0f);
+
+    // Same seed and index, same outcome
+    ScenarioResult again = runner.run_scenario(0);
+    TEST_ASSERT_EQUAL_FLOAT(result.time_s, again.time_s);
+    TEST_ASSERT_EQUAL_FLOAT(result.distance_m, again.distance_m);
+}
+
+// ------------------------
+// Test: Distribution Statistics
+// ------------------------
+void test_summary_statistics(void) {
+    ScenarioResult results[11];
+    for (int k = 0; k < 11; k++) {
+        results[k].arrived = k != 5;
+        results[k].time_s = 100.0f + 10.0f * ((k * 7) % 11);    // 100..200, shuffled
+        results[k].distance_m = 300.0f;
+        results[k].tacks = k;
+    }
+    RegattaSummary summary = RegattaRunner::summarize(results, 11);
+    TEST_ASSERT_EQUAL(11, summary.scenarios);
+    TEST_ASSERT_EQUAL(10, summary.arrived);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, summary.tacks.min);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 5.0, summary.tacks.p50);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 10.0, summary.tacks.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 300.0, summary.distance_m.mean);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, summary.distance_m.stddev);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 100.0, summary.time_s.min);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 200.0, summary.time_s.max);
+}
+
+// ------------------------
+// Test: Regatta with 10 Hz Fixes Waking the Planner
+// ------------------------
+void test_regatta_at_fix_rate(void) {
+    RegattaSettings settings;
+    settings.course_length_m = 100.0;
+    settings.time_limit_s = 300.0;
+    settings.wind_angle_max_deg = 30.0;     // Upwind, the planner has to tack
+    settings.planner_period_s = 0.5;
+    RegattaRunner periodic(settings);
+    settings.fix_period_s = 0.1;
+    RegattaRunner paced(settings);
+
+    // Paced to its period, the planner decides on the same samples as the periodic task
+    int tacks = 0;
+    for (int k = 0; k < 6; k++) {
+        ScenarioResult expected = periodic.run_scenario(k);
+        ScenarioResult result = paced.run_scenario(k);
+        TEST_ASSERT_EQUAL(expected.arrived, result.arrived);
+        TEST_ASSERT_EQUAL_FLOAT(expected.time_s, result.time_s);
+        TEST_ASSERT_EQUAL(expected.tacks, result.tacks);
+        tacks += result.tacks;
+    }
+    TEST_ASSERT_TRUE(tacks > 0);
+}
+
+#ifndef ARDUINO
+// ------------------------
+// Test: Thread Pool Gives the Sequential Results (host only)
+// ------------------------
+void test_threads_match_sequential(void) {
+    RegattaSettings settings;
+    settings.course_length_m = 100.0;
+    settings.time_limit_s = 300.0;
+    RegattaRunner runner(settings);
+
+    ScenarioResult sequential[12], threaded[12];
+    runner.run(sequential, 12, 1);
+    runner.run(threaded, 12, 4);
+    for (int k = 0; k < 12; k++) {
+        TEST_ASSERT_EQUAL(sequential[k].arrived, threaded[k].arrived);
+        TEST_ASSERT_EQUAL_FLOAT(sequential[k].time_s, threaded[k].time_s);
+        TEST_ASSERT_EQUAL(sequential[k].tacks, threaded[k].tacks);
+    }
+}
+#endif
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_boat_speed_model);
+    RUN_TEST(test_apparent_wind_and_rates);
+    RUN_TEST(test_current_drift);
+    RUN_TEST(test_reaching_scenario);
+    RUN_TEST(test_summary_statistics);
+    RUN_TEST(test_regatta_at_fix_rate);
+#ifndef ARDUINO
+    RUN_TEST(test_threads_match_sequential);
+#endif
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,131 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "shared_data.h"
+
+#ifndef ARDUINO
+#include <atomic>
+#include <thread>
+#endif
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Versions, Timestamps and Default Value
+// ------------------------
+void test_snapshot_versions(void) {
+    static SharedSnapshot<GnssData> snapshot;
+    GnssData fix;
+    uint32_t stamp = 123;
+    TEST_ASSERT_EQUAL_UINT32(0, snapshot.read(&fix, &stamp));
+    TEST_ASSERT_EQUAL_UINT32(0, stamp);
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 0.0, fix.latitude);
+
+    for (uint32_t k = 1; k <= 5; k++) {
+        GnssData next = {47.0 + k, -1.0 - k, 10.0 * k};
+        snapshot.write(next, 1000 * k);
+        TEST_ASSERT_EQUAL_UINT32(k, snapshot.version());
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, snapshot.read(&fix, &stamp));
+    TEST_ASSERT_EQUAL_UINT32(5000, stamp);
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 52.0, fix.latitude);
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, -6.0, fix.longitude);
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 50.0, fix.altitude);
+}
+
+// ------------------------
+// Test: Manual Heading Holds Until the Planner Publishes Again
+// ------------------------
+void test_target_angle_last_writer(void) {
+    static SharedData shared;
+    TEST_ASSERT_EQUAL_INT(0, shared.target_angle());
+
+    NavigationData navigation = {47.25, -1.37, 45};
+    shared.navigation.write(navigation, 1000);
+    TEST_ASSERT_EQUAL_INT(45, shared.target_angle());
+
+    // Tension alone does not override the planner
+    CommandData command = {};
+    command.targetTension = 60;
+    shared.command.write(command, 1500);
+    TEST_ASSERT_EQUAL_INT(45, shared.target_angle());
+
+    command.targetAngle = 270;
+    command.targetAngle_ms = 2000;
+    shared.command.write(command, 2000);
+    TEST_ASSERT_EQUAL_INT(270, shared.target_angle());
+
+    navigation.targetAngle = 50;
+    shared.navigation.write(navigation, 2500);
+    TEST_ASSERT_EQUAL_INT(50, shared.target_angle());
+
+    // Heading popped from headingQueue by the control loop: same rule, on its publication time
+    TEST_ASSERT_EQUAL_INT(270, shared.target_angle(40, 1800));
+    TEST_ASSERT_EQUAL_INT(40, shared.target_angle(40, 2200));
+
+    TelemetryData telemetry = shared.telemetry();
+    TEST_ASSERT_EQUAL_INT(50, telemetry.targetAngle);
+    TEST_ASSERT_EQUAL_INT(60, telemetry.targetTension);
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 47.25, telemetry.waypoint_lat);
+}
+
+#ifndef ARDUINO
+// ------------------------
+// Test: Readers Never See a Torn Write (host only)
+// ------------------------
+void test_no_torn_reads(void) {
+    static SharedSnapshot<GnssData> snapshot;
+    std::atomic<bool> done(false);
+    std::thread writer([&done]() {
+        // Every write keeps longitude = -latitude and altitude = 2 * latitude
+        for (uint32_t k = 1; k <= 200000; k++) {
+            double value = k * 1e-3 + 0.123456789;
+            GnssData fix = {value, -value, 2.0 * value};
+            snapshot.write(fix, k);
+        }
+        done = true;
+    });
+
+    long torn = 0, reads = 0;
+    uint32_t last_version = 0;
+    bool writer_done;
+    do {
+        // Sampled before the read, so the final value is read at least once
+        writer_done = done;
+        GnssData fix;
+        uint32_t stamp;
+        uint32_t version = snapshot.read(&fix, &stamp);
+        if (version == 0) {
+            continue;
+        }
+        reads++;
+        torn += fix.longitude != -fix.latitude || fix.altitude != 2.0 * fix.latitude || stamp != version;
+        torn += version < last_version;
+        last_version = version;
+    } while (!writer_done);
+    writer.join();
+    TEST_ASSERT_EQUAL(0, torn);
+    TEST_ASSERT_TRUE(reads > 0);
+}
+#endif
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_snapshot_versions);
+    RUN_TEST(test_target_angle_last_writer);
+#ifndef ARDUINO
+    RUN_TEST(test_no_torn_reads);
+#endif
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,70 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include <stdlib.h>
+#include "staticAlloc.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static size_t trapped_size = 0;
+static int traps = 0;
+
+static void record_trap(size_t size, void* caller) {
+    (void)caller;
+    trapped_size = size;
+    traps++;
+}
+
+// ------------------------
+// Test: Heap Lock
+// ------------------------
+void test_heap_lock(void) {
+    TEST_ASSERT_FALSE(heap_locked());
+    TEST_ASSERT_EQUAL_UINT32(0, heap_trap_count());
+
+    // Allocations made during the initialization are kept
+    void* init_buffer = malloc(512);
+    TEST_ASSERT_TRUE(init_buffer != NULL);
+    heap_lock();
+    TEST_ASSERT_TRUE(heap_locked());
+    TEST_ASSERT_TRUE(heap_used_at_lock() >= 512);
+    TEST_ASSERT_EQUAL_UINT32(heap_used_at_lock(), heap_used());
+}
+
+// ------------------------
+// Test: Allocation After Init
+// ------------------------
+void test_heap_trap(void) {
+    set_heap_trap_handler(record_trap);
+    heap_trap(24, nullptr);
+    TEST_ASSERT_EQUAL_INT(1, traps);
+    TEST_ASSERT_EQUAL_UINT32(24, (uint32_t)trapped_size);
+    TEST_ASSERT_EQUAL_UINT32(1, heap_trap_count());
+
+#ifdef STATIC_ALLOCATION
+    // operator new goes through the trap once the heap is locked
+    int* late = new int[10];
+    TEST_ASSERT_EQUAL_INT(2, traps);
+    TEST_ASSERT_EQUAL_UINT32(10 * sizeof(int), (uint32_t)trapped_size);
+    delete[] late;
+#endif
+    set_heap_trap_handler(nullptr);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_heap_lock);
+    RUN_TEST(test_heap_trap);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,122 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include <string.h>
+#include "taskMonitor.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Histogram Buckets
+// ------------------------
+void test_hist_bucket(void) {
+    TEST_ASSERT_EQUAL_INT(0, task_hist_bucket(0));
+    TEST_ASSERT_EQUAL_INT(0, task_hist_bucket(63));
+    TEST_ASSERT_EQUAL_INT(1, task_hist_bucket(64));
+    TEST_ASSERT_EQUAL_INT(1, task_hist_bucket(127));
+    TEST_ASSERT_EQUAL_INT(2, task_hist_bucket(128));
+    TEST_ASSERT_EQUAL_INT(9, task_hist_bucket(20000));         // 50 Hz period
+    TEST_ASSERT_EQUAL_INT(14, task_hist_bucket(1000000));      // 1 s
+    TEST_ASSERT_EQUAL_INT(15, task_hist_bucket(1u << 20));
+    TEST_ASSERT_EQUAL_INT(15, task_hist_bucket(0xFFFFFFFFu));
+}
+
+// ------------------------
+// Test: Loop Counts, Durations, Deadlines and Windows
+// ------------------------
+void test_sample_windows(void) {
+    static TaskMonitor monitor;
+    static TaskUsage usage[MONITORED_TASK_COUNT];
+    LoopProbe& probe = monitor.attach(TASK_CONTROL);
+    monitor.set_deadline(TASK_CONTROL, 2000);
+    monitor.sample(0, usage);
+
+    // Five loops every 20 ms, each busy for 100 us, the last one for 3000 us
+    uint32_t now = 1000;
+    for (int k = 0; k < 5; k++) {
+        probe.begin(now);
+        probe.end(now + (k == 4 ? 3000 : 100));
+        now += 20000;
+    }
+    monitor.sample(100000, usage);
+
+    const TaskUsage& control = usage[TASK_CONTROL];
+    TEST_ASSERT_EQUAL_UINT8(TASK_CONTROL, control.task);
+    TEST_ASSERT_EQUAL_UINT32(5, control.loops);
+    TEST_ASSERT_EQUAL_UINT32(3000, control.exec_max_us);
+    TEST_ASSERT_EQUAL_UINT32(20000, control.period_min_us);
+    TEST_ASSERT_EQUAL_UINT32(20000, control.period_max_us);
+    TEST_ASSERT_EQUAL_UINT32(1, control.deadline_misses);
+    TEST_ASSERT_EQUAL_UINT16(4, control.exec_hist[task_hist_bucket(100)]);
+    TEST_ASSERT_EQUAL_UINT16(1, control.exec_hist[task_hist_bucket(3000)]);
+    TEST_ASSERT_EQUAL_UINT16(4, control.period_hist[task_hist_bucket(20000)]);
+    // 3400 us busy out of 100000 us (no FreeRTOS run-time counters on the host)
+    TEST_ASSERT_EQUAL_UINT16(34, control.cpu_permille);
+    TEST_ASSERT_EQUAL_UINT32(0, usage[TASK_PATH].loops);
+    TEST_ASSERT_EQUAL_UINT32(0, usage[TASK_PATH].period_min_us);
+
+    // Next window: only its own loops, min/max restarted
+    probe.begin(now + 5000);
+    probe.end(now + 5050);
+    monitor.sample(200000, usage);
+    TEST_ASSERT_EQUAL_UINT32(1, control.loops);
+    TEST_ASSERT_EQUAL_UINT32(50, control.exec_max_us);
+    TEST_ASSERT_EQUAL_UINT32(25000, control.period_min_us);
+    TEST_ASSERT_EQUAL_UINT32(25000, control.period_max_us);
+    TEST_ASSERT_EQUAL_UINT32(0, control.deadline_misses);
+    TEST_ASSERT_EQUAL_UINT16(0, control.exec_hist[task_hist_bucket(3000)]);
+    TEST_ASSERT_EQUAL_UINT16(1, control.exec_hist[task_hist_bucket(50)]);
+}
+
+// ------------------------
+// Test: Telemetry Line
+// ------------------------
+void test_format_usage(void) {
+    TaskUsage usage;
+    memset(&usage, 0, sizeof(usage));
+    usage.task = TASK_PATH;
+    usage.cpu_permille = 125;
+    usage.stack_free_words = 310;
+    usage.loops = 12;
+    usage.exec_max_us = 4200;
+    usage.period_min_us = 180000;
+    usage.period_max_us = 510000;
+    usage.exec_hist[task_hist_bucket(1000)] = 10;
+    usage.exec_hist[task_hist_bucket(4200)] = 2;
+    usage.period_hist[task_hist_bucket(500000)] = 11;
+    usage.deadline_misses = 3;
+
+    char line[200];
+    int length = format_task_usage(usage, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("task_path:125,310,12,4200,180000,510000,4/10/0/0/2,13/11,3", line);
+    TEST_ASSERT_EQUAL_INT((int)strlen(line), length);
+
+    // Empty histograms, and a buffer too short is cut but terminated
+    memset(&usage, 0, sizeof(usage));
+    usage.task = TASK_BLINK;
+    format_task_usage(usage, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("task_blink:0,0,0,0,0,0,-,-,0", line);
+    char small[12];
+    length = format_task_usage(usage, small, sizeof(small));
+    TEST_ASSERT_EQUAL_STRING("task_blink:", small);
+    TEST_ASSERT_EQUAL_INT((int)strlen(line), length);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_hist_bucket);
+    RUN_TEST(test_sample_windows);
+    RUN_TEST(test_format_usage);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
@@ -0,0 +1,116 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include <stdio.h>
+#include "taskTable.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static void task_stub(void*) {
+}
+
+// Same periods as main.cpp
+static void default_table(TaskConfig* table) {
+    static const uint32_t periods[MONITORED_TASK_COUNT] = {1000, 20, 500, 500, 25, 100, 20, 5000, 20, 20};
+    for (int t = 0; t < MONITORED_TASK_COUNT; t++) {
+        table[t] = TaskConfig();
+        table[t].entry = task_stub;
+        table[t].period_ms = periods[t];
+        table[t].stack_words = 1024;
+        table[t].background = t == TASK_TRACE;
+    }
+}
+
+// ------------------------
+// Test: Rate-Monotonic Priorities
+// ------------------------
+void test_rate_monotonic(void) {
+    TaskConfig table[MONITORED_TASK_COUNT];
+    default_table(table);
+
+    TEST_ASSERT_EQUAL_INT(6, assign_rate_monotonic_priorities(table, 1, 6));
+    TEST_ASSERT_EQUAL_UINT8(6, table[TASK_CONTROL].priority);
+    TEST_ASSERT_EQUAL_UINT8(6, table[TASK_I2C0].priority);     // Bus owners, as short as the control loop
+    TEST_ASSERT_EQUAL_UINT8(5, table[TASK_GPS].priority);
+    TEST_ASSERT_EQUAL_UINT8(4, table[TASK_XBEE].priority);
+    TEST_ASSERT_EQUAL_UINT8(3, table[TASK_PATH].priority);
+    TEST_ASSERT_EQUAL_UINT8(3, table[TASK_SENSOR].priority);    // Same period, same priority
+    TEST_ASSERT_EQUAL_UINT8(2, table[TASK_BLINK].priority);
+    TEST_ASSERT_EQUAL_UINT8(1, table[TASK_MONITOR].priority);
+    TEST_ASSERT_EQUAL_UINT8(0, table[TASK_TRACE].priority);     // Background, despite its 20 ms
+
+    // Fewer levels than periods: the longest periods share the lowest priority
+    assign_rate_monotonic_priorities(table, 2, 4);
+    TEST_ASSERT_EQUAL_UINT8(4, table[TASK_CONTROL].priority);
+    TEST_ASSERT_EQUAL_UINT8(2, table[TASK_XBEE].priority);
+    TEST_ASSERT_EQUAL_UINT8(2, table[TASK_MONITOR].priority);
+}
+
+// ------------------------
+// Test: Rate Lines
+// ------------------------
+void test_apply_rate(void) {
+    TaskConfig table[MONITORED_TASK_COUNT];
+    default_table(table);
+
+    TEST_ASSERT_TRUE(apply_task_rate(table, "control,10"));
+    TEST_ASSERT_EQUAL_UINT32(10, table[TASK_CONTROL].period_ms);
+    TEST_ASSERT_EQUAL_UINT32(10000, task_deadline_us(table[TASK_CONTROL]));
+    TEST_ASSERT_TRUE(apply_task_rate(table, "path,250,100\r\n"));
+    TEST_ASSERT_EQUAL_UINT32(250, table[TASK_PATH].period_ms);
+    TEST_ASSERT_EQUAL_UINT32(100000, task_deadline_us(table[TASK_PATH]));
+
+    // Unknown task, bad numbers, deadline after the period: unchanged
+    TEST_ASSERT_FALSE(apply_task_rate(table, "rudder,10"));
+    TEST_ASSERT_FALSE(apply_task_rate(table, "control"));
+    TEST_ASSERT_FALSE(apply_task_rate(table, "control,fast"));
+    TEST_ASSERT_FALSE(apply_task_rate(table, "control,0"));
+    TEST_ASSERT_FALSE(apply_task_rate(table, "gps,25,40"));
+    TEST_ASSERT_EQUAL_UINT32(10, table[TASK_CONTROL].period_ms);
+    TEST_ASSERT_EQUAL_UINT32(25, table[TASK_GPS].period_ms);
+    TEST_ASSERT_EQUAL_UINT32(0, table[TASK_GPS].deadline_ms);
+}
+
+#ifndef ARDUINO
+// ------------------------
+// Test: Persisted Rates File
+// ------------------------
+void test_load_rates(void) {
+    TaskConfig table[MONITORED_TASK_COUNT];
+    default_table(table);
+    TEST_ASSERT_EQUAL_INT(0, load_task_rates(table, "/nonexistent/tasks.cfg"));
+
+    const char* path = "test_tasks.cfg";
+    FILE* file = fopen(path, "w");
+    TEST_ASSERT_TRUE(file != NULL);
+    fputs("# task,period ms[,deadline ms]\ncontrol,25\n\nxbee,200,150\nbogus,1\n", file);
+    fclose(file);
+
+    TEST_ASSERT_EQUAL_INT(2, load_task_rates(table, path));
+    remove(path);
+    TEST_ASSERT_EQUAL_UINT32(25, table[TASK_CONTROL].period_ms);
+    TEST_ASSERT_EQUAL_UINT32(200, table[TASK_XBEE].period_ms);
+    TEST_ASSERT_EQUAL_UINT32(150, table[TASK_XBEE].deadline_ms);
+}
+#endif
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rate_monotonic);
+    RUN_TEST(test_apply_rate);
+#ifndef ARDUINO
+    RUN_TEST(test_load_rates);
+#endif
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
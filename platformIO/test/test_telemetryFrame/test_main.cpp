@@ -0,0 +1,161 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "telemetryFrame.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static TelemetryData sample() {
+    TelemetryData data;
+    memset(&data, 0, sizeof(data));
+    data.latitude = 47.2544141;
+    data.longitude = -1.3691732;
+    data.compass = 123.45;
+    data.wind_vane = 359.999;
+    data.horizontal_tilt = -4.5;
+    data.vertical_tilt = 2.25;
+    data.targetAngle = 90;
+    data.targetTension = 1500;
+    data.angleFromNorth = -30;
+    return data;
+}
+
+// Checks the frame (delimiter, COBS, CRC, header), returns the payload length
+static size_t decode(const uint8_t* frame, size_t length, uint8_t type, uint8_t* payload) {
+    TEST_ASSERT_EQUAL_UINT8(0x00, frame[length - 1]);
+    for (size_t i = 0; i + 1 < length; i++) {
+        TEST_ASSERT_NOT_EQUAL(0x00, frame[i]);
+    }
+    uint8_t raw[TELEMETRY_FRAME_SIZE];
+    size_t raw_length = cobs_decode(frame, length - 1, raw);
+    TEST_ASSERT_TRUE(raw_length >= 5);
+    uint16_t crc = raw[raw_length - 2] | (raw[raw_length - 1] << 8);
+    TEST_ASSERT_EQUAL_HEX16(telemetry_crc16(raw, raw_length - 2), crc);
+    TEST_ASSERT_EQUAL_UINT8(TELEMETRY_VERSION, raw[0]);
+    TEST_ASSERT_EQUAL_UINT8(type, raw[1]);
+    memcpy(payload, raw + 3, raw_length - 5);
+    return raw_length - 5;
+}
+
+// ------------------------
+// Test: CRC and COBS
+// ------------------------
+void test_crc_cobs() {
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, telemetry_crc16((const uint8_t*)"123456789", 9));
+
+    uint8_t data[300], encoded[310], decoded[310];
+    for (int i = 0; i < 300; i++) {
+        data[i] = (i % 7 == 0) ? 0 : (uint8_t)i;
+    }
+    // Zeros, and a run longer than 254 non-zero bytes
+    memset(data + 20, 0x55, 270);
+    size_t length = cobs_encode(data, sizeof(data), encoded);
+    TEST_ASSERT_TRUE(length <= sizeof(data) + sizeof(data) / 254 + 1);
+    for (size_t i = 0; i < length; i++) {
+        TEST_ASSERT_NOT_EQUAL(0x00, encoded[i]);
+    }
+    TEST_ASSERT_EQUAL(sizeof(data), cobs_decode(encoded, length, decoded));
+    TEST_ASSERT_EQUAL_MEMORY(data, decoded, sizeof(data));
+
+    encoded[0] = 0;
+    TEST_ASSERT_EQUAL(0, cobs_decode(encoded, length, decoded));
+}
+
+#define ALL_FIELDS ((uint16_t)((1u << TELEMETRY_FIELD_COUNT) - 1))
+
+// ------------------------
+// Test: Frame with every field
+// ------------------------
+void test_all_fields() {
+    TelemetryEncoder encoder;
+    int32_t values[TELEMETRY_FIELD_COUNT];
+    telemetry_quantize_all(sample(), values);
+    uint8_t frame[TELEMETRY_FRAME_SIZE], payload[TELEMETRY_FRAME_SIZE];
+    size_t length = encoder.encode_state(values, ALL_FIELDS, frame);
+    TEST_ASSERT_TRUE(length <= telemetry_state_size(ALL_FIELDS));
+    size_t payload_length = decode(frame, length, TELEMETRY_STATE, payload);
+
+    TEST_ASSERT_EQUAL_HEX16(ALL_FIELDS, payload[0] | (payload[1] << 8));
+    TEST_ASSERT_EQUAL(2 + 4 + 4 + 7 * 2, payload_length);
+    int32_t lat = (int32_t)(payload[2] | (payload[3] << 8) | (payload[4] << 16) | ((uint32_t)payload[5] << 24));
+    TEST_ASSERT_EQUAL_INT32(472544141, lat);
+    // 359.999 rounds to 360, sent as 0
+    TEST_ASSERT_EQUAL_UINT16(0, payload[12] | (payload[13] << 8));
+    TEST_ASSERT_EQUAL_INT16(-450, (int16_t)(payload[14] | (payload[15] << 8)));
+    TEST_ASSERT_EQUAL_INT16(-30, (int16_t)(payload[22] | (payload[23] << 8)));
+}
+
+// ------------------------
+// Test: Only the fields of the mask, numbered frames
+// ------------------------
+void test_mask() {
+    TelemetryEncoder encoder;
+    TelemetryData data = sample();
+    data.compass = 200.0;
+    data.targetTension = 1600;
+    int32_t values[TELEMETRY_FIELD_COUNT];
+    telemetry_quantize_all(data, values);
+    uint8_t frame[TELEMETRY_FRAME_SIZE], payload[TELEMETRY_FRAME_SIZE], raw[TELEMETRY_FRAME_SIZE];
+    encoder.encode_state(values, ALL_FIELDS, frame);
+
+    uint16_t mask = (1u << TLM_COMPASS) | (1u << TLM_TARGET_TENSION);
+    size_t length = encoder.encode_state(values, mask, frame);
+    size_t payload_length = decode(frame, length, TELEMETRY_STATE, payload);
+    TEST_ASSERT_EQUAL_HEX16(mask, payload[0] | (payload[1] << 8));
+    TEST_ASSERT_EQUAL(2 + 2 + 2, payload_length);
+    TEST_ASSERT_EQUAL_UINT16(20000, payload[2] | (payload[3] << 8));
+    TEST_ASSERT_EQUAL_INT16(1600, (int16_t)(payload[4] | (payload[5] << 8)));
+
+    cobs_decode(frame, length - 1, raw);
+    TEST_ASSERT_EQUAL_UINT8(1, raw[2]);
+}
+
+// ------------------------
+// Test: Text frame, and size against the former ASCII lines
+// ------------------------
+void test_text_and_size() {
+    TelemetryEncoder encoder;
+    uint8_t frame[TELEMETRY_FRAME_SIZE], payload[TELEMETRY_FRAME_SIZE];
+    const char* line = "task_control:12.5,320,1000,5,0";
+    size_t length = encoder.encode_text(line, frame);
+    size_t payload_length = decode(frame, length, TELEMETRY_TEXT, payload);
+    TEST_ASSERT_EQUAL(strlen(line), payload_length);
+    TEST_ASSERT_EQUAL_MEMORY(line, payload, payload_length);
+
+    TelemetryData data = sample();
+    char ascii[512];
+    int ascii_length = snprintf(ascii, sizeof(ascii),
+        "latitude:%.6f\r\nlongitude:%.6f\r\ncompass:%.2f\r\nwind_vane:%.2f\r\nhorizontal_tilt:%.2f\r\n"
+        "vertical_tilt:%.2f\r\ntarget_angle:%d\r\ntarget_tension:%d\r\nangle_from_north:%d\r\n",
+        data.latitude, data.longitude, data.compass, data.wind_vane, data.horizontal_tilt,
+        data.vertical_tilt, data.targetAngle, data.targetTension, data.angleFromNorth);
+    int32_t values[TELEMETRY_FIELD_COUNT];
+    telemetry_quantize_all(data, values);
+    length = encoder.encode_state(values, ALL_FIELDS, frame);
+    TEST_ASSERT_TRUE(length * 4 <= (size_t)ascii_length);
+
+    // Typical tick: heading and tilt
+    TEST_ASSERT_TRUE(encoder.encode_state(values, (1u << TLM_COMPASS) | (1u << TLM_HORIZONTAL_TILT), frame) <= 13);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_crc_cobs);
+    RUN_TEST(test_all_fields);
+    RUN_TEST(test_mask);
+    RUN_TEST(test_text_and_size);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
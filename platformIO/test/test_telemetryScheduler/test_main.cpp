@@ -0,0 +1,224 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include <string.h>
+#include "telemetryScheduler.h"
+#include "taskMonitor.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+#define ALL_FIELDS ((uint16_t)((1u << TELEMETRY_FIELD_COUNT) - 1))
+
+static TelemetryData sample() {
+    TelemetryData data;
+    memset(&data, 0, sizeof(data));
+    data.latitude = 47.2544141;
+    data.longitude = -1.3691732;
+    data.compass = 120.0;
+    data.wind_vane = 45.0;
+    data.targetAngle = 90;
+    data.targetTension = 1500;
+    return data;
+}
+
+// Fields of a state frame, 0 if nothing was sent
+static uint16_t sent_mask(const uint8_t* frame, size_t length) {
+    if (length == 0) {
+        return 0;
+    }
+    uint8_t raw[TELEMETRY_FRAME_SIZE];
+    cobs_decode(frame, length - 1, raw);
+    return (uint16_t)(raw[3] | (raw[4] << 8));
+}
+
+// ------------------------
+// Test: First frame has every field, then only refreshes
+// ------------------------
+void test_first_frame_and_refresh() {
+    TelemetryScheduler scheduler;
+    TelemetryData data = sample();
+    uint8_t frame[TELEMETRY_FRAME_SIZE];
+
+    TEST_ASSERT_EQUAL_HEX16(ALL_FIELDS, sent_mask(frame, scheduler.encode_state(data, 0, frame)));
+    for (uint32_t now = 100; now < TELEMETRY_REFRESH_MS; now += 100) {
+        TEST_ASSERT_EQUAL(0, scheduler.encode_state(data, now, frame));
+    }
+    TEST_ASSERT_EQUAL_HEX16(ALL_FIELDS, sent_mask(frame, scheduler.encode_state(data, TELEMETRY_REFRESH_MS, frame)));
+}
+
+// ------------------------
+// Test: Per-field period and deadband
+// ------------------------
+void test_rate_and_deadband() {
+    TelemetryScheduler scheduler;
+    TelemetryData data = sample();
+    uint8_t frame[TELEMETRY_FRAME_SIZE];
+    scheduler.encode_state(data, 0, frame);
+
+    int compass_sent = 0, wind_sent = 0;
+    for (uint32_t now = 100; now <= 2000; now += 100) {
+        data.compass += 1.0;                                    // Moves past its deadband every tick
+        data.wind_vane = (now % 200 == 0) ? 44.0 : 46.0;        // Noise inside its deadband
+        uint16_t mask = sent_mask(frame, scheduler.encode_state(data, now, frame));
+        compass_sent += (mask >> TLM_COMPASS) & 1;
+        wind_sent += (mask >> TLM_WIND_VANE) & 1;
+    }
+    TEST_ASSERT_EQUAL(2000 / scheduler.field_config(TLM_COMPASS).period_ms, compass_sent);
+    TEST_ASSERT_EQUAL(0, wind_sent);
+
+    // 359.5° to 0.5° is a 1° move, not 359°
+    TEST_ASSERT_TRUE(scheduler.configure("compass,0,1,1.5"));
+    data.compass = 359.5;
+    scheduler.encode_state(data, 2100, frame);
+    data.compass = 0.5;
+    TEST_ASSERT_EQUAL(0, sent_mask(frame, scheduler.encode_state(data, 2200, frame)) & (1u << TLM_COMPASS));
+}
+
+// ------------------------
+// Test: Byte budget, critical fields first
+// ------------------------
+static uint32_t run_loaded(TelemetryScheduler& scheduler, int* sent) {
+    TelemetryData data = sample();
+    uint8_t frame[TELEMETRY_FRAME_SIZE];
+    uint32_t bytes = 0;
+    memset(sent, 0, TELEMETRY_FIELD_COUNT * sizeof(int));
+    for (uint32_t now = 0; now < 10000; now += 100) {
+        // Every sensor field moves past its deadband every tick, the setpoints every second
+        data.latitude += 0.00001;
+        data.longitude += 0.00001;
+        data.compass += 5.0;
+        data.wind_vane += 5.0;
+        data.horizontal_tilt = -data.horizontal_tilt + 5.0;
+        data.vertical_tilt = -data.vertical_tilt + 5.0;
+        if (now % 1000 == 0) {
+            data.targetAngle++;
+            data.targetTension++;
+        }
+        data.angleFromNorth++;
+        size_t length = scheduler.encode_state(data, now, frame);
+        bytes += length;
+        uint16_t mask = sent_mask(frame, length);
+        for (int f = 0; f < TELEMETRY_FIELD_COUNT; f++) {
+            sent[f] += (mask >> f) & 1;
+        }
+    }
+    return bytes;
+}
+
+void test_budget() {
+    int weak[TELEMETRY_FIELD_COUNT], strong[TELEMETRY_FIELD_COUNT];
+    TelemetryScheduler scheduler;
+    scheduler.set_link_quality(0.0f);
+    TEST_ASSERT_EQUAL(TELEMETRY_BUDGET_MIN, scheduler.budget());
+    uint32_t weak_bytes = run_loaded(scheduler, weak);
+    TEST_ASSERT_TRUE(weak_bytes <= TELEMETRY_BUDGET_MIN * (10000 + TELEMETRY_BURST_MS) / 1000);
+    TEST_ASSERT_TRUE(weak_bytes >= TELEMETRY_BUDGET_MIN * 9);
+    TEST_ASSERT_EQUAL(10, weak[TLM_TARGET_ANGLE]);
+    TEST_ASSERT_TRUE(weak[TLM_LATITUDE] > weak[TLM_COMPASS]);
+    TEST_ASSERT_TRUE(weak[TLM_COMPASS] > weak[TLM_VERTICAL_TILT]);
+
+    TelemetryScheduler good;
+    good.set_link_quality(1.0f);
+    TEST_ASSERT_EQUAL(TELEMETRY_BUDGET_MAX, good.budget());
+    uint32_t strong_bytes = run_loaded(good, strong);
+    TEST_ASSERT_TRUE(strong_bytes > weak_bytes);
+    // Enough budget: every field at its own rate
+    TEST_ASSERT_EQUAL(10000 / good.field_config(TLM_COMPASS).period_ms, strong[TLM_COMPASS]);
+    TEST_ASSERT_EQUAL(10000 / good.field_config(TLM_VERTICAL_TILT).period_ms, strong[TLM_VERTICAL_TILT]);
+}
+
+// ------------------------
+// Test: Task usage lines never starve the priority-0 fields
+// ------------------------
+void test_text_burst() {
+    TelemetryScheduler scheduler;
+    scheduler.set_link_quality(0.0f);
+    TelemetryData data = sample();
+    uint8_t frame[TELEMETRY_FRAME_SIZE];
+
+    // One usage line per task every 5 s, as monitorTask queues them (64-68 bytes each)
+    TaskUsage usage;
+    memset(&usage, 0, sizeof(usage));
+    usage.cpu_permille = 123;
+    usage.stack_free_words = 412;
+    usage.loops = 250;
+    usage.exec_max_us = 1840;
+    usage.period_min_us = 19990;
+    usage.period_max_us = 20011;
+    char line[TELEMETRY_TEXT_SIZE + 1];
+
+    int waiting = 0, text_sent = 0, latitude_sent = 0;
+    for (uint32_t now = 0; now < 30000; now += 100) {
+        data.latitude += 0.00001;
+        data.longitude += 0.00001;
+        // Same order as XbeeTask: state frame first, then the waiting lines
+        latitude_sent += (sent_mask(frame, scheduler.encode_state(data, now, frame)) >> TLM_LATITUDE) & 1;
+        if (now % 5000 == 0) {
+            waiting += MONITORED_TASK_COUNT;
+        }
+        while (waiting > 0) {
+            usage.task = (uint8_t)(waiting % MONITORED_TASK_COUNT);
+            format_task_usage(usage, line, sizeof(line));
+            if (scheduler.encode_text(line, now, frame) == 0) {
+                break;
+            }
+            waiting--;
+            text_sent++;
+        }
+    }
+    // Latitude keeps its 500 ms period, the lines wait for a better link
+    TEST_ASSERT_EQUAL(30000 / scheduler.field_config(TLM_LATITUDE).period_ms, latitude_sent);
+    TEST_ASSERT_TRUE(waiting > 0);
+
+    // Good link: the waiting lines go out, the state frames still keep their rate
+    scheduler.set_link_quality(1.0f);
+    latitude_sent = 0;
+    for (uint32_t now = 30000; now < 35000; now += 100) {
+        data.latitude += 0.00001;
+        latitude_sent += (sent_mask(frame, scheduler.encode_state(data, now, frame)) >> TLM_LATITUDE) & 1;
+        while (waiting > 0 && scheduler.encode_text(line, now, frame) != 0) {
+            waiting--;
+            text_sent++;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, waiting);
+    TEST_ASSERT_EQUAL(5000 / scheduler.field_config(TLM_LATITUDE).period_ms, latitude_sent);
+}
+
+// ------------------------
+// Test: Field settings from the ground station
+// ------------------------
+void test_configure() {
+    TelemetryScheduler scheduler;
+    TEST_ASSERT_TRUE(scheduler.configure("wind_vane,250,1,2.5"));
+    TEST_ASSERT_EQUAL(250, scheduler.field_config(TLM_WIND_VANE).period_ms);
+    TEST_ASSERT_EQUAL(1, scheduler.field_config(TLM_WIND_VANE).priority);
+    TEST_ASSERT_EQUAL(250, scheduler.field_config(TLM_WIND_VANE).deadband);
+
+    TEST_ASSERT_FALSE(scheduler.configure("wind,250,1,2.5"));
+    TEST_ASSERT_FALSE(scheduler.configure("wind_vane,250,1"));
+    TEST_ASSERT_FALSE(scheduler.configure("wind_vane,250,1,-1"));
+    TEST_ASSERT_FALSE(scheduler.configure("wind_vane,70000,1,0"));
+    TEST_ASSERT_EQUAL(250, scheduler.field_config(TLM_WIND_VANE).period_ms);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_first_frame_and_refresh);
+    RUN_TEST(test_rate_and_deadband);
+    RUN_TEST(test_budget);
+    RUN_TEST(test_text_burst);
+    RUN_TEST(test_configure);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
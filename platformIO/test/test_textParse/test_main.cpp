@@ -0,0 +1,69 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "textParse.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ------------------------
+// Test: Radio Command Values
+// ------------------------
+void test_parse_values(void) {
+    double value = 0.0;
+    TEST_ASSERT_TRUE(parse_decimal("47.2498", nullptr, &value));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 47.2498, value);
+    TEST_ASSERT_TRUE(parse_decimal("-1.5537021", nullptr, &value));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, -1.5537021, value);
+    TEST_ASSERT_TRUE(parse_decimal(" +12 ", nullptr, &value));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 12.0, value);
+    TEST_ASSERT_TRUE(parse_decimal("12.", nullptr, &value));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 12.0, value);
+    TEST_ASSERT_TRUE(parse_decimal(".5", nullptr, &value));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 0.5, value);
+    TEST_ASSERT_TRUE(parse_decimal("2.5e-3", nullptr, &value));
+    TEST_ASSERT_FLOAT_WITHIN(1e-15, 0.0025, value);
+    TEST_ASSERT_TRUE(parse_decimal("0.000000000000000000001234", nullptr, &value));
+    TEST_ASSERT_FLOAT_WITHIN(1e-30, 1.234e-21, value);
+}
+
+// ------------------------
+// Test: Bounded Text and Garbage
+// ------------------------
+void test_parse_bounds(void) {
+    // "wp:lat,lon": the latitude stops at the comma
+    const char* pair = "47.25,-1.37";
+    double lat = 0.0, lon = 0.0;
+    TEST_ASSERT_TRUE(parse_decimal(pair, pair + 5, &lat));
+    TEST_ASSERT_TRUE(parse_decimal(pair + 6, nullptr, &lon));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 47.25, lat);
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, -1.37, lon);
+    TEST_ASSERT_FALSE(parse_decimal(pair, nullptr, &lat));
+
+    // Unchanged on failure
+    double value = 3.0;
+    TEST_ASSERT_FALSE(parse_decimal("", nullptr, &value));
+    TEST_ASSERT_FALSE(parse_decimal("-", nullptr, &value));
+    TEST_ASSERT_FALSE(parse_decimal(".", nullptr, &value));
+    TEST_ASSERT_FALSE(parse_decimal("12abc", nullptr, &value));
+    TEST_ASSERT_FALSE(parse_decimal("1e", nullptr, &value));
+    TEST_ASSERT_FALSE(parse_decimal("nan", nullptr, &value));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 3.0, value);
+}
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_parse_values);
+    RUN_TEST(test_parse_bounds);
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
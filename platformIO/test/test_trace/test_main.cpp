@@ -0,0 +1,167 @@
+#include <Arduino.h>  // Required for PlatformIO/Unity compatibility
+#include <unity.h>
+#include "trace.h"
+
+#ifndef ARDUINO
+#include <thread>
+#include <vector>
+#endif
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static TraceRecord make_record(uint16_t event, uint32_t arg) {
+    TraceRecord record;
+    record.timestamp_us = 1000u + arg;
+    record.event = event;
+    record.level = TRACE_LEVEL_INFO;
+    record.arg_count = 1;
+    record.args[0] = arg;
+    record.args[1] = 0;
+    record.args[2] = 0;
+    return record;
+}
+
+// ------------------------
+// Test: Records Come Out in Order, Across Laps
+// ------------------------
+void test_push_pop_order(void) {
+    static TraceBuffer buffer;
+    TraceRecord record;
+    TEST_ASSERT_FALSE(buffer.pop(&record));
+
+    // Three laps of the ring, a few records at a time
+    uint32_t next_in = 0, next_out = 0;
+    while (next_out < 3 * TraceBuffer::CAPACITY) {
+        for (int k = 0; k < 5; k++) {
+            TEST_ASSERT_TRUE(buffer.push(make_record(EVT_PATH_DIRECTION, next_in++)));
+        }
+        while (buffer.pop(&record)) {
+            TEST_ASSERT_EQUAL_UINT32(next_out, record.args[0]);
+            TEST_ASSERT_EQUAL_UINT32(1000u + next_out, record.timestamp_us);
+            next_out++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, buffer.take_dropped());
+}
+
+// ------------------------
+// Test: Full Buffer Drops and Counts
+// ------------------------
+void test_full_buffer_drops(void) {
+    static TraceBuffer buffer;
+    for (uint32_t k = 0; k < TraceBuffer::CAPACITY; k++) {
+        TEST_ASSERT_TRUE(buffer.push(make_record(EVT_PATH_DIRECTION, k)));
+    }
+    TEST_ASSERT_FALSE(buffer.push(make_record(EVT_PATH_DIRECTION, 999)));
+    TEST_ASSERT_FALSE(buffer.push(make_record(EVT_PATH_DIRECTION, 999)));
+    TEST_ASSERT_EQUAL_UINT32(2, buffer.take_dropped());
+    TEST_ASSERT_EQUAL_UINT32(0, buffer.take_dropped());
+
+    // Oldest records are kept, one slot frees one push
+    TraceRecord record;
+    TEST_ASSERT_TRUE(buffer.pop(&record));
+    TEST_ASSERT_EQUAL_UINT32(0, record.args[0]);
+    TEST_ASSERT_TRUE(buffer.push(make_record(EVT_PATH_DIRECTION, 1000)));
+    TEST_ASSERT_FALSE(buffer.push(make_record(EVT_PATH_DIRECTION, 1001)));
+}
+
+// ------------------------
+// Test: Argument Packing and Serial Frame
+// ------------------------
+void test_frame_encoding(void) {
+    TraceRecord record;
+    record.timestamp_us = 0x04030201;
+    record.event = EVT_GPS_POSITION;
+    record.level = TRACE_LEVEL_INFO;
+    record.arg_count = 3;
+    record.args[0] = trace_pack(trace_degrees(47.2536990));
+    record.args[1] = trace_pack(trace_degrees(-1.3701990));
+    record.args[2] = trace_pack(12.5);
+
+    TEST_ASSERT_EQUAL_INT32(472536990, (int32_t)record.args[0]);
+    TEST_ASSERT_EQUAL_INT32(-13701990, (int32_t)record.args[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x41480000, record.args[2]);     // 12.5f
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFB, trace_pack((int8_t)-5));
+    TEST_ASSERT_EQUAL_HEX32(1, trace_pack(true));
+
+    uint8_t frame[TRACE_FRAME_SIZE];
+    trace_encode_frame(record, frame);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, frame[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x5A, frame[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, frame[2]);                  // Timestamp, little-endian
+    TEST_ASSERT_EQUAL_HEX8(0x04, frame[5]);
+    TEST_ASSERT_EQUAL_HEX8(EVT_GPS_POSITION, frame[6]);
+    TEST_ASSERT_EQUAL_HEX8(0, frame[7]);
+    TEST_ASSERT_EQUAL_HEX8(TRACE_LEVEL_INFO, frame[8]);
+    TEST_ASSERT_EQUAL_HEX8(3, frame[9]);
+    TEST_ASSERT_EQUAL_HEX8(0x48, frame[20]);                 // Top bytes of 12.5f
+    TEST_ASSERT_EQUAL_HEX8(0x41, frame[21]);
+
+    // Record bytes plus checksum sum to zero
+    uint8_t sum = 0;
+    for (size_t k = 2; k < TRACE_FRAME_SIZE; k++) {
+        sum += frame[k];
+    }
+    TEST_ASSERT_EQUAL_HEX8(0, sum);
+}
+
+#ifndef ARDUINO
+// ------------------------
+// Test: Concurrent Producers Lose Nothing (host only)
+// ------------------------
+void test_concurrent_producers(void) {
+    static TraceBuffer buffer;
+    const int producers = 4;
+    const uint32_t per_producer = 20000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([p, per_producer]() {
+            for (uint32_t k = 0; k < per_producer; k++) {
+                // Retry on full so every record must come out exactly once
+                while (!buffer.push(make_record((uint16_t)p, k))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Records of one producer stay in order
+    uint32_t next[producers] = {0, 0, 0, 0};
+    uint32_t received = 0;
+    TraceRecord record;
+    while (received < producers * per_producer) {
+        if (buffer.pop(&record)) {
+            TEST_ASSERT_EQUAL_UINT32(next[record.event], record.args[0]);
+            next[record.event]++;
+            received++;
+        }
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    TEST_ASSERT_FALSE(buffer.pop(&record));
+}
+#endif
+
+void setup() {
+    delay(2000);  // Allow time for serial monitor connection
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_push_pop_order);
+    RUN_TEST(test_full_buffer_drops);
+    RUN_TEST(test_frame_encoding);
+#ifndef ARDUINO
+    RUN_TEST(test_concurrent_producers);
+#endif
+
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop - tests run once in setup()
+}
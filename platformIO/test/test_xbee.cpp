@@ -25,7 +25,7 @@ xbeeImpl xbee;  // This uses the overridden Serial1
 
 // === TEST: sendValue (Serial Output) ===
 void test_send_changed_values() {
-    SharedData data = {
+    TelemetryData data = {
         .latitude = 48.8566,
         .longitude = 2.3522,
         .compass = 123.45,